@@ -76,6 +76,7 @@ sed "s/PROJECTNAME/$2/g" "$1/Source/Game/$2Game.h" > tmp.tmp     && mv tmp.tmp "
 sed "s/PROJECTNAME/$2/g" "$1/Build/iOS/$2.xcodeproj/project.pbxproj" > tmp.tmp   && mv tmp.tmp "$1/Build/iOS/$2.xcodeproj/project.pbxproj"
 sed "s/PROJECTNAME/$2/g" "$1/Build/MacOS/$2.xcodeproj/project.pbxproj" > tmp.tmp && mv tmp.tmp "$1/Build/MacOS/$2.xcodeproj/project.pbxproj"
 sed "s/PROJECTNAME/$2/g" "$1/Build/Windows/$2.vcproj" > tmp.tmp  && mv tmp.tmp "$1/Build/Windows/$2.vcproj"
+sed "s/PROJECTNAME/$2/g" "$1/Build/Linux/Makefile" > tmp.tmp  && mv tmp.tmp "$1/Build/Linux/Makefile"
 
 # All done
 ECHO "---------------------------------------"
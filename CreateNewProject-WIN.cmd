@@ -76,6 +76,7 @@ Tools\fart %DestFolder%\Source\Game\%ProjectName%Game.h PROJECTNAME %ProjectName
 Tools\fart %DestFolder%\Build\iOS\%ProjectName%.xcodeproj\project.pbxproj PROJECTNAME %ProjectName%
 Tools\fart %DestFolder%\Build\MacOS\%ProjectName%.xcodeproj\project.pbxproj PROJECTNAME %ProjectName%
 Tools\fart %DestFolder%\Build\Windows\%ProjectName%.vcproj PROJECTNAME %ProjectName%
+Tools\fart %DestFolder%\Build\Linux\Makefile PROJECTNAME %ProjectName%
 
 ECHO ---------------------------------------
 ECHO Created Project %ProjectName%
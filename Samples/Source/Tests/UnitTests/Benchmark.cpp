@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+// Includes
+#include "BasePCH.h"
+#include "Benchmark.h"
+
+// Most iterations a single repetition will run, while calibrating
+#define BENCHMARK_MAX_ITERATIONS    (1 << 24)
+
+volatile float Benchmark::Sink = 0.0f;
+
+// ***********************************************************************
+BenchmarkSuite::BenchmarkSuite()
+{
+}
+
+// ***********************************************************************
+BenchmarkSuite::~BenchmarkSuite()
+{
+    // Delete all the benchmarks
+    for(vector<Benchmark*>::iterator iter = this->Benchmarks.begin(); iter != this->Benchmarks.end(); iter++)
+    {
+        Benchmark* benchmark = (*iter);
+        GdkDelete(benchmark);
+    }
+    this->Benchmarks.clear();
+}
+
+// ***********************************************************************
+void BenchmarkSuite::Add(Benchmark* benchmark)
+{
+    this->Benchmarks.push_back(benchmark);
+}
+
+// ***********************************************************************
+void BenchmarkSuite::Run(const BenchmarkSettings& settings, vector<BenchmarkResult>& results)
+{
+    for(vector<Benchmark*>::iterator iter = this->Benchmarks.begin(); iter != this->Benchmarks.end(); iter++)
+    {
+        Benchmark* benchmark = (*iter);
+
+        // Is this benchmark filtered out?
+        if(settings.Filter.empty() == false && benchmark->Name.find(settings.Filter) == string::npos)
+            continue;
+
+        results.push_back(RunBenchmark(benchmark, settings));
+    }
+}
+
+// ***********************************************************************
+BenchmarkResult BenchmarkSuite::RunBenchmark(Benchmark* benchmark, const BenchmarkSettings& settings)
+{
+    BenchmarkResult result;
+    result.Name = benchmark->Name;
+
+    // Without a graphics device, skip the benchmarks that need one
+    if(settings.Headless && benchmark->NeedsGraphics)
+    {
+        result.Skipped = true;
+        return result;
+    }
+
+    benchmark->OnSetup();
+
+    // Find how many iterations fill a repetition
+    int iterations = 1;
+    while(iterations < BENCHMARK_MAX_ITERATIONS)
+    {
+        double startTime = HighResTimer::GetSeconds();
+        benchmark->OnRun(iterations);
+        double elapsed = HighResTimer::GetSeconds() - startTime;
+        if(elapsed >= settings.MinRepetitionTime)
+            break;
+
+        // Grow towards the target time, at most 10x per step
+        double scale = (elapsed > 0.0) ? (settings.MinRepetitionTime * 1.2 / elapsed) : 10.0;
+        if(scale > 10.0)
+            scale = 10.0;
+        if(scale < 2.0)
+            scale = 2.0;
+        iterations = (int)(iterations * scale);
+    }
+    if(iterations > BENCHMARK_MAX_ITERATIONS)
+        iterations = BENCHMARK_MAX_ITERATIONS;
+
+    // Warm up
+    for(int run = 0; run < settings.WarmupRuns; run++)
+        benchmark->OnRun(iterations);
+
+    // Time the repetitions  (In nanoseconds per iteration)
+    vector<double> times;
+    for(int run = 0; run < settings.Repetitions; run++)
+    {
+        double startTime = HighResTimer::GetSeconds();
+        benchmark->OnRun(iterations);
+        double elapsed = HighResTimer::GetSeconds() - startTime;
+        times.push_back(elapsed * 1.0e9 / iterations);
+    }
+
+    // Count the GL commands of a single iteration, & capture them
+    if(benchmark->NeedsGraphics && GLCommandRecorder::IsNullDevice())
+    {
+        if(settings.CaptureFolder.empty() == false)
+        {
+            string capturePath = Path::Combine(settings.CaptureFolder.c_str(), (benchmark->Name + ".glcapture").c_str());
+            GLCommandRecorder::StartCapture(capturePath.c_str());
+        }
+
+        GLCommandRecorder::ResetStats();
+        benchmark->OnRun(1);
+        GLCommandRecorder::StopCapture();
+
+        result.GLCommands = GLCommandRecorder::GetStats().Commands;
+        result.GLBytes = GLCommandRecorder::GetStats().Bytes;
+    }
+
+    benchmark->OnTeardown();
+
+    // Statistics
+    result.Iterations = iterations;
+    result.Repetitions = (int) times.size();
+    if(times.empty())
+        return result;
+
+    sort(times.begin(), times.end());
+    size_t count = times.size();
+    result.Min = times.front();
+    result.Max = times.back();
+    result.Median = (count % 2 == 1) ? times[count / 2] : (times[count / 2 - 1] + times[count / 2]) * 0.5;
+
+    double sum = 0.0;
+    for(size_t index = 0; index < count; index++)
+        sum += times[index];
+    result.Mean = sum / count;
+
+    double variance = 0.0;
+    for(size_t index = 0; index < count; index++)
+        variance += (times[index] - result.Mean) * (times[index] - result.Mean);
+    result.StdDev = (count > 1) ? sqrt(variance / (count - 1)) : 0.0;
+
+    return result;
+}
+
+// ***********************************************************************
+static void WriteJSONString(FileStream* file, const char* text)
+{
+    // Quote the text, escaping any quotes, backslashes & control characters in it
+    string escaped = "\"";
+    for(const char* c = text; *c != '\0'; c++)
+    {
+        if(*c == '"' || *c == '\\')
+        {
+            escaped += '\\';
+            escaped += *c;
+        }
+        else if((unsigned char) *c < 0x20)
+        {
+            char code[8];
+            GDK_SNPRINTF(code, sizeof(code), "\\u%04x", (unsigned int)(unsigned char) *c);
+            escaped += code;
+        }
+        else
+            escaped += *c;
+    }
+    escaped += '"';
+    file->Write((void*) escaped.c_str(), escaped.length());
+}
+
+// ***********************************************************************
+static void WriteClamped(FileStream* file, const char* line, int length, int lineSize)
+{
+    // GDK_SNPRINTF returns the untruncated length
+    if(length < 0 || length >= lineSize)
+        length = (int) strlen(line);
+    file->Write((void*) line, length);
+}
+
+// ***********************************************************************
+void BenchmarkSuite::WriteJSON(const char* path, const vector<BenchmarkResult>& results, const BenchmarkSettings& settings)
+{
+    FileStream* file = File::Create(path);
+    if(file == NULL)
+    {
+        LOG_ERROR("Unable to write the benchmark results to: %s", path);
+        return;
+    }
+    char line[1024];
+
+    int length = GDK_SNPRINTF(line, sizeof(line),
+        "{\n  \"platform\": \"%s\",\n  \"repetitions\": %d,\n  \"warmup_runs\": %d,\n  \"regression_threshold\": %.3f,\n  \"benchmarks\": [\n",
+        PlatformType::ToString(Device::GetPlatformType()), settings.Repetitions, settings.WarmupRuns, settings.RegressionThreshold
+        );
+    WriteClamped(file, line, length, sizeof(line));
+
+    for(size_t index = 0; index < results.size(); index++)
+    {
+        const BenchmarkResult& result = results[index];
+        const char* separator = (index + 1 < results.size()) ? "," : "";
+
+        // The name can be any length, so it is written on its own
+        length = GDK_SNPRINTF(line, sizeof(line), "    { \"name\": ");
+        WriteClamped(file, line, length, sizeof(line));
+        WriteJSONString(file, result.Name.c_str());
+
+        if(result.Skipped)
+        {
+            length = GDK_SNPRINTF(line, sizeof(line), ", \"skipped\": true }%s\n", separator);
+        }
+        else
+        {
+            length = GDK_SNPRINTF(line, sizeof(line),
+                ", \"iterations\": %d, \"min_ns\": %.3f, \"median_ns\": %.3f, \"mean_ns\": %.3f, \"stddev_ns\": %.3f, \"max_ns\": %.3f, "
+                "\"gl_commands\": %d, \"gl_bytes\": %lld, \"baseline_median_ns\": %.3f, \"change\": %.4f, \"regressed\": %s }%s\n",
+                result.Iterations, result.Min, result.Median, result.Mean, result.StdDev, result.Max,
+                result.GLCommands, (long long) result.GLBytes, result.BaselineMedian, result.Change, result.Regressed ? "true" : "false", separator
+                );
+        }
+        WriteClamped(file, line, length, sizeof(line));
+    }
+
+    length = GDK_SNPRINTF(line, sizeof(line), "  ]\n}\n");
+    WriteClamped(file, line, length, sizeof(line));
+
+    file->Close();
+    GdkDelete(file);
+}
+
+// ***********************************************************************
+bool BenchmarkSuite::LoadBaseline(const char* path, map<string, BenchmarkResult>& baseline)
+{
+    if(File::Exists(path) == false)
+        return false;
+
+    // Read the whole file
+    FileStream* file = File::Open(path, FileMode::Read);
+    if(file == NULL)
+    {
+        LOG_ERROR("Unable to open the benchmark baseline: %s", path);
+        return false;
+    }
+    int size = (int) file->GetLength();
+    string text(size, '\0');
+    if(size > 0)
+        file->Read(&text[0], size);
+    file->Close();
+    GdkDelete(file);
+
+    // Pick the name, median & GL counts out of each benchmark's line  (The baseline is a JSON file from WriteJSON)
+    size_t position = 0;
+    while((position = text.find("\"name\": \"", position)) != string::npos)
+    {
+        position += 9;
+        size_t lineEnd = text.find('\n', position);
+
+        // Read the name up to its closing quote, undoing WriteJSONString's escapes
+        string name;
+        size_t nameEnd = position;
+        while(nameEnd < text.length() && text[nameEnd] != '"')
+        {
+            if(text[nameEnd] == '\\' && nameEnd + 1 < text.length())
+            {
+                nameEnd++;
+                if(text[nameEnd] == 'u' && nameEnd + 4 < text.length())
+                {
+                    name += (char) strtol(text.substr(nameEnd + 1, 4).c_str(), NULL, 16);
+                    nameEnd += 5;
+                    continue;
+                }
+            }
+            name += text[nameEnd++];
+        }
+        if(nameEnd >= text.length())
+            break;
+
+        size_t medianPosition = text.find("\"median_ns\": ", nameEnd);
+        if(medianPosition != string::npos && medianPosition < lineEnd)
+        {
+            BenchmarkResult& result = baseline[name];
+            result.Name = name;
+            result.Median = atof(text.c_str() + medianPosition + 13);
+
+            size_t commandsPosition = text.find("\"gl_commands\": ", nameEnd);
+            if(commandsPosition != string::npos && commandsPosition < lineEnd)
+                result.GLCommands = atoi(text.c_str() + commandsPosition + 15);
+
+            size_t bytesPosition = text.find("\"gl_bytes\": ", nameEnd);
+            if(bytesPosition != string::npos && bytesPosition < lineEnd)
+                result.GLBytes = (Int64) atof(text.c_str() + bytesPosition + 12);
+        }
+
+        position = nameEnd;
+    }
+
+    // A baseline file that holds no results is corrupt, or isn't one of ours.  Comparing against it would silently pass
+    if(baseline.empty())
+    {
+        LOG_ERROR("The benchmark baseline [%s] has no benchmark results", path);
+        return false;
+    }
+    return true;
+}
+
+// ***********************************************************************
+int BenchmarkSuite::CompareToBaseline(vector<BenchmarkResult>& results, const map<string, BenchmarkResult>& baseline, double threshold)
+{
+    int numRegressions = 0;
+    for(vector<BenchmarkResult>::iterator iter = results.begin(); iter != results.end(); iter++)
+    {
+        BenchmarkResult& result = *iter;
+        map<string, BenchmarkResult>::const_iterator baselineResult = baseline.find(result.Name);
+        if(result.Skipped || baselineResult == baseline.end() || baselineResult->second.Median <= 0.0)
+            continue;
+
+        result.BaselineMedian = baselineResult->second.Median;
+        result.BaselineGLCommands = baselineResult->second.GLCommands;
+        result.BaselineGLBytes = baselineResult->second.GLBytes;
+        result.Change = (result.Median - result.BaselineMedian) / result.BaselineMedian;
+
+        // The GL counts don't vary from run to run, so any increase is a regression
+        result.Regressed = result.Change > threshold ||
+            (result.BaselineGLCommands > 0 && result.GLCommands > result.BaselineGLCommands) ||
+            (result.BaselineGLBytes > 0 && result.GLBytes > result.BaselineGLBytes);
+        if(result.Regressed)
+            numRegressions++;
+    }
+    return numRegressions;
+}
+
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+using namespace Gdk;
+
+// ==============================================
+class BenchmarkSettings
+{
+public:
+    // Properties
+    int WarmupRuns;                 // Untimed repetitions, before the timed ones
+    int Repetitions;                // Timed repetitions  (The statistics are over these)
+    double MinRepetitionTime;       // Each repetition runs enough iterations to take at least this many seconds
+    double RegressionThreshold;     // A median this much slower than the baseline is a regression  (0.10 = 10%)
+    bool Headless;                  // Skip the benchmarks that need the graphics device
+    string Filter;                  // Only run the benchmarks with this text in their name  (Empty = all)
+    string CaptureFolder;           // Capture the GL commands of each graphics benchmark here  (Null graphics device only.  Empty = none)
+
+    // CTor
+    BenchmarkSettings()
+        : WarmupRuns(2), Repetitions(15), MinRepetitionTime(0.01), RegressionThreshold(0.10), Headless(false)
+    {}
+};
+
+// ==============================================
+class BenchmarkResult
+{
+public:
+    // Properties
+    string Name;
+    bool Skipped;
+    int Iterations;                 // Iterations in each repetition
+    int Repetitions;
+
+    // Nanoseconds per iteration
+    double Min;
+    double Median;
+    double Mean;
+    double StdDev;
+    double Max;
+
+    // GL commands sent by a single iteration  (Only counted by the null graphics device)
+    int GLCommands;
+    Int64 GLBytes;
+
+    // Baseline comparison
+    double BaselineMedian;          // 0 = not in the baseline
+    double Change;                  // (Median - BaselineMedian) / BaselineMedian
+    int BaselineGLCommands;         // 0 = not counted in the baseline
+    Int64 BaselineGLBytes;          // 0 = not counted in the baseline
+    bool Regressed;                 // Slower than the threshold allows, or sending more GL commands or bytes
+
+    // CTor
+    BenchmarkResult()
+        : Skipped(false), Iterations(0), Repetitions(0), Min(0), Median(0), Mean(0), StdDev(0), Max(0),
+          GLCommands(0), GLBytes(0), BaselineMedian(0), Change(0), BaselineGLCommands(0), BaselineGLBytes(0), Regressed(false)
+    {}
+};
+
+// ==============================================
+class Benchmark
+{
+public:
+    // Properties
+    string Name;
+    bool NeedsGraphics;
+
+    // CTor / DTor
+    Benchmark(const char* name, bool needsGraphics = false)
+        : Name(name), NeedsGraphics(needsGraphics)
+    {}
+    virtual ~Benchmark() {}
+
+    // Benchmark overrides
+    virtual void OnSetup() {}
+    virtual void OnRun(int iterations) = 0;     // Does the measured work, the given number of times
+    virtual void OnTeardown() {}
+
+    // Benchmarks write their results here, so the optimizer can't remove the work
+    static volatile float Sink;
+};
+
+// ==============================================
+class BenchmarkSuite
+{
+public:
+    // Properties
+    vector<Benchmark*> Benchmarks;
+
+    // CTor / DTor
+    BenchmarkSuite();
+    ~BenchmarkSuite();
+
+    // Adding benchmarks
+    void Add(Benchmark* benchmark);
+    void AddEngineBenchmarks();
+
+    // Running
+    void Run(const BenchmarkSettings& settings, vector<BenchmarkResult>& results);
+    static BenchmarkResult RunBenchmark(Benchmark* benchmark, const BenchmarkSettings& settings);
+
+    // Baselines
+    static void WriteJSON(const char* path, const vector<BenchmarkResult>& results, const BenchmarkSettings& settings);
+    static bool LoadBaseline(const char* path, map<string, BenchmarkResult>& baseline);
+    static int CompareToBaseline(vector<BenchmarkResult>& results, const map<string, BenchmarkResult>& baseline, double threshold);
+};
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+//
+// Headless benchmark runner, for tracking engine performance on a build machine
+//
+// Usage:
+//
+//      GdkBenchmarks [-o results.json] [-b baseline.json] [-t threshold] [-r repetitions] [-f filter] [-c folder]
+//
+//          -o results.json     Where to write the results  (Default = Benchmarks.json)
+//          -b baseline.json    Results of an earlier run, to compare against
+//          -t threshold        Slowdown of the median that counts as a regression  (Default = 0.10, or 10%)
+//          -r repetitions      Timed repetitions of each benchmark  (Default = 15)
+//          -f filter           Only run the benchmarks with this text in their name
+//          -c folder           Capture the GL commands of one iteration of each graphics benchmark, to diff against
+//                              another build's.  (Null graphics device only)
+//
+//      Returns 1 if any benchmark regressed against the baseline, so the build can fail on it.  Returns 2 if
+//      the baseline file can't be read, or has no results in it.
+//
+// Building:
+//
+//      Build the Gdk & Samples/Source/Tests/UnitTests/Benchmark*.cpp with GDK_BENCHMARK_MAIN defined,
+//      without SampleGame.cpp.  The graphics device is never created, so the benchmarks that need
+//      it are skipped.  Unless the GDK is built with the null graphics device  (GDK_NULL_GRAPHICS):  It needs
+//      no GPU, so the graphics benchmarks run too, and count the GL commands & bytes they send.
+//
+
+#ifdef GDK_BENCHMARK_MAIN
+
+// Includes
+#include "BasePCH.h"
+#include "Benchmark.h"
+
+// ***********************************************************************
+class BenchmarkGame : public Game
+{
+public:
+    virtual bool OnLoadSettings(ApplicationSettings &settings)
+    {
+        Game::OnLoadSettings(settings);
+
+        // The benchmarks don't load anything in the background
+        settings.ResourceLoaderBackgroundThreads = 0;
+        settings.AsyncIOThreads = 1;
+        return true;
+    }
+};
+
+GDK_GAME_CLASS(BenchmarkGame);
+
+// ***********************************************************************
+int main(int argc, char** argv)
+{
+    // Parse the command line
+    const char* outputPath = "Benchmarks.json";
+    const char* baselinePath = NULL;
+    BenchmarkSettings settings;
+    settings.Headless = true;
+
+    for(int argIndex = 1; argIndex < argc; argIndex++)
+    {
+        if(strcmp(argv[argIndex], "-o") == 0 && argIndex + 1 < argc)
+            outputPath = argv[++argIndex];
+        else if(strcmp(argv[argIndex], "-b") == 0 && argIndex + 1 < argc)
+            baselinePath = argv[++argIndex];
+        else if(strcmp(argv[argIndex], "-t") == 0 && argIndex + 1 < argc)
+            settings.RegressionThreshold = atof(argv[++argIndex]);
+        else if(strcmp(argv[argIndex], "-r") == 0 && argIndex + 1 < argc)
+            settings.Repetitions = atoi(argv[++argIndex]);
+        else if(strcmp(argv[argIndex], "-f") == 0 && argIndex + 1 < argc)
+            settings.Filter = argv[++argIndex];
+        else if(strcmp(argv[argIndex], "-c") == 0 && argIndex + 1 < argc)
+            settings.CaptureFolder = argv[++argIndex];
+        else
+        {
+            printf("Usage: GdkBenchmarks [-o results.json] [-b baseline.json] [-t threshold] [-r repetitions] [-f filter] [-c folder]\n");
+            return 2;
+        }
+    }
+
+    // Start the GDK systems  (But not the game, which would create the graphics device)
+    if(Application::Platform_InitGdk() == false)
+        return 2;
+
+    // The null graphics device is safe to create anywhere
+    if(GLCommandRecorder::IsNullDevice())
+    {
+        Graphics::Platform_SetOSFrameBuffers(0, 0, 0, 0);
+        if(Application::Platform_InitGame() == false)
+            return 2;
+        settings.Headless = false;
+
+        if(settings.CaptureFolder.empty() == false && Directory::Exists(settings.CaptureFolder.c_str()) == false)
+            Directory::Create(settings.CaptureFolder.c_str());
+    }
+
+    // Run the benchmarks
+    vector<BenchmarkResult> results;
+    {
+        BenchmarkSuite suite;
+        suite.AddEngineBenchmarks();
+        suite.Run(settings, results);
+    }
+
+    // Compare to the baseline
+    int numRegressions = 0;
+    bool baselineFailed = false;
+    map<string, BenchmarkResult> baseline;
+    if(baselinePath != NULL)
+    {
+        if(BenchmarkSuite::LoadBaseline(baselinePath, baseline))
+            numRegressions = BenchmarkSuite::CompareToBaseline(results, baseline, settings.RegressionThreshold);
+        else if(File::Exists(baselinePath))
+        {
+            printf("ERROR: Unable to read any baseline results from %s\n", baselinePath);
+            baselineFailed = true;
+        }
+        else
+            printf("WARNING: No baseline file at %s\n", baselinePath);
+    }
+
+    BenchmarkSuite::WriteJSON(outputPath, results, settings);
+
+    // Print a summary
+    printf("%-40s %12s %12s %10s %8s %10s %10s\n", "Benchmark", "Median ns", "StdDev ns", "Iterations", "Change", "GL cmds", "GL bytes");
+    for(vector<BenchmarkResult>::iterator iter = results.begin(); iter != results.end(); iter++)
+    {
+        const BenchmarkResult& result = *iter;
+        if(result.Skipped)
+        {
+            printf("%-40s %12s\n", result.Name.c_str(), "skipped");
+            continue;
+        }
+
+        char change[32] = "";
+        if(result.BaselineMedian > 0.0)
+            GDK_SPRINTF(change, sizeof(change), "%+.1f%%", result.Change * 100.0);
+        printf("%-40s %12.2f %12.2f %10d %8s %10d %10lld%s\n",
+            result.Name.c_str(), result.Median, result.StdDev, result.Iterations, change,
+            result.GLCommands, (long long) result.GLBytes, result.Regressed ? "  REGRESSED" : "");
+    }
+    printf("%d regression(s).  Results written to %s\n", numRegressions, outputPath);
+
+    if(GLCommandRecorder::IsNullDevice())
+        Application::Platform_ShutdownGame();
+    Application::Platform_ShutdownGdk();
+
+    if(baselineFailed)
+        return 2;
+    return numRegressions > 0 ? 1 : 0;
+}
+
+#endif // GDK_BENCHMARK_MAIN
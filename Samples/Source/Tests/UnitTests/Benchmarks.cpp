@@ -0,0 +1,607 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+// Includes
+#include "BasePCH.h"
+#include "Benchmark.h"
+
+// The benchmarks use fixed inputs, rather than Random, so every run measures the same work
+
+// Number of inputs each benchmark cycles through  (Must be a power of 2)
+#define BENCHMARK_NUM_INPUTS    256
+
+// ***********************************************************************
+static float InputValue(int index, float scale)
+{
+    // A cheap, repeatable spread of values in [-scale, scale]
+    UInt32 hash = (UInt32) index * 2654435761u;
+    return ((hash >> 8) / (float)(1 << 24) * 2.0f - 1.0f) * scale;
+}
+
+// ***********************************************************************
+static Vector3 InputVector(int index, float scale)
+{
+    return Vector3(InputValue(index * 3, scale), InputValue(index * 3 + 1, scale), InputValue(index * 3 + 2, scale));
+}
+
+// ###########################################################################################################
+// Math
+
+// ***********************************************************************
+class Matrix3DMultiplyBenchmark : public Benchmark
+{
+public:
+    Matrix3D Matrices[BENCHMARK_NUM_INPUTS];
+
+    Matrix3DMultiplyBenchmark() : Benchmark("Math.Matrix3D.Multiply") {}
+
+    virtual void OnSetup()
+    {
+        for(int index = 0; index < BENCHMARK_NUM_INPUTS; index++)
+        {
+            Matrices[index] = Matrix3D::CreateRotationOnAxis(InputVector(index, 1.0f).GetNormalized(), InputValue(index, 3.0f));
+            Matrices[index].Translate(InputVector(index + 1, 10.0f));
+        }
+    }
+
+    virtual void OnRun(int iterations)
+    {
+        Matrix3D result;
+        for(int i = 0; i < iterations; i++)
+        {
+            int index = i & (BENCHMARK_NUM_INPUTS - 1);
+            result = Matrices[index] * Matrices[(index + 1) & (BENCHMARK_NUM_INPUTS - 1)];
+            Sink = result.M11;
+        }
+    }
+};
+
+// ***********************************************************************
+class Matrix3DInverseBenchmark : public Benchmark
+{
+public:
+    Matrix3D Matrices[BENCHMARK_NUM_INPUTS];
+
+    Matrix3DInverseBenchmark() : Benchmark("Math.Matrix3D.Inverse") {}
+
+    virtual void OnSetup()
+    {
+        Matrix3D projection = Matrix3D::CreatePerspectiveFOV(1.0f, 1.5f, 0.1f, 100.0f);
+        for(int index = 0; index < BENCHMARK_NUM_INPUTS; index++)
+        {
+            Matrix3D view = Matrix3D::CreateLookAt(InputVector(index, 20.0f), Vector3::ZERO, Vector3::UNIT_Y);
+            Matrices[index] = view * projection;
+        }
+    }
+
+    virtual void OnRun(int iterations)
+    {
+        for(int i = 0; i < iterations; i++)
+        {
+            Matrix3D inverse = Matrices[i & (BENCHMARK_NUM_INPUTS - 1)].GetInverse();
+            Sink = inverse.M11;
+        }
+    }
+};
+
+// ***********************************************************************
+class Intersection3RaySphereBenchmark : public Benchmark
+{
+public:
+    Ray3 Rays[BENCHMARK_NUM_INPUTS];
+    Sphere3 Spheres[BENCHMARK_NUM_INPUTS];
+
+    Intersection3RaySphereBenchmark() : Benchmark("Math.Intersection3.FindRaySphere") {}
+
+    virtual void OnSetup()
+    {
+        for(int index = 0; index < BENCHMARK_NUM_INPUTS; index++)
+        {
+            Rays[index] = Ray3(InputVector(index, 10.0f), InputVector(index + 7, 1.0f).GetNormalized());
+            Spheres[index] = Sphere3(InputVector(index + 13, 10.0f), 1.0f + Math::Abs(InputValue(index, 4.0f)));
+        }
+    }
+
+    virtual void OnRun(int iterations)
+    {
+        float distance = 0.0f;
+        int hits = 0;
+        for(int i = 0; i < iterations; i++)
+        {
+            int index = i & (BENCHMARK_NUM_INPUTS - 1);
+            if(Intersection3::Find(Rays[index], Spheres[(index * 7) & (BENCHMARK_NUM_INPUTS - 1)], distance))
+                hits++;
+        }
+        Sink = distance + hits;
+    }
+};
+
+// ***********************************************************************
+class Intersection3RayBoxBenchmark : public Benchmark
+{
+public:
+    Ray3 Rays[BENCHMARK_NUM_INPUTS];
+    Box3 Boxes[BENCHMARK_NUM_INPUTS];
+
+    Intersection3RayBoxBenchmark() : Benchmark("Math.Intersection3.FindRayBox") {}
+
+    virtual void OnSetup()
+    {
+        for(int index = 0; index < BENCHMARK_NUM_INPUTS; index++)
+        {
+            Rays[index] = Ray3(InputVector(index, 10.0f), InputVector(index + 7, 1.0f).GetNormalized());
+
+            Matrix3D rotation = Matrix3D::CreateRotationOnAxis(InputVector(index + 3, 1.0f).GetNormalized(), InputValue(index, 3.0f));
+            Boxes[index] = Box3(
+                InputVector(index + 13, 10.0f),
+                Vector3(rotation.M11, rotation.M12, rotation.M13),
+                Vector3(rotation.M21, rotation.M22, rotation.M23),
+                Vector3(rotation.M31, rotation.M32, rotation.M33),
+                1.0f, 2.0f, 3.0f
+                );
+        }
+    }
+
+    virtual void OnRun(int iterations)
+    {
+        float distance = 0.0f;
+        int hits = 0;
+        for(int i = 0; i < iterations; i++)
+        {
+            int index = i & (BENCHMARK_NUM_INPUTS - 1);
+            if(Intersection3::Find(Rays[index], Boxes[(index * 7) & (BENCHMARK_NUM_INPUTS - 1)], distance))
+                hits++;
+        }
+        Sink = distance + hits;
+    }
+};
+
+// ***********************************************************************
+class Intersection3FrustumSphereBenchmark : public Benchmark
+{
+public:
+    Frustum3* Frustum;
+    Sphere3 Spheres[BENCHMARK_NUM_INPUTS];
+
+    Intersection3FrustumSphereBenchmark() : Benchmark("Math.Intersection3.TestFrustumSphere"), Frustum(NULL) {}
+
+    virtual void OnSetup()
+    {
+        Matrix3D view = Matrix3D::CreateLookAt(Vector3(0.0f, 5.0f, -20.0f), Vector3::ZERO, Vector3::UNIT_Y);
+        Frustum = GdkNew Frustum3(view * Matrix3D::CreatePerspectiveFOV(1.0f, 1.5f, 0.1f, 100.0f));
+        for(int index = 0; index < BENCHMARK_NUM_INPUTS; index++)
+            Spheres[index] = Sphere3(InputVector(index, 40.0f), 1.0f + Math::Abs(InputValue(index, 2.0f)));
+    }
+
+    virtual void OnRun(int iterations)
+    {
+        int visible = 0;
+        for(int i = 0; i < iterations; i++)
+        {
+            if(Intersection3::Test(*Frustum, Spheres[i & (BENCHMARK_NUM_INPUTS - 1)]))
+                visible++;
+        }
+        Sink = (float) visible;
+    }
+
+    virtual void OnTeardown()
+    {
+        GdkDelete(Frustum);
+        Frustum = NULL;
+    }
+};
+
+// ***********************************************************************
+class QuaternionSlerpBenchmark : public Benchmark
+{
+public:
+    Quaternion Rotations[BENCHMARK_NUM_INPUTS];
+
+    QuaternionSlerpBenchmark() : Benchmark("Math.Quaternion.Slerp") {}
+
+    virtual void OnSetup()
+    {
+        for(int index = 0; index < BENCHMARK_NUM_INPUTS; index++)
+            Rotations[index] = Quaternion::FromAxisAngle(InputVector(index, 1.0f).GetNormalized(), InputValue(index + 5, 3.0f));
+    }
+
+    virtual void OnRun(int iterations)
+    {
+        Quaternion result;
+        for(int i = 0; i < iterations; i++)
+        {
+            int index = i & (BENCHMARK_NUM_INPUTS - 1);
+            float t = (i & 15) / 15.0f;
+            result = Quaternion::Slerp(t, Rotations[index], Rotations[(index + 1) & (BENCHMARK_NUM_INPUTS - 1)]);
+            Sink = result.W;
+        }
+    }
+};
+
+// ***********************************************************************
+class PerlinNoiseBenchmark : public Benchmark
+{
+public:
+    PerlinNoiseBenchmark() : Benchmark("Math.PerlinNoise.CompoundNoise3") {}
+
+    virtual void OnRun(int iterations)
+    {
+        float total = 0.0f;
+        for(int i = 0; i < iterations; i++)
+            total += PerlinNoise::CompoundNoise3((i & 63) * 0.37f, ((i >> 6) & 63) * 0.41f, (i >> 12) * 0.29f);
+        Sink = total;
+    }
+};
+
+// ###########################################################################################################
+// System
+
+// ***********************************************************************
+class StringHashMapFindBenchmark : public Benchmark
+{
+public:
+    StringHashMap<int> HashMap;
+    vector<string> Keys;
+
+    StringHashMapFindBenchmark() : Benchmark("System.StringHashMap.Find") {}
+
+    virtual void OnSetup()
+    {
+        // Asset-path-like keys
+        char key[64];
+        for(int index = 0; index < BENCHMARK_NUM_INPUTS; index++)
+        {
+            GDK_SPRINTF(key, sizeof(key), "Textures/Level%02d/Sprite_%04d.png", index % 10, index);
+            Keys.push_back(key);
+            HashMap.Add(key, index);
+        }
+    }
+
+    virtual void OnRun(int iterations)
+    {
+        int total = 0;
+        for(int i = 0; i < iterations; i++)
+        {
+            StringHashMap<int>::Iterator iter = HashMap.Find(Keys[i & (BENCHMARK_NUM_INPUTS - 1)].c_str());
+            if(iter != HashMap.End())
+                total += iter->second;
+        }
+        Sink = (float) total;
+    }
+
+    virtual void OnTeardown()
+    {
+        HashMap.Clear();
+        Keys.clear();
+    }
+};
+
+// ###########################################################################################################
+// IO
+
+// Size of the streams the IO benchmarks read
+#define BENCHMARK_STREAM_SIZE   (64 * 1024)
+
+// ***********************************************************************
+class MemoryStreamReadBenchmark : public Benchmark
+{
+public:
+    MemoryStream* Stream;
+
+    MemoryStreamReadBenchmark() : Benchmark("IO.MemoryStream.ReadInt32"), Stream(NULL) {}
+
+    virtual void OnSetup()
+    {
+        Stream = GdkNew MemoryStream(BENCHMARK_STREAM_SIZE);
+        for(int index = 0; index < BENCHMARK_STREAM_SIZE / 4; index++)
+            Stream->WriteInt32(index);
+    }
+
+    virtual void OnRun(int iterations)
+    {
+        Int32 total = 0;
+        Stream->SetPosition(0);
+        for(int i = 0; i < iterations; i++)
+        {
+            if(Stream->AtEnd())
+                Stream->SetPosition(0);
+            total += Stream->ReadInt32();
+        }
+        Sink = (float) total;
+    }
+
+    virtual void OnTeardown()
+    {
+        GdkDelete(Stream);
+        Stream = NULL;
+    }
+};
+
+// ***********************************************************************
+class BinaryReaderReadBenchmark : public Benchmark
+{
+public:
+    MemoryStream* Stream;
+
+    BinaryReaderReadBenchmark() : Benchmark("IO.BinaryReader.ReadInt32"), Stream(NULL) {}
+
+    virtual void OnSetup()
+    {
+        Stream = GdkNew MemoryStream(BENCHMARK_STREAM_SIZE);
+        for(int index = 0; index < BENCHMARK_STREAM_SIZE / 4; index++)
+            Stream->WriteInt32(index);
+    }
+
+    virtual void OnRun(int iterations)
+    {
+        Int32 total = 0;
+        int remaining = iterations;
+        while(remaining > 0)
+        {
+            // Read through the stream, restarting at the end
+            Stream->SetPosition(0);
+            BinaryReader reader(Stream);
+            int count = remaining < BENCHMARK_STREAM_SIZE / 4 ? remaining : BENCHMARK_STREAM_SIZE / 4;
+            for(int i = 0; i < count; i++)
+                total += reader.ReadInt32();
+            remaining -= count;
+        }
+        Sink = (float) total;
+    }
+
+    virtual void OnTeardown()
+    {
+        GdkDelete(Stream);
+        Stream = NULL;
+    }
+};
+
+// ***********************************************************************
+class DecompressBenchmark : public Benchmark
+{
+public:
+    CompressionType::Enum Compression;
+    vector<UInt8> Source;
+    vector<UInt8> Compressed;
+    vector<UInt8> Decompressed;
+
+    DecompressBenchmark(const char* name, CompressionType::Enum compression)
+        : Benchmark(name), Compression(compression)
+    {}
+
+    virtual void OnSetup()
+    {
+        // Somewhat compressible data, like a mix of text & vertex data
+        Source.resize(BENCHMARK_STREAM_SIZE);
+        for(int index = 0; index < BENCHMARK_STREAM_SIZE; index++)
+            Source[index] = (index & 256) ? (UInt8)('a' + (index * 7) % 26) : (UInt8)(InputValue(index >> 2, 4.0f) + 4.0f);
+
+        Compressed.resize(Stream::GetMaxCompressedSize(BENCHMARK_STREAM_SIZE, Compression));
+        int compressedSize = Stream::Compress(&Source[0], BENCHMARK_STREAM_SIZE, &Compressed[0], (int) Compressed.size(), Compression);
+        Compressed.resize(compressedSize > 0 ? compressedSize : 0);
+        Decompressed.resize(BENCHMARK_STREAM_SIZE);
+    }
+
+    virtual void OnRun(int iterations)
+    {
+        for(int i = 0; i < iterations; i++)
+            Stream::Decompress(&Compressed[0], (int) Compressed.size(), &Decompressed[0], BENCHMARK_STREAM_SIZE, Compression);
+        Sink = Decompressed[BENCHMARK_STREAM_SIZE / 2];
+    }
+
+    virtual void OnTeardown()
+    {
+        Source.clear();
+        Compressed.clear();
+        Decompressed.clear();
+    }
+};
+
+// ###########################################################################################################
+// Graphics
+
+// Quads added to the GeometryBuffer in each iteration
+#define BENCHMARK_NUM_QUADS     1000
+
+// ***********************************************************************
+class GeometryBufferAddQuadBenchmark : public Benchmark
+{
+public:
+    GeometryBuffer* Buffer;
+    VertexP2T2C4 Vertices[4];
+
+    GeometryBufferAddQuadBenchmark() : Benchmark("Graphics.GeometryBuffer.AddQuad", true), Buffer(NULL) {}
+
+    virtual void OnSetup()
+    {
+        Buffer = GdkNew GeometryBuffer();
+        Vertices[0] = VertexP2T2C4(0.0f,  0.0f,  0.0f, 0.0f, 255, 255, 255, 255);
+        Vertices[1] = VertexP2T2C4(32.0f, 0.0f,  1.0f, 0.0f, 255, 255, 255, 255);
+        Vertices[2] = VertexP2T2C4(32.0f, 32.0f, 1.0f, 1.0f, 255, 255, 255, 255);
+        Vertices[3] = VertexP2T2C4(0.0f,  32.0f, 0.0f, 1.0f, 255, 255, 255, 255);
+    }
+
+    virtual void OnRun(int iterations)
+    {
+        // Each iteration batches a frame's worth of sprites
+        for(int i = 0; i < iterations; i++)
+        {
+            Buffer->Setup(VertexP2T2C4::Format, PrimitiveTypes::IndexedTriangles);
+            for(int quad = 0; quad < BENCHMARK_NUM_QUADS; quad++)
+                Buffer->AddQuad(Vertices);
+        }
+        Sink = (float) Buffer->GetVertexCount();
+    }
+
+    virtual void OnTeardown()
+    {
+        GdkDelete(Buffer);
+        Buffer = NULL;
+    }
+};
+
+// Sprites, billboards & particles drawn in each iteration
+#define BENCHMARK_NUM_SPRITES   500
+
+// Instances of the model drawn in each iteration
+#define BENCHMARK_NUM_MODELS    20
+
+// ***********************************************************************
+static AtlasImage* BenchmarkImage(int index)
+{
+    // Cycle through the shared images  (They're all on the one atlas sheet, so they batch together)
+    AtlasImage* images[] =
+    {
+        SharedResources::AtlasImages.Particle1, SharedResources::AtlasImages.Particle2,
+        SharedResources::AtlasImages.Fence, SharedResources::AtlasImages.Test1
+    };
+    return images[index & 3];
+}
+
+// ***********************************************************************
+class Drawing2DBenchmark : public Benchmark
+{
+public:
+    Drawing2DBenchmark() : Benchmark("Graphics.Drawing2D.DrawAtlasImage", true) {}
+
+    virtual void OnRun(int iterations)
+    {
+        // Each iteration draws & flushes a frame's worth of images
+        for(int i = 0; i < iterations; i++)
+        {
+            for(int sprite = 0; sprite < BENCHMARK_NUM_SPRITES; sprite++)
+            {
+                Vector2 position(InputValue(sprite * 2, 400.0f), InputValue(sprite * 2 + 1, 300.0f));
+                Drawing2D::DrawAtlasImage(BenchmarkImage(sprite), position, Color::WHITE, InputValue(sprite, Math::PI));
+            }
+            Drawing2D::Flush();
+        }
+    }
+};
+
+// ***********************************************************************
+class BillboardRendererBenchmark : public Benchmark
+{
+public:
+    BillboardRendererBenchmark() : Benchmark("Graphics.BillboardRenderer.DrawImage", true) {}
+
+    virtual void OnRun(int iterations)
+    {
+        for(int i = 0; i < iterations; i++)
+        {
+            for(int billboard = 0; billboard < BENCHMARK_NUM_SPRITES; billboard++)
+                BillboardRenderer::DrawImage(BenchmarkImage(billboard), InputVector(billboard, 50.0f), Color::WHITE, InputValue(billboard, Math::PI));
+            BillboardRenderer::Flush();
+        }
+    }
+};
+
+// ***********************************************************************
+class ModelDrawBenchmark : public Benchmark
+{
+public:
+    Model* TankModel;
+    Matrix3D Worlds[BENCHMARK_NUM_MODELS];
+
+    ModelDrawBenchmark() : Benchmark("Graphics.Model.Draw", true), TankModel(NULL) {}
+
+    virtual void OnSetup()
+    {
+        TankModel = ModelManager::FromAsset("Models/Tank");
+        for(int index = 0; index < BENCHMARK_NUM_MODELS; index++)
+        {
+            Vector3 position = InputVector(index, 50.0f);
+            Worlds[index] = Matrix3D::CreateRotationY(InputValue(index, Math::PI));
+            Worlds[index].Translate(position.X, 0.0f, position.Z);
+        }
+    }
+
+    virtual void OnRun(int iterations)
+    {
+        for(int i = 0; i < iterations; i++)
+        {
+            for(int index = 0; index < BENCHMARK_NUM_MODELS; index++)
+            {
+                TankModel->World = Worlds[index];
+                TankModel->Draw();
+            }
+        }
+    }
+
+    virtual void OnTeardown()
+    {
+        TankModel->Release();
+        TankModel = NULL;
+    }
+};
+
+// ***********************************************************************
+class ParticleSystem2DBenchmark : public Benchmark
+{
+public:
+    ParticleSystem2D* System;
+
+    ParticleSystem2DBenchmark() : Benchmark("Graphics.ParticleSystem2D.Draw", true), System(NULL) {}
+
+    virtual void OnSetup()
+    {
+        // A full system of particles that live for the whole benchmark
+        System = GdkNew ParticleSystem2D();
+        System->EmitterEnabled = false;
+        System->DefaultImage = SharedResources::AtlasImages.Particle1;
+        System->DefaultLifetime = 1.0e6f;
+        System->Init(BENCHMARK_NUM_SPRITES);
+        System->EmitByNumber(BENCHMARK_NUM_SPRITES);
+    }
+
+    virtual void OnRun(int iterations)
+    {
+        for(int i = 0; i < iterations; i++)
+        {
+            System->Draw();
+            Drawing2D::Flush();
+        }
+    }
+
+    virtual void OnTeardown()
+    {
+        GdkDelete(System);
+        System = NULL;
+    }
+};
+
+// ###########################################################################################################
+
+// ***********************************************************************
+void BenchmarkSuite::AddEngineBenchmarks()
+{
+    // Math
+    Add(GdkNew Matrix3DMultiplyBenchmark());
+    Add(GdkNew Matrix3DInverseBenchmark());
+    Add(GdkNew Intersection3RaySphereBenchmark());
+    Add(GdkNew Intersection3RayBoxBenchmark());
+    Add(GdkNew Intersection3FrustumSphereBenchmark());
+    Add(GdkNew QuaternionSlerpBenchmark());
+    Add(GdkNew PerlinNoiseBenchmark());
+
+    // System
+    Add(GdkNew StringHashMapFindBenchmark());
+
+    // IO
+    Add(GdkNew MemoryStreamReadBenchmark());
+    Add(GdkNew BinaryReaderReadBenchmark());
+    Add(GdkNew DecompressBenchmark("IO.Stream.Decompress.ZLib", CompressionType::ZLib));
+    if(Stream::IsCompressionTypeSupported(CompressionType::LZ4))
+        Add(GdkNew DecompressBenchmark("IO.Stream.Decompress.LZ4", CompressionType::LZ4));
+    if(Stream::IsCompressionTypeSupported(CompressionType::Zstd))
+        Add(GdkNew DecompressBenchmark("IO.Stream.Decompress.Zstd", CompressionType::Zstd));
+
+    // Graphics
+    Add(GdkNew GeometryBufferAddQuadBenchmark());
+    Add(GdkNew Drawing2DBenchmark());
+    Add(GdkNew BillboardRendererBenchmark());
+    Add(GdkNew ModelDrawBenchmark());
+    Add(GdkNew ParticleSystem2DBenchmark());
+}
@@ -0,0 +1,61 @@
+/* 
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+
+// Includes
+#include "BasePCH.h"
+#include "UnitTestsModule.h"
+#include "Benchmark.h"
+ 
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::Test_Benchmarks(TestExecutionContext *context)
+{
+    // A quicker run than the headless runner, as it stalls the module
+    BenchmarkSettings settings;
+    settings.WarmupRuns = 1;
+    settings.Repetitions = 5;
+
+    vector<BenchmarkResult> results;
+    {
+        BenchmarkSuite suite;
+        suite.AddEngineBenchmarks();
+        suite.Run(settings, results);
+    }
+
+    // Compare to the baseline on this device.  The baseline is only recorded when there isn't one, so a slow creep
+    // over many runs still shows up.  (Delete BenchmarksBaseline.json to record a new one)
+    string workingFolder = Path::GetCommonPath(CommonPaths::WorkingFolder);
+    string baselinePath = Path::Combine(workingFolder.c_str(), "BenchmarksBaseline.json");
+    string resultsPath = Path::Combine(workingFolder.c_str(), "Benchmarks.json");
+    map<string, BenchmarkResult> baseline;
+    int numRegressions = 0;
+    if(File::Exists(baselinePath.c_str()))
+    {
+        // A baseline that can't be read fails, rather than being recorded over
+        UNIT_TEST_CHECK(BenchmarkSuite::LoadBaseline(baselinePath.c_str(), baseline), "Loaded the benchmark baseline: %s", baselinePath.c_str());
+        numRegressions = BenchmarkSuite::CompareToBaseline(results, baseline, settings.RegressionThreshold);
+    }
+    else
+    {
+        context->Log->WriteLine(LogLevel::Info, "Recording the benchmark baseline: %s", baselinePath.c_str());
+        BenchmarkSuite::WriteJSON(baselinePath.c_str(), results, settings);
+    }
+    BenchmarkSuite::WriteJSON(resultsPath.c_str(), results, settings);
+
+    for(vector<BenchmarkResult>::iterator iter = results.begin(); iter != results.end(); iter++)
+    {
+        const BenchmarkResult& result = *iter;
+        if(result.Skipped)
+            context->Log->WriteLine(LogLevel::Verbose, "SKIP: %s", result.Name.c_str());
+        else if(result.BaselineMedian > 0.0)
+            context->Log->WriteLine(result.Regressed ? LogLevel::Warning : LogLevel::Info, "%s: %.1f ns  (%+.1f%%)",
+                result.Name.c_str(), result.Median, result.Change * 100.0);
+        else
+            context->Log->WriteLine(LogLevel::Info, "%s: %.1f ns", result.Name.c_str(), result.Median);
+    }
+
+    return numRegressions > 0 ? TestStatus::Warning : TestStatus::Pass;
+}
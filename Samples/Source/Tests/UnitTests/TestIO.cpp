@@ -0,0 +1,974 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+
+// Includes
+#include "BasePCH.h"
+#include "UnitTestsModule.h"
+
+
+// Test data for the BinaryReader tests.  (Laid out like the node, joint & vertex sections of a .gdkmodel)
+#define TEST_NUM_NODES          8000
+#define TEST_NUM_JOINTS         4000
+#define TEST_VERTEX_DATA_SIZE   (1024 * 1024)
+
+// Size of the compression round trip test data.  (Larger than a Zstd block, & several of the decompression buffers)
+#define TEST_COMPRESSION_DATA_SIZE  (640 * 1024)
+
+// Alignment of the assets in the large pack test, so most of them are past the reach of a 32-bit offset
+#define TEST_PACK_LARGE_ALIGNMENT   (1024ULL * 1024 * 1024)
+
+// ***********************************************************************
+struct BinaryReaderTestResult
+{
+    UInt32 NameLengths;
+    UInt32 ParentSum;
+    float MatrixSum;
+    UInt32 VertexDataSum;
+
+    bool operator==(const BinaryReaderTestResult& other) const
+    {
+        return NameLengths == other.NameLengths && ParentSum == other.ParentSum
+            && MatrixSum == other.MatrixSum && VertexDataSum == other.VertexDataSum;
+    }
+};
+
+// ***********************************************************************
+void WriteBinaryReaderTestData(Stream* stream)
+{
+    char name[32];
+
+    // Nodes
+    stream->WriteUInt16(TEST_NUM_NODES);
+    for(int nodeIndex = 0; nodeIndex < TEST_NUM_NODES; nodeIndex++)
+    {
+        GDK_SPRINTF(name, 32, "Node_%d", nodeIndex);
+        stream->WriteString(name);
+        stream->WriteUInt16((UInt16)(nodeIndex / 2));
+
+        Matrix3D transform = Matrix3D::CreateTranslation((float)nodeIndex, 1.0f, 2.0f);
+        transform.WriteToStream(stream);
+    }
+
+    // Joints
+    stream->WriteUInt16(TEST_NUM_JOINTS);
+    for(int jointIndex = 0; jointIndex < TEST_NUM_JOINTS; jointIndex++)
+    {
+        Matrix3D invBindMatrix = Matrix3D::CreateScale((float)(jointIndex % 7) + 1.0f);
+        invBindMatrix.WriteToStream(stream);
+    }
+
+    // Vertex data
+    UInt8* vertexData = (UInt8*) GdkAlloc(TEST_VERTEX_DATA_SIZE);
+    for(int i = 0; i < TEST_VERTEX_DATA_SIZE; i++)
+        vertexData[i] = (UInt8)(i * 31);
+
+    stream->WriteInt32(TEST_VERTEX_DATA_SIZE);
+    stream->Write(vertexData, TEST_VERTEX_DATA_SIZE);
+    GdkFree(vertexData);
+}
+
+// ***********************************************************************
+BinaryReaderTestResult ParseTestDataFromStream(Stream* stream)
+{
+    BinaryReaderTestResult result;
+    memset(&result, 0, sizeof(result));
+
+    // Nodes
+    UInt16 numNodes = stream->ReadUInt16();
+    for(UInt16 nodeIndex = 0; nodeIndex < numNodes; nodeIndex++)
+    {
+        string name = stream->ReadString();
+        UInt16 parent = stream->ReadUInt16();
+        Matrix3D transform = Matrix3D::ReadFromStream(stream);
+
+        result.NameLengths += (UInt32) name.size();
+        result.ParentSum += parent;
+        result.MatrixSum += transform.M41;
+    }
+
+    // Joints
+    UInt16 numJoints = stream->ReadUInt16();
+    vector<Matrix3D> invBindMatrices;
+    for(UInt16 jointIndex = 0; jointIndex < numJoints; jointIndex++)
+        invBindMatrices.push_back(Matrix3D::ReadFromStream(stream));
+    for(size_t jointIndex = 0; jointIndex < invBindMatrices.size(); jointIndex++)
+        result.MatrixSum += invBindMatrices[jointIndex].M11;
+
+    // Vertex data
+    int vertexDataSize = stream->ReadInt32();
+    UInt8* vertexData = (UInt8*) GdkAlloc(vertexDataSize);
+    stream->Read(vertexData, vertexDataSize);
+    for(int i = 0; i < vertexDataSize; i++)
+        result.VertexDataSum += vertexData[i];
+    GdkFree(vertexData);
+
+    return result;
+}
+
+// ***********************************************************************
+BinaryReaderTestResult ParseTestDataFromReader(BinaryReader& reader)
+{
+    BinaryReaderTestResult result;
+    memset(&result, 0, sizeof(result));
+
+    // Nodes
+    UInt16 numNodes = reader.ReadUInt16();
+    for(UInt16 nodeIndex = 0; nodeIndex < numNodes; nodeIndex++)
+    {
+        string name = reader.ReadString();
+        UInt16 parent = reader.ReadUInt16();
+        Matrix3D transform;
+        reader.ReadArray(&transform, 1);
+
+        result.NameLengths += (UInt32) name.size();
+        result.ParentSum += parent;
+        result.MatrixSum += transform.M41;
+    }
+
+    // Joints
+    UInt16 numJoints = reader.ReadUInt16();
+    vector<Matrix3D> invBindMatrices;
+    reader.ReadArray(invBindMatrices, numJoints);
+    for(size_t jointIndex = 0; jointIndex < invBindMatrices.size(); jointIndex++)
+        result.MatrixSum += invBindMatrices[jointIndex].M11;
+
+    // Vertex data, in place if the base stream supports it
+    int vertexDataSize = reader.ReadInt32();
+    UInt8* vertexDataCopy = NULL;
+    const UInt8* vertexData = (const UInt8*) reader.ReadSpan(vertexDataSize);
+    if(vertexData == NULL)
+    {
+        vertexDataCopy = (UInt8*) GdkAlloc(vertexDataSize);
+        reader.Read(vertexDataCopy, vertexDataSize);
+        vertexData = vertexDataCopy;
+    }
+    for(int i = 0; i < vertexDataSize; i++)
+        result.VertexDataSum += vertexData[i];
+    GdkFree(vertexDataCopy);
+
+    return result;
+}
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::Test_IO_BinaryReader(TestExecutionContext *context)
+{
+    string workingFolder = Path::GetCommonPath(CommonPaths::WorkingFolder);
+    string testFilePath = Path::Combine(workingFolder.c_str(), "BinaryReaderTest.bin");
+
+    context->Log->WriteLine(LogLevel::Info, "Writing test data to: %s", testFilePath.c_str());
+
+    // Write the test data
+    FileStream* fileStream = File::Create(testFilePath.c_str());
+    WriteBinaryReaderTestData(fileStream);
+    fileStream->Close();
+    GdkDelete(fileStream);
+
+    double startTime, streamTime, bufferedTime, mappedTime;
+
+    // Parse the file with the Stream::ReadXXX() methods
+    startTime = HighResTimer::GetSeconds();
+    fileStream = File::Open(testFilePath.c_str(), FileMode::Read);
+    BinaryReaderTestResult streamResult = ParseTestDataFromStream(fileStream);
+    fileStream->Close();
+    GdkDelete(fileStream);
+    streamTime = HighResTimer::GetSeconds() - startTime;
+
+    // Parse the file with a BinaryReader, buffering a FileStream
+    startTime = HighResTimer::GetSeconds();
+    fileStream = File::Open(testFilePath.c_str(), FileMode::Read);
+    BinaryReaderTestResult bufferedResult;
+    {
+        BinaryReader reader(fileStream);
+        bufferedResult = ParseTestDataFromReader(reader);
+        UNIT_TEST_CHECK(reader.AtEnd(), "BinaryReader over FileStream read to the end of the file");
+    }
+    UNIT_TEST_CHECK(fileStream->AtEnd(), "FileStream position was synced by the BinaryReader");
+    fileStream->Close();
+    GdkDelete(fileStream);
+    bufferedTime = HighResTimer::GetSeconds() - startTime;
+
+    // Parse the file with a BinaryReader, reading in place from a MappedFileStream
+    startTime = HighResTimer::GetSeconds();
+    MappedFileStream* mappedStream = GdkNew MappedFileStream(testFilePath.c_str());
+    BinaryReaderTestResult mappedResult;
+    {
+        BinaryReader reader(mappedStream);
+        mappedResult = ParseTestDataFromReader(reader);
+        UNIT_TEST_CHECK(reader.AtEnd(), "BinaryReader over MappedFileStream read to the end of the file");
+    }
+    mappedStream->Close();
+    GdkDelete(mappedStream);
+    mappedTime = HighResTimer::GetSeconds() - startTime;
+
+    File::Delete(testFilePath.c_str());
+
+    // Verify the results
+    UNIT_TEST_CHECK(bufferedResult == streamResult, "Buffered BinaryReader results match Stream results");
+    UNIT_TEST_CHECK(mappedResult == streamResult, "Mapped BinaryReader results match Stream results");
+
+    // Log the timings
+    context->Log->WriteLine(LogLevel::Info, "Stream:                   %.2f ms", streamTime * 1000.0);
+    context->Log->WriteLine(LogLevel::Info, "BinaryReader (FileStream): %.2f ms", bufferedTime * 1000.0);
+    context->Log->WriteLine(LogLevel::Info, "BinaryReader (Mapped):     %.2f ms", mappedTime * 1000.0);
+
+    return TestStatus::Pass;
+}
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::Test_IO_Compression(TestExecutionContext *context)
+{
+    static const CompressionType::Enum compressionTypes[] = { CompressionType::ZLib, CompressionType::LZ4, CompressionType::Zstd };
+    static const char* compressionNames[] = { "ZLib", "LZ4", "Zstd" };
+
+    // Create the test data:  Long runs of repeated bytes, with a little noise at the start of every 64KB.
+    // (It compresses well, so the decoders have far more output to give than fits in a single call)
+    UInt8* data = (UInt8*) GdkAlloc(TEST_COMPRESSION_DATA_SIZE);
+    UInt32 seed = 12345;
+    for(int i = 0; i < TEST_COMPRESSION_DATA_SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        data[i] = (i & 0xF000) ? (UInt8)(i >> 13) : (UInt8)(seed >> 16);
+    }
+
+    for(int typeIndex = 0; typeIndex < 3; typeIndex++)
+    {
+        CompressionType::Enum compressionType = compressionTypes[typeIndex];
+        if(Stream::IsCompressionTypeSupported(compressionType) == false)
+        {
+            context->Log->WriteLine(LogLevel::Info, "%s is not supported by this build", compressionNames[typeIndex]);
+            continue;
+        }
+
+        // Compress the data
+        int maxCompressedSize = Stream::GetMaxCompressedSize(TEST_COMPRESSION_DATA_SIZE, compressionType);
+        MemoryStream compressed(maxCompressedSize);
+        int compressedSize = Stream::Compress(data, TEST_COMPRESSION_DATA_SIZE, compressed.GetBufferStartPtr(), maxCompressedSize, compressionType);
+        UNIT_TEST_CHECK(compressedSize > 0, "%s compressed %d bytes to %d bytes", compressionNames[typeIndex], TEST_COMPRESSION_DATA_SIZE, compressedSize);
+        compressed.SetLength(compressedSize);
+
+        // Decompress it as a stream
+        MemoryStream decompressed(TEST_COMPRESSION_DATA_SIZE);
+        bool succeeded = compressed.Decompress(&decompressed, compressionType, compressedSize);
+        UNIT_TEST_CHECK(succeeded, "%s stream decompression succeeded", compressionNames[typeIndex]);
+        UNIT_TEST_CHECK(decompressed.GetLength() == TEST_COMPRESSION_DATA_SIZE
+            && memcmp(decompressed.GetBufferStartPtr(), data, TEST_COMPRESSION_DATA_SIZE) == 0,
+            "%s stream decompression matches the original data", compressionNames[typeIndex]);
+
+        // Decompress it in one call
+        UInt8* buffer = (UInt8*) GdkAlloc(TEST_COMPRESSION_DATA_SIZE);
+        succeeded = Stream::Decompress(compressed.GetBufferStartPtr(), compressedSize, buffer, TEST_COMPRESSION_DATA_SIZE, compressionType)
+            && memcmp(buffer, data, TEST_COMPRESSION_DATA_SIZE) == 0;
+        GdkFree(buffer);
+        UNIT_TEST_CHECK(succeeded, "%s buffer decompression matches the original data", compressionNames[typeIndex]);
+
+        // A truncated frame must fail, rather than succeed with partial data  (ZLib stops quietly at the end of its input)
+        if(compressionType != CompressionType::ZLib)
+        {
+            compressed.SetPosition(0);
+            MemoryStream truncated(TEST_COMPRESSION_DATA_SIZE);
+            succeeded = compressed.Decompress(&truncated, compressionType, compressedSize / 2);
+            UNIT_TEST_CHECK(succeeded == false, "%s stream decompression of a truncated frame fails", compressionNames[typeIndex]);
+        }
+    }
+
+    GdkFree(data);
+    return TestStatus::Pass;
+}
+
+// ***********************************************************************
+void WriteTestPackAsset(const string& folder, const char* relativePath, int size, int pattern)
+{
+    string filePath = Path::Combine(folder.c_str(), relativePath);
+
+    // Text like repeats for the even patterns, noise for the odd ones
+    UInt8* data = (UInt8*) GdkAlloc(size > 0 ? size : 1);
+    UInt32 seed = (UInt32) pattern + 1;
+    for(int i = 0; i < size; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        data[i] = (pattern & 1) ? (UInt8)(seed >> 16) : (UInt8)("GDK asset pack test data "[i % 25] + pattern);
+    }
+
+    FileStream* file = File::Create(filePath.c_str());
+    file->Write(data, size);
+    file->Close();
+    GdkDelete(file);
+    GdkFree(data);
+}
+
+// ***********************************************************************
+void ReadTestPackAsset(Stream* stream, vector<UInt8>& data)
+{
+    data.resize((size_t) stream->GetLength());
+    if(data.size() > 0)
+        data.resize(stream->Read(&data[0], (int) data.size()));
+    stream->Close();
+    GdkDelete(stream);
+}
+
+// ***********************************************************************
+int WriteTestPack(const string& assetFolder, const char* packPath, bool largeOffsets)
+{
+    // Find the assets  (Added in path order, like GdkPack)
+    vector<string> files;
+    Directory::GetFiles(assetFolder.c_str(), files, true);
+    sort(files.begin(), files.end());
+
+    // Store each asset with the next codec in turn, so every codec this build supports is covered
+    PackWriter writer;
+    if(largeOffsets)
+        writer.SetAlignment(TEST_PACK_LARGE_ALIGNMENT);
+    for(size_t fileIndex = 0; fileIndex < files.size(); fileIndex++)
+    {
+        UInt16 compression = (UInt16)(fileIndex % 4);
+        if(PackWriter::IsCompressionSupported(compression) == false)
+            compression = GDKPACK_COMPRESSION_NONE;
+
+        string filePath = Path::Combine(assetFolder.c_str(), files[fileIndex].c_str());
+        writer.AddFile(files[fileIndex].c_str(), filePath.c_str(), compression);
+    }
+
+    if(writer.Write(packPath) == false)
+        return -1;
+    return (int) writer.GetAssetCount();
+}
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::Test_IO_AssetPack(TestExecutionContext *context)
+{
+    string workingFolder = Path::GetCommonPath(CommonPaths::WorkingFolder);
+    string assetFolder = Path::Combine(workingFolder.c_str(), "PackTestAssets");
+    string packPath = Path::Combine(workingFolder.c_str(), "PackTest.gdkpack");
+
+    // Create a folder of assets:  Compressible & incompressible, empty, nested, and larger than the decompression buffers
+    if(Directory::Exists(assetFolder.c_str()))
+        Directory::Delete(assetFolder.c_str(), true);
+    const char* folders[] = { "", "Images", "Models", "Models/Tank", "Sounds" };
+    for(int folderIndex = 0; folderIndex < 5; folderIndex++)
+        Directory::Create(Path::Combine(assetFolder.c_str(), folders[folderIndex]).c_str());
+
+    WriteTestPackAsset(assetFolder, "Readme.txt", 3000, 0);
+    WriteTestPackAsset(assetFolder, "Empty.bin", 0, 1);
+    WriteTestPackAsset(assetFolder, "Images/Noise.bin", 50000, 3);
+    WriteTestPackAsset(assetFolder, "Images/Large.txt", 300000, 2);
+    WriteTestPackAsset(assetFolder, "Models/Tank/Tank.txt", 70000, 4);
+    WriteTestPackAsset(assetFolder, "Models/Tank/Tank.bin", 20000, 5);
+    WriteTestPackAsset(assetFolder, "Sounds/Click.txt", 1000, 6);
+    WriteTestPackAsset(assetFolder, "Sounds/Music.txt", 200000, 8);
+
+    // Spread the assets out past 4GB, where the file system can hold the pack as a sparse file.  (So the 64-bit offsets are used)
+    bool largeOffsets = false;
+#ifdef GDKPLATFORM_LINUX
+    largeOffsets = sizeof(void*) == 8;
+#endif
+
+    int numAssets = WriteTestPack(assetFolder, packPath.c_str(), largeOffsets);
+    UNIT_TEST_CHECK(numAssets == 8, "Packed %d assets into: %s", numAssets, packPath.c_str());
+
+    vector<string> files;
+    Directory::GetFiles(assetFolder.c_str(), files, true);
+    FileAssetProvider looseAssets(assetFolder.c_str());
+
+    // Read every asset back from the pack, both mapped & with positioned reads, & compare it to the loose file
+    for(int mapped = 1; mapped >= 0; mapped--)
+    {
+        const char* mode = mapped ? "Mapped" : "Positioned reads";
+        PackAssetProvider pack(packPath.c_str(), mapped != 0);
+        UNIT_TEST_CHECK(pack.IsOpen() && pack.IsMapped() == (mapped != 0), "%s: Opened the pack", mode);
+        UNIT_TEST_CHECK((int) pack.GetAssetCount() == numAssets, "%s: Pack has %d assets", mode, numAssets);
+
+        for(size_t fileIndex = 0; fileIndex < files.size(); fileIndex++)
+        {
+            const char* assetPath = files[fileIndex].c_str();
+            Stream* packStream = pack.GetAssetStream(assetPath);
+            UNIT_TEST_CHECK(packStream != NULL, "%s: Found [%s]", mode, assetPath);
+
+            vector<UInt8> packData, looseData;
+            ReadTestPackAsset(packStream, packData);
+            ReadTestPackAsset(looseAssets.GetAssetStream(assetPath), looseData);
+            UNIT_TEST_CHECK(packData == looseData, "%s: [%s] matches the loose file (%d bytes)", mode, assetPath, (int) looseData.size());
+        }
+
+        UNIT_TEST_CHECK(pack.HasAsset("Missing.txt") == false && pack.GetAssetStream("Images") == NULL, "%s: Paths not in the pack are not found", mode);
+    }
+
+    File::Delete(packPath.c_str());
+    Directory::Delete(assetFolder.c_str(), true);
+
+    return TestStatus::Pass;
+}
+
+// ***********************************************************************
+int GetTestAssetSize(const char* assetPath)
+{
+    // The size tells which of the lookup test providers the asset came from
+    Stream* stream = AssetManager::GetAssetStream(assetPath);
+    if(stream == NULL)
+        return -1;
+
+    int size = (int) stream->GetLength();
+    stream->Close();
+    GdkDelete(stream);
+    return size;
+}
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::Test_IO_AssetLookup(TestExecutionContext *context)
+{
+    string workingFolder = Path::GetCommonPath(CommonPaths::WorkingFolder);
+    string firstFolder = Path::Combine(workingFolder.c_str(), "LookupTestFirst");
+    string secondFolder = Path::Combine(workingFolder.c_str(), "LookupTestSecond");
+    const char* folders[] = { firstFolder.c_str(), secondFolder.c_str() };
+    for(int folderIndex = 0; folderIndex < 2; folderIndex++)
+    {
+        if(Directory::Exists(folders[folderIndex]))
+            Directory::Delete(folders[folderIndex], true);
+        Directory::Create(folders[folderIndex]);
+    }
+
+    // The assets in the first provider are 100 bytes, & those in the second are 200 bytes
+    FileAssetProvider* first = GdkNew FileAssetProvider(firstFolder.c_str());
+    AssetManager::RegisterProvider(first, 101);
+    UNIT_TEST_CHECK(GetTestAssetSize("Lookup.bin") == -1 && GetTestAssetSize("Lookup.bin") == -1, "The missing asset wasnt found  (& the miss was cached)");
+
+    // Registering a provider must not leave the cached miss in place
+    WriteTestPackAsset(secondFolder, "Lookup.bin", 200, 1);
+    FileAssetProvider* second = GdkNew FileAssetProvider(secondFolder.c_str());
+    AssetManager::RegisterProvider(second, 100);
+    UNIT_TEST_CHECK(GetTestAssetSize("Lookup.bin") == 200, "Found the asset in the provider registered after the miss");
+
+    // A hit is cached until the lookup cache is cleared, even once a higher priority provider has the asset
+    WriteTestPackAsset(firstFolder, "Lookup.bin", 100, 2);
+    UNIT_TEST_CHECK(GetTestAssetSize("Lookup.bin") == 200, "The cached provider is used for the asset");
+    AssetManager::ClearLookupCache();
+    UNIT_TEST_CHECK(GetTestAssetSize("Lookup.bin") == 100, "Found the asset in the higher priority provider, after clearing the cache");
+
+    // An asset that goes missing from its cached provider is searched for again
+    File::Delete(Path::Combine(firstFolder.c_str(), "Lookup.bin").c_str());
+    UNIT_TEST_CHECK(GetTestAssetSize("Lookup.bin") == 200, "Found the asset again, once it was deleted from the cached provider");
+
+    // An indexed provider only sees the files that were there when the index was built
+    first->SetIndexed(true);
+    WriteTestPackAsset(firstFolder, "Indexed.bin", 100, 3);
+    UNIT_TEST_CHECK(first->HasAsset("Indexed.bin") == false && GetTestAssetSize("Indexed.bin") == -1, "A file added after the index was built isnt found");
+    first->RebuildIndex();
+    UNIT_TEST_CHECK(first->HasAsset("Indexed.bin") && GetTestAssetSize("Indexed.bin") == 100, "The file is found once the index is rebuilt");
+
+    // Turning the index off (or on) must not leave misses from the other mode in the lookup cache
+    WriteTestPackAsset(firstFolder, "Unindexed.bin", 100, 4);
+    UNIT_TEST_CHECK(GetTestAssetSize("Unindexed.bin") == -1, "Another file added after the index was built isnt found");
+    first->SetIndexed(false);
+    UNIT_TEST_CHECK(first->IsIndexed() == false && GetTestAssetSize("Unindexed.bin") == 100, "The file is found once the index is turned off");
+
+    WriteTestPackAsset(secondFolder, "Lookup2.bin", 200, 5);
+    second->SetIndexed(true);
+    UNIT_TEST_CHECK(GetTestAssetSize("Lookup2.bin") == 200 && GetTestAssetSize("Lookup.bin") == 200, "The files are found in a provider indexed after it was registered");
+
+    AssetManager::UnRegisterProvider(first, true);
+    AssetManager::UnRegisterProvider(second, true);
+    UNIT_TEST_CHECK(GetTestAssetSize("Lookup.bin") == -1, "The asset isnt found once its providers are unregistered");
+
+    Directory::Delete(firstFolder.c_str(), true);
+    Directory::Delete(secondFolder.c_str(), true);
+
+    return TestStatus::Pass;
+}
+
+// ***********************************************************************
+#define TEST_ASYNCIO_FILE_SIZE      (1024 * 1024)
+#define TEST_ASYNCIO_BLOCK_SIZE     (32 * 1024)
+#define TEST_ASYNCIO_NUM_BLOCKS     (TEST_ASYNCIO_FILE_SIZE / TEST_ASYNCIO_BLOCK_SIZE)
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::Test_IO_AsyncIO(TestExecutionContext *context)
+{
+    string workingFolder = Path::GetCommonPath(CommonPaths::WorkingFolder);
+    string assetFolder = Path::Combine(workingFolder.c_str(), "AsyncIOTestAssets");
+    string filePath = Path::Combine(assetFolder.c_str(), "Data.bin");
+    string writePath = Path::Combine(assetFolder.c_str(), "Written.bin");
+
+    if(Directory::Exists(assetFolder.c_str()))
+        Directory::Delete(assetFolder.c_str(), true);
+    Directory::Create(assetFolder.c_str());
+    WriteTestPackAsset(assetFolder, "Data.bin", TEST_ASYNCIO_FILE_SIZE, 7);
+
+    vector<UInt8> expected;
+    ReadTestPackAsset(GdkNew FileStream(filePath.c_str(), FileMode::Read), expected);
+
+    FileAssetProvider* provider = GdkNew FileAssetProvider(assetFolder.c_str());
+    AssetManager::RegisterProvider(provider, 100);
+
+    // Run the requests on the calling thread, & on the I/O threads  (Through the io_uring, where there is one)
+    int originalNumThreads = AsyncIO::GetNumThreads();
+    int threadCounts[] = { 0, 2 };
+    TestStatus::Enum status = TestStatus::Pass;
+    for(int threadIndex = 0; threadIndex < 2 && status == TestStatus::Pass; threadIndex++)
+    {
+        AsyncIO::SetNumThreads(threadCounts[threadIndex]);
+        context->Log->WriteLine(LogLevel::Info, "%d I/O threads  (io_uring: %s)", threadCounts[threadIndex], AsyncIO::IsUsingIORing() ? "yes" : "no");
+        status = CheckAsyncIO(context, filePath, writePath, expected);
+    }
+    AsyncIO::SetNumThreads(originalNumThreads);
+
+    AssetManager::UnRegisterProvider(provider, true);
+    Directory::Delete(assetFolder.c_str(), true);
+
+    return status;
+}
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::CheckAsyncIO(TestExecutionContext *context, const string& filePath, const string& writePath, const vector<UInt8>& expected)
+{
+    int numThreads = AsyncIO::GetNumThreads();
+    vector<UInt8> buffer(TEST_ASYNCIO_FILE_SIZE + TEST_ASYNCIO_BLOCK_SIZE);
+
+    // Read the file in blocks, in reverse order, with every read in flight at once.  The last read runs past the end of the file
+    FileStream file(filePath.c_str(), FileMode::Read);
+    vector<AsyncIORequest*> requests;
+    for(int block = TEST_ASYNCIO_NUM_BLOCKS - 1; block >= 0; block--)
+    {
+        Int64 offset = block * TEST_ASYNCIO_BLOCK_SIZE;
+        requests.push_back(file.ReadAsync(&buffer[(size_t) offset], offset, TEST_ASYNCIO_BLOCK_SIZE));
+    }
+    AsyncIORequest* pastEnd = AsyncIO::QueueRead(&file, &buffer[TEST_ASYNCIO_FILE_SIZE - 100], TEST_ASYNCIO_FILE_SIZE - 100, 1000);
+
+    bool allComplete = true;
+    for(size_t index = 0; index < requests.size(); index++)
+    {
+        requests[index]->Wait();
+        allComplete = allComplete && requests[index]->GetStatus() == AsyncIOStatus::Complete && requests[index]->GetBytesRead() == TEST_ASYNCIO_BLOCK_SIZE;
+        GdkDelete(requests[index]);
+    }
+    requests.clear();
+    pastEnd->Wait();
+    UNIT_TEST_CHECK(allComplete && memcmp(&buffer[0], &expected[0], TEST_ASYNCIO_FILE_SIZE - 100) == 0,
+        "%d threads: ReadAsync read every block of the file", numThreads);
+    UNIT_TEST_CHECK(pastEnd->GetStatus() == AsyncIOStatus::Failed && pastEnd->GetBytesRead() == 100,
+        "%d threads: A read past the end of the file failed, with the bytes that were there  (%d bytes)", numThreads, (int) pastEnd->GetBytesRead());
+    GdkDelete(pastEnd);
+
+    // A memory backed stream is read right away
+    MemoryStream memory((void*) &expected[0], TEST_ASYNCIO_FILE_SIZE);
+    UInt8 memoryBytes[64];
+    AsyncIORequest* memoryRead = memory.ReadAsync(memoryBytes, 5000, 64);
+    UNIT_TEST_CHECK(memoryRead->IsComplete() && memoryRead->GetBytesRead() == 64 && memcmp(memoryBytes, &expected[5000], 64) == 0,
+        "%d threads: ReadAsync of a MemoryStream completed right away", numThreads);
+    GdkDelete(memoryRead);
+
+    // Write the blocks in reverse order, then read the file back
+    {
+        FileStream output(writePath.c_str(), FileMode::Write);
+        for(int block = TEST_ASYNCIO_NUM_BLOCKS - 1; block >= 0; block--)
+        {
+            Int64 offset = block * TEST_ASYNCIO_BLOCK_SIZE;
+            requests.push_back(AsyncIO::QueueWrite(&output, (void*) &expected[(size_t) offset], offset, TEST_ASYNCIO_BLOCK_SIZE));
+        }
+        for(size_t index = 0; index < requests.size(); index++)
+        {
+            requests[index]->Wait();
+            allComplete = allComplete && requests[index]->GetStatus() == AsyncIOStatus::Complete;
+            GdkDelete(requests[index]);
+        }
+        requests.clear();
+        output.Close();
+    }
+    vector<UInt8> written;
+    ReadTestPackAsset(GdkNew FileStream(writePath.c_str(), FileMode::Read), written);
+    UNIT_TEST_CHECK(allComplete && written == expected, "%d threads: QueueWrite wrote every block of the file", numThreads);
+
+    // Open asset streams
+    AsyncIORequest* assetRequest = AssetManager::GetAssetStreamAsync("Data.bin");
+    AsyncIORequest* missingRequest = AssetManager::GetAssetStreamAsync("Missing.bin");
+    assetRequest->Wait();
+    missingRequest->Wait();
+    UNIT_TEST_CHECK(assetRequest->GetStatus() == AsyncIOStatus::Complete && assetRequest->GetStream() != NULL
+        && assetRequest->GetBytesRead() == TEST_ASYNCIO_FILE_SIZE && assetRequest->GetAssetPath() == "Data.bin",
+        "%d threads: GetAssetStreamAsync opened the asset", numThreads);
+    vector<UInt8> assetData;
+    ReadTestPackAsset(assetRequest->GetStream(), assetData);
+    UNIT_TEST_CHECK(assetData == expected, "%d threads: The asset stream has the asset's data", numThreads);
+    UNIT_TEST_CHECK(missingRequest->GetStatus() == AsyncIOStatus::Failed && missingRequest->GetStream() == NULL,
+        "%d threads: GetAssetStreamAsync of a missing asset failed", numThreads);
+    GdkDelete(assetRequest);
+    GdkDelete(missingRequest);
+
+    // Queue many reads & restart the I/O threads right away.  The shutdown must drain every request first
+    memset(&buffer[0], 0, buffer.size());
+    for(int repeat = 0; repeat < 4; repeat++)
+        for(int block = 0; block < TEST_ASYNCIO_NUM_BLOCKS; block++)
+        {
+            Int64 offset = block * TEST_ASYNCIO_BLOCK_SIZE;
+            requests.push_back(file.ReadAsync(&buffer[(size_t) offset], offset, TEST_ASYNCIO_BLOCK_SIZE, (short) block));
+        }
+    AsyncIO::SetNumThreads(numThreads);
+
+    bool drained = true;
+    for(size_t index = 0; index < requests.size(); index++)
+    {
+        drained = drained && requests[index]->GetStatus() == AsyncIOStatus::Complete;
+        GdkDelete(requests[index]);
+    }
+    requests.clear();
+    UNIT_TEST_CHECK(drained && memcmp(&buffer[0], &expected[0], TEST_ASYNCIO_FILE_SIZE) == 0,
+        "%d threads: Every queued read was complete once the I/O threads were shut down", numThreads);
+
+    file.Close();
+    return TestStatus::Pass;
+}
+
+// ***********************************************************************
+void ReadTestFile(const string& filePath, vector<UInt8>& data)
+{
+    ReadTestPackAsset(GdkNew FileStream(filePath.c_str(), FileMode::Read), data);
+}
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::Test_IO_WriteBehind(TestExecutionContext *context)
+{
+    string workingFolder = Path::GetCommonPath(CommonPaths::WorkingFolder);
+    string filePath = Path::Combine(workingFolder.c_str(), "WriteBehindTest.bin");
+    string copyPath = Path::Combine(workingFolder.c_str(), "WriteBehindCopy.bin");
+    string movePath = Path::Combine(workingFolder.c_str(), "WriteBehindMoved.bin");
+
+    // Write-behind buffers go to the I/O threads  (or the io_uring), or are written on the calling thread
+    int originalNumThreads = AsyncIO::GetNumThreads();
+    int threadCounts[] = { 2, 0 };
+    for(int threadIndex = 0; threadIndex < 2; threadIndex++)
+    {
+        int numThreads = threadCounts[threadIndex];
+        AsyncIO::SetNumThreads(numThreads);
+
+        // Write many small records, spanning several write-behind buffers  (256 KB each)
+        vector<UInt8> expected;
+        FileStream* file = GdkNew FileStream(filePath.c_str(), FileMode::WriteBehind);
+        for(UInt32 record = 0; record < 100000; record++)
+        {
+            UInt8 bytes[7];
+            for(int i = 0; i < 7; i++)
+                bytes[i] = (UInt8)(record * 31 + i);
+            file->Write(bytes, 1 + record % 7);
+            expected.insert(expected.end(), bytes, bytes + 1 + record % 7);
+        }
+        Int64 length = (Int64) expected.size();
+        UNIT_TEST_CHECK(file->GetLength() == length && file->GetPosition() == length,
+            "%d threads: The length & position include the buffered bytes  (%d bytes)", numThreads, (int) length);
+
+        // Seek back into a buffer that has already been written, & overwrite part of it
+        UInt8 patch[300];
+        for(int i = 0; i < 300; i++)
+            patch[i] = (UInt8)(0xA0 ^ i);
+        file->SetPosition(1000);
+        file->Write(patch, 300);
+        memcpy(&expected[1000], patch, 300);
+        UNIT_TEST_CHECK(file->GetPosition() == 1300 && file->GetLength() == length, "%d threads: Seeked back & overwrote 300 bytes", numThreads);
+
+        // Append at the end
+        file->Seek(0, SeekOrigin::End);
+        file->Write(patch, 300);
+        expected.insert(expected.end(), patch, patch + 300);
+
+        file->Close();
+        GdkDelete(file);
+
+        vector<UInt8> written;
+        ReadTestFile(filePath, written);
+        UNIT_TEST_CHECK(written == expected, "%d threads: The file matches every write  (%d bytes)", numThreads, (int) written.size());
+    }
+    AsyncIO::SetNumThreads(originalNumThreads);
+
+    // WriteAt writes at an offset, without moving the position
+    {
+        vector<UInt8> expected(5000);
+        for(size_t i = 0; i < expected.size(); i++)
+            expected[i] = (UInt8)(i * 7);
+
+        FileStream file(filePath.c_str(), FileMode::Write);
+        file.Write(&expected[0], 4000);
+        file.Flush();
+        UInt8 patch[100];
+        memset(patch, 0x5A, 100);
+        int bytesWritten = file.WriteAt(patch, 2000, 100);
+        memcpy(&expected[2000], patch, 100);
+        UNIT_TEST_CHECK(bytesWritten == 100 && file.GetPosition() == 4000, "WriteAt wrote 100 bytes without moving the position");
+        file.Write(&expected[4000], 1000);
+        file.Close();
+
+        vector<UInt8> written;
+        ReadTestFile(filePath, written);
+        UNIT_TEST_CHECK(written == expected, "The file matches the writes & the WriteAt");
+    }
+
+    // Copy & move over existing (larger) files
+    vector<UInt8> source;
+    ReadTestFile(filePath, source);
+    WriteTestPackAsset(workingFolder, "WriteBehindCopy.bin", 20000, 3);
+    WriteTestPackAsset(workingFolder, "WriteBehindMoved.bin", 20000, 5);
+
+    File::Copy(filePath.c_str(), copyPath.c_str());
+    vector<UInt8> copied;
+    ReadTestFile(copyPath, copied);
+    UNIT_TEST_CHECK(copied == source, "File::Copy replaced the existing file  (%d bytes)", (int) copied.size());
+
+    File::Move(copyPath.c_str(), movePath.c_str());
+    vector<UInt8> moved;
+    ReadTestFile(movePath, moved);
+    UNIT_TEST_CHECK(moved == source && File::Exists(copyPath.c_str()) == false, "File::Move replaced the existing file  (%d bytes)", (int) moved.size());
+
+    File::Delete(filePath.c_str());
+    File::Delete(movePath.c_str());
+
+    return TestStatus::Pass;
+}
+
+// ***********************************************************************
+bool IsTestImageData(const UInt8* pixels, int width, int height)
+{
+    for(int y = 0; y < height; y++)
+        for(int x = 0; x < width; x++)
+            for(int channel = 0; channel < 4; channel++)
+                if(pixels[(y * width + x) * 4 + channel] != GetTestImageByte(x, y, channel))
+                    return false;
+    return true;
+}
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::Test_IO_ChunkedImage(TestExecutionContext *context)
+{
+    string workingFolder = Path::GetCommonPath(CommonPaths::WorkingFolder);
+    string assetFolder = Path::Combine(workingFolder.c_str(), "ChunkedImageTestAssets");
+    string imagePath = Path::Combine(assetFolder.c_str(), "ChunkedImage.gdkimage");
+
+    // An image with 13 chunks, the last of which is a partial band of rows
+    const int width = 61;
+    const int height = 203;
+    if(Directory::Exists(assetFolder.c_str()) == false)
+        Directory::Create(assetFolder.c_str());
+    WriteTestImage(imagePath.c_str(), width, height, CompressionType::ZLib, 16);
+
+    FileAssetProvider* provider = GdkNew FileAssetProvider(assetFolder.c_str());
+    AssetManager::RegisterProvider(provider, 100);
+
+    // The decoded image data is checked through the DecodedAssetCache, where the loader stores it
+    Int64 originalCacheSize = DecodedAssetCache::GetMaxSize();
+    DecodedAssetCache::SetMaxSize(64 * 1024 * 1024);
+    Stream* imageStream = File::Open(imagePath.c_str(), FileMode::Read);
+    UInt64 cacheKey = DecodedAssetCache::GetKey(imageStream, "Texture2D", TEXTURE2D_DECODER_VERSION);
+    imageStream->Close();
+    GdkDelete(imageStream);
+
+    // Decode the chunks in place from a mapped stream, & from a copy of a file stream,
+    // on the loading thread alone & alongside the background threads
+    int originalThreadCount = ResourceManager::GetBackgroundThreadCount();
+    int threadCounts[] = { 0, 1, 3 };
+    TestStatus::Enum status = TestStatus::Pass;
+    for(int mapped = 1; mapped >= 0 && status == TestStatus::Pass; mapped--)
+    {
+        provider->SetMappedFileThreshold(mapped);
+        for(int threadIndex = 0; threadIndex < 3 && status == TestStatus::Pass; threadIndex++)
+        {
+            int numThreads = threadCounts[threadIndex];
+            ResourceManager::SetBackgroundThreadCount(numThreads);
+            DecodedAssetCache::Clear();
+            status = CheckChunkedImageLoad(context, cacheKey, width, height, mapped != 0, numThreads);
+        }
+    }
+    ResourceManager::SetBackgroundThreadCount(originalThreadCount);
+
+    DecodedAssetCache::Clear();
+    DecodedAssetCache::SetMaxSize(originalCacheSize);
+    AssetManager::UnRegisterProvider(provider, true);
+    Directory::Delete(assetFolder.c_str(), true);
+
+    return status;
+}
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::CheckChunkedImageLoad(TestExecutionContext *context, UInt64 cacheKey, int width, int height, bool mapped, int numThreads)
+{
+    const char* streamType = mapped ? "Mapped" : "File";
+
+    Texture2D* texture = Texture2DManager::FromAsset("ChunkedImage");
+    UNIT_TEST_CHECK(texture->State == ResourceState::Ready && texture->Width == width && texture->Height == height,
+        "%s stream, %d threads: Loaded the chunked image  (%d x %d)", streamType, numThreads, texture->Width, texture->Height);
+    texture->Release();
+
+    Stream* cached = DecodedAssetCache::Open(cacheKey);
+    UNIT_TEST_CHECK(cached != NULL, "%s stream, %d threads: The decoded image was stored in the cache", streamType, numThreads);
+
+    Int64 numBytes = cached->GetLength() - cached->GetPosition();
+    const UInt8* pixels = (const UInt8*) cached->GetSpan(cached->GetPosition(), numBytes);
+    bool matches = pixels != NULL && numBytes == (Int64) width * height * 4 && IsTestImageData(pixels, width, height);
+    cached->Close();
+    GdkDelete(cached);
+    UNIT_TEST_CHECK(matches, "%s stream, %d threads: Every chunk decoded into its own rows", streamType, numThreads);
+
+    return TestStatus::Pass;
+}
+
+// ***********************************************************************
+// Bytes written before & after the vectored test data, so the vectored calls start & end mid-buffer
+#define TEST_VECTORED_EDGE_SIZE     10
+
+// ***********************************************************************
+void SplitTestBuffers(UInt8* data, int totalSize, int numBuffers, vector<StreamBuffer>& buffers)
+{
+    // Uneven sizes, with an empty buffer, so the buffer boundaries fall at odd offsets
+    buffers.resize(numBuffers);
+    int offset = 0;
+    for(int bufferIndex = 0; bufferIndex < numBuffers; bufferIndex++)
+    {
+        int remaining = totalSize - offset;
+        int size = remaining;
+        if(bufferIndex == 1)
+            size = 0;
+        else if(bufferIndex < numBuffers - 1)
+            size = remaining / (numBuffers - bufferIndex) + (bufferIndex % 3) - 1;
+        if(size < 0)
+            size = 0;
+        if(size > remaining)
+            size = remaining;
+
+        buffers[bufferIndex].Data = data + offset;
+        buffers[bufferIndex].Size = size;
+        offset += size;
+    }
+}
+
+// ***********************************************************************
+int WriteVectoredTestData(Stream* stream, vector<UInt8>& expected, int numBuffers)
+{
+    // Write the edges with plain writes, & the rest with a single WriteV()
+    int payloadSize = (int) expected.size() - 2 * TEST_VECTORED_EDGE_SIZE;
+    vector<StreamBuffer> buffers;
+    SplitTestBuffers(&expected[TEST_VECTORED_EDGE_SIZE], payloadSize, numBuffers, buffers);
+
+    stream->Write(&expected[0], TEST_VECTORED_EDGE_SIZE);
+    int bytesWritten = stream->WriteV(&buffers[0], numBuffers);
+    stream->Write(&expected[TEST_VECTORED_EDGE_SIZE + payloadSize], TEST_VECTORED_EDGE_SIZE);
+    return bytesWritten;
+}
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::Test_IO_VectoredIO(TestExecutionContext *context)
+{
+    string workingFolder = Path::GetCommonPath(CommonPaths::WorkingFolder);
+    string filePath = Path::Combine(workingFolder.c_str(), "VectoredTest.bin");
+
+    // Just under the size where FileStream switches to readv() / writev()  (64 KB), right at it, & well past it.
+    // Then with more buffers than a single readv() / writev() takes  (64)
+    int payloadSizes[] = { 64 * 1024 - 1, 64 * 1024, 300000 };
+    int bufferCounts[] = { 5, 100 };
+    for(int sizeIndex = 0; sizeIndex < 3; sizeIndex++)
+    {
+        for(int countIndex = 0; countIndex < 2; countIndex++)
+        {
+            int payloadSize = payloadSizes[sizeIndex];
+            int numBuffers = bufferCounts[countIndex];
+            vector<UInt8> expected(payloadSize + 2 * TEST_VECTORED_EDGE_SIZE);
+            for(size_t i = 0; i < expected.size(); i++)
+                expected[i] = (UInt8)(i * 29 + i / 251 + sizeIndex);
+
+            // MemoryStream  (Grown from a small buffer, by the WriteV)
+            MemoryStream memoryStream(16);
+            int bytesWritten = WriteVectoredTestData(&memoryStream, expected, numBuffers);
+            UNIT_TEST_CHECK(bytesWritten == payloadSize && memoryStream.GetLength() == (Int64) expected.size()
+                && memcmp(memoryStream.GetBufferStartPtr(), &expected[0], expected.size()) == 0,
+                "MemoryStream: WriteV of %d bytes in %d buffers", payloadSize, numBuffers);
+
+            memoryStream.SetPosition(0);
+            TestStatus::Enum status = CheckVectoredRead(context, "MemoryStream", &memoryStream, expected, numBuffers);
+            if(status != TestStatus::Pass)
+                return status;
+
+            // FileStream
+            FileStream* file = GdkNew FileStream(filePath.c_str(), FileMode::Write);
+            bytesWritten = WriteVectoredTestData(file, expected, numBuffers);
+            file->Close();
+            GdkDelete(file);
+
+            vector<UInt8> written;
+            ReadTestFile(filePath, written);
+            UNIT_TEST_CHECK(bytesWritten == payloadSize && written == expected, "FileStream: WriteV of %d bytes in %d buffers", payloadSize, numBuffers);
+
+            file = GdkNew FileStream(filePath.c_str(), FileMode::Read);
+            status = CheckVectoredRead(context, "FileStream", file, expected, numBuffers);
+            file->Close();
+            GdkDelete(file);
+            if(status != TestStatus::Pass)
+                return status;
+        }
+    }
+
+    // ReadMatrices, on both sides of 64 KB  (A Matrix3D is 64 bytes), after a few bytes so the matrices are unaligned
+    int matrixCounts[] = { 1023, 1024, 4000 };
+    for(int countIndex = 0; countIndex < 3; countIndex++)
+    {
+        int numMatrices = matrixCounts[countIndex];
+        vector<Matrix3D> matrices(numMatrices);
+        for(int matrixIndex = 0; matrixIndex < numMatrices; matrixIndex++)
+            matrices[matrixIndex] = Matrix3D::CreateTranslation((float) matrixIndex, (float) countIndex, -1.0f) * Matrix3D::CreateScale((float) matrixIndex + 0.5f);
+
+        MemoryStream memoryStream(16);
+        FileStream* file = GdkNew FileStream(filePath.c_str(), FileMode::Write);
+        Stream* streams[] = { &memoryStream, file };
+        for(int streamIndex = 0; streamIndex < 2; streamIndex++)
+        {
+            streams[streamIndex]->WriteUInt8(1);
+            streams[streamIndex]->WriteUInt16(2);
+            streams[streamIndex]->WriteMatrices(&matrices[0], numMatrices);
+        }
+        file->Close();
+        GdkDelete(file);
+
+        memoryStream.SetPosition(0);
+        file = GdkNew FileStream(filePath.c_str(), FileMode::Read);
+        streams[1] = file;
+        bool matches[2];
+        for(int streamIndex = 0; streamIndex < 2; streamIndex++)
+        {
+            // Ask for more matrices than there are, so the read is cut short at the end of the stream
+            vector<Matrix3D> readMatrices(numMatrices + 5);
+            bool prefixRead = streams[streamIndex]->ReadUInt8() == 1 && streams[streamIndex]->ReadUInt16() == 2;
+            int numRead = streams[streamIndex]->ReadMatrices(&readMatrices[0], numMatrices + 5);
+            matches[streamIndex] = prefixRead && numRead == numMatrices && std::equal(matrices.begin(), matrices.end(), readMatrices.begin());
+        }
+        file->Close();
+        GdkDelete(file);
+
+        int numBytes = numMatrices * (int) sizeof(Matrix3D);
+        UNIT_TEST_CHECK(matches[0], "MemoryStream: ReadMatrices read the %d matrices  (%d bytes)", numMatrices, numBytes);
+        UNIT_TEST_CHECK(matches[1], "FileStream: ReadMatrices read the %d matrices  (%d bytes)", numMatrices, numBytes);
+    }
+
+    File::Delete(filePath.c_str());
+
+    return TestStatus::Pass;
+}
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::CheckVectoredRead(TestExecutionContext *context, const char* streamName, Stream* stream, const vector<UInt8>& expected, int numBuffers)
+{
+    int payloadSize = (int) expected.size() - 2 * TEST_VECTORED_EDGE_SIZE;
+    vector<UInt8> data(expected.size(), 0);
+    vector<StreamBuffer> buffers;
+    SplitTestBuffers(&data[TEST_VECTORED_EDGE_SIZE], payloadSize, numBuffers, buffers);
+
+    // Read the edges with plain reads, & the rest with a single ReadV()
+    int edgeRead = stream->Read(&data[0], TEST_VECTORED_EDGE_SIZE);
+    int bytesRead = stream->ReadV(&buffers[0], numBuffers);
+    edgeRead += stream->Read(&data[TEST_VECTORED_EDGE_SIZE + payloadSize], TEST_VECTORED_EDGE_SIZE);
+    UNIT_TEST_CHECK(edgeRead == 2 * TEST_VECTORED_EDGE_SIZE && bytesRead == payloadSize && data == expected && stream->GetPosition() == (Int64) expected.size(),
+        "%s: ReadV of %d bytes in %d buffers", streamName, payloadSize, numBuffers);
+
+    // A read past the end of the stream fills the buffers up to the end
+    std::fill(data.begin(), data.end(), 0);
+    stream->SetPosition((Int64) expected.size() - 100);
+    bytesRead = stream->ReadV(&buffers[0], numBuffers);
+    UNIT_TEST_CHECK(bytesRead == 100 && memcmp(&data[TEST_VECTORED_EDGE_SIZE], &expected[expected.size() - 100], 100) == 0,
+        "%s: ReadV past the end read the last 100 bytes", streamName);
+
+    return TestStatus::Pass;
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+
+// Includes
+#include "BasePCH.h"
+#include "UnitTestsModule.h"
+
+
+// Number of frames in the input recording test  (After the frame that starts the recording)
+#define TEST_INPUT_NUM_FRAMES       4
+
+// ***********************************************************************
+// The input events raised during the recording test, as text, one list per frame
+static vector<string> testInputEvents[TEST_INPUT_NUM_FRAMES + 1];
+static int testInputFrame = 0;
+static int testPlaybackFinishedCount = 0;
+
+// ***********************************************************************
+void LogTestInputEvent(const char* format, ...)
+{
+    char text[128];
+    va_list args;
+    va_start(args, format);
+    GDK_VSNPRINTF(text, sizeof(text), format, args);
+    va_end(args);
+
+    testInputEvents[testInputFrame].push_back(text);
+}
+
+// ***********************************************************************
+void OnTestKeyDown(Keys::Enum key)                          { LogTestInputEvent("KeyDown %d", (int) key); }
+void OnTestKeyUp(Keys::Enum key)                            { LogTestInputEvent("KeyUp %d", (int) key); }
+void OnTestCharTyped(char c)                                { LogTestInputEvent("Char %c", c); }
+void OnTestMouseMove(MouseMoveArgs* args)                   { LogTestInputEvent("MouseMove %d,%d", args->NewX, args->NewY); }
+void OnTestMouseButtonDown(MouseButton::Enum button)        { LogTestInputEvent("MouseButtonDown %d", (int) button); }
+void OnTestMouseButtonUp(MouseButton::Enum button)          { LogTestInputEvent("MouseButtonUp %d", (int) button); }
+void OnTestMouseWheelScroll(float deltaX, float deltaY)     { LogTestInputEvent("MouseWheelScroll %.2f,%.2f", deltaX, deltaY); }
+void OnTestPlaybackFinished()                               { testPlaybackFinishedCount++; }
+
+// ***********************************************************************
+void SendTestInput(int frame)
+{
+    // Synthetic platform input, as the platform would pass it in before the frame
+    switch(frame)
+    {
+        case 1:
+            Keyboard::Platform_ProcessKeyDown(Keys::A);
+            Keyboard::Platform_ProcessChar('a');
+            Mouse::Platform_ProcessMouseMove(10, 20);
+            break;
+        case 2:
+            Mouse::Platform_ProcessMouseButtonDown(MouseButton::Left);
+            Mouse::Platform_ProcessMouseMove(15, 25);
+            Mouse::Platform_ProcessMouseWheelScroll(0.0f, 1.5f);
+            break;
+        case 3:
+            // Nothing this frame
+            break;
+        case 4:
+            Mouse::Platform_ProcessMouseButtonUp(MouseButton::Left);
+            Keyboard::Platform_ProcessKeyUp(Keys::A);
+            break;
+    }
+}
+
+// ***********************************************************************
+void SetTestInputHandlers(bool add)
+{
+    if(add)
+    {
+        Keyboard::KeyDown.AddHandlerFunction(&OnTestKeyDown);
+        Keyboard::KeyUp.AddHandlerFunction(&OnTestKeyUp);
+        Keyboard::CharTyped.AddHandlerFunction(&OnTestCharTyped);
+        Mouse::MouseMove.AddHandlerFunction(&OnTestMouseMove);
+        Mouse::MouseButtonDown.AddHandlerFunction(&OnTestMouseButtonDown);
+        Mouse::MouseButtonUp.AddHandlerFunction(&OnTestMouseButtonUp);
+        Mouse::MouseWheelScroll.AddHandlerFunction(&OnTestMouseWheelScroll);
+        InputRecording::PlaybackFinished.AddHandlerFunction(&OnTestPlaybackFinished);
+    }
+    else
+    {
+        Keyboard::KeyDown.RemoveHandlerFunction(&OnTestKeyDown);
+        Keyboard::KeyUp.RemoveHandlerFunction(&OnTestKeyUp);
+        Keyboard::CharTyped.RemoveHandlerFunction(&OnTestCharTyped);
+        Mouse::MouseMove.RemoveHandlerFunction(&OnTestMouseMove);
+        Mouse::MouseButtonDown.RemoveHandlerFunction(&OnTestMouseButtonDown);
+        Mouse::MouseButtonUp.RemoveHandlerFunction(&OnTestMouseButtonUp);
+        Mouse::MouseWheelScroll.RemoveHandlerFunction(&OnTestMouseWheelScroll);
+        InputRecording::PlaybackFinished.RemoveHandlerFunction(&OnTestPlaybackFinished);
+    }
+}
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::Test_Input_Recording(TestExecutionContext *context)
+{
+    string workingFolder = Path::GetCommonPath(CommonPaths::WorkingFolder);
+    string recordingPath = Path::Combine(workingFolder.c_str(), "InputRecordingTest.gdkinput");
+
+    bool originalUseFixedTimeStep = Application::IsUsingFixedTimeStep;
+    float originalFixedTimeStep = Application::FixedTimeStep;
+    Application::IsUsingFixedTimeStep = true;
+    Application::FixedTimeStep = 1.0f / 60.0f;
+    SetTestInputHandlers(true);
+
+    TestStatus::Enum status = CheckInputRecording(context, recordingPath);
+
+    // Make sure the live input isnt left ignored, if the test stopped partway through
+    InputRecording::StopRecording();
+    InputRecording::StopPlayback();
+    SetTestInputHandlers(false);
+
+    Application::IsUsingFixedTimeStep = originalUseFixedTimeStep;
+    Application::FixedTimeStep = originalFixedTimeStep;
+    File::Delete(recordingPath.c_str());
+
+    return status;
+}
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::CheckInputRecording(TestExecutionContext *context, const string& recordingPath)
+{
+    // Record a few frames of input, with an uneven frame time for each
+    float recordedElapsed[TEST_INPUT_NUM_FRAMES + 1];
+    vector<string> liveEvents[TEST_INPUT_NUM_FRAMES + 1];
+    UNIT_TEST_CHECK(InputRecording::StartRecording(recordingPath.c_str()) && InputRecording::IsRecording(), "Started recording the input");
+
+    for(int frame = 0; frame <= TEST_INPUT_NUM_FRAMES; frame++)
+    {
+        testInputFrame = frame;
+        testInputEvents[frame].clear();
+        SendTestInput(frame);
+
+        float elapsedSeconds = 0.01f + frame * 0.0037f;
+        float secondsSinceLastUpdate = frame == 0 ? 0.004f : 0.0f;
+        recordedElapsed[frame] = elapsedSeconds;
+        InputRecording::Platform_BeginFrame(elapsedSeconds, secondsSinceLastUpdate);
+        liveEvents[frame] = testInputEvents[frame];
+    }
+    InputRecording::StopRecording();
+    UNIT_TEST_CHECK(InputRecording::IsRecording() == false && liveEvents[1].size() == 3 && liveEvents[2].size() == 3 && liveEvents[4].size() == 2,
+        "Recorded %d frames of input", TEST_INPUT_NUM_FRAMES + 1);
+
+    // Play it back.  The fixed time step settings of the recording are restored
+    Application::IsUsingFixedTimeStep = false;
+    Application::FixedTimeStep = 0.1f;
+    UNIT_TEST_CHECK(InputRecording::StartPlayback(recordingPath.c_str()) && InputRecording::IsPlaying()
+        && InputRecording::GetPlaybackFrameCount() == TEST_INPUT_NUM_FRAMES + 1, "Started the playback  (%d frames)", InputRecording::GetPlaybackFrameCount());
+    UNIT_TEST_CHECK(Application::IsUsingFixedTimeStep && Application::FixedTimeStep == 1.0f / 60.0f, "The playback restored the fixed time step");
+
+    testPlaybackFinishedCount = 0;
+    for(int frame = 0; frame <= TEST_INPUT_NUM_FRAMES; frame++)
+    {
+        testInputFrame = frame;
+        testInputEvents[frame].clear();
+
+        // Live input is ignored during the playback
+        Keyboard::Platform_ProcessKeyDown(Keys::B);
+        Mouse::Platform_ProcessMouseMove(500, 500);
+
+        float elapsedSeconds = 1.0f;
+        float secondsSinceLastUpdate = 0.5f;
+        InputRecording::Platform_BeginFrame(elapsedSeconds, secondsSinceLastUpdate);
+
+        // The first frame also dispatches the input state from the start of the recording
+        vector<string>& played = testInputEvents[frame];
+        if(frame == 0)
+            played.erase(played.begin(), played.end() - liveEvents[0].size());
+
+        UNIT_TEST_CHECK(played == liveEvents[frame] && InputRecording::GetPlaybackFrame() == frame + 1,
+            "Frame %d: Played the %d recorded events", frame, (int) liveEvents[frame].size());
+        UNIT_TEST_CHECK(elapsedSeconds == recordedElapsed[frame] && secondsSinceLastUpdate == (frame == 0 ? 0.004f : 0.5f),
+            "Frame %d: Played the recorded elapsed time  (%.4f seconds)", frame, elapsedSeconds);
+    }
+
+    // The next frame finishes the playback, & runs on the real elapsed time
+    float elapsedSeconds = 1.0f;
+    float secondsSinceLastUpdate = 0.0f;
+    InputRecording::Platform_BeginFrame(elapsedSeconds, secondsSinceLastUpdate);
+    UNIT_TEST_CHECK(InputRecording::IsPlaying() == false && testPlaybackFinishedCount == 1 && elapsedSeconds == 1.0f,
+        "The playback finished after the last recorded frame");
+    UNIT_TEST_CHECK(Keyboard::IsKeyDown(Keys::A) == false && Keyboard::IsKeyDown(Keys::B) == false && Mouse::GetX() == 15 && Mouse::GetY() == 25,
+        "The live input was ignored during the playback");
+
+    return TestStatus::Pass;
+}
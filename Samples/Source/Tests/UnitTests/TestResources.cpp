@@ -0,0 +1,589 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+
+// Includes
+#include "BasePCH.h"
+#include "UnitTestsModule.h"
+
+
+// ***********************************************************************
+UInt8 GetTestImageByte(int x, int y, int channel)
+{
+    // A pattern that differs in every row, so a chunk decoded into the wrong band is caught
+    return (UInt8)(x * 7 + y * 13 + channel * 61);
+}
+
+// ***********************************************************************
+void WriteTestImage(const char* filePath, int width, int height, CompressionType::Enum compressionType, int rowsPerChunk)
+{
+    // Build the RGBA pixels
+    int rowSize = width * 4;
+    vector<UInt8> pixels(rowSize * height);
+    for(int y = 0; y < height; y++)
+        for(int x = 0; x < width; x++)
+            for(int channel = 0; channel < 4; channel++)
+                pixels[y * rowSize + x * 4 + channel] = GetTestImageByte(x, y, channel);
+
+    // Write the header
+    UInt16 flags = (UInt16)(compressionType << 6);
+    if(rowsPerChunk > 0)
+        flags |= 0x0020;
+
+    FileStream file(filePath, FileMode::Write);
+    file.WriteUInt16((UInt16) width);
+    file.WriteUInt16((UInt16) height);
+    file.WriteUInt16((UInt16) PixelFormat::RGBA_8888);
+    file.WriteUInt16(flags);
+
+    // Compress the image data, as a whole or in bands of rows
+    int numChunks = rowsPerChunk > 0 ? (height + rowsPerChunk - 1) / rowsPerChunk : 1;
+    int chunkRows = rowsPerChunk > 0 ? rowsPerChunk : height;
+    vector<UInt32> chunkSizes;
+    vector<UInt8> chunkData;
+    for(int chunkIndex = 0; chunkIndex < numChunks; chunkIndex++)
+    {
+        int firstRow = chunkIndex * chunkRows;
+        int numRows = (height - firstRow) < chunkRows ? (height - firstRow) : chunkRows;
+        int maxSize = Stream::GetMaxCompressedSize(numRows * rowSize, compressionType);
+
+        size_t offset = chunkData.size();
+        chunkData.resize(offset + maxSize);
+        int size = Stream::Compress(&pixels[firstRow * rowSize], numRows * rowSize, &chunkData[offset], maxSize, compressionType);
+        chunkData.resize(offset + size);
+        chunkSizes.push_back((UInt32) size);
+    }
+
+    if(rowsPerChunk > 0)
+    {
+        file.WriteUInt16((UInt16) rowsPerChunk);
+        file.WriteUInt16((UInt16) numChunks);
+        for(int chunkIndex = 0; chunkIndex < numChunks; chunkIndex++)
+            file.WriteUInt32(chunkSizes[chunkIndex]);
+    }
+    file.Write(&chunkData[0], (UInt32) chunkData.size());
+    file.Close();
+}
+
+// ***********************************************************************
+void WriteTestAtlas(const string& assetFolder, const char* name, int numSheets)
+{
+    // Write the sheet images  (The atlas loads them as "<name>_sheet_<index>")
+    for(int sheetIndex = 0; sheetIndex < numSheets; sheetIndex++)
+    {
+        char sheetPath[256];
+        GDK_SNPRINTF(sheetPath, 256, "%s_sheet_%d.gdkimage", name, sheetIndex);
+        WriteTestImage(Path::Combine(assetFolder.c_str(), sheetPath).c_str(), 16, 16, CompressionType::ZLib, 0);
+    }
+
+    // Write an atlas with just the sheets  (No images or animations)
+    string atlasPath = Path::Combine(assetFolder.c_str(), (string(name) + ".gdkatlas").c_str());
+    FileStream file(atlasPath.c_str(), FileMode::Write);
+    file.WriteInt16((Int16) numSheets);
+    file.WriteUInt16(0);
+    for(int sheetIndex = 0; sheetIndex < numSheets; sheetIndex++)
+    {
+        file.WriteInt16(16);
+        file.WriteInt16(16);
+        file.WriteUInt8((UInt8) PixelFormat::RGBA_8888);
+    }
+    file.WriteInt16(0);
+    file.WriteInt16(0);
+    file.Close();
+}
+
+// ***********************************************************************
+const ResourceLoadRecord* FindLoadRecord(const vector<ResourceLoadRecord>& records, const string& name)
+{
+    for(size_t index = 0; index < records.size(); index++)
+        if(records[index].Name == name)
+            return &records[index];
+    return NULL;
+}
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::Test_Resource_AssetBundle(TestExecutionContext *context)
+{
+    string workingFolder = Path::GetCommonPath(CommonPaths::WorkingFolder);
+    string assetFolder = Path::Combine(workingFolder.c_str(), "BundleTestAssets");
+
+    // Create a small DAG of assets:  Two atlases & their sheets, with the Right atlas also depending on the Left one,
+    // & an image that nothing depends on
+    if(Directory::Exists(assetFolder.c_str()))
+        Directory::Delete(assetFolder.c_str(), true);
+    const char* folders[] = { "", "Atlas", "Images", "Bundles" };
+    for(int folderIndex = 0; folderIndex < 4; folderIndex++)
+        Directory::Create(Path::Combine(assetFolder.c_str(), folders[folderIndex]).c_str());
+
+    WriteTestAtlas(assetFolder, "Atlas/BundleLeft", 2);
+    WriteTestAtlas(assetFolder, "Atlas/BundleRight", 1);
+    WriteTestImage(Path::Combine(assetFolder.c_str(), "Images/BundleBackground.gdkimage").c_str(), 32, 32, CompressionType::ZLib, 0);
+
+    FileAssetProvider* provider = GdkNew FileAssetProvider(assetFolder.c_str());
+    AssetManager::RegisterProvider(provider, 100);
+
+    // Write the bundle.  The writer adds the sheets of each atlas as its dependencies
+    AssetBundleWriter writer;
+    int left = writer.AddAsset(BundleAssetType::Atlas, "Atlas/BundleLeft");
+    int right = writer.AddAsset(BundleAssetType::Atlas, "Atlas/BundleRight");
+    int background = writer.AddAsset(BundleAssetType::Texture2D, "Images/BundleBackground");
+    UNIT_TEST_CHECK(left >= 0 && right >= 0 && background >= 0, "Added the assets to the bundle writer");
+    UNIT_TEST_CHECK(writer.AddAsset(BundleAssetType::Atlas, "Atlas/BundleLeft") == left, "Adding an asset twice returns its existing index");
+    UNIT_TEST_CHECK(writer.AddDependency(right, left) && writer.AddDependency(left, left) == false, "Added a dependency between the atlases");
+
+    UNIT_TEST_CHECK(writer.GetAssetCount() == 6, "The bundle has the 3 assets & the 3 atlas sheets  (%d assets)", (int) writer.GetAssetCount());
+    UNIT_TEST_CHECK(writer.GetDependencies(left).size() == 2 && writer.GetDependencies(right).size() == 2 && writer.GetDependencies(background).size() == 0,
+        "The dependencies were filled from the child resources");
+    writer.Write(Path::Combine(assetFolder.c_str(), "Bundles/Test.gdkbundle").c_str());
+
+    // Write a bundle with a dependency cycle
+    AssetBundleWriter cycleWriter;
+    int first = cycleWriter.AddAsset(BundleAssetType::Texture2D, "Images/BundleBackground");
+    int second = cycleWriter.AddAsset(BundleAssetType::Texture2D, "Atlas/BundleRight_sheet_0");
+    cycleWriter.AddDependency(first, second);
+    cycleWriter.AddDependency(second, first);
+    cycleWriter.Write(Path::Combine(assetFolder.c_str(), "Bundles/Cycle.gdkbundle").c_str());
+
+    // Load the bundles, both on the calling thread & on the background threads
+    int originalThreadCount = ResourceManager::GetBackgroundThreadCount();
+    bool originalStatsEnabled = ResourceLoadStats::Enabled;
+    ResourceLoadStats::Enabled = true;
+
+    TestStatus::Enum status = TestStatus::Pass;
+    int threadCounts[] = { 0, 3 };
+    for(int threadIndex = 0; threadIndex < 2 && status == TestStatus::Pass; threadIndex++)
+    {
+        ResourceManager::SetBackgroundThreadCount(threadCounts[threadIndex]);
+        ResourceLoadStats::Clear();
+        status = CheckAssetBundleLoad(context, writer, threadCounts[threadIndex]);
+    }
+
+    ResourceManager::SetBackgroundThreadCount(originalThreadCount);
+    ResourceLoadStats::Enabled = originalStatsEnabled;
+    ResourceLoadStats::Clear();
+
+    AssetManager::UnRegisterProvider(provider, true);
+    Directory::Delete(assetFolder.c_str(), true);
+
+    return status;
+}
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::CheckAssetBundleLoad(TestExecutionContext *context, AssetBundleWriter& writer, int numThreads)
+{
+    // Load the bundle asyncronously, & watch its progress
+    AssetBundle* bundle = AssetBundleManager::FromAsset("Bundles/Test", true);
+    bool progressRises = true;
+    float lastProgress = 0.0f;
+    while(bundle->State == ResourceState::Loading)
+    {
+        float progress = bundle->GetProgress();
+        progressRises = progressRises && progress >= lastProgress && progress <= 1.0f;
+        lastProgress = progress;
+        Thread::Sleep(1);
+    }
+    bundle->WaitForCompletion();
+
+    UNIT_TEST_CHECK(bundle->State == ResourceState::Ready, "%d threads: The bundle completed", numThreads);
+    UNIT_TEST_CHECK(progressRises && bundle->GetProgress() == 1.0f && bundle->GetLoadedAssetCount() == writer.GetAssetCount(),
+        "%d threads: The progress rose to 1.0", numThreads);
+
+    // Every asset must be ready, & its dependencies must have finished loading before it started
+    vector<ResourceLoadRecord> records;
+    ResourceLoadStats::GetRecords(records);
+    bool allReady = true;
+    bool inOrder = true;
+    for(size_t index = 0; index < bundle->GetAssetCount(); index++)
+    {
+        Resource* asset = bundle->GetAsset(index);
+        allReady = allReady && asset != NULL && asset->State == ResourceState::Ready;
+
+        const ResourceLoadRecord* record = FindLoadRecord(records, bundle->GetAssetName(index));
+        const vector<UInt16>& dependencies = writer.GetDependencies(index);
+        for(size_t dependencyIndex = 0; dependencyIndex < dependencies.size(); dependencyIndex++)
+        {
+            const ResourceLoadRecord* dependency = FindLoadRecord(records, bundle->GetAssetName(dependencies[dependencyIndex]));
+            inOrder = inOrder && record != NULL && dependency != NULL && dependency->StartTime + dependency->LoadTime <= record->StartTime;
+        }
+    }
+    UNIT_TEST_CHECK(allReady, "%d threads: Every asset in the bundle is ready", numThreads);
+    UNIT_TEST_CHECK(inOrder, "%d threads: Every asset loaded after its dependencies", numThreads);
+    bundle->Release();
+
+    // A bundle with a dependency cycle must fail, rather than never completing
+    AssetBundle* cycle = AssetBundleManager::FromAsset("Bundles/Cycle", true);
+    cycle->WaitForCompletion();
+    UNIT_TEST_CHECK(cycle->State == ResourceState::LoadFailed && cycle->GetLoadedAssetCount() == 0,
+        "%d threads: The bundle with a dependency cycle failed to load", numThreads);
+    cycle->Release();
+
+    return TestStatus::Pass;
+}
+
+// ***********************************************************************
+struct ParallelTaskTestData
+{
+    Resource* Res;
+    vector<int> RunCounts;
+    vector<UInt32> ThreadIds;
+    volatile bool WrongResource;
+};
+
+// ***********************************************************************
+void RunParallelTestTask(Resource* resource, void* context, int taskIndex)
+{
+    ParallelTaskTestData* data = (ParallelTaskTestData*) context;
+    if(resource != data->Res)
+        data->WrongResource = true;
+
+    // Each task has its own slot, so a task that runs twice (or not at all) shows in its count
+    data->RunCounts[taskIndex]++;
+    data->ThreadIds[taskIndex] = Thread::GetCurrentThreadId();
+    Thread::Sleep(1);
+}
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::Test_Resource_ParallelTasks(TestExecutionContext *context)
+{
+    Texture2D* texture = Texture2DManager::Create("ParallelTaskTest", 1, 1, PixelFormat::RGBA_8888);
+    int originalThreadCount = ResourceManager::GetBackgroundThreadCount();
+
+    // Run the tasks on the calling thread alone, with a single helper, & with several
+    int threadCounts[] = { 0, 1, 3 };
+    int taskCounts[] = { 0, 1, 64 };
+    TestStatus::Enum status = TestStatus::Pass;
+    for(int threadIndex = 0; threadIndex < 3 && status == TestStatus::Pass; threadIndex++)
+    {
+        int numThreads = threadCounts[threadIndex];
+        ResourceManager::SetBackgroundThreadCount(numThreads);
+
+        for(int taskIndex = 0; taskIndex < 3 && status == TestStatus::Pass; taskIndex++)
+            status = CheckParallelTasks(context, texture, numThreads, taskCounts[taskIndex]);
+    }
+
+    ResourceManager::SetBackgroundThreadCount(originalThreadCount);
+    texture->Release();
+
+    return status;
+}
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::CheckParallelTasks(TestExecutionContext *context, Resource* resource, int numThreads, int numTasks)
+{
+    ParallelTaskTestData data;
+    data.Res = resource;
+    data.RunCounts.resize(numTasks, 0);
+    data.ThreadIds.resize(numTasks, 0);
+    data.WrongResource = false;
+
+    ResourceManager::RunParallelTasks(resource, numTasks, &RunParallelTestTask, &data);
+
+    // Every task must have run exactly once, by the time RunParallelTasks() returns
+    bool onceEach = std::count(data.RunCounts.begin(), data.RunCounts.end(), 1) == numTasks;
+    UNIT_TEST_CHECK(onceEach && data.WrongResource == false, "%d threads: Each of the %d tasks ran once", numThreads, numTasks);
+
+    // Count the threads that ran tasks
+    vector<UInt32> threadIds = data.ThreadIds;
+    std::sort(threadIds.begin(), threadIds.end());
+    int numTaskThreads = (int)(std::unique(threadIds.begin(), threadIds.end()) - threadIds.begin());
+    UInt32 callingThreadId = Thread::GetCurrentThreadId();
+    if(numThreads == 0 || numTasks <= 1)
+    {
+        UNIT_TEST_CHECK(numTasks == 0 || (numTaskThreads == 1 && threadIds[0] == callingThreadId),
+            "%d threads: The %d tasks ran on the calling thread", numThreads, numTasks);
+    }
+    else
+    {
+        UNIT_TEST_CHECK(numTaskThreads > 1 && numTaskThreads <= numThreads + 1,
+            "%d threads: The %d tasks ran across %d threads", numThreads, numTasks, numTaskThreads);
+    }
+
+    return TestStatus::Pass;
+}
+
+// ***********************************************************************
+void FillCacheTestData(vector<UInt8>& data, int size, int pattern)
+{
+    data.resize(size);
+    for(int i = 0; i < size; i++)
+        data[i] = (UInt8)(i * 13 + pattern);
+}
+
+// ***********************************************************************
+bool IsCacheEntry(UInt64 key, const vector<UInt8>& expected)
+{
+    Stream* stream = DecodedAssetCache::Open(key);
+    if(stream == NULL)
+        return false;
+
+    Int64 size = stream->GetLength() - stream->GetPosition();
+    const UInt8* data = (const UInt8*) stream->GetSpan(stream->GetPosition(), size);
+    bool matches = data != NULL && size == (Int64) expected.size() && memcmp(data, &expected[0], expected.size()) == 0;
+    stream->Close();
+    GdkDelete(stream);
+    return matches;
+}
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::Test_Resource_DecodedAssetCache(TestExecutionContext *context)
+{
+    const Int64 headerSize = 32;
+    const int entrySize = 300 * 1024;
+    string workingFolder = Path::GetCommonPath(CommonPaths::WorkingFolder);
+    string cacheFolder = Path::Combine(workingFolder.c_str(), "DecodedAssetCache");
+
+    // Restart the cache, empty & with room for 3 entries
+    Int64 originalMaxSize = DecodedAssetCache::GetMaxSize();
+    DecodedAssetCache::Shutdown();
+    DecodedAssetCache::Init(1024 * 1024);
+    DecodedAssetCache::Clear();
+    UNIT_TEST_CHECK(DecodedAssetCache::IsEnabled() && DecodedAssetCache::GetSize() == 0, "Restarted the cache, with a 1 MB max size");
+
+    // Keys are ordered so that entries with equal use counts would be evicted in the wrong order
+    const UInt64 keyA = 0x1000000000000001ULL;
+    const UInt64 keyB = 0x2000000000000002ULL;
+    const UInt64 keyC = 0x3000000000000003ULL;
+    const UInt64 keyD = 0x4000000000000004ULL;
+    const UInt64 keyE = 0x5000000000000005ULL;
+    const UInt64 keyF = 0x6000000000000006ULL;
+    vector<UInt8> dataA, dataB, dataC, dataD, dataE, dataF;
+    FillCacheTestData(dataA, entrySize, 1);
+    FillCacheTestData(dataB, entrySize, 2);
+    FillCacheTestData(dataC, entrySize, 3);
+    FillCacheTestData(dataD, entrySize, 4);
+    FillCacheTestData(dataE, entrySize, 5);
+    FillCacheTestData(dataF, entrySize, 6);
+
+    // Store, then open
+    DecodedAssetCache::Store(keyA, &dataA[0], entrySize);
+    UNIT_TEST_CHECK(IsCacheEntry(keyA, dataA) && DecodedAssetCache::GetSize() == entrySize + headerSize, "Stored & opened an entry");
+    UNIT_TEST_CHECK(DecodedAssetCache::Open(keyB) == NULL, "A key that was never stored isnt found");
+
+    // An entry whose header was overwritten is rejected, & removed
+    DecodedAssetCache::Store(keyB, &dataB[0], entrySize);
+    char fileName[32];
+    GDK_SNPRINTF(fileName, 32, "%016llx.gdkcache", (unsigned long long) keyB);
+    string entryPath = Path::Combine(cacheFolder.c_str(), fileName);
+    vector<UInt8> garbage;
+    FillCacheTestData(garbage, entrySize + (int) headerSize, 7);
+    FileStream* file = File::Create(entryPath.c_str());
+    file->Write(&garbage[0], (UInt32) garbage.size());
+    file->Close();
+    GdkDelete(file);
+
+    UNIT_TEST_CHECK(DecodedAssetCache::Open(keyB) == NULL && File::Exists(entryPath.c_str()) == false
+        && DecodedAssetCache::GetSize() == entrySize + headerSize, "The entry with an invalid header was rejected & removed");
+
+    // Fill the cache, then use A, so B is the least recently used entry when D is stored
+    DecodedAssetCache::Store(keyB, &dataB[0], entrySize);
+    DecodedAssetCache::Store(keyC, &dataC[0], entrySize);
+    UNIT_TEST_CHECK(IsCacheEntry(keyA, dataA), "Used entry A");
+    DecodedAssetCache::Store(keyD, &dataD[0], entrySize);
+    UNIT_TEST_CHECK(DecodedAssetCache::Open(keyB) == NULL && DecodedAssetCache::GetSize() == 3 * (entrySize + headerSize),
+        "Storing a 4th entry evicted the least recently used entry  (B)");
+
+    // Shrinking the cache evicts the next least recently used entry  (C)
+    DecodedAssetCache::SetMaxSize(700 * 1024);
+    UNIT_TEST_CHECK(DecodedAssetCache::Open(keyC) == NULL && DecodedAssetCache::GetSize() == 2 * (entrySize + headerSize),
+        "Shrinking the cache to 700 KB evicted the least recently used entry  (C)");
+    DecodedAssetCache::SetMaxSize(1024 * 1024);
+
+    // Use A again, so D is the least recently used entry, & restart the cache
+    UNIT_TEST_CHECK(IsCacheEntry(keyA, dataA), "Used entry A");
+    DecodedAssetCache::Shutdown();
+    DecodedAssetCache::Init(1024 * 1024);
+    UNIT_TEST_CHECK(DecodedAssetCache::GetSize() == 2 * (entrySize + headerSize), "The entries were found again after a restart");
+
+    // The use order came from the saved index, so D (not A, which has the lower key) is evicted first
+    DecodedAssetCache::Store(keyE, &dataE[0], entrySize);
+    DecodedAssetCache::Store(keyF, &dataF[0], entrySize);
+    UNIT_TEST_CHECK(DecodedAssetCache::Open(keyD) == NULL && IsCacheEntry(keyA, dataA) && IsCacheEntry(keyE, dataE) && IsCacheEntry(keyF, dataF),
+        "The use order survived the restart  (D was evicted, A was kept)");
+
+    // Restore the cache
+    DecodedAssetCache::Clear();
+    DecodedAssetCache::Shutdown();
+    DecodedAssetCache::Init(originalMaxSize);
+
+    return TestStatus::Pass;
+}
+
+// ***********************************************************************
+void CopyTestAsset(const char* assetPath, const string& filePath)
+{
+    Stream* source = AssetManager::GetAssetStream(assetPath);
+    vector<UInt8> data((size_t) source->GetLength());
+    source->Read(&data[0], (int) data.size());
+    source->Close();
+    GdkDelete(source);
+
+    FileStream file(filePath.c_str(), FileMode::Write);
+    file.Write(&data[0], (UInt32) data.size());
+    file.Close();
+}
+
+// ***********************************************************************
+UInt16 ReadTestAssetFlags(const string& assetPath, int offset)
+{
+    Stream* stream = AssetManager::GetAssetStream(assetPath.c_str());
+    stream->Seek(offset, SeekOrigin::Begin);
+    UInt16 flags = stream->ReadUInt16();
+    stream->Close();
+    GdkDelete(stream);
+    return flags;
+}
+
+// ***********************************************************************
+bool IsConvertedTestImage(const string& name, const vector<UInt8>& expected)
+{
+    Texture2D* texture = Texture2DManager::FromAsset(name.c_str());
+    bool loaded = texture->State == ResourceState::Ready;
+    texture->Release();
+
+    // The decoded pixels are checked through the DecodedAssetCache, where the loader stores them
+    string assetPath = name + ".gdkimage";
+    Stream* stream = AssetManager::GetAssetStream(assetPath.c_str());
+    UInt64 cacheKey = DecodedAssetCache::GetKey(stream, "Texture2D", TEXTURE2D_DECODER_VERSION);
+    stream->Close();
+    GdkDelete(stream);
+
+    return loaded && IsCacheEntry(cacheKey, expected);
+}
+
+// ***********************************************************************
+bool IsSameTestMeshData(const string& name, const string& expectedName)
+{
+    Model* model = ModelManager::FromAsset(name.c_str());
+    Model* expected = ModelManager::FromAsset(expectedName.c_str());
+
+    bool matches = model->State == ResourceState::Ready && expected->State == ResourceState::Ready
+        && model->Meshes.size() == expected->Meshes.size();
+    for(size_t meshIndex = 0; matches && meshIndex < model->Meshes.size(); meshIndex++)
+    {
+        ModelMesh* mesh = model->Meshes[meshIndex];
+        ModelMesh* expectedMesh = expected->Meshes[meshIndex];
+        size_t vertexDataSize = mesh->NumVertices * ModelMeshFlags::GetVertexStrideFromFlags(mesh->Flags);
+        matches = mesh->Flags == expectedMesh->Flags && mesh->NumVertices == expectedMesh->NumVertices && mesh->NumIndices == expectedMesh->NumIndices
+            && memcmp(mesh->VertexData, expectedMesh->VertexData, vertexDataSize) == 0
+            && memcmp(mesh->IndexData, expectedMesh->IndexData, mesh->NumIndices * sizeof(UInt16)) == 0;
+    }
+
+    model->Release();
+    expected->Release();
+    return matches;
+}
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::Test_Resource_AssetConverter(TestExecutionContext *context)
+{
+    string workingFolder = Path::GetCommonPath(CommonPaths::WorkingFolder);
+    string assetFolder = Path::Combine(workingFolder.c_str(), "AssetConverterTestAssets");
+    string modelFolder = Path::Combine(assetFolder.c_str(), "Models");
+    if(Directory::Exists(assetFolder.c_str()) == false)
+        Directory::Create(assetFolder.c_str());
+    if(Directory::Exists(modelFolder.c_str()) == false)
+        Directory::Create(modelFolder.c_str());
+
+    // A chunked ZLib image, & an uncompressed copy of the TestAxis model.  (Its textures come from the base assets)
+    WriteTestImage(Path::Combine(assetFolder.c_str(), "ChunkedImage.gdkimage").c_str(), 61, 203, CompressionType::ZLib, 16);
+    CopyTestAsset("Models/TestAxis.gdkmodel", Path::Combine(modelFolder.c_str(), "TestAxisOriginal.gdkmodel"));
+
+    FileAssetProvider* provider = GdkNew FileAssetProvider(assetFolder.c_str());
+    AssetManager::RegisterProvider(provider, 100);
+
+    // The converted meshes are compared with the original ones, so keep their data
+    Int64 originalCacheSize = DecodedAssetCache::GetMaxSize();
+    DecodedAssetCache::SetMaxSize(64 * 1024 * 1024);
+    bool originalKeepMeshData = ModelManager::GetKeepMeshData();
+    ModelManager::SetKeepMeshData(true);
+
+    CompressionType::Enum compressionTypes[] = { CompressionType::LZ4, CompressionType::Zstd };
+    const char* compressionNames[] = { "LZ4", "Zstd" };
+    TestStatus::Enum status = TestStatus::Pass;
+    for(int typeIndex = 0; typeIndex < 2 && status == TestStatus::Pass; typeIndex++)
+        status = CheckAssetConversion(context, assetFolder, compressionTypes[typeIndex], compressionNames[typeIndex]);
+
+    ModelManager::SetKeepMeshData(originalKeepMeshData);
+    DecodedAssetCache::Clear();
+    DecodedAssetCache::SetMaxSize(originalCacheSize);
+    AssetManager::UnRegisterProvider(provider, true);
+    Directory::Delete(assetFolder.c_str(), true);
+
+    return status;
+}
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::CheckAssetConversion(TestExecutionContext *context, const string& assetFolder, CompressionType::Enum compressionType, const char* compressionName)
+{
+    string chunkedName = string("ChunkedImage_") + compressionName;
+    string chunkedPath = Path::Combine(assetFolder.c_str(), (chunkedName + ".gdkimage").c_str());
+    string sourcePath = Path::Combine(assetFolder.c_str(), "ChunkedImage.gdkimage");
+
+    // Without the codec, the conversion fails & leaves no file behind
+    if(Stream::IsCompressionTypeSupported(compressionType) == false)
+    {
+        UNIT_TEST_CHECK(AssetConverter::ConvertAsset(sourcePath.c_str(), chunkedPath.c_str(), compressionType) == false && File::Exists(chunkedPath.c_str()) == false,
+            "%s: Converting fails, as %s is not supported by this build", compressionName, compressionName);
+        return TestStatus::Pass;
+    }
+
+    // The chunked image, converted file to file
+    UNIT_TEST_CHECK(AssetConverter::ConvertAsset(sourcePath.c_str(), chunkedPath.c_str(), compressionType), "%s: Converted the chunked image", compressionName);
+    UInt16 flags = ReadTestAssetFlags(chunkedName + ".gdkimage", 6);
+    UNIT_TEST_CHECK(((flags >> 6) & 0x3) == compressionType && (flags & 0x0020) != 0,
+        "%s: The chunked image is still chunked, & has the codec bits set  (Flags 0x%04x)", compressionName, flags);
+
+    vector<UInt8> expected(61 * 203 * 4);
+    for(int y = 0; y < 203; y++)
+        for(int x = 0; x < 61; x++)
+            for(int channel = 0; channel < 4; channel++)
+                expected[(y * 61 + x) * 4 + channel] = GetTestImageByte(x, y, channel);
+    UNIT_TEST_CHECK(IsConvertedTestImage(chunkedName, expected), "%s: Loaded the converted chunked image, with the original pixels", compressionName);
+
+    // The TestAxis texture, converted from its asset stream.  Its original pixels are decompressed here
+    string imageName = string("Models/TestAxis_") + compressionName;
+    Stream* source = AssetManager::GetAssetStream("Models/TestAxis.gdkimage");
+    FileStream* file = File::Create(Path::Combine(assetFolder.c_str(), (imageName + ".gdkimage").c_str()).c_str());
+    bool converted = AssetConverter::ConvertImage(source, file, compressionType);
+    file->Close();
+    GdkDelete(file);
+
+    MemoryStream decoded(64 * 1024);
+    source->Seek(8, SeekOrigin::Begin);
+    source->Decompress(&decoded, CompressionType::ZLib);
+    source->Close();
+    GdkDelete(source);
+    const UInt8* pixels = (const UInt8*) decoded.GetBufferStartPtr();
+    expected.assign(pixels, pixels + decoded.GetLength());
+
+    flags = ReadTestAssetFlags(imageName + ".gdkimage", 6);
+    UNIT_TEST_CHECK(converted && ((flags >> 6) & 0x3) == compressionType, "%s: Converted the TestAxis texture  (Flags 0x%04x)", compressionName, flags);
+    UNIT_TEST_CHECK(IsConvertedTestImage(imageName, expected), "%s: Loaded the converted texture, with the original pixels", compressionName);
+
+    // The TestAxis model, converted from its asset stream, then back to ZLib from the converted model
+    string modelName = string("Models/TestAxis_") + compressionName;
+    string zlibModelName = modelName + "_ZLib";
+    const char* sourceNames[] = { "Models/TestAxis", modelName.c_str() };
+    const char* modelNames[] = { modelName.c_str(), zlibModelName.c_str() };
+    CompressionType::Enum modelCompression[] = { compressionType, CompressionType::ZLib };
+    for(int modelIndex = 0; modelIndex < 2; modelIndex++)
+    {
+        source = AssetManager::GetAssetStream((string(sourceNames[modelIndex]) + ".gdkmodel").c_str());
+        file = File::Create(Path::Combine(assetFolder.c_str(), (string(modelNames[modelIndex]) + ".gdkmodel").c_str()).c_str());
+        converted = AssetConverter::ConvertModel(source, file, modelCompression[modelIndex]);
+        file->Close();
+        GdkDelete(file);
+        source->Close();
+        GdkDelete(source);
+
+        flags = ReadTestAssetFlags(string(modelNames[modelIndex]) + ".gdkmodel", 2);
+        UNIT_TEST_CHECK(converted && flags == modelCompression[modelIndex] + 1, "%s: Converted %s to %s  (Flags 0x%04x)",
+            compressionName, sourceNames[modelIndex], modelNames[modelIndex], flags);
+        UNIT_TEST_CHECK(IsSameTestMeshData(modelNames[modelIndex], "Models/TestAxisOriginal"),
+            "%s: Loaded %s, with the original vertex & index data", compressionName, modelNames[modelIndex]);
+    }
+
+    return TestStatus::Pass;
+}
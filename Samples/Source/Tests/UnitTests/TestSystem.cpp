@@ -48,6 +48,58 @@ TestStatus::Enum UnitTestsModule::Test_System_Logging(TestExecutionContext *cont
     return TestStatus::Pass;
 }
 
+// ***********************************************************************
+// Encodes the arguments of a deferred message, the way Log::WriteDeferred() does for the LOG_DEFERRED macros
+static int EncodeDeferredArgs(LogFormat* format, UInt8* payload, int payloadSize, ...)
+{
+    if(format->NumArgs < 0)
+        format->Parse();
+    
+    va_list args;
+    va_start(args, payloadSize);
+    int payloadLength = format->EncodeArgs(payload, payloadSize, args);
+    va_end(args);
+    return payloadLength;
+}
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::Test_System_LogFormat(TestExecutionContext *context)
+{
+    // The LogFormats are declared as the LOG_DEFERRED macros declare them
+    static LogFormat mixedFormat = { "str[%s] int[%d] float[%.2f] big[%lld] hex[%x] char[%c] 100%%", -1 };
+    static LogFormat starFormat = { "[%*d] [%-6s] [%.*f]", -1 };
+    static LogFormat stringFormat = { "%s", -1 };
+    
+    UInt8 payload[4096];
+    char text[4096];
+    
+    // Mixed argument types
+    int payloadLength = EncodeDeferredArgs(&mixedFormat, payload, sizeof(payload), "ABC", 123, 3.14159f, -5000000000LL, 255, 'Z');
+    UNIT_TEST_CHECK(mixedFormat.NumArgs == 6, "Parsed %d arguments from the mixed format", mixedFormat.NumArgs);
+    mixedFormat.FormatArgs(text, sizeof(text), payload, payloadLength);
+    UNIT_TEST_CHECK(strcmp(text, "str[ABC] int[123] float[3.14] big[-5000000000] hex[ff] char[Z] 100%") == 0, "Mixed format: %s", text);
+    
+    // '*' widths & precisions
+    payloadLength = EncodeDeferredArgs(&starFormat, payload, sizeof(payload), 5, 42, "ab", 3, 2.5);
+    starFormat.FormatArgs(text, sizeof(text), payload, payloadLength);
+    UNIT_TEST_CHECK(strcmp(text, "[   42] [ab    ] [2.500]") == 0, "Star format: %s", text);
+    
+    // Long strings are cut to LOGFORMAT_MAX_STRING characters
+    string longString(LOGFORMAT_MAX_STRING + 50, 'x');
+    payloadLength = EncodeDeferredArgs(&stringFormat, payload, sizeof(payload), longString.c_str());
+    stringFormat.FormatArgs(text, sizeof(text), payload, payloadLength);
+    UNIT_TEST_CHECK(strlen(text) == LOGFORMAT_MAX_STRING, "Long string argument was cut to %d characters", (int) strlen(text));
+    
+    // Missing arguments leave their conversions as they are
+    stringFormat.FormatArgs(text, sizeof(text), payload, 0);
+    UNIT_TEST_CHECK(strcmp(text, "%s") == 0, "Format without its argument: %s", text);
+    
+    // And through the log itself
+    LOG_DEFERRED_INFO("Deferred Log Test: str[%s] int[%d] float[%f]", "ABC", 123, 3.14f);
+    
+    return TestStatus::Pass;
+}
+
 
 // ***********************************************************************
 class MemTest
@@ -162,6 +214,44 @@ TestStatus::Enum UnitTestsModule::Test_System_Containers_SortedVector(TestExecut
 // ##############################################################################################
 // ##############################################################################################
 
+// ***********************************************************************
+void* TestThreadIdFunction(void* arg)
+{
+    // Return the id the thread sees for itself
+    return (void*)(size_t) Thread::GetCurrentThreadId();
+}
+
+// ***********************************************************************
+class TestThreadIdClass
+{
+public:
+    void* ThreadIdMethod(void* arg)     { return TestThreadIdFunction(arg); }
+};
+
+// ***********************************************************************
+TestStatus::Enum UnitTestsModule::Test_System_Threading_Thread(TestExecutionContext *context)
+{
+    UInt32 mainThreadId = Thread::GetCurrentThreadId();
+
+    // The id of a thread matches the id it gets from GetCurrentThreadId(), as soon as Create() returns
+    Thread functionThread = Thread::Create(TestThreadIdFunction);
+    UInt32 functionThreadId = functionThread.GetId();
+    UInt32 reportedId = (UInt32)(size_t) functionThread.Join();
+    UNIT_TEST_CHECK(functionThreadId == reportedId && functionThreadId != mainThreadId,
+        "Function thread: GetId() matches GetCurrentThreadId()  (%u)", reportedId);
+
+    TestThreadIdClass testObject;
+    Thread::Delegate* threadDelegate = Thread::Delegate::FromMethod(&testObject, &TestThreadIdClass::ThreadIdMethod);
+    Thread delegateThread = Thread::Create(threadDelegate);
+    Thread delegateThreadCopy = delegateThread;
+    reportedId = (UInt32)(size_t) delegateThread.Join();
+    GdkDelete(threadDelegate);
+    UNIT_TEST_CHECK(delegateThreadCopy.GetId() == reportedId && reportedId != mainThreadId,
+        "Delegate thread: GetId() matches GetCurrentThreadId()  (%u)", reportedId);
+
+    return TestStatus::Pass;
+}
+
 // ***********************************************************************
 struct TestWorkItem
 {
@@ -176,7 +266,7 @@ public:
 class TestWorkQueue : public ThreadedWorkQueue<TestWorkItem*>
 {
 public:
-    TestWorkQueue() : ThreadedWorkQueue<TestWorkItem*>(4)
+    TestWorkQueue() : ThreadedWorkQueue<TestWorkItem*>(4, "TestWorkQueue")
     {
     }
     
@@ -152,11 +152,13 @@ void UnitTestsModule::BuildTestTree()
  
     CNODE(this->rootNode, systemTests, "System Tests");
         TNODE(systemTests, "Logging", Test_System_Logging);
+        TNODE(systemTests, "Log Format", Test_System_LogFormat);
         TNODE(systemTests, "Memory", Test_System_Memory);
         CNODE(systemTests, systemContainerTests, "Containers");
             TNODE(systemContainerTests, "StringHashMap", Test_System_Containers_StringHashMap);
             TNODE(systemContainerTests, "SortedVector", Test_System_Containers_SortedVector);
         CNODE(systemTests, systemThreadingTests, "Threading");
+            TNODE(systemThreadingTests, "Thread", Test_System_Threading_Thread);
             TNODE(systemThreadingTests, "ThreadedWorkQueue", Test_System_Threading_ThreadedWorkQueue);
     
     // Math Tests
@@ -170,6 +172,40 @@ void UnitTestsModule::BuildTestTree()
         TNODE(mathTests, "Distance 3D", Test_Math_Distance3D);
         TNODE(mathTests, "Intersection 3D", Test_Math_Intersection3D);
     
+    // IO Tests
+    // -----------------------
+    
+    CNODE(this->rootNode, ioTests, "IO Tests");
+        TNODE(ioTests, "BinaryReader", Test_IO_BinaryReader);
+        TNODE(ioTests, "Compression", Test_IO_Compression);
+        TNODE(ioTests, "Asset Pack", Test_IO_AssetPack);
+        TNODE(ioTests, "Asset Lookup", Test_IO_AssetLookup);
+        TNODE(ioTests, "Async IO", Test_IO_AsyncIO);
+        TNODE(ioTests, "Write Behind", Test_IO_WriteBehind);
+        TNODE(ioTests, "Chunked Image", Test_IO_ChunkedImage);
+        TNODE(ioTests, "Vectored IO", Test_IO_VectoredIO);
+    
+    // Resource Tests
+    // -----------------------
+    
+    CNODE(this->rootNode, resourceTests, "Resource Tests");
+        TNODE(resourceTests, "Asset Bundle", Test_Resource_AssetBundle);
+        TNODE(resourceTests, "Parallel Tasks", Test_Resource_ParallelTasks);
+        TNODE(resourceTests, "Decoded Asset Cache", Test_Resource_DecodedAssetCache);
+        TNODE(resourceTests, "Asset Converter", Test_Resource_AssetConverter);
+    
+    // Input Tests
+    // -----------------------
+    
+    CNODE(this->rootNode, inputTests, "Input Tests");
+        TNODE(inputTests, "Input Recording", Test_Input_Recording);
+    
+    // Benchmarks
+    // -----------------------
+    
+    CNODE(this->rootNode, benchmarks, "Benchmarks");
+        TNODE(benchmarks, "Engine Benchmarks", Test_Benchmarks);
+    
     // -----------------------
     
     #undef CNODE
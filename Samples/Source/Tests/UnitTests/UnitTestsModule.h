@@ -28,6 +28,10 @@
 
 #endif
 
+// Test asset writers  (TestResources.cpp)
+UInt8 GetTestImageByte(int x, int y, int channel);
+void WriteTestImage(const char* filePath, int width, int height, CompressionType::Enum compressionType, int rowsPerChunk);
+
 // ==============================================
 namespace TestStatus
 {
@@ -157,9 +161,11 @@ protected:
     
     // System Tests
     TESTMETHOD(Test_System_Logging);
+    TESTMETHOD(Test_System_LogFormat);
     TESTMETHOD(Test_System_Memory);
     TESTMETHOD(Test_System_Containers_StringHashMap);
     TESTMETHOD(Test_System_Containers_SortedVector);
+    TESTMETHOD(Test_System_Threading_Thread);
     TESTMETHOD(Test_System_Threading_ThreadedWorkQueue);
     
     // Math Tests
@@ -170,6 +176,37 @@ protected:
     TESTMETHOD(Test_Math_Distance3D);
     TESTMETHOD(Test_Math_Intersection3D);
     
+    // IO Tests
+    TESTMETHOD(Test_IO_BinaryReader);
+    TESTMETHOD(Test_IO_Compression);
+    TESTMETHOD(Test_IO_AssetPack);
+    TESTMETHOD(Test_IO_AssetLookup);
+    TESTMETHOD(Test_IO_AsyncIO);
+    TESTMETHOD(Test_IO_WriteBehind);
+    TESTMETHOD(Test_IO_ChunkedImage);
+    TESTMETHOD(Test_IO_VectoredIO);
+    
+    // Resource Tests
+    TESTMETHOD(Test_Resource_AssetBundle);
+    TESTMETHOD(Test_Resource_ParallelTasks);
+    TESTMETHOD(Test_Resource_DecodedAssetCache);
+    TESTMETHOD(Test_Resource_AssetConverter);
+    
+    // Input Tests
+    TESTMETHOD(Test_Input_Recording);
+    
+    // Benchmarks
+    TESTMETHOD(Test_Benchmarks);
+    
     #undef TESTMETHOD
+    
+    // Test helpers
+    TestStatus::Enum CheckAsyncIO(TestExecutionContext* context, const string& filePath, const string& writePath, const vector<UInt8>& expected);
+    TestStatus::Enum CheckChunkedImageLoad(TestExecutionContext* context, UInt64 cacheKey, int width, int height, bool mapped, int numThreads);
+    TestStatus::Enum CheckVectoredRead(TestExecutionContext* context, const char* streamName, Stream* stream, const vector<UInt8>& expected, int numBuffers);
+    TestStatus::Enum CheckAssetBundleLoad(TestExecutionContext* context, AssetBundleWriter& writer, int numThreads);
+    TestStatus::Enum CheckParallelTasks(TestExecutionContext* context, Resource* resource, int numThreads, int numTasks);
+    TestStatus::Enum CheckAssetConversion(TestExecutionContext* context, const string& assetFolder, CompressionType::Enum compressionType, const char* compressionName);
+    TestStatus::Enum CheckInputRecording(TestExecutionContext* context, const string& recordingPath);
    
 };
@@ -20,6 +20,7 @@ float Application::FixedTimeStep = 0.02f;
 bool Application::DebugStatsVisible = true;
 Color Application::DebugStatsColor = Color(0,0,128,255);
 int Application::CurrentFPS = 0;
+FrameTimeStats Application::CurrentFrameStats[FramePhase::Count];
 float Application::MaxTimeStep = 0.2f;
 
 // Internals
@@ -62,6 +63,9 @@ Application::Application ()
 // *****************************************************************
 void Application::Update(float elapsedSeconds)
 {
+    GDK_PROFILE_FRAME();
+    double updateStartTime = HighResTimer::GetSeconds();
+
 	// GDK Pre-Update tasks
 	// ----------------------
 
@@ -76,11 +80,19 @@ void Application::Update(float elapsedSeconds)
 
 	// Update the game
     Game* game = Game::GetSingleton();
-	game->OnUpdate(elapsedSeconds);
+    {
+        GDK_PROFILE_SCOPE("Game::OnUpdate");
+	    game->OnUpdate(elapsedSeconds);
+    }
+    double drawStartTime = HighResTimer::GetSeconds();
+    FrameStats::AddTime(FramePhase::Update, drawStartTime - updateStartTime);
 	
 	// Draw the game
     if(exitRequest == false)
+    {
+        GDK_PROFILE_SCOPE("Game::OnDraw");
         game->OnDraw(elapsedSeconds);
+    }
 
     // GDK Debug Stats
     // ----------------------
@@ -95,30 +107,18 @@ void Application::Update(float elapsedSeconds)
             fpsTimer -= 1.0f;
             CurrentFPS = fpsCounter;
             fpsCounter = 0;
+
+            // Update the frame time stats
+            for(int phase = 0; phase < FramePhase::Count; phase++)
+                CurrentFrameStats[phase] = FrameStats::GetStats((FramePhase::Enum) phase);
         }
         
         // Render the debug stats
         if(DebugStatsVisible == true)
-        {
-            // Setup a 2D projection matrix to draw in screen coordinates
-            int w = Application::GetWidth();
-            int h = Application::GetHeight();
-            Matrix3D proj = Matrix3D::CreateOrthoOffCenter(
-                0, (float) w,	// left / right
-                (float) h, 0,	// bottom / top
-                -1.0f, 1.0f		// far / near
-                );
-            Graphics::GlobalUniforms.Projection->SetMatrix4(proj);
-
-            // Draw the FPS string
-            char temp[64];
-            Vector2 textScale(0.7f, 0.7f);
-            GDK_SPRINTF(temp, 64, "FPS: %d", CurrentFPS);
-            Drawing2D::DrawText(SharedResources::Fonts.Arial20, temp, Vector2(width - 80.0f, 10), DebugStatsColor, textScale);
-            
-            Drawing2D::Flush();
-        }
+            DrawDebugStats();
     }
+
+    FrameStats::AddTime(FramePhase::Draw, HighResTimer::GetSeconds() - drawStartTime);
     
 	// GDK Post-Update tasks
 	// ----------------------
@@ -127,6 +127,80 @@ void Application::Update(float elapsedSeconds)
     Mouse::PostUpdate(elapsedSeconds);
 }
 
+// *****************************************************************
+/// @brief
+///     Draws the debug stats overlay  (FPS, frame times & graphics counters)
+// *****************************************************************
+void Application::DrawDebugStats()
+{
+    // Setup a 2D projection matrix to draw in screen coordinates
+    int w = Application::GetWidth();
+    int h = Application::GetHeight();
+    Matrix3D proj = Matrix3D::CreateOrthoOffCenter(
+        0, (float) w,	// left / right
+        (float) h, 0,	// bottom / top
+        -1.0f, 1.0f		// far / near
+        );
+    Graphics::GlobalUniforms.Projection->SetMatrix4(proj);
+
+    // Draw the FPS string
+    char temp[64];
+    BMFont* font = SharedResources::Fonts.Arial20;
+    Vector2 textScale(0.7f, 0.7f);
+    GDK_SPRINTF(temp, 64, "FPS: %d", CurrentFPS);
+    Drawing2D::DrawText(font, temp, Vector2(width - 80.0f, 10), DebugStatsColor, textScale);
+
+    // Draw the frame time table  (in ms), one column at a time so the numbers line up
+    static const char* columnNames[] = { "ms", "avg", "p50", "p95", "p99", "max", "spikes" };
+    const int numColumns = 7;
+    const float columnWidth = 40.0f;
+    const float rowHeight = 14.0f;
+    float left = width - (80.0f + columnWidth * (numColumns - 1));
+    float top = 30.0f;
+
+    for(int column = 0; column < numColumns; column++)
+        Drawing2D::DrawText(font, columnNames[column], Vector2(left + column * columnWidth + (column > 0 ? 20.0f : 0.0f), top), DebugStatsColor, textScale);
+
+    for(int phase = 0; phase < FramePhase::Count; phase++)
+    {
+        const FrameTimeStats& stats = CurrentFrameStats[phase];
+        float values[] = { stats.Average, stats.P50, stats.P95, stats.P99, stats.Max };
+        float y = top + (phase + 1) * rowHeight;
+
+        Drawing2D::DrawText(font, FramePhase::ToString((FramePhase::Enum) phase), Vector2(left, y), DebugStatsColor, textScale);
+        for(int column = 1; column < numColumns - 1; column++)
+        {
+            GDK_SPRINTF(temp, 64, "%.1f", values[column - 1] * 1000.0f);
+            Drawing2D::DrawText(font, temp, Vector2(left + column * columnWidth + 20.0f, y), DebugStatsColor, textScale);
+        }
+        GDK_SPRINTF(temp, 64, "%d", stats.SpikeCount);
+        Drawing2D::DrawText(font, temp, Vector2(left + (numColumns - 1) * columnWidth + 20.0f, y), DebugStatsColor, textScale);
+    }
+
+    // Draw the graphics counters of the last frame
+    const GraphicsFrameStats& graphicsStats = Graphics::GetFrameStats();
+    float y = top + (FramePhase::Count + 1.5f) * rowHeight;
+
+    GDK_SPRINTF(temp, 64, "Draws: %d  Verts: %d  Indices: %d", graphicsStats.DrawCalls, graphicsStats.Vertices, graphicsStats.Indices);
+    Drawing2D::DrawText(font, temp, Vector2(left, y), DebugStatsColor, textScale);
+
+    GDK_SPRINTF(temp, 64, "States: %d  Filtered: %d", graphicsStats.StateChanges, graphicsStats.RedundantStateChanges);
+    Drawing2D::DrawText(font, temp, Vector2(left, y + rowHeight), DebugStatsColor, textScale);
+
+    GDK_SPRINTF(temp, 64, "Textures: %d  Shaders: %d  Uniforms: %d", graphicsStats.TextureBinds, graphicsStats.ShaderBinds, graphicsStats.UniformUploads);
+    Drawing2D::DrawText(font, temp, Vector2(left, y + rowHeight * 2), DebugStatsColor, textScale);
+
+    GDK_SPRINTF(temp, 64, "Uploaded: %.1f KB", graphicsStats.BufferBytesUploaded / 1024.0f);
+    Drawing2D::DrawText(font, temp, Vector2(left, y + rowHeight * 3), DebugStatsColor, textScale);
+
+    // Draw the Drawing2D batch flushes of the last frame
+    const Drawing2DFrameReport& report = Drawing2D::GetFrameReport();
+    GDK_SPRINTF(temp, 64, "2D Flushes: %d  Verts: %d", report.NumFlushes, report.NumVertices);
+    Drawing2D::DrawText(font, temp, Vector2(left, y + rowHeight * 4), DebugStatsColor, textScale);
+
+    Drawing2D::Flush();
+}
+
 // *****************************************************************
 /// @brief
 ///     Initializes all 1st-tier GDK sub-systems.
@@ -143,6 +217,7 @@ bool Application::Platform_InitGdk()
 
 	// Init the GDK System 
 	Log::Init();
+    Profiler::Init();
 	Device::Init();
 	Mouse::Init();
 	Keyboard::Init();
@@ -163,6 +238,12 @@ bool Application::Platform_InitGdk()
 	initialAppSettings.FixedTimeStep = FixedTimeStep;
 	initialAppSettings.UseFixedTimeStep = IsUsingFixedTimeStep;
 	initialAppSettings.ResourceLoaderBackgroundThreads = 2;
+	initialAppSettings.AsyncIOThreads = 4;
+	initialAppSettings.DecodedAssetCacheSize = 0;
+	initialAppSettings.FrameStatsWindow = 300;
+	initialAppSettings.LogCrashHandlers = false;
+	initialAppSettings.InputRecordFile = "";
+	initialAppSettings.InputPlaybackFile = "";
 
 	// Load the application settings from the game
     Game* game = Game::GetSingleton();
@@ -176,10 +257,18 @@ bool Application::Platform_InitGdk()
 	IsUsingFixedTimeStep = initialAppSettings.UseFixedTimeStep;
 	FixedTimeStep = initialAppSettings.FixedTimeStep;
 
+	if(initialAppSettings.LogCrashHandlers)
+		Log::InstallCrashHandlers();
+
 	// Initialize the Resource & Asset managers
     AssetManager::Init();
+    AsyncIO::Init(initialAppSettings.AsyncIOThreads);
+    DecodedAssetCache::Init((Int64) initialAppSettings.DecodedAssetCacheSize * 1024 * 1024);
+    ResourceLoadStats::Init();
     ResourceManager::Init(initialAppSettings.ResourceLoaderBackgroundThreads);
 
+    FrameStats::Init(initialAppSettings.FrameStatsWindow);
+
 	// Setup the application states
 	exitRequest = false;
 	appIsActive = true;
@@ -201,11 +290,17 @@ void Application::Platform_ShutdownGdk()
 	// Destroy the game singleton
     Game::DestroySingleton();
 
+    FrameStats::Shutdown();
+
 	// Shutdown Resource & Asset Managers
     ResourceManager::Shutdown();
+    ResourceLoadStats::Shutdown();
+    DecodedAssetCache::Shutdown();
+    AsyncIO::Shutdown();
 	AssetManager::Shutdown();
     
     // Shutdown GDK Systems
+    Profiler::Shutdown();
 	Log::Shutdown();
 
 	// Shutdown GDK Memory
@@ -233,6 +328,12 @@ bool Application::Platform_InitGame()
 	if(Game::GetSingleton()->OnInit() == false)
 		return false;
 
+	// Start playing back or recording the input
+	if(initialAppSettings.InputPlaybackFile.empty() == false)
+		InputRecording::StartPlayback(initialAppSettings.InputPlaybackFile.c_str(), true);
+	else if(initialAppSettings.InputRecordFile.empty() == false)
+		InputRecording::StartRecording(initialAppSettings.InputRecordFile.c_str());
+
 	return true;
 }
 
@@ -253,6 +354,9 @@ void Application::Platform_ShutdownGame()
 	// Shutdown the game
 	Game::GetSingleton()->OnShutdown();
 
+	// Close any input recording or playback
+	InputRecording::Shutdown();
+
 	// Shutdown 2nd Tier GDK Systems
 	SharedResources::Shutdown();
 	Graphics::Shutdown();
@@ -281,6 +385,12 @@ void Application::Platform_MainLoop()
     }
     lastUpdateTime = currentTime;
 
+    // Record the frame, or play back the input & elapsed time of the recorded frame
+    InputRecording::Platform_BeginFrame(elapsedSeconds, secondsSinceLastUpdate);
+
+    // Close out the previous frame's stats
+    FrameStats::BeginFrame(currentTime);
+
 	// Are we using a fixed time step?
 	if(IsUsingFixedTimeStep)
 	{
@@ -71,6 +71,12 @@ namespace Gdk
         /// @{
         
 		int ResourceLoaderBackgroundThreads;      ///< Number of threads used by the background resource loading system.  (0 = disable background resource loading)
+		int AsyncIOThreads;                       ///< Number of threads used to service asynchronous reads.  (0 = do asynchronous reads on the calling thread)
+		int DecodedAssetCacheSize;                ///< Maximum size (in MB) of the on-disk cache of decoded assets.  (0 = disable the cache)
+		int FrameStatsWindow;                     ///< Number of frames the FrameStats are computed over
+		bool LogCrashHandlers;                    ///< Install handlers that write out the queued log messages if the process crashes.  (See Log::InstallCrashHandlers)
+		string InputRecordFile;                   ///< If set, the input is recorded to this file.  (See InputRecording)
+		string InputPlaybackFile;                 ///< If set, the input is played back from this file, and the application exits at the end of it.  (See InputRecording)
         
         /// @}
 	};
@@ -117,6 +123,9 @@ namespace Gdk
 
 		/// The current frames-per-second of the application
         static int CurrentFPS;                  
+
+		/// Statistics of each FramePhase, refreshed along with CurrentFPS
+        static FrameTimeStats CurrentFrameStats[FramePhase::Count];
         
         /// @}
 	
@@ -250,6 +259,8 @@ namespace Gdk
         static float fpsTimer;
         static int fpsCounter;
         
+        static void DrawDebugStats();
+        
         // Internal Methods
 		// ================================
         
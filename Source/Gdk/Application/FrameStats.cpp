@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "BasePCH.h"
+#include "FrameStats.h"
+
+using namespace Gdk;
+
+// Static Instantiations
+float FrameStats::SpikeThreshold = 1.0f / 30.0f;
+vector<FrameStats::FrameSample> FrameStats::samples;
+int FrameStats::nextSample = 0;
+int FrameStats::numSamples = 0;
+FrameStats::FrameSample FrameStats::currentFrame;
+double FrameStats::frameStartTime = 0.0;
+double FrameStats::presentStartTime = 0.0;
+
+// *****************************************************************
+const char* FramePhase::ToString(FramePhase::Enum phase)
+{
+	static const char* phaseNames[] =
+	{
+		"Update",
+		"Draw",
+		"Present",
+		"Frame",
+	};
+	return phaseNames[phase];
+}
+
+// *****************************************************************
+/// @brief
+///     Static Initializer for the FrameStats
+/// @param windowSize
+///     Number of frames to keep statistics over
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void FrameStats::Init(int windowSize)
+{
+    SetWindowSize(windowSize);
+}
+
+// *****************************************************************
+/// @brief
+///     Static Shutdown for the FrameStats
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void FrameStats::Shutdown()
+{
+    samples.clear();
+    nextSample = 0;
+    numSamples = 0;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the number of frames that statistics are kept over
+// *****************************************************************
+int FrameStats::GetWindowSize()
+{
+    return (int) samples.size();
+}
+
+// *****************************************************************
+/// @brief
+///     Sets the number of frames that statistics are kept over
+/// @remarks
+///     The frames that were already recorded are discarded.
+// *****************************************************************
+void FrameStats::SetWindowSize(int numFrames)
+{
+    ASSERT(numFrames > 0, "The FrameStats window must be at least 1 frame");
+
+    samples.resize(numFrames);
+    Reset();
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the number of frames currently recorded  (Up to the window size)
+// *****************************************************************
+int FrameStats::GetNumFrames()
+{
+    return numSamples;
+}
+
+// *****************************************************************
+/// @brief
+///     Discards all the recorded frames
+/// @remarks
+///     This is useful for skipping the frames spent loading, before measuring a scene.
+// *****************************************************************
+void FrameStats::Reset()
+{
+    nextSample = 0;
+    numSamples = 0;
+    memset(&currentFrame, 0, sizeof(currentFrame));
+    frameStartTime = 0.0;
+}
+
+// *****************************************************************
+/// @brief
+///     Computes the statistics of a phase, over the recorded frames
+/// @param phase
+///     The phase of the frame to get the statistics of
+/// @remarks
+///     The percentiles are of the nearest rank.  If no frames are recorded, all the statistics are 0.
+// *****************************************************************
+FrameTimeStats FrameStats::GetStats(FramePhase::Enum phase)
+{
+    FrameTimeStats stats;
+    memset(&stats, 0, sizeof(stats));
+    if(numSamples == 0)
+        return stats;
+
+    // Get the sorted times of the phase
+    vector<float> times(numSamples);
+    float total = 0.0f;
+    for(int i = 0; i < numSamples; i++)
+    {
+        float time = samples[i].Times[phase];
+        times[i] = time;
+        total += time;
+        if(time > SpikeThreshold)
+            stats.SpikeCount++;
+    }
+    sort(times.begin(), times.end());
+
+    stats.NumFrames = numSamples;
+    stats.Min = times.front();
+    stats.Max = times.back();
+    stats.Average = total / numSamples;
+    stats.P50 = times[((numSamples * 50) + 99) / 100 - 1];
+    stats.P95 = times[((numSamples * 95) + 99) / 100 - 1];
+    stats.P99 = times[((numSamples * 99) + 99) / 100 - 1];
+
+    return stats;
+}
+
+// *****************************************************************
+/// @brief
+///     Writes the statistics of every phase to the log
+/// @remarks
+///     The times are logged in milliseconds.  Automated performance runs can call this at the end
+///     of a run, and parse the results out of the log.
+// *****************************************************************
+void FrameStats::LogStats()
+{
+    LOG_INFO("Frame times over %d frames (ms):", numSamples);
+    for(int phase = 0; phase < FramePhase::Count; phase++)
+    {
+        FrameTimeStats stats = GetStats((FramePhase::Enum) phase);
+        LOG_INFO("  %-7s min %.2f  avg %.2f  p50 %.2f  p95 %.2f  p99 %.2f  max %.2f  spikes %d",
+            FramePhase::ToString((FramePhase::Enum) phase),
+            stats.Min * 1000.0f, stats.Average * 1000.0f, stats.P50 * 1000.0f,
+            stats.P95 * 1000.0f, stats.P99 * 1000.0f, stats.Max * 1000.0f,
+            stats.SpikeCount
+            );
+    }
+}
+
+// *****************************************************************
+/// @brief
+///     Ends the previous frame & starts a new one
+/// @param currentTime
+///     HighResTimer time at the start of the main loop
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void FrameStats::BeginFrame(double currentTime)
+{
+    // Record the previous frame
+    if(frameStartTime != 0.0 && samples.empty() == false)
+    {
+        currentFrame.Times[FramePhase::Frame] = (float)(currentTime - frameStartTime);
+
+        samples[nextSample] = currentFrame;
+        nextSample = (nextSample + 1) % (int) samples.size();
+        if(numSamples < (int) samples.size())
+            numSamples++;
+    }
+
+    memset(&currentFrame, 0, sizeof(currentFrame));
+    frameStartTime = currentTime;
+}
+
+// *****************************************************************
+/// @brief
+///     Adds time to a phase of the current frame
+/// @remarks
+///     With a fixed time step, there can be several updates in one frame, so the times are summed.
+///     GDK Internal Use Only
+// *****************************************************************
+void FrameStats::AddTime(FramePhase::Enum phase, double seconds)
+{
+    currentFrame.Times[phase] += (float) seconds;
+}
+
+// *****************************************************************
+/// @brief
+///     Tells the FrameStats that the platform is about to present the back buffer
+/// @note
+///     GDK Internal Use Only
+// *****************************************************************
+void FrameStats::Platform_BeginPresent()
+{
+    presentStartTime = HighResTimer::GetSeconds();
+}
+
+// *****************************************************************
+/// @brief
+///     Tells the FrameStats that the platform has presented the back buffer
+/// @note
+///     GDK Internal Use Only
+// *****************************************************************
+void FrameStats::Platform_EndPresent()
+{
+    AddTime(FramePhase::Present, HighResTimer::GetSeconds() - presentStartTime);
+}
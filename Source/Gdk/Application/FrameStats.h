@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+
+namespace Gdk
+{
+
+    /// @addtogroup Application
+    /// @{
+
+	// =================================================================================
+    /// @brief
+    ///     Enumeration of the parts of a frame that are timed by FrameStats
+	// =================================================================================
+	namespace FramePhase
+	{
+		enum Enum
+		{
+            /// The GDK pre-update tasks & Game::OnUpdate
+			Update,
+
+            /// Game::OnDraw & the debug stats overlay
+			Draw,
+
+            /// Presenting the back buffer  (Includes any wait for vsync)
+			Present,
+
+            /// The whole frame, from the start of one main loop to the start of the next
+            Frame,
+
+            /// Number of phases
+            Count
+		};
+
+		const char* ToString(FramePhase::Enum phase);
+	}
+
+    // =================================================================================
+    /// @brief
+    ///     Statistics of the frame times of one FramePhase, over the FrameStats window
+    /// @remarks
+    ///     All times are in seconds.
+    // =================================================================================
+    struct FrameTimeStats
+    {
+        float Min;
+        float Average;
+        float P50;
+        float P95;
+        float P99;
+        float Max;
+
+        /// Number of frames in the window that took longer than FrameStats::SpikeThreshold
+        int SpikeCount;
+
+        /// Number of frames the statistics were computed from
+        int NumFrames;
+    };
+
+    // =================================================================================
+    /// @brief
+    ///     Records the times of the most recent frames, & computes percentiles & spike counts from them.
+    /// @remarks
+    ///     The time of each frame is split into the update, draw & present phases, and a rolling
+    ///     window of frames is kept.  Averages hide the occasional long frame, so the percentiles
+    ///     (& the maximum) are the numbers to watch for hitches.
+    ///   @par
+    ///     The window size is set by ApplicationSettings::FrameStatsWindow, and can be changed with SetWindowSize().
+    ///     The statistics are shown by the debug stats overlay, and can be written to the log with LogStats().
+    // =================================================================================
+	class FrameStats
+	{
+	public:
+
+        // Public Properties
+		// =====================================================
+
+        /// Frames (or phases) that take longer than this many seconds are counted as spikes.  (Default = 1/30 sec)
+        static float SpikeThreshold;
+
+        // Public Methods
+		// =====================================================
+
+        // ---------------------------------
+        /// @name Statistics Methods
+        /// @{
+
+        static FrameTimeStats GetStats(FramePhase::Enum phase);
+        static void LogStats();
+        static void Reset();
+
+        /// @}
+
+        // ---------------------------------
+        /// @name Window Methods
+        /// @{
+
+        static int GetWindowSize();
+        static void SetWindowSize(int numFrames);
+        static int GetNumFrames();
+
+        /// @}
+
+		// INTERNAL ONLY - Platform Interfaces
+		// =====================================================
+
+        /// @cond INTERNAL
+
+        // ---------------------------------
+        /// @name Internal Platform Methods
+        /// @{
+
+        static void Platform_BeginPresent();
+        static void Platform_EndPresent();
+
+        /// @}
+
+        /// @endcond
+
+    private:
+
+        // Private Types
+		// =====================================================
+
+        // ***********************************************************************
+        struct FrameSample
+        {
+            float Times[FramePhase::Count];
+        };
+
+        // Private Methods
+		// =====================================================
+
+        friend class Application;
+
+        static void Init(int windowSize);
+        static void Shutdown();
+
+        static void BeginFrame(double currentTime);
+        static void AddTime(FramePhase::Enum phase, double seconds);
+
+        // Private Properties
+		// =====================================================
+
+        static vector<FrameSample> samples;     // Ring buffer of the frames in the window
+        static int nextSample;
+        static int numSamples;
+
+        static FrameSample currentFrame;
+        static double frameStartTime;
+        static double presentStartTime;
+	};
+
+    /// @}
+
+} // namespace Gdk
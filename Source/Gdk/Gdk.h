@@ -10,6 +10,7 @@
 
 // System
 #include "System/Logging.h"
+#include "System/LogFormat.h"
 #include "System/Assert.h"
 #include "System/Memory.h"
 #include "System/Delegates.h"
@@ -19,25 +20,33 @@
 #include "System/Containers/SortedVector.h"
 #include "System/Containers/StringHashMap.h"
 
+// System/Time
+#include "System/Time/HighResTimer.h"
+
+// System/Profiler  (Before ThreadedWorkQueue, which profiles its work items)
+#include "System/Profiler.h"
+
 // System/Threading
 #include "System/Threading/Thread.h"
+#include "System/Threading/LockStats.h"
 #include "System/Threading/CriticalSection.h"
 #include "System/Threading/Mutex.h"
 #include "System/Threading/Event.h"
 #include "System/Threading/ThreadedWorkQueue.h"
 
-// System/Time
-#include "System/Time/HighResTimer.h"
-
 // Application
 #include "Application/PlatformInterfaces.h"
+#include "Application/FrameStats.h"
 #include "Application/Application.h"
 #include "Application/Game.h"
 
 // IO
 #include "IO/Stream.h"
 #include "IO/FileStream.h"
+#include "IO/MappedFileStream.h"
 #include "IO/MemoryStream.h"
+#include "IO/BinaryReader.h"
+#include "IO/AsyncIO.h"
 #include "IO/File.h"
 #include "IO/Directory.h"
 #include "IO/Path.h"
@@ -45,9 +54,17 @@
 // Resource
 #include "Resource/AssetProvider.h"
 #include "Resource/FileAssetProvider.h"
+#include "Resource/PackAssetProvider.h"
 #include "Resource/AssetManager.h"
+#include "Resource/DecodedAssetCache.h"
+#include "Resource/ResourceLoadStats.h"
 #include "Resource/Resource.h"
 #include "Resource/ResourceManager.h"
+#include "Resource/AssetBundle.h"
+#include "Resource/AssetBundleManager.h"
+#include "Resource/AssetBundleWriter.h"
+#include "Resource/AssetConverter.h"
+#include "Resource/PackWriter.h"
 #include "Resource/ResourcePool.h"
 #include "Resource/SharedResources.h"
 
@@ -92,6 +109,7 @@
 #include "Input/Mouse.h"
 #include "Input/Touch.h"
 #include "Input/MotionInput.h"
+#include "Input/InputRecording.h"
 
 // Graphics
 #include "Graphics/Color.h"
@@ -99,6 +117,7 @@
 #include "Graphics/Graphics.h"
 #include "Graphics/VertexFormats.h"
 #include "Graphics/GeometryBuffer.h"
+#include "Graphics/GLCommandRecorder.h"
 
 // Graphics/Texture
 #include "Graphics/Texture/Texture2D.h"
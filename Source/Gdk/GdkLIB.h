@@ -16,8 +16,9 @@
 //   GDKPLATFORM_MACOSX		: Apple \ Mac OS X
 //   GDKPLATFORM_IOS		: Apple \ iOS
 //
+// GDKPLATFORM_LINUX		: Linux  (Headless)
+//
 // TODO:
-//	 GDKPLATFORM_LINUX		: Linux OS
 //   GDKPLATFORM_NACL		: Google NaCl
 //   GDKPLATFORM_ANDROID	: Android phones
 //
@@ -169,6 +170,41 @@
 
 #endif
 
+
+//----------------------------------------------------------------------------
+// Platform:  Linux  (Headless:  No window, rendering through an EGL surfaceless context)
+//----------------------------------------------------------------------------
+
+#if defined(__linux__) && !defined(__ANDROID__)
+
+	#define GDKPLATFORM_LINUX
+
+    // Platform Includes
+	#include <wchar.h>
+	#include <stdint.h>
+    #include <errno.h>
+    #include <pthread.h>
+    #include <unistd.h>
+
+    // Include OpenGL ES
+    #define GDK_OPENGL_ES
+    #include <GLES2/gl2.h>
+    #include <GLES2/gl2ext.h>
+
+    // Common Types
+    // ----------------
+
+    typedef int8_t		Int8;
+    typedef int16_t		Int16;
+    typedef int32_t		Int32;
+    typedef int64_t		Int64;
+    typedef uint8_t		UInt8;
+    typedef uint16_t	UInt16;
+    typedef uint32_t	UInt32;
+    typedef uint64_t	UInt64;
+
+#endif
+
 // ---------------------------------------------------------------------------
 // Common Types
 
@@ -223,12 +259,18 @@ using namespace std;
 	#define GDK_SPRINTF(buffer, bufferSize, format, ...)		sprintf_s(buffer, bufferSize, format, __VA_ARGS__ )
 	#define GDK_SSCANF(buffer, format, ...)						sscanf_s(buffer, format, __VA_ARGS__ )
 	#define GDK_VSPRINTF(buffer, bufferSize, format, valist)	vsprintf_s(buffer, bufferSize, format, valist)
+	#define GDK_VSNPRINTF(buffer, bufferSize, format, valist)	_vsnprintf_s(buffer, bufferSize, _TRUNCATE, format, valist)
+	#define GDK_SNPRINTF(buffer, bufferSize, format, ...)		_snprintf_s(buffer, bufferSize, _TRUNCATE, format, __VA_ARGS__ )
+	#define GDK_MEMORY_BARRIER()								MemoryBarrier()
 
 #else
 
 	#define GDK_SPRINTF(buffer, bufferSize, format, args...)	sprintf(buffer, format, ##args)
 	#define GDK_SSCANF(buffer, format, args...)					sscanf(buffer, format, ##args)
 	#define GDK_VSPRINTF(buffer, bufferSize, format, valist)	vsprintf(buffer, format, valist)
+	#define GDK_VSNPRINTF(buffer, bufferSize, format, valist)	vsnprintf(buffer, bufferSize, format, valist)
+	#define GDK_SNPRINTF(buffer, bufferSize, format, args...)	snprintf(buffer, bufferSize, format, ##args)
+	#define GDK_MEMORY_BARRIER()								__sync_synchronize()
 
 #endif
 
@@ -161,6 +161,19 @@ Atlas::~Atlas()
 	AnimationsByName.Clear();
 }
 
+// *****************************************************************
+/// @brief
+///     Gets the resources used by this atlas.  (The textures of its sheets)
+// *****************************************************************
+void Atlas::GetChildResources(vector<Resource*>& children)
+{
+	for(vector<AtlasSheet*>::iterator iter = this->Sheets.begin(); iter != this->Sheets.end(); iter++)
+	{
+		if((*iter)->Texture != NULL)
+			children.push_back((*iter)->Texture);
+	}
+}
+
 // *****************************************************************
 /// @brief
 ///     Gets the AtlasImage with the given name.
@@ -211,26 +224,27 @@ void Atlas::LoadFromAsset()
     char assetPath[256];
     GDK_SPRINTF(assetPath, 256, "%s.gdkatlas", GetName().c_str());
     Stream* stream = AssetManager::GetAssetStream(assetPath);
+    BinaryReader reader(stream);
 
 	// Load the sheets
 	//----------------------------
 
 	// Get the number of sheets
-	short numSheets = stream->ReadInt16();
+	short numSheets = reader.ReadInt16();
 	this->Sheets.reserve(numSheets);
 
 	// Get the atlas flags
-	UInt16 atlasFlags = stream->ReadUInt16();
+	UInt16 atlasFlags = reader.ReadUInt16();
     GDK_NOT_USED(atlasFlags);
 
 	// Load the sheets
 	for(int sheetIndex = 0; sheetIndex < numSheets; sheetIndex++)
 	{
 		// Load this sheet properties
-		short sheetWidth = stream->ReadInt16();
-		short sheetHeight = stream->ReadInt16();
+		short sheetWidth = reader.ReadInt16();
+		short sheetHeight = reader.ReadInt16();
 		
-        UInt8 sheetPixelFormat = stream->ReadUInt8();
+        UInt8 sheetPixelFormat = reader.ReadUInt8();
         GDK_NOT_USED(sheetPixelFormat);
         
 		// Create the sheet
@@ -253,7 +267,7 @@ void Atlas::LoadFromAsset()
 	// -------------------------------
 
 	// Get the number of images
-	short numImages = stream->ReadInt16();
+	short numImages = reader.ReadInt16();
 	this->Images.reserve(numImages);
 
 	// Loop through the images
@@ -264,42 +278,42 @@ void Atlas::LoadFromAsset()
 		image->Index = imageIndex;
 
 		// Get the image name
-		image->Name = stream->ReadString();
+		image->Name = reader.ReadString();
 
 		// Get the image's associated sheet
-		short sheetIndex = stream->ReadInt16();
+		short sheetIndex = reader.ReadInt16();
 		image->Sheet = this->Sheets[sheetIndex];
 
 		// Get the size of the image
-		image->Width = stream->ReadInt16();
-		image->Height = stream->ReadInt16();
+		image->Width = reader.ReadInt16();
+		image->Height = reader.ReadInt16();
 
 		// Get the size & position of the cropped image as it is embedded in the sheet
-		image->CroppedImageWidth = stream->ReadInt16();
-		image->CroppedImageHeight = stream->ReadInt16();
-		image->CroppedImageX = stream->ReadInt16();
-		image->CroppedImageY = stream->ReadInt16();
+		image->CroppedImageWidth = reader.ReadInt16();
+		image->CroppedImageHeight = reader.ReadInt16();
+		image->CroppedImageX = reader.ReadInt16();
+		image->CroppedImageY = reader.ReadInt16();
 
 		// Get the Texture coordinates of the cropped image within the sheet texture
-		image->TopLeftTexCoord.X = stream->ReadFloat();
-		image->TopLeftTexCoord.Y = stream->ReadFloat();
-		image->BottomRightTexCoord.X = stream->ReadFloat();
-		image->BottomRightTexCoord.Y = stream->ReadFloat();
+		image->TopLeftTexCoord.X = reader.ReadFloat();
+		image->TopLeftTexCoord.Y = reader.ReadFloat();
+		image->BottomRightTexCoord.X = reader.ReadFloat();
+		image->BottomRightTexCoord.Y = reader.ReadFloat();
 		
 		// Get the reference point of the image
-		image->ReferencePoint.X = stream->ReadFloat();
-		image->ReferencePoint.Y = stream->ReadFloat();
+		image->ReferencePoint.X = reader.ReadFloat();
+		image->ReferencePoint.Y = reader.ReadFloat();
 
 		// Get the number of child points for this image
-		short numChildPoints = stream->ReadInt16();
+		short numChildPoints = reader.ReadInt16();
 		image->ChildPoints.reserve(numChildPoints);
 
 		// Load the child points
 		for(short childPointIndex = 0; childPointIndex < numChildPoints; childPointIndex++)
 		{
 			Vector2 childPoint;
-			childPoint.X = stream->ReadFloat();
-			childPoint.Y = stream->ReadFloat();
+			childPoint.X = reader.ReadFloat();
+			childPoint.Y = reader.ReadFloat();
 			image->ChildPoints.push_back(childPoint);
 		}
 
@@ -312,7 +326,7 @@ void Atlas::LoadFromAsset()
 	// -------------------------------
 
 	// Get the number of animations
-	short numAnimations = stream->ReadInt16();
+	short numAnimations = reader.ReadInt16();
 	this->Animations.reserve(numAnimations);
 
 	// Loop through the animations
@@ -322,19 +336,19 @@ void Atlas::LoadFromAsset()
 		AtlasAnimation *animation = GdkNew AtlasAnimation();
 
 		// Get the animation name
-		animation->Name = stream->ReadString();
+		animation->Name = reader.ReadString();
 
 		// Get the FPS
-		animation->FPS = stream->ReadFloat();
+		animation->FPS = reader.ReadFloat();
 
 		// Get the number of animation frames
-		short numFrames = stream->ReadInt16();
+		short numFrames = reader.ReadInt16();
 		animation->Images.reserve(numFrames);
 
 		// Load the frames
 		for(short frameIndex = 0; frameIndex < numFrames; frameIndex++)
 		{
-			short animImageIndex = stream->ReadInt16();
+			short animImageIndex = reader.ReadInt16();
 			animation->Images.push_back( this->Images[animImageIndex] );
 		}
 
@@ -342,5 +356,10 @@ void Atlas::LoadFromAsset()
 		this->Animations.push_back(animation);
 		this->AnimationsByName.Add(animation->Name.c_str(), animation);
 	}
+
+	// Close the asset stream
+	reader.Close();
+	stream->Close();
+	GdkDelete( stream );
 }
 
@@ -53,6 +53,17 @@ Resource* AtlasManager::OnCreateNewResourceInstance()
     return new Atlas();
 }
 
+// *****************************************************************
+/// @brief
+///     Gets the name of the Atlas resource type, for the ResourceLoadStats
+/// @remarks
+///     GDK Internal use only
+// *****************************************************************
+const char* AtlasManager::GetResourceTypeName()
+{
+    return "Atlas";
+}
+
 // *****************************************************************
 void AtlasManager::PerformLoadFromAsset(Resource* resource)
 {
@@ -61,5 +72,8 @@ void AtlasManager::PerformLoadFromAsset(Resource* resource)
     
     // Load the atlas from it's corresponding asset
     atlas->LoadFromAsset();
+    
+    // The resource is now ready for use
+    atlas->State = ResourceState::Ready;
 }
 
@@ -98,6 +98,15 @@ BMFont::~BMFont()
 	}
 }
 
+// *****************************************************************
+/// @brief
+///     Gets the resources used by this font.  (The textures of its pages)
+// *****************************************************************
+void BMFont::GetChildResources(vector<Resource*>& children)
+{
+	children.insert(children.end(), this->pages.begin(), this->pages.end());
+}
+
 // *****************************************************************
 /// @brief
 ///     Gets the size of the given string in pixel coordinates.
@@ -173,6 +182,7 @@ void BMFont::LoadFromAsset()
     char assetPath[256];
     GDK_SPRINTF(assetPath, 256, "%s.gdkfont", GetName().c_str());
     Stream* stream = AssetManager::GetAssetStream(assetPath);
+    BinaryReader reader(stream);
     
 	// Read & parse the font file
 	//----------------------------
@@ -181,21 +191,21 @@ void BMFont::LoadFromAsset()
 
 	// Skip the first 4 bytes (first 3 = "BMF", last one = Version)
 	char bmid[4];
-	stream->Read(bmid, 4);
+	reader.Read(bmid, 4);
 
 	// While not at the end of the stream
-	while(stream->AtEnd() == false)
+	while(reader.AtEnd() == false)
 	{
 		// Read the next block type & size
-		char blockType = stream->ReadInt8();
-		int blockSize = stream->ReadInt32();
+		char blockType = reader.ReadInt8();
+		int blockSize = reader.ReadInt32();
 
 		// Process the block type
 		if(blockType == 2) // Common
 		{
 			// Read in the common block
 			BMFFcommon *commonBlock = (BMFFcommon*)GdkAlloc(blockSize);
-			stream->Read(commonBlock, blockSize);
+			reader.Read(commonBlock, blockSize);
 
 			// Set the font properties
 			this->lineHeight = commonBlock->LineHeight;
@@ -212,7 +222,7 @@ void BMFont::LoadFromAsset()
 		{
 			// Read in the pages block
 			char *pages = (char*)GdkAlloc(blockSize);
-			stream->Read(pages, blockSize);
+			reader.Read(pages, blockSize);
 
 			// Parse out the page names
 			short nameLen = blockSize / numPages;
@@ -241,7 +251,7 @@ void BMFont::LoadFromAsset()
 			// Read in the char block(s)
 			int numChars = blockSize / sizeof(BMFFchar);
 			BMFFchar *charBlock = (BMFFchar*)GdkAlloc(blockSize);
-			stream->Read(charBlock, blockSize);
+			reader.Read(charBlock, blockSize);
 
 			// Processes the chars
 			for(int i=0; i<numChars; i++)
@@ -276,7 +286,12 @@ void BMFont::LoadFromAsset()
 		else
 		{
 			// Skip any other block
-			stream->Seek(blockSize, SeekOrigin::Current);
+			reader.Seek(blockSize, SeekOrigin::Current);
 		}
 	}
+
+	// Close the asset stream
+	reader.Close();
+	stream->Close();
+	GdkDelete( stream );
 }
\ No newline at end of file
@@ -105,6 +105,8 @@ namespace Gdk
         /// @name Virtuals from Resouce
         /// @{
         
+        virtual void GetChildResources(vector<Resource*>& children);
+        
         /// @} 
         
 	private:
@@ -53,6 +53,17 @@ Resource* BMFontManager::OnCreateNewResourceInstance()
     return new BMFont();
 }
 
+// *****************************************************************
+/// @brief
+///     Gets the name of the BMFont resource type, for the ResourceLoadStats
+/// @remarks
+///     GDK Internal use only
+// *****************************************************************
+const char* BMFontManager::GetResourceTypeName()
+{
+    return "BMFont";
+}
+
 // *****************************************************************
 void BMFontManager::PerformLoadFromAsset(Resource* resource)
 {
@@ -61,4 +72,7 @@ void BMFontManager::PerformLoadFromAsset(Resource* resource)
     
     // Load the BMFont from it's corresponding asset
     bmFont->LoadFromAsset();
+    
+    // The resource is now ready for use
+    bmFont->State = ResourceState::Ready;
 }
\ No newline at end of file
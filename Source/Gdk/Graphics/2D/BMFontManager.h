@@ -40,6 +40,7 @@ namespace Gdk
         /// @{
         
         virtual Resource* OnCreateNewResourceInstance();
+        virtual const char* GetResourceTypeName();
         
         /// @}
         
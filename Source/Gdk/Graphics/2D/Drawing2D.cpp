@@ -17,6 +17,25 @@ Shader* Drawing2D::nonTexturedShader = NULL;
 
 Matrix2D Drawing2D::WorldTransform = Matrix2D::IDENTITY;
 
+bool Drawing2D::ShowFlushes = false;
+Drawing2DFrameReport Drawing2D::currentFrameReport;
+Drawing2DFrameReport Drawing2D::lastFrameReport;
+
+// *****************************************************************
+const char* Drawing2DFlushReason::ToString(Drawing2DFlushReason::Enum reason)
+{
+	static const char* reasonNames[] =
+	{
+		"Explicit",
+		"TextureChange",
+		"BlendModeChange",
+		"VertexFormatChange",
+		"PrimitiveTypeChange",
+		"ParticleSystem",
+	};
+	return reasonNames[reason];
+}
+
 // *****************************************************************
 /// @brief
 ///     Initializes the static Drawing2D class
@@ -142,8 +161,15 @@ Drawing2DBatch*  Drawing2D::GetBatch(
         return batch;
     }
     
-    // Flush the current batch
-    Flush();
+    // Flush the current batch, noting which state broke it
+    Drawing2DFlushReason::Enum reason = Drawing2DFlushReason::PrimitiveTypeChange;
+    if(textureID1 != batch->TextureID1 || textureID2 != batch->TextureID2)
+        reason = Drawing2DFlushReason::TextureChange;
+    else if(blendMode != batch->BlendMode)
+        reason = Drawing2DFlushReason::BlendModeChange;
+    else if(vertexFormat != batch->VertexFormat)
+        reason = Drawing2DFlushReason::VertexFormatChange;
+    Flush(reason);
     
     // Setup the batch for the new render state
     batch->TextureID1 = textureID1;
@@ -161,11 +187,15 @@ Drawing2DBatch*  Drawing2D::GetBatch(
 // *****************************************************************
 /// @brief
 ///     Flushes any geometry & render data in the current batch.
+/// @param reason
+///     Why the batch is being flushed.  This is only used by the flush diagnostics.
 /// @remarks
 ///     Make sure to call this method when you are finished doing any Draw calls
 // *****************************************************************
-void Drawing2D::Flush()
+void Drawing2D::Flush(Drawing2DFlushReason::Enum reason)
 {
+    GDK_PROFILE_SCOPE("Drawing2D::Flush");
+
     // Bail early if there is no geometry to render
     if(batch->Geometry->GetVertexCount() == 0)
         return;
@@ -193,12 +223,137 @@ void Drawing2D::Flush()
     // Apply the shader
     shader->Apply();
     
+    // Record the flush
+    Drawing2DFlushRecord record;
+    record.Reason = reason;
+    record.NumVertices = batch->Geometry->GetVertexCount();
+    record.NumIndices = batch->Geometry->GetIndexCount();
+    currentFrameReport.Flushes.push_back(record);
+    currentFrameReport.NumFlushes++;
+    currentFrameReport.NumVertices += record.NumVertices;
+    currentFrameReport.FlushesByReason[reason]++;
+
     // Draw the geometry
     batch->Geometry->Bind();
     batch->Geometry->Draw();
+
+    if(ShowFlushes == true)
+        DrawFlushOutline(reason);
+
     batch->Geometry->Clear();
 }
 
+// *****************************************************************
+/// @brief
+///     Outlines the bounds of the batch that was just drawn, in the color of the flush reason
+/// @remarks
+///     The outline is drawn with the batch's geometry buffer, which is then setup for the batch again.
+///     GDK Internal Use Only
+// *****************************************************************
+void Drawing2D::DrawFlushOutline(Drawing2DFlushReason::Enum reason)
+{
+	static const Color reasonColors[] =
+	{
+		Color(255, 255, 255, 255),      // Explicit
+		Color(255, 0, 0, 255),          // TextureChange
+		Color(255, 255, 0, 255),        // BlendModeChange
+		Color(0, 255, 255, 255),        // VertexFormatChange
+		Color(255, 0, 255, 255),        // PrimitiveTypeChange
+		Color(0, 255, 0, 255),          // ParticleSystem
+	};
+
+    // Get the bounds of the batch  (Every Drawing2D vertex format starts with a 2D position)
+    GeometryBuffer* geometry = batch->Geometry;
+    size_t stride = VertexFormat::GetStride(batch->VertexFormat);
+    const UInt8* vertex = (const UInt8*) geometry->GetVertexDataPtr();
+    int numVertices = geometry->GetVertexCount();
+
+    const GLfloat* position = (const GLfloat*) vertex;
+    float minX = position[0], maxX = position[0];
+    float minY = position[1], maxY = position[1];
+    for(int i = 1; i < numVertices; i++)
+    {
+        vertex += stride;
+        position = (const GLfloat*) vertex;
+        minX = position[0] < minX ? position[0] : minX;
+        maxX = position[0] > maxX ? position[0] : maxX;
+        minY = position[1] < minY ? position[1] : minY;
+        maxY = position[1] > maxY ? position[1] : maxY;
+    }
+
+    // Draw the outline as 4 lines
+    const Color& color = reasonColors[reason];
+    geometry->Clear();
+    geometry->Setup(VertexP2C4::Format, PrimitiveTypes::Lines);
+    geometry->AddVertex(VertexP2C4(minX, minY, color.R, color.G, color.B, color.A));
+    geometry->AddVertex(VertexP2C4(maxX, minY, color.R, color.G, color.B, color.A));
+    geometry->AddVertex(VertexP2C4(maxX, minY, color.R, color.G, color.B, color.A));
+    geometry->AddVertex(VertexP2C4(maxX, maxY, color.R, color.G, color.B, color.A));
+    geometry->AddVertex(VertexP2C4(maxX, maxY, color.R, color.G, color.B, color.A));
+    geometry->AddVertex(VertexP2C4(minX, maxY, color.R, color.G, color.B, color.A));
+    geometry->AddVertex(VertexP2C4(minX, maxY, color.R, color.G, color.B, color.A));
+    geometry->AddVertex(VertexP2C4(minX, minY, color.R, color.G, color.B, color.A));
+
+    Graphics::SetBlendMode(BlendMode::Normal);
+    nonTexturedShader->Apply();
+    geometry->Bind();
+    geometry->Draw();
+
+    // Setup the geometry for the batch again
+    geometry->Setup(batch->VertexFormat, batch->PrimitiveType);
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the report of the batch flushes done in the last complete frame
+// *****************************************************************
+const Drawing2DFrameReport& Drawing2D::GetFrameReport()
+{
+    return lastFrameReport;
+}
+
+// *****************************************************************
+/// @brief
+///     Writes the report of the last complete frame's batch flushes to the log
+// *****************************************************************
+void Drawing2D::LogFrameReport()
+{
+    const Drawing2DFrameReport& report = lastFrameReport;
+    LOG_INFO("Drawing2D: %d flushes, %d vertices", report.NumFlushes, report.NumVertices);
+
+    for(int reason = 0; reason < Drawing2DFlushReason::Count; reason++)
+    {
+        if(report.FlushesByReason[reason] > 0)
+            LOG_INFO("  %-20s %d", Drawing2DFlushReason::ToString((Drawing2DFlushReason::Enum) reason), report.FlushesByReason[reason]);
+    }
+
+    for(size_t i = 0; i < report.Flushes.size(); i++)
+    {
+        const Drawing2DFlushRecord& record = report.Flushes[i];
+        LOG_INFO("  #%-4d %-20s %6d vertices %6d indices", (int) i, Drawing2DFlushReason::ToString(record.Reason), record.NumVertices, record.NumIndices);
+    }
+}
+
+// *****************************************************************
+/// @brief
+///     Ends the report of the current frame & starts a new one
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void Drawing2D::BeginFrame()
+{
+    // Swap the reports, so the flush records keep their memory
+    lastFrameReport.Flushes.swap(currentFrameReport.Flushes);
+    lastFrameReport.NumFlushes = currentFrameReport.NumFlushes;
+    lastFrameReport.NumVertices = currentFrameReport.NumVertices;
+    memcpy(lastFrameReport.FlushesByReason, currentFrameReport.FlushesByReason, sizeof(lastFrameReport.FlushesByReason));
+
+    currentFrameReport.Flushes.clear();
+    currentFrameReport.NumFlushes = 0;
+    currentFrameReport.NumVertices = 0;
+    memset(currentFrameReport.FlushesByReason, 0, sizeof(currentFrameReport.FlushesByReason));
+}
+
 // #######################################################################################################################
 //
 // 2D Primitive Rendering
@@ -13,6 +13,74 @@ namespace Gdk
     /// @addtogroup _2D
     /// @{ 
     
+	// =================================================================================
+    /// @brief
+    ///     Enumeration of the reasons Drawing2D flushes its batch
+	// =================================================================================
+	namespace Drawing2DFlushReason
+	{
+		enum Enum
+		{
+            /// Drawing2D::Flush() was called directly
+			Explicit,
+
+            /// A draw used a different texture than the batch
+			TextureChange,
+
+            /// A draw used a different blend mode than the batch
+			BlendModeChange,
+
+            /// A draw used a different vertex format than the batch
+			VertexFormatChange,
+
+            /// A draw used a different primitive type than the batch
+			PrimitiveTypeChange,
+
+            /// A ParticleSystem2D flushed around its own batch
+            ParticleSystem,
+
+            /// Number of reasons
+            Count
+		};
+
+		const char* ToString(Drawing2DFlushReason::Enum reason);
+	}
+
+    // =================================================================================
+    ///	@brief
+    ///		Details of a single flush of the Drawing2D batch
+    // =================================================================================
+    struct Drawing2DFlushRecord
+    {
+        Drawing2DFlushReason::Enum Reason;
+        int NumVertices;
+        int NumIndices;
+    };
+
+    // =================================================================================
+    ///	@brief
+    ///		Report of the Drawing2D batch flushes done in a single frame
+    ///	@remarks
+    ///		Each flush is a separate draw call, so a frame with many flushes for small numbers of vertices
+    ///     is one where batching is breaking down.  The reasons show which state change is the cause.
+    ///	@see
+    ///		Drawing2D::GetFrameReport
+    // =================================================================================
+    struct Drawing2DFrameReport
+    {
+        /// Number of flushes that drew geometry  (Flushing an empty batch is not counted)
+        int NumFlushes;
+
+        /// Number of vertices drawn by all the flushes
+        int NumVertices;
+
+        /// Number of flushes for each Drawing2DFlushReason
+        int FlushesByReason[Drawing2DFlushReason::Count];
+
+        /// Every flush of the frame, in order
+        vector<Drawing2DFlushRecord> Flushes;
+    };
+
     // =================================================================================
     ///	@brief
     ///		Contains a batch of geometry to be rendered with specific render state settings.
@@ -85,8 +153,19 @@ namespace Gdk
                                         PrimitiveTypes::Enum primitiveType
                                         );
         
-        static void Flush();
+        static void Flush(Drawing2DFlushReason::Enum reason = Drawing2DFlushReason::Explicit);
         
+        /// @}
+        // ---------------------------------
+        /// @name Batch Diagnostics
+        /// @{
+
+        /// If true, each flushed batch is outlined in a color for the reason it was flushed.  (Default = false)
+        static bool ShowFlushes;
+
+        static const Drawing2DFrameReport& GetFrameReport();
+        static void LogFrameReport();
+
         /// @}
         // ---------------------------------
         /// @name Basic 2D Primitives
@@ -270,14 +349,21 @@ namespace Gdk
 		static Drawing2DBatch* batch;
         static Shader* texturedShader;
         static Shader* nonTexturedShader;
+
+        // Flush diagnostics
+        static Drawing2DFrameReport currentFrameReport;
+        static Drawing2DFrameReport lastFrameReport;
 		
 		// Hidden CTor
 		Drawing2D() {}
         
-		// Init & Shutdown from the Graphics class
+		// Init, Shutdown & BeginFrame from the Graphics class
 		friend class Graphics;
 		static void Init();
 		static void Shutdown();
+        static void BeginFrame();
+
+        static void DrawFlushOutline(Drawing2DFlushReason::Enum reason);
 
 	};
     
@@ -293,7 +293,7 @@ void ParticleSystem2D::Draw()
         return; // no particles to render, so bail
     
     // Flush the current drawing data
-    Drawing2D::Flush();
+    Drawing2D::Flush(Drawing2DFlushReason::ParticleSystem);
     
 	// Set the shader used for rendering this particle system
     if(this->Shader == NULL)
@@ -352,7 +352,7 @@ void ParticleSystem2D::Draw()
     }
     
     // Flush the drawing data
-    Drawing2D::Flush();
+    Drawing2D::Flush(Drawing2DFlushReason::ParticleSystem);
     
     // Disable the custom shader
     Drawing2D::SetTexturedShader(NULL);
@@ -14,7 +14,7 @@ using namespace Gdk;
 #define BILLBOARD_MAX_QUADS 1024
 
 #define CHECK_BUFFER_SPACE(dataSize)  \
-	unsigned int numBytes = (unsigned int)endOfTheBuffer - (unsigned int)batchBuffer; \
+	unsigned int numBytes = (unsigned int)((UInt8*)endOfTheBuffer - (UInt8*)batchBuffer); \
 	if(numBytes + dataSize > (unsigned int)bufferSize) { Flush(); }
 
 
@@ -49,7 +49,7 @@ inline void AddBillboardVertex(
 	vertex->FacingZ = facingZ;
 	vertex->FacingType = facingType;
 
-	buffer = (void*)((unsigned int)buffer + sizeof(BillboardVertex));
+	buffer = (void*)((UInt8*)buffer + sizeof(BillboardVertex));
 }
 
 // #######################################################################################################
@@ -143,6 +143,10 @@ void BillboardRenderer::Flush()
 
 		// Use the index buffer to draw the quads
 		glDrawElements(GL_TRIANGLES, batch->NumPrimitives * 6, GL_UNSIGNED_SHORT, SharedResources::QuadIndexBuffer);
+
+		// The vertices are in client memory, so the driver copies them for every draw
+		Graphics::CountDrawCall(0, batch->NumPrimitives * 6);
+		Graphics::CountBufferUpload(batch->NumPrimitives * 4 * stride);
 	}
 
 	Graphics::EnableDepthWrite(true);
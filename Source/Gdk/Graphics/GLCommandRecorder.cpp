@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "BasePCH.h"
+#include "GLCommandRecorder.h"
+
+using namespace Gdk;
+
+// Static Instantiations
+GLCommandStats GLCommandRecorder::stats;
+FileStream* GLCommandRecorder::captureFile = NULL;
+
+// *****************************************************************
+/// @brief
+///     Returns true if the GDK was built with the null graphics device  (GDK_NULL_GRAPHICS)
+// *****************************************************************
+bool GLCommandRecorder::IsNullDevice()
+{
+#ifdef GDK_NULL_GRAPHICS
+    return true;
+#else
+    return false;
+#endif
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the counts of the commands received since the last ResetStats()
+/// @remarks
+///     The counts are always 0 when IsNullDevice() is false.
+// *****************************************************************
+const GLCommandStats& GLCommandRecorder::GetStats()
+{
+    return stats;
+}
+
+// *****************************************************************
+/// @brief
+///     Zeroes the command counts
+// *****************************************************************
+void GLCommandRecorder::ResetStats()
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+// *****************************************************************
+/// @brief
+///     Starts writing the commands to a text file
+/// @param filePath
+///     Path of the capture file.  An existing file is replaced.
+/// @remarks
+///     Without the null graphics device there are no commands to capture, and the file will only have the header.
+/// @return
+///     false if the file couldn't be created.
+// *****************************************************************
+bool GLCommandRecorder::StartCapture(const char* filePath)
+{
+    StopCapture();
+
+    captureFile = File::Open(filePath, FileMode::WriteBehind);
+    if(captureFile == NULL)
+    {
+        LOG_WARN("Unable to create the GL command capture: %s", filePath);
+        return false;
+    }
+
+    const char* header = "# GDK GL command capture.  One command per line:  [bytes=size hash=FastHash] summarizes the data sent with it\n";
+    captureFile->Write((void*) header, strlen(header));
+    return true;
+}
+
+// *****************************************************************
+/// @brief
+///     Stops the current capture, and closes the capture file
+// *****************************************************************
+void GLCommandRecorder::StopCapture()
+{
+    if(captureFile == NULL)
+        return;
+
+    captureFile->Close();
+    GdkDelete(captureFile);
+    captureFile = NULL;
+}
+
+// *****************************************************************
+/// @brief
+///     Writes a command to the capture file
+/// @param data
+///     Data sent to GL with the command, or NULL if there is none
+/// @param dataSize
+///     Size of the data, in bytes
+/// @param format
+///     printf() style format of the command & its arguments
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void GLCommandRecorder::Platform_Capture(const void* data, size_t dataSize, const char* format, ...)
+{
+    if(captureFile == NULL)
+        return;
+
+    char line[512];
+
+    // Format the command
+    va_list args;
+    va_start(args, format);
+    int length = GDK_VSNPRINTF(line, sizeof(line) - 64, format, args);
+    va_end(args);
+    if(length < 0 || length >= (int)sizeof(line) - 64)
+        length = (int)strlen(line);
+
+    // Summarize the data, rather than writing it all out
+    if(data != NULL && dataSize > 0)
+    {
+        unsigned int hash = StringUtilities::FastHash((const UInt8*) data, (int) dataSize);
+        length += GDK_SNPRINTF(line + length, sizeof(line) - length, "  [bytes=%u hash=%08x]", (unsigned int) dataSize, hash);
+    }
+
+    line[length++] = '\n';
+    captureFile->Write(line, length);
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+
+
+namespace Gdk
+{
+	/// @addtogroup Graphics
+    /// @{
+
+    // =================================================================================
+    ///	@brief
+    ///		Counters of the GL commands received by the null graphics device
+    ///	@see
+    ///		GLCommandRecorder::GetStats
+    // =================================================================================
+    struct GLCommandStats
+    {
+        int Commands;                   ///< GL calls made
+        int DrawCalls;                  ///< glDrawArrays & glDrawElements calls
+        Int64 Bytes;                    ///< Total of the byte counts below
+        Int64 BufferBytes;              ///< Bytes sent with glBufferData & glBufferSubData
+        Int64 TextureBytes;             ///< Bytes sent with glTexImage2D
+        Int64 UniformBytes;             ///< Bytes of uniform values sent with glUniform*
+        Int64 ClientArrayBytes;         ///< Bytes of client memory vertex & index arrays, read by the draw calls
+    };
+
+    // =================================================================================
+    ///	@brief
+    ///		Counts & captures the GL commands sent to the null graphics device.
+    ///	@remarks
+    ///		When the GDK is built with GDK_NULL_GRAPHICS, the OpenGL ES 2.0 entry points the GDK uses are implemented
+    ///     by the GDK itself, in NullGL.cpp.  They don't talk to a driver:  Each call is counted here, along with the bytes
+    ///     of data it passes to GL.  So the CPU cost of the renderers can be measured on a machine without a GPU, and the
+    ///     counts themselves checked for regressions.  (They're deterministic, unlike timings)
+    ///   @par
+    ///     A capture writes every command to a text file, one per line, with its arguments.  Any data passed with the
+    ///     command is summarized by its size & a hash, so two captures of the same scene can be diffed to see exactly how
+    ///     the command streams differ.
+    ///   @par
+    ///     In a normal build the real GL driver is used, IsNullDevice() returns false, and there is nothing to record.
+    // =================================================================================
+	class GLCommandRecorder
+	{
+	public:
+
+        // Public Methods
+		// =====================================================
+
+        // ---------------------------------
+        /// @name Statistics Methods
+        /// @{
+
+        static bool IsNullDevice();
+        static const GLCommandStats& GetStats();
+        static void ResetStats();
+
+        /// @}
+
+        // ---------------------------------
+        /// @name Capture Methods
+        /// @{
+
+        static bool StartCapture(const char* filePath);
+        static void StopCapture();
+
+        /// @brief
+        ///     Gets if the command stream is being captured to a file
+        static bool IsCapturing()       { return captureFile != NULL; }
+
+        /// @}
+
+    public:
+
+        // INTERNAL ONLY - Platform Interfaces
+		// =====================================================
+
+        /// @cond INTERNAL
+
+        // ---------------------------------
+        /// @name Internal Platform Methods
+        /// @{
+
+        // Called by the null GL entry points, for every command
+        static GLCommandStats& Platform_GetStats()      { return stats; }
+        static void Platform_Capture(const void* data, size_t dataSize, const char* format, ...);
+
+        /// @}
+
+        /// @endcond
+
+	private:
+
+		// Private Properties
+		// =====================================================
+
+        static GLCommandStats stats;
+        static FileStream* captureFile;
+	};
+
+    /// @} // Graphics
+
+} // namespace Gdk
@@ -293,6 +293,7 @@ void GeometryBuffer::Bind()
             // Copy the vertex data to the GPU VBO
             size_t vertexDataSize = numVertices * vertexStride;
             glBufferSubData(GL_ARRAY_BUFFER, 0, vertexDataSize, vertexBuffer);
+            Graphics::CountBufferUpload(vertexDataSize);
         }
         
         // Do we have any indices?
@@ -300,6 +301,7 @@ void GeometryBuffer::Bind()
         {
             // Copy the index data to the GPU IBO
             glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, numIndices * 2, indexBuffer);
+            Graphics::CountBufferUpload(numIndices * 2);
         }
         
         bufferDataIsUpToDate = true;
@@ -430,5 +432,8 @@ void GeometryBuffer::Draw()
             break;
         
     }
+
+    bool indexed = currentPrimitiveType == PrimitiveTypes::IndexedLines || currentPrimitiveType == PrimitiveTypes::IndexedTriangles;
+    Graphics::CountDrawCall(indexed ? 0 : numVertices, indexed ? numIndices : 0);
 }
 
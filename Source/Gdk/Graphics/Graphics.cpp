@@ -70,6 +70,11 @@ bool Graphics::currentEnabledVertexAttributes[];
 GLuint Graphics::currentVertexBufferId = 0;
 GLuint Graphics::currentIndexBufferId = 0;
 
+// Frame Stats
+GraphicsFrameStats Graphics::currentFrameStats;
+GraphicsFrameStats Graphics::lastFrameStats;
+pthread_t Graphics::renderThread;
+
 // Global Shader Parameters
 SharedUniformValueSet Graphics::GlobalUniformsSet;
 Graphics::_GlobalUniforms Graphics::GlobalUniforms;
@@ -82,6 +87,9 @@ Graphics::_GlobalUniforms Graphics::GlobalUniforms;
 // *****************************************************************
 void Graphics::Init()
 {
+    // The frame stats are only counted on this thread
+    renderThread = pthread_self();
+
 	// Setup the initial render states
 	// -------------------------------
 
@@ -235,6 +243,11 @@ void Graphics::Shutdown()
 // *****************************************************************
 void Graphics::Update(float elapsedSeconds)
 {
+    // Start counting a new frame
+    lastFrameStats = currentFrameStats;
+    memset(&currentFrameStats, 0, sizeof(currentFrameStats));
+    Drawing2D::BeginFrame();
+
     // Bind the OS frame buffer
     glBindFramebuffer(GL_FRAMEBUFFER, osFrameBufferId);
 
@@ -242,6 +255,19 @@ void Graphics::Update(float elapsedSeconds)
     glViewport(0, 0, Application::GetWidth(), Application::GetHeight());
 }
 
+// *****************************************************************
+/// @brief
+///     Gets the counters of the graphics work done in the last complete frame
+/// @remarks
+///     The counters are reset at the start of each update, so these are the counts from the previous
+///     update & draw.  They are useful for finding where batching is breaking down, as every draw call,
+///     state change & upload is counted.
+// *****************************************************************
+const GraphicsFrameStats& Graphics::GetFrameStats()
+{
+    return lastFrameStats;
+}
+
 // *****************************************************************
 /// @brief
 ///     Tells the GDK graphics system about the OS supplied frame buffer & render buffers
@@ -506,13 +532,13 @@ Vector2 Graphics::SymmetricToScreen(Vector2 symmetricCoordinate)
 void Graphics::SetColorWriteMask(bool red, bool green, bool blue, bool alpha, bool forceChange)
 {
 	// Only change state if we need to :)
-	if( forceChange || currentRedWriteMask != red || currentGreenWriteMask != green || currentBlueWriteMask != blue || currentAlphaWriteMask != alpha)
+	if(TrackStateChange(forceChange || currentRedWriteMask != red || currentGreenWriteMask != green || currentBlueWriteMask != blue || currentAlphaWriteMask != alpha))
 	{
 		glColorMask((GLboolean)red, (GLboolean)green, (GLboolean)blue, (GLboolean)alpha);
-		red = currentRedWriteMask;
-		green = currentGreenWriteMask;
-		blue = currentBlueWriteMask;
-		alpha = currentAlphaWriteMask;
+		currentRedWriteMask = red;
+		currentGreenWriteMask = green;
+		currentBlueWriteMask = blue;
+		currentAlphaWriteMask = alpha;
 	}
 }
 
@@ -546,7 +572,7 @@ void Graphics::Clear(
 		color.A * Color::NORMALIZATION_SCALAR
 		);
 	
-#ifdef GDKPLATFORM_IOS
+#ifdef GDK_OPENGL_ES
 	glClearDepthf(depth);
 #else
 	glClearDepth(depth);
@@ -586,7 +612,7 @@ void Graphics::Clear(
 void Graphics::SetCullingMode(CullingMode::Enum cullingMode, bool forceChange)
 {
 	// Only change state if we need to :)
-	if(cullingMode != currentCullingMode || forceChange)
+	if(TrackStateChange(cullingMode != currentCullingMode || forceChange))
 	{
 		if(cullingMode == CullingMode::Disabled)
 			glDisable(GL_CULL_FACE);
@@ -624,7 +650,7 @@ void Graphics::SetCullingMode(CullingMode::Enum cullingMode, bool forceChange)
 void Graphics::EnableDepthTest(bool enabled, bool forceChange)
 {
 	// Only change state if we need to
-	if(currentDepthTestEnabled != enabled || forceChange)
+	if(TrackStateChange(currentDepthTestEnabled != enabled || forceChange))
 	{
 		if(enabled)
 			glEnable(GL_DEPTH_TEST);
@@ -653,7 +679,7 @@ void Graphics::EnableDepthTest(bool enabled, bool forceChange)
 void Graphics::EnableDepthWrite(bool enabled, bool forceChange)
 {
 	// Only change state if we need to
-	if(currentDepthWriteEnabled != enabled || forceChange)
+	if(TrackStateChange(currentDepthWriteEnabled != enabled || forceChange))
 	{
 		if(enabled)
 			glDepthMask(GL_TRUE);
@@ -676,7 +702,7 @@ void Graphics::EnableDepthWrite(bool enabled, bool forceChange)
 void Graphics::SetDepthTestFunction(CompareFunction::Enum depthFunction, bool forceChange)
 {
 	// Only change state if we need to
-	if(currentDepthCompareFunction != depthFunction || forceChange)
+	if(TrackStateChange(currentDepthCompareFunction != depthFunction || forceChange))
 	{
 		glDepthFunc((GLenum)depthFunction);
 		currentDepthCompareFunction = depthFunction;
@@ -696,7 +722,7 @@ void Graphics::SetDepthTestFunction(CompareFunction::Enum depthFunction, bool fo
 void Graphics::EnableDepthBias(bool enabled, bool forceChange)
 {
 	// Only change state if we need to
-	if(currentDepthBiasEnabled != enabled || forceChange)
+	if(TrackStateChange(currentDepthBiasEnabled != enabled || forceChange))
 	{
 		if(enabled)
 			glEnable(GL_POLYGON_OFFSET_FILL);
@@ -729,7 +755,7 @@ void Graphics::EnableDepthBias(bool enabled, bool forceChange)
 void Graphics::SetDepthBias(float factor, float units, bool forceChange)
 {
 	// Only change state if we need to
-	if(currentDepthBiasFactor != factor || currentDepthBiasUnits != units || forceChange)
+	if(TrackStateChange(currentDepthBiasFactor != factor || currentDepthBiasUnits != units || forceChange))
 	{
 		glPolygonOffset(factor, units);
 		currentDepthBiasFactor = factor;
@@ -749,7 +775,7 @@ void Graphics::SetDepthBias(float factor, float units, bool forceChange)
 void Graphics::EnableBlending(bool enabled, bool forceChange)
 {
 	// Only change state if we need to
-	if(currentBlendingEnabled != enabled || forceChange)
+	if(TrackStateChange(currentBlendingEnabled != enabled || forceChange))
 	{
 		if(enabled)
 			glEnable(GL_BLEND);
@@ -772,7 +798,7 @@ void Graphics::EnableBlending(bool enabled, bool forceChange)
 void Graphics::SetBlendColorConstant(const Color& color, bool forceChange)
 {
 	// Only change state if we need to
-	if(currentBlendColorConstant != color || forceChange)
+	if(TrackStateChange(currentBlendColorConstant != color || forceChange))
 	{
 		float scalar = 1.0f / 255.0f;
 		glBlendColor(color.R * scalar, color.G * scalar, color.B * scalar, color.A * scalar);
@@ -838,17 +864,17 @@ void Graphics::SetBlendMode(
 	)
 {
 	// Only change state if we 'need' to
-	if( forceChange ||
+	if(TrackStateChange(forceChange ||
 		currentSourceRGBFactor != sourceFactor || currentSourceAlphaFactor != sourceFactor ||
-		currentDestRGBFactor != destFactor || currentDestAlphaFactor != destFactor)
+		currentDestRGBFactor != destFactor || currentDestAlphaFactor != destFactor))
 	{
 		glBlendFunc((GLenum)sourceFactor, (GLenum)destFactor);
 		currentSourceRGBFactor = currentSourceAlphaFactor = sourceFactor;
 		currentDestRGBFactor = currentDestAlphaFactor = destFactor;
 	}
 
-	if( forceChange ||
-		currentRGBBlendEquation != blendEquation || currentAlphaBlendEquation != blendEquation)
+	if(TrackStateChange(forceChange ||
+		currentRGBBlendEquation != blendEquation || currentAlphaBlendEquation != blendEquation))
 	{
 		glBlendEquation((GLenum)blendEquation);
 		currentRGBBlendEquation = currentAlphaBlendEquation = blendEquation;
@@ -887,9 +913,9 @@ void Graphics::SetBlendMode(
 	)
 {
 	// Only change state if we 'need' to
-	if( forceChange ||
+	if(TrackStateChange(forceChange ||
 		currentSourceRGBFactor != sourceRGBFactor || currentSourceAlphaFactor != sourceAlphaFactor ||
-		currentDestRGBFactor != destRGBFactor || currentDestAlphaFactor != destAlphaFactor)
+		currentDestRGBFactor != destRGBFactor || currentDestAlphaFactor != destAlphaFactor))
 	{
 		glBlendFuncSeparate((GLenum)sourceRGBFactor, (GLenum)destRGBFactor, (GLenum)sourceAlphaFactor, (GLenum)destAlphaFactor);
 		currentSourceRGBFactor = sourceRGBFactor;
@@ -898,8 +924,8 @@ void Graphics::SetBlendMode(
 		currentDestAlphaFactor = destAlphaFactor;
 	}
 
-	if( forceChange ||
-		currentRGBBlendEquation != rgbBlendEquation || currentAlphaBlendEquation != alphaBlendEquation)
+	if(TrackStateChange(forceChange ||
+		currentRGBBlendEquation != rgbBlendEquation || currentAlphaBlendEquation != alphaBlendEquation))
 	{
 		glBlendEquationSeparate((GLenum)rgbBlendEquation, (GLenum)alphaBlendEquation);
 		currentRGBBlendEquation = rgbBlendEquation;
@@ -922,7 +948,7 @@ void Graphics::SetActiveTextureUnit(
 	)
 {
 	// Only change state if we need to :)
-	if(textureUnit != currentActiveTextureUnit || forceChange)
+	if(TrackStateChange(textureUnit != currentActiveTextureUnit || forceChange))
 	{
 		glActiveTexture((GLenum)textureUnit);
 		currentActiveTextureUnit = textureUnit;
@@ -952,13 +978,15 @@ void Graphics::BindTexture(
 	int textureIndex = TextureUnit::ToIndex(textureUnit);
 
 	// Only change state if we need to :)
-	if(glTextureId != currentTextureIds[textureIndex] || forceChange)
+	if(TrackStateChange(glTextureId != currentTextureIds[textureIndex] || forceChange))
 	{
 		// Make sure this is the active texture unit
 		SetActiveTextureUnit(textureUnit, forceChange);
 		
 		// Bind the texture
 		glBindTexture((GLenum)textureTarget, glTextureId);
+		if(IsRenderThread())
+			currentFrameStats.TextureBinds++;
 		currentTextureIds[textureIndex] = glTextureId;
 	}
 }
@@ -981,7 +1009,7 @@ void Graphics::EnableScissorTest(
 	)
 {
 	// Only change state if we need to :)
-	if(enabled != currentScissorTestEnabled || forceChange)
+	if(TrackStateChange(enabled != currentScissorTestEnabled || forceChange))
 	{
 		if(enabled == true)
 			glEnable(GL_SCISSOR_TEST);
@@ -1015,11 +1043,11 @@ void Graphics::SetScissorRect(
 	)
 {
 	// Only change state if we need to :)
-	if (x != currentScissorX ||
+	if(TrackStateChange(x != currentScissorX ||
 		y != currentScissorY ||
 		width != currentScissorWidth ||
 		height != currentScissorHeight ||
-		forceChange )
+		forceChange ))
 	{
 		glScissor(x, y, width, height);
 
@@ -1042,9 +1070,11 @@ void Graphics::SetScissorRect(
 void Graphics::SetActiveShaderProgram(GLuint shaderProgramId, bool forceChange)
 {
 	// Only change state if we need to :)
-	if(shaderProgramId != currentShaderProgramId || forceChange)
+	if(TrackStateChange(shaderProgramId != currentShaderProgramId || forceChange))
 	{
 		glUseProgram(shaderProgramId);
+		if(IsRenderThread())
+			currentFrameStats.ShaderBinds++;
 		currentShaderProgramId = shaderProgramId;
 	}
 }
@@ -1066,7 +1096,7 @@ void Graphics::SetActiveShaderProgram(GLuint shaderProgramId, bool forceChange)
 void Graphics::EnableVertexAttribArray(int index, bool enabled, bool forceChange)
 {
 	// Only change state if we need to :)
-	if(currentEnabledVertexAttributes[index] != enabled || forceChange)
+	if(TrackStateChange(currentEnabledVertexAttributes[index] != enabled || forceChange))
 	{
 		if(enabled)
 			glEnableVertexAttribArray(index);
@@ -1110,7 +1140,7 @@ void Graphics::EnableVertexAttribArrays(int numToEnable)
 void Graphics::BindVertexBuffer(GLuint glVertexBufferId, bool forceChange)
 {
 	// Only change state if we need to :)
-	if(glVertexBufferId != currentVertexBufferId || forceChange)
+	if(TrackStateChange(glVertexBufferId != currentVertexBufferId || forceChange))
 	{
 		glBindBuffer(GL_ARRAY_BUFFER, glVertexBufferId);
 		currentVertexBufferId = glVertexBufferId;
@@ -1129,7 +1159,7 @@ void Graphics::BindVertexBuffer(GLuint glVertexBufferId, bool forceChange)
 void Graphics::BindIndexBuffer(GLuint glIndexBufferId, bool forceChange)
 {
 	// Only change state if we need to :)
-	if(glIndexBufferId != currentIndexBufferId || forceChange)
+	if(TrackStateChange(glIndexBufferId != currentIndexBufferId || forceChange))
 	{
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, glIndexBufferId);
 		currentIndexBufferId = glIndexBufferId;
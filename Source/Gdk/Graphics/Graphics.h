@@ -15,6 +15,25 @@ namespace Gdk
 	/// @addtogroup Graphics
     /// @{
     
+    // =================================================================================
+    ///	@brief
+    ///		Counters of the graphics work done in a single frame
+    ///	@see
+    ///		Graphics::GetFrameStats
+    // =================================================================================
+    struct GraphicsFrameStats
+    {
+        int StateChanges;               ///< Render state changes sent to GL
+        int RedundantStateChanges;      ///< State changes filtered out, as the state was already set
+        int DrawCalls;                  ///< glDraw* calls
+        int Vertices;                   ///< Vertices drawn by non-indexed draw calls
+        int Indices;                    ///< Indices drawn by indexed draw calls
+        int TextureBinds;               ///< Textures bound  (Also counted as state changes)
+        int ShaderBinds;                ///< Shader programs made active  (Also counted as state changes)
+        int UniformUploads;             ///< glUniform* calls
+        Int64 BufferBytesUploaded;      ///< Bytes of vertex & index data sent to GL  (Uploads by the resource loaders are in the ResourceLoadStats)
+    };
+
     // =================================================================================
     ///	@brief
     ///		Provides access to the GDK Graphics system.
@@ -58,6 +77,13 @@ namespace Gdk
 		static const string& GetGLVersion();
 		static int GetNumSupportedTextureUnits();
 		static ShaderProfile::Enum GetShaderProfile();
+
+        /// @}
+        // ---------------------------------
+        /// @name Statistics
+        /// @{
+
+        static const GraphicsFrameStats& GetFrameStats();
         
         /// @}
         // ---------------------------------
@@ -228,6 +254,17 @@ namespace Gdk
         // Only the platform application should call these, they are not safe for the game code to call...
         static void Platform_SetOSFrameBuffers(GLuint frameBufferId, GLuint colorRenderBufferId, GLuint depthRenderBufferId, GLuint stencilRenderBufferId);
         
+        /// @}
+
+        // ---------------------------------
+        /// @name Internal Statistics Methods
+        /// @{
+
+        // Called by the GDK classes that issue draws & uploads to GL directly.  Only the render thread's calls are counted
+        static void CountDrawCall(int numVertices, int numIndices)  { if(IsRenderThread()) { currentFrameStats.DrawCalls++; currentFrameStats.Vertices += numVertices; currentFrameStats.Indices += numIndices; } }
+        static void CountUniformUploads(int numUploads)             { if(IsRenderThread()) currentFrameStats.UniformUploads += numUploads; }
+        static void CountBufferUpload(Int64 numBytes)               { if(IsRenderThread()) currentFrameStats.BufferBytesUploaded += numBytes; }
+        
         /// @}
         
         /// @endcond
@@ -295,6 +332,28 @@ namespace Gdk
 		static bool currentEnabledVertexAttributes[MAX_VERTEX_ATTRIBUTES];
 		static GLuint currentVertexBufferId;
 		static GLuint currentIndexBufferId;
+
+        // Frame Stats
+        static GraphicsFrameStats currentFrameStats;
+        static GraphicsFrameStats lastFrameStats;
+
+        // The thread the graphics system was initialized on.  The frame stats aren't locked, so the GL work
+        // that the resource loaders do on the background threads isn't counted
+        static pthread_t renderThread;
+        static bool IsRenderThread()    { return pthread_equal(pthread_self(), renderThread) != 0; }
+
+        // Counts a state change, or a redundant change that was filtered out
+        static bool TrackStateChange(bool changing)
+        {
+            if(IsRenderThread())
+            {
+                if(changing)
+                    currentFrameStats.StateChanges++;
+                else
+                    currentFrameStats.RedundantStateChanges++;
+            }
+            return changing;
+        }
         
         // Internal Methods
 		// =====================================================
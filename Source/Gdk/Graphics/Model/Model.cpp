@@ -14,6 +14,9 @@
 
 using namespace Gdk;
 
+// Version of the mesh data stored in the DecodedAssetCache.  (Bump this if the stored layout changes)
+#define MODEL_DECODER_VERSION   1
+
 // *****************************************************************
 /// @brief
 ///     Constructs a new model
@@ -60,6 +63,15 @@ Model::~Model()
 		GdkDelete(*iter);
 	}
 }
+
+// *****************************************************************
+/// @brief
+///     Gets the resources used by this model.  (Its textures)
+// *****************************************************************
+void Model::GetChildResources(vector<Resource*>& children)
+{
+	children.insert(children.end(), this->childResources.begin(), this->childResources.end());
+}
 	 
 // ***********************************************************************
 ModelInstance* Model::CreateInstance()
@@ -101,31 +113,72 @@ void Model::LoadFromAsset()
     char assetPath[256];
     GDK_SPRINTF(assetPath, 256, "%s.gdkmodel", GetName().c_str());
     Stream* stream = AssetManager::GetAssetStream(assetPath);
+    BinaryReader reader(stream);
 
 	// Header
 	// ---------------
 
 	// Read the version & flags
-	UInt16 version = stream->ReadUInt16();
-	UInt16 headerFlags = stream->ReadUInt16();
-    
-    GDK_NOT_USED(headerFlags);
+	UInt16 version = reader.ReadUInt16();
+	UInt16 headerFlags = reader.ReadUInt16();
 
 	// Verify the version
 	int requiredVersion = 3;
 	if(version != requiredVersion)
 	{
 		LOG_ERROR("The model asset \"%s\" is an unsupported version: %d [Expected: %d]", GetName().c_str(), version, requiredVersion);
+		reader.Close();
+		stream->Close();
+		GdkDelete( stream );
 		return;
 	}
 
+    // Get the compression of the mesh data.  (0 = Uncompressed, otherwise CompressionType + 1)
+    int meshDataCompression = (headerFlags & 0x0003) - 1;
+    ASSERT(meshDataCompression < 0 || Stream::IsCompressionTypeSupported((CompressionType::Enum) meshDataCompression),
+        "The model asset \"%s\" uses a compression type [%d] that is not supported by this build of GDK", GetName().c_str(), meshDataCompression);
+
+    // Mesh data is used in place where possible, & otherwise staged in buffers borrowed from the ModelManager
+    MeshDataSource meshDataSource;
+    meshDataSource.Cached = NULL;
+    meshDataSource.CachedEnd = NULL;
+    meshDataSource.Decoded = NULL;
+    meshDataSource.Staging.Data = NULL;
+    meshDataSource.Staging.Capacity = 0;
+    meshDataSource.Compressed.Data = NULL;
+    meshDataSource.Compressed.Capacity = 0;
+    
+    // Should the meshes keep a CPU-side copy of their vertex & index data?
+    bool keepMeshData = ModelManager::GetKeepMeshData();
+    
+    // Compressed mesh data is kept in the DecodedAssetCache, in its decompressed form
+    UInt64 cacheKey = 0;
+    Stream* cacheStream = NULL;
+    if(meshDataCompression >= 0 && DecodedAssetCache::IsEnabled())
+    {
+        cacheKey = DecodedAssetCache::GetKey(stream, "Model", MODEL_DECODER_VERSION);
+        cacheStream = DecodedAssetCache::Open(cacheKey);
+        if(cacheStream != NULL)
+        {
+            // Use the cached mesh data in place
+            Int64 cachedSize = cacheStream->GetLength() - cacheStream->GetPosition();
+            meshDataSource.Cached = (const UInt8*) cacheStream->GetSpan(cacheStream->GetPosition(), cachedSize);
+            meshDataSource.CachedEnd = meshDataSource.Cached + cachedSize;
+        }
+        if(meshDataSource.Cached == NULL)
+        {
+            // Collect the decompressed mesh data as it is read, to be stored once the model is loaded
+            meshDataSource.Decoded = GdkNew MemoryStream(64 * 1024);
+        }
+    }
+
 	// Read the sub-object counts
-	UInt16 numNodes = stream->ReadUInt16();
-	UInt16 numMaterials = stream->ReadUInt16();
-	UInt16 numMeshes = stream->ReadUInt16();
-	UInt16 numMeshInstances = stream->ReadUInt16();
-	UInt16 numAnimations = stream->ReadUInt16();
-	UInt16 numAnimationClips = stream->ReadUInt16();
+	UInt16 numNodes = reader.ReadUInt16();
+	UInt16 numMaterials = reader.ReadUInt16();
+	UInt16 numMeshes = reader.ReadUInt16();
+	UInt16 numMeshInstances = reader.ReadUInt16();
+	UInt16 numAnimations = reader.ReadUInt16();
+	UInt16 numAnimationClips = reader.ReadUInt16();
 
 	// Reserve space for the child objects
 	this->Nodes.reserve(numNodes);
@@ -143,9 +196,9 @@ void Model::LoadFromAsset()
 		ModelNode* node = GdkNew ModelNode();
 
 		// Load the stream data
-		node->Name = stream->ReadString();
-		UInt16 parentNodeIndex = stream->ReadUInt16();
-		node->LocalTransform = Matrix3D::ReadFromStream(stream);
+		node->Name = reader.ReadString();
+		UInt16 parentNodeIndex = reader.ReadUInt16();
+		reader.ReadMatrices(&node->LocalTransform, 1);
 
 		// Setup the node index
 		node->Index = nodeIndex;
@@ -184,19 +237,19 @@ void Model::LoadFromAsset()
 		ModelMaterial* material = GdkNew ModelMaterial();
 		
 		// Read in the basic properties
-		material->Name = stream->ReadString();
-		material->Flags = (ModelMaterialFlags::Enum) stream->ReadUInt16();
-		Color::ReadFromStream(stream).Normalize(material->Emissive);
-		Color::ReadFromStream(stream).Normalize(material->Ambient);
-		Color::ReadFromStream(stream).Normalize(material->Diffuse);
-		Color::ReadFromStream(stream).Normalize(material->Specular);
-		material->Shininess = stream->ReadFloat();
+		material->Name = reader.ReadString();
+		material->Flags = (ModelMaterialFlags::Enum) reader.ReadUInt16();
+		Color::ReadFromStream(&reader).Normalize(material->Emissive);
+		Color::ReadFromStream(&reader).Normalize(material->Ambient);
+		Color::ReadFromStream(&reader).Normalize(material->Diffuse);
+		Color::ReadFromStream(&reader).Normalize(material->Specular);
+		material->Shininess = reader.ReadFloat();
 
 		// Do we need to load a Diffuse texture?
 		if(material->Flags & ModelMaterialFlags::DiffuseTextured)
 		{
 			// Load the asset, track it, and store the texture reference
-			string textureName = stream->ReadString();
+			string textureName = reader.ReadString();
 			string assetFolder = Path::GetDirectory(GetName().c_str());
 			string textureAssetPath = Path::Combine(assetFolder.c_str(), textureName.c_str());
             
@@ -208,7 +261,7 @@ void Model::LoadFromAsset()
 		if(material->Flags & ModelMaterialFlags::BumpTextured)
 		{
 			// Load the asset, track it, and store the texture reference
-			string textureName = stream->ReadString();
+			string textureName = reader.ReadString();
 			string assetFolder = Path::GetDirectory(GetName().c_str());
 			string textureAssetPath = Path::Combine(assetFolder.c_str(), textureName.c_str());
             
@@ -230,50 +283,60 @@ void Model::LoadFromAsset()
 		ModelMesh* mesh = GdkNew ModelMesh();
 
 		// Read the mesh properties
-		mesh->Name = stream->ReadString();
-		mesh->Flags = stream->ReadUInt16();
-		mesh->NumVertices = stream->ReadUInt16();
-		mesh->NumIndices = stream->ReadUInt16();
-		UInt16 numMeshParts = stream->ReadUInt16();
+		mesh->Name = reader.ReadString();
+		mesh->Flags = reader.ReadUInt16();
+		mesh->NumVertices = reader.ReadUInt16();
+		mesh->NumIndices = reader.ReadUInt16();
+		UInt16 numMeshParts = reader.ReadUInt16();
 
 		// Read the number of joints
-		mesh->NumJoints = stream->ReadUInt16();
+		mesh->NumJoints = reader.ReadUInt16();
 
 		// Read the joint Inverse Bind Matrices
-		for(int jointIndex=0; jointIndex < mesh->NumJoints; jointIndex++)
-		{
-			Matrix3D jointInvBindMatrix = Matrix3D::ReadFromStream(stream);
-			mesh->JointInvBindMatrices.push_back(jointInvBindMatrix);
-		}
+		reader.ReadArray(mesh->JointInvBindMatrices, mesh->NumJoints);
 
 		// Read the Bounding sphere of the mesh
-		mesh->BoundingSphere.Center = Vector3::ReadFromStream(stream);
-		mesh->BoundingSphere.Radius = stream->ReadFloat();
+		mesh->BoundingSphere.Center = Vector3::ReadFromStream(&reader);
+		mesh->BoundingSphere.Radius = reader.ReadFloat();
 
 		// Create GL buffers for the vertex & index data
 		glGenBuffers(1, &(mesh->VertexBuffer));
 		glGenBuffers(1, &(mesh->IndexBuffer));
 
-		// Read in the vertex data
+		// Get the vertex data.  If the stream is memory backed (such as a mapped file or pack), the data is used in place
 		size_t vertexStride = ModelMeshFlags::GetVertexStrideFromFlags(mesh->Flags);
-		size_t vertexDataSize = mesh->NumVertices * vertexStride;
-		void* vertexData = GdkAlloc(vertexDataSize);
-		stream->Read(vertexData, vertexDataSize);
+		int vertexDataSize = (int)(mesh->NumVertices * vertexStride);
+		const void* vertexData = ReadMeshData(reader, vertexDataSize, meshDataCompression, &meshDataSource);
 
 		// Copy the vertex data into the vertex buffer
-		Graphics::BindVertexBuffer(mesh->VertexBuffer);
-		glBufferData(GL_ARRAY_BUFFER, vertexDataSize, vertexData, GL_STATIC_DRAW); 
-		GdkFree(vertexData);
+		{
+			ResourceLoadTimer loadTimer(ResourceLoadPhase::Upload);
+			Graphics::BindVertexBuffer(mesh->VertexBuffer);
+			glBufferData(GL_ARRAY_BUFFER, vertexDataSize, vertexData, GL_STATIC_DRAW); 
+		}
+		ResourceLoadStats::AddBytes(ResourceLoadPhase::Upload, vertexDataSize);
+		if(keepMeshData)
+		{
+			mesh->VertexData = GdkAlloc(vertexDataSize > 0 ? vertexDataSize : 1);
+			memcpy(mesh->VertexData, vertexData, vertexDataSize);
+		}
 
-		// Read in the index data
+		// Get the index data, in place if possible
 		int indexDataSize = mesh->NumIndices * sizeof(UInt16);
-		void* indexData = GdkAlloc(indexDataSize);
-		stream->Read(indexData, indexDataSize);
+		const void* indexData = ReadMeshData(reader, indexDataSize, meshDataCompression, &meshDataSource);
 
 		// Copy the index data into the index buffer
-		Graphics::BindIndexBuffer(mesh->IndexBuffer);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexDataSize, indexData, GL_STATIC_DRAW);
-		GdkFree(indexData);
+		{
+			ResourceLoadTimer loadTimer(ResourceLoadPhase::Upload);
+			Graphics::BindIndexBuffer(mesh->IndexBuffer);
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexDataSize, indexData, GL_STATIC_DRAW);
+		}
+		ResourceLoadStats::AddBytes(ResourceLoadPhase::Upload, indexDataSize);
+		if(keepMeshData)
+		{
+			mesh->IndexData = (UInt16*) GdkAlloc(indexDataSize > 0 ? indexDataSize : 1);
+			memcpy(mesh->IndexData, indexData, indexDataSize);
+		}
 		
 		// Pre-size the mesh parts vector
 		mesh->MeshParts.reserve(numMeshParts);
@@ -285,9 +348,9 @@ void Model::LoadFromAsset()
 			ModelMeshPart* meshPart = GdkNew ModelMeshPart();
 
 			// Read the mesh part properties
-			meshPart->IndexStart = stream->ReadUInt16();
-			meshPart->IndexCount = stream->ReadUInt16();
-			meshPart->MaterialSymbol = stream->ReadString();
+			meshPart->IndexStart = reader.ReadUInt16();
+			meshPart->IndexCount = reader.ReadUInt16();
+			meshPart->MaterialSymbol = reader.ReadString();
 
 			// Add the mesh part to the mesh
 			mesh->MeshParts.push_back(meshPart);
@@ -307,40 +370,139 @@ void Model::LoadFromAsset()
 		ModelMeshInstance* meshInstance = GdkNew ModelMeshInstance();
 
 		// Get the mesh & node indices
-		meshInstance->NodeIndex = stream->ReadUInt16();
-		meshInstance->MeshIndex = stream->ReadUInt16();
+		meshInstance->NodeIndex = reader.ReadUInt16();
+		meshInstance->MeshIndex = reader.ReadUInt16();
 	
 		// Get the mesh used by this instance
 		ModelMesh* mesh = this->Meshes[meshInstance->MeshIndex];
 
-		// Pre-size the material bindings vector to the number of mesh parts
-		size_t meshPartCount = mesh->MeshParts.size();
-		meshInstance->MaterialBindings.reserve(meshPartCount);
+		// Read the material binding of each mesh part
+		reader.ReadArray(meshInstance->MaterialBindings, (int) mesh->MeshParts.size());
 
-		// Loop through the mesh parts
-		for(size_t meshPartIndex=0; meshPartIndex < meshPartCount; meshPartIndex++)
-		{
-			// Get the material binding for this mesh part
-			UInt16 materialIndex = stream->ReadUInt16();
-			meshInstance->MaterialBindings.push_back(materialIndex);
-		}
-
-		// Pre-size the joint nodes vector to the number of joints
-		meshInstance->JointNodes.reserve(mesh->NumJoints);
-	
-		// Loop through the joints
-		for(size_t jointIndex=0; jointIndex < mesh->NumJoints; jointIndex++)
-		{
-			// Load the node index for this joint
-			UInt16 nodeIndex = stream->ReadUInt16();
-			meshInstance->JointNodes.push_back(nodeIndex);
-		}
+		// Read the node index of each joint
+		reader.ReadArray(meshInstance->JointNodes, mesh->NumJoints);
 
 		// Add the mesh instance to the model
 		this->MeshInstances.push_back(meshInstance);
 	}
+
+    // Store the decompressed mesh data in the cache, or release the cached mesh data
+    if(meshDataSource.Decoded != NULL)
+    {
+        DecodedAssetCache::Store(cacheKey, meshDataSource.Decoded->GetBufferStartPtr(), meshDataSource.Decoded->GetLength());
+        GdkDelete( meshDataSource.Decoded );
+    }
+    if(cacheStream != NULL)
+    {
+        cacheStream->Close();
+        GdkDelete( cacheStream );
+    }
+    
+    // Return the staging buffers
+    if(meshDataSource.Staging.Data != NULL)
+        ModelManager::ReleaseStagingBuffer(meshDataSource.Staging.Data, meshDataSource.Staging.Capacity);
+    if(meshDataSource.Compressed.Data != NULL)
+        ModelManager::ReleaseStagingBuffer(meshDataSource.Compressed.Data, meshDataSource.Compressed.Capacity);
+
+	// Close the asset stream
+	reader.Close();
+	stream->Close();
+	GdkDelete( stream );
 }	
 
+// *****************************************************************
+/// @brief
+///     Reads a block of vertex or index data from a .gdkmodel
+/// @param reader
+///     The reader for the model asset
+/// @param dataSize
+///     Size of the (uncompressed) data, in bytes
+/// @param compression
+///     The CompressionType of the mesh data, or -1 if it is not compressed
+/// @param source
+///     The cached mesh data, the stream that collects decompressed blocks for the DecodedAssetCache, and
+///     the staging buffers of the load
+/// @return
+///     The data.  This is only valid until the next call, as the staging buffers are reused.
+/// @remarks
+///     Uncompressed data in a memory backed stream (and cached data) is used in place.  Everything else
+///     goes through the staging buffers, so there are no per-mesh allocations.
+///     GDK Internal Use Only
+// *****************************************************************
+const void* Model::ReadMeshData(BinaryReader& reader, int dataSize, int compression, MeshDataSource* source)
+{
+    // Uncompressed data is read straight out of the stream, in place if possible
+    if(compression < 0)
+    {
+        const void* data = reader.ReadSpan(dataSize);
+        if(data == NULL)
+        {
+            void* staging = ReserveStagingBuffer(source->Staging, dataSize);
+            reader.Read(staging, dataSize);
+            data = staging;
+        }
+        return data;
+    }
+
+    int compressedSize = (int) reader.ReadUInt32();
+
+    // Use the cached copy of the block, if there is one
+    if(source->Cached != NULL)
+    {
+        if(source->Cached + dataSize <= source->CachedEnd)
+        {
+            reader.Seek(compressedSize, SeekOrigin::Current);
+            const void* data = source->Cached;
+            source->Cached += dataSize;
+            return data;
+        }
+
+        // The cached data doesnt match the model, so stop using it
+        LOG_WARN("The cached mesh data of the model asset \"%s\" is too small, and was ignored", GetName().c_str());
+        source->Cached = NULL;
+    }
+
+    // Get the compressed block, in place if possible
+    const void* compressedData = reader.ReadSpan(compressedSize);
+    if(compressedData == NULL)
+    {
+        void* compressedStaging = ReserveStagingBuffer(source->Compressed, compressedSize);
+        reader.Read(compressedStaging, compressedSize);
+        compressedData = compressedStaging;
+    }
+
+    // Decompress it
+    void* data = ReserveStagingBuffer(source->Staging, dataSize);
+    bool result = Stream::Decompress(compressedData, compressedSize, data, dataSize, (CompressionType::Enum) compression);
+    ResourceLoadStats::AddBytes(ResourceLoadPhase::Decompress, dataSize);
+    ASSERT(result, "Failed to decompress the mesh data in the model asset \"%s\"", GetName().c_str());
+
+    // Collect the decompressed block for the cache
+    if(source->Decoded != NULL)
+        source->Decoded->Write(data, dataSize);
+
+    return data;
+}
+
+// *****************************************************************
+/// @brief
+///     Makes sure a staging buffer can hold the given number of bytes
+/// @return
+///     The staging buffer's memory.  (Its contents are not kept if it has to grow)
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void* Model::ReserveStagingBuffer(StagingBuffer& buffer, int size)
+{
+    if(buffer.Data == NULL || buffer.Capacity < size)
+    {
+        if(buffer.Data != NULL)
+            ModelManager::ReleaseStagingBuffer(buffer.Data, buffer.Capacity);
+        buffer.Data = ModelManager::AcquireStagingBuffer(size, &buffer.Capacity);
+    }
+    return buffer.Data;
+}
+
 // ***********************************************************************
 void Model::SetupVertexAttributeChannels(ModelMesh* mesh)
 {
@@ -447,6 +609,8 @@ void Model::SetupVertexAttributeChannels(ModelMesh* mesh)
 // ***********************************************************************
 void Model::Draw(ModelInstance* modelInstance)
 {
+	GDK_PROFILE_SCOPE_DETAIL("Model::Draw", GetName().c_str());
+
 	// NOTE: The caller is responsible for the Global Shared Uniforms
 	// - View / Projection transforms
 	// - Lighting
@@ -559,10 +723,12 @@ void Model::Draw(ModelInstance* modelInstance)
 						glUniform4f( boneMatricesUniformLocation + jointLocationOffset + 1, jointMatrix.M12, jointMatrix.M22, jointMatrix.M32, jointMatrix.M42);
 						glUniform4f( boneMatricesUniformLocation + jointLocationOffset + 2, jointMatrix.M13, jointMatrix.M23, jointMatrix.M33, jointMatrix.M43);
 					}
+					Graphics::CountUniformUploads(mesh->NumJoints * 3);
 				}
 
 				// Render the mesh part
 				glDrawElements(GL_TRIANGLES, meshPart->IndexCount, GL_UNSIGNED_SHORT, (void*) (meshPart->IndexStart * sizeof(UInt16)));
+				Graphics::CountDrawCall(0, meshPart->IndexCount);
 			}
 
 		} // foreach( MeshPart )
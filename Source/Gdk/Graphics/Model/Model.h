@@ -41,12 +41,34 @@ namespace Gdk
         /// @name Virtuals from Resouce
         /// @{
         
+        virtual void GetChildResources(vector<Resource*>& children);
         
         /// @}
         
         
     private:
         
+        // Private Types
+        // =====================================================
+        
+        // ***********************************************************************
+        struct StagingBuffer
+        {
+            void* Data;                 // Buffer borrowed from the ModelManager  (NULL if none yet)
+            int Capacity;
+        };
+        
+        // ***********************************************************************
+        struct MeshDataSource
+        {
+            const UInt8* Cached;        // The next block of cached mesh data  (NULL if the mesh data isnt cached)
+            const UInt8* CachedEnd;     // End of the cached mesh data
+            MemoryStream* Decoded;      // Collects the decompressed blocks, to be stored in the cache  (NULL if not storing)
+            
+            StagingBuffer Staging;      // Holds mesh data that cant be used in place, until it is uploaded
+            StagingBuffer Compressed;   // Holds compressed mesh data read from a stream that isnt memory backed
+        };
+        
         // Private Methods
         // =====================================================
         
@@ -55,6 +77,8 @@ namespace Gdk
         Model();
         
         void LoadFromAsset();
+        const void* ReadMeshData(BinaryReader& reader, int dataSize, int compression, MeshDataSource* source);
+        static void* ReserveStagingBuffer(StagingBuffer& buffer, int size);
 
         
 		// Rendering Utilities
@@ -10,6 +10,15 @@ using namespace Gdk;
 
 // Static Instantiations
 ModelManager* ModelManager::singleton = NULL;
+bool ModelManager::keepMeshData = false;
+vector< pair<void*, int> > ModelManager::stagingBuffers;
+Mutex* ModelManager::stagingBuffersMutex = NULL;
+
+// Staging buffers are allocated in multiples of this size, so a buffer can be reused by slightly larger meshes
+#define MODELMANAGER_STAGING_GRANULARITY    (64 * 1024)
+
+// Most staging buffers that are kept in the pool.  (Enough for 2 per loader thread)
+#define MODELMANAGER_MAX_STAGING_BUFFERS    8
 
 // *****************************************************************
 /// @brief
@@ -17,6 +26,7 @@ ModelManager* ModelManager::singleton = NULL;
 // *****************************************************************
 ModelManager::ModelManager()
 {
+    stagingBuffersMutex = Mutex::Create("ModelStagingBuffers");
 }
 
 // *****************************************************************
@@ -25,6 +35,9 @@ ModelManager::ModelManager()
 // *****************************************************************
 ModelManager::~ModelManager()
 {
+    FreeStagingBuffers();
+    GdkDelete( stagingBuffersMutex );
+    stagingBuffersMutex = NULL;
 }
 
 // *****************************************************************
@@ -53,6 +66,17 @@ Resource* ModelManager::OnCreateNewResourceInstance()
     return new Model();
 }
 
+// *****************************************************************
+/// @brief
+///     Gets the name of the Model resource type, for the ResourceLoadStats
+/// @remarks
+///     GDK Internal use only
+// *****************************************************************
+const char* ModelManager::GetResourceTypeName()
+{
+    return "Model";
+}
+
 // *****************************************************************
 void ModelManager::PerformLoadFromAsset(Resource* resource)
 {
@@ -61,4 +85,113 @@ void ModelManager::PerformLoadFromAsset(Resource* resource)
     
     // Load the Model from it's corresponding asset
     model->LoadFromAsset();
-}
\ No newline at end of file
+    
+    // The resource is now ready for use
+    model->State = ResourceState::Ready;
+}
+
+// *****************************************************************
+/// @brief
+///     Sets whether models keep a CPU-side copy of their mesh data
+/// @param keepMeshData
+///     If true, models loaded from now on keep a copy of each mesh's vertex & index data, in
+///     ModelMesh::VertexData & ModelMesh::IndexData.  (Default = false)
+/// @remarks
+///     Mesh data is normally only in the GL buffers.  Only turn this on for models that need the data 
+///     on the CPU, (such as for collision) as the copies are allocated for every mesh.
+// *****************************************************************
+void ModelManager::SetKeepMeshData(bool keepMeshData)
+{
+    ModelManager::keepMeshData = keepMeshData;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets whether models keep a CPU-side copy of their mesh data
+// *****************************************************************
+bool ModelManager::GetKeepMeshData()
+{
+    return keepMeshData;
+}
+
+// *****************************************************************
+/// @brief
+///     Frees the pooled staging buffers
+/// @remarks
+///     The buffers are allocated again by the next model load that needs them.
+// *****************************************************************
+void ModelManager::FreeStagingBuffers()
+{
+    stagingBuffersMutex->Lock();
+    for(vector< pair<void*, int> >::iterator iter = stagingBuffers.begin(); iter != stagingBuffers.end(); iter++)
+        GdkFree(iter->first);
+    stagingBuffers.clear();
+    stagingBuffersMutex->Unlock();
+}
+
+// *****************************************************************
+/// @brief
+///     Gets a staging buffer from the pool, or allocates a new one
+/// @param size
+///     Minimum size of the buffer (in bytes)
+/// @param capacity
+///     [Out] The actual size of the buffer
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void* ModelManager::AcquireStagingBuffer(int size, int* capacity)
+{
+    stagingBuffersMutex->Lock();
+    
+    // Find the smallest pooled buffer that is large enough
+    vector< pair<void*, int> >::iterator best = stagingBuffers.end();
+    for(vector< pair<void*, int> >::iterator iter = stagingBuffers.begin(); iter != stagingBuffers.end(); iter++)
+    {
+        if(iter->second >= size && (best == stagingBuffers.end() || iter->second < best->second))
+            best = iter;
+    }
+    
+    if(best != stagingBuffers.end())
+    {
+        void* buffer = best->first;
+        *capacity = best->second;
+        stagingBuffers.erase(best);
+        stagingBuffersMutex->Unlock();
+        return buffer;
+    }
+    
+    stagingBuffersMutex->Unlock();
+    
+    // Allocate a new buffer
+    *capacity = ((size + MODELMANAGER_STAGING_GRANULARITY - 1) / MODELMANAGER_STAGING_GRANULARITY) * MODELMANAGER_STAGING_GRANULARITY;
+    if(*capacity == 0)
+        *capacity = MODELMANAGER_STAGING_GRANULARITY;
+    return GdkAlloc(*capacity);
+}
+
+// *****************************************************************
+/// @brief
+///     Returns a staging buffer to the pool
+/// @remarks
+///     If the pool is full, the smallest buffer is freed.
+///     GDK Internal Use Only
+// *****************************************************************
+void ModelManager::ReleaseStagingBuffer(void* buffer, int capacity)
+{
+    stagingBuffersMutex->Lock();
+    
+    stagingBuffers.push_back(pair<void*, int>(buffer, capacity));
+    if(stagingBuffers.size() > MODELMANAGER_MAX_STAGING_BUFFERS)
+    {
+        vector< pair<void*, int> >::iterator smallest = stagingBuffers.begin();
+        for(vector< pair<void*, int> >::iterator iter = stagingBuffers.begin(); iter != stagingBuffers.end(); iter++)
+        {
+            if(iter->second < smallest->second)
+                smallest = iter;
+        }
+        GdkFree(smallest->first);
+        stagingBuffers.erase(smallest);
+    }
+    
+    stagingBuffersMutex->Unlock();
+}
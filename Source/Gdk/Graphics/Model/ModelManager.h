@@ -13,6 +13,10 @@ namespace Gdk
     // =================================================================================
     ///	@brief
     ///		Manages Model Resources
+    ///	@remarks
+    ///		Mesh data that cant be uploaded straight from the asset stream is staged in buffers that are
+    ///     pooled by the manager, & reused from one model load to the next.  Call FreeStagingBuffers()
+    ///     once a level is loaded, to give the memory back.
     // =================================================================================
     class ModelManager : public ResourceManager
 	{
@@ -30,6 +34,16 @@ namespace Gdk
         
         /// @}
         
+        // ---------------------------------
+        /// @name Mesh Data methods
+        /// @{
+        
+        static void SetKeepMeshData(bool keepMeshData);
+        static bool GetKeepMeshData();
+        static void FreeStagingBuffers();
+        
+        /// @}
+        
     protected:
         // Protecteds
 		// =====================================================
@@ -39,6 +53,7 @@ namespace Gdk
         /// @{
         
         virtual Resource* OnCreateNewResourceInstance();
+        virtual const char* GetResourceTypeName();
         
         /// @}
         
@@ -49,12 +64,22 @@ namespace Gdk
         // Creation Worker Methods
         static void PerformLoadFromAsset(Resource* resource);
         
+        // Staging buffers for mesh data
+        friend class Model;
+        static void* AcquireStagingBuffer(int size, int* capacity);
+        static void ReleaseStagingBuffer(void* buffer, int capacity);
+        
         // CTor/DTor
         ModelManager();
         
         // Singleton
         static ModelManager* singleton;
         
+        // Mesh data settings & staging buffers
+        static bool keepMeshData;
+        static vector< pair<void*, int> > stagingBuffers;
+        static Mutex* stagingBuffersMutex;
+        
         friend class ResourceManager;
         
 	};
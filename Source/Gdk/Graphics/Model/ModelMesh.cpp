@@ -39,6 +39,8 @@ ModelMesh::ModelMesh()
 {
 	VertexBuffer = 0;
 	IndexBuffer = 0;
+	VertexData = NULL;
+	IndexData = NULL;
 	NumJoints = 0;
 }
 
@@ -54,6 +56,12 @@ ModelMesh::~ModelMesh()
 	// Release the Vertex & Index buffers
 	glDeleteBuffers(1, &VertexBuffer);
 	glDeleteBuffers(1, &IndexBuffer);
+
+	// Release the CPU-side copies of the vertex & index data
+	if(VertexData != NULL)
+		GdkFree(VertexData);
+	if(IndexData != NULL)
+		GdkFree(IndexData);
 }
 
 // ***********************************************************************
@@ -66,6 +66,10 @@ namespace Gdk
 		GLuint	VertexBuffer;
 		GLuint	IndexBuffer;
 
+		// CPU-side copies of the vertex & index data  (NULL unless ModelManager::SetKeepMeshData() was set when loading)
+		void*	VertexData;
+		UInt16*	IndexData;
+
 		vector<class ModelMeshPart*> MeshParts;
 
 		UInt16				NumJoints;
@@ -0,0 +1,912 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+//
+// Null graphics device:  The OpenGL ES 2.0 entry points used by the GDK, implemented as recorders.
+//
+// Built in place of the GL library when GDK_NULL_GRAPHICS is defined.  Every call is counted by the
+// GLCommandRecorder, & written to its capture if there is one.  Only the state the GDK reads back from GL
+// is kept:  Object names, shader uniforms (parsed from the GLSL source, for the ShaderTechnique reflection),
+// and the bound buffers & vertex attribute arrays, to size the client memory arrays read by draw calls.
+//
+
+#include "BasePCH.h"
+
+#ifdef GDK_NULL_GRAPHICS
+
+#ifndef GDK_OPENGL_ES
+	#error "The null graphics device implements the OpenGL ES 2.0 API, which this platform doesn't link to directly"
+#endif
+
+using namespace Gdk;
+
+// Counts the command, & captures it  (The formatting only happens during a capture)
+#define NULLGL_COMMAND(data, dataSize, format, args...)								\
+	do {																			\
+		GLCommandRecorder::Platform_GetStats().Commands++;							\
+		if(GLCommandRecorder::IsCapturing())										\
+			GLCommandRecorder::Platform_Capture(data, dataSize, format, ##args);	\
+	} while(0)
+
+#define NULLGL_MAX_VERTEX_ATTRIBS	16
+
+// ===========================================================================================
+// Null device state
+// ===========================================================================================
+
+namespace
+{
+	// A uniform declared in a shader's GLSL source
+	struct NullUniform
+	{
+		string Name;
+		GLenum Type;
+		GLint Size;
+	};
+
+	// A vertex attribute array, set by glVertexAttribPointer
+	struct NullVertexAttrib
+	{
+		bool Enabled;
+		GLint Size;
+		GLenum Type;
+		GLsizei Stride;
+		const void* Pointer;
+		GLuint Buffer;
+	};
+
+	GLuint nextObjectName = 1;
+	GLuint arrayBuffer = 0;
+	GLuint elementArrayBuffer = 0;
+	NullVertexAttrib vertexAttribs[NULLGL_MAX_VERTEX_ATTRIBS];
+
+	map<GLuint, vector<NullUniform> > shaderUniforms;
+	map<GLuint, vector<GLuint> > programShaders;
+	map<GLuint, vector<NullUniform> > programUniforms;
+
+	// ***********************************************************************
+	void CountBytes(Int64 GLCommandStats::*counter, Int64 numBytes)
+	{
+		GLCommandStats& stats = GLCommandRecorder::Platform_GetStats();
+		stats.*counter += numBytes;
+		stats.Bytes += numBytes;
+	}
+
+	// ***********************************************************************
+	const char* EnumName(GLenum value)
+	{
+		#define NULLGL_ENUM(e) { e, #e }
+		static const struct { GLenum Value; const char* Name; } names[] =
+		{
+			NULLGL_ENUM(GL_NEVER), NULLGL_ENUM(GL_LESS), NULLGL_ENUM(GL_EQUAL), NULLGL_ENUM(GL_LEQUAL),
+			NULLGL_ENUM(GL_GREATER), NULLGL_ENUM(GL_NOTEQUAL), NULLGL_ENUM(GL_GEQUAL), NULLGL_ENUM(GL_ALWAYS),
+			NULLGL_ENUM(GL_SRC_COLOR), NULLGL_ENUM(GL_ONE_MINUS_SRC_COLOR), NULLGL_ENUM(GL_SRC_ALPHA), NULLGL_ENUM(GL_ONE_MINUS_SRC_ALPHA),
+			NULLGL_ENUM(GL_DST_ALPHA), NULLGL_ENUM(GL_ONE_MINUS_DST_ALPHA), NULLGL_ENUM(GL_DST_COLOR), NULLGL_ENUM(GL_ONE_MINUS_DST_COLOR),
+			NULLGL_ENUM(GL_SRC_ALPHA_SATURATE), NULLGL_ENUM(GL_CONSTANT_COLOR), NULLGL_ENUM(GL_ONE_MINUS_CONSTANT_COLOR),
+			NULLGL_ENUM(GL_CONSTANT_ALPHA), NULLGL_ENUM(GL_ONE_MINUS_CONSTANT_ALPHA),
+			NULLGL_ENUM(GL_FUNC_ADD), NULLGL_ENUM(GL_FUNC_SUBTRACT), NULLGL_ENUM(GL_FUNC_REVERSE_SUBTRACT),
+			NULLGL_ENUM(GL_FRONT), NULLGL_ENUM(GL_BACK), NULLGL_ENUM(GL_FRONT_AND_BACK), NULLGL_ENUM(GL_CW), NULLGL_ENUM(GL_CCW),
+			NULLGL_ENUM(GL_CULL_FACE), NULLGL_ENUM(GL_DEPTH_TEST), NULLGL_ENUM(GL_STENCIL_TEST), NULLGL_ENUM(GL_DITHER),
+			NULLGL_ENUM(GL_BLEND), NULLGL_ENUM(GL_SCISSOR_TEST), NULLGL_ENUM(GL_POLYGON_OFFSET_FILL),
+			NULLGL_ENUM(GL_BYTE), NULLGL_ENUM(GL_UNSIGNED_BYTE), NULLGL_ENUM(GL_SHORT), NULLGL_ENUM(GL_UNSIGNED_SHORT),
+			NULLGL_ENUM(GL_INT), NULLGL_ENUM(GL_UNSIGNED_INT), NULLGL_ENUM(GL_FLOAT),
+			NULLGL_ENUM(GL_UNSIGNED_SHORT_4_4_4_4), NULLGL_ENUM(GL_UNSIGNED_SHORT_5_5_5_1), NULLGL_ENUM(GL_UNSIGNED_SHORT_5_6_5),
+			NULLGL_ENUM(GL_ALPHA), NULLGL_ENUM(GL_RGB), NULLGL_ENUM(GL_RGBA), NULLGL_ENUM(GL_LUMINANCE), NULLGL_ENUM(GL_LUMINANCE_ALPHA),
+			NULLGL_ENUM(GL_TEXTURE_2D), NULLGL_ENUM(GL_TEXTURE_MAG_FILTER), NULLGL_ENUM(GL_TEXTURE_MIN_FILTER),
+			NULLGL_ENUM(GL_TEXTURE_WRAP_S), NULLGL_ENUM(GL_TEXTURE_WRAP_T), NULLGL_ENUM(GL_NEAREST), NULLGL_ENUM(GL_LINEAR),
+			NULLGL_ENUM(GL_NEAREST_MIPMAP_NEAREST), NULLGL_ENUM(GL_LINEAR_MIPMAP_NEAREST),
+			NULLGL_ENUM(GL_NEAREST_MIPMAP_LINEAR), NULLGL_ENUM(GL_LINEAR_MIPMAP_LINEAR),
+			NULLGL_ENUM(GL_REPEAT), NULLGL_ENUM(GL_CLAMP_TO_EDGE), NULLGL_ENUM(GL_MIRRORED_REPEAT),
+			NULLGL_ENUM(GL_ARRAY_BUFFER), NULLGL_ENUM(GL_ELEMENT_ARRAY_BUFFER),
+			NULLGL_ENUM(GL_STREAM_DRAW), NULLGL_ENUM(GL_STATIC_DRAW), NULLGL_ENUM(GL_DYNAMIC_DRAW),
+			NULLGL_ENUM(GL_FRAGMENT_SHADER), NULLGL_ENUM(GL_VERTEX_SHADER),
+			NULLGL_ENUM(GL_FRAMEBUFFER), NULLGL_ENUM(GL_RENDERBUFFER), NULLGL_ENUM(GL_COLOR_ATTACHMENT0),
+			NULLGL_ENUM(GL_DEPTH_ATTACHMENT), NULLGL_ENUM(GL_STENCIL_ATTACHMENT),
+			NULLGL_ENUM(GL_RGBA4), NULLGL_ENUM(GL_RGB5_A1), NULLGL_ENUM(GL_RGB565), NULLGL_ENUM(GL_RGBA8_OES),
+			NULLGL_ENUM(GL_DEPTH_COMPONENT16), NULLGL_ENUM(GL_STENCIL_INDEX8),
+		};
+		#undef NULLGL_ENUM
+
+		for(size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+		{
+			if(names[i].Value == value)
+				return names[i].Name;
+		}
+
+		// Not a name we know, so use the value
+		static char unknownNames[4][16];
+		static int nextUnknownName = 0;
+		char* name = unknownNames[nextUnknownName++ & 3];
+		GDK_SNPRINTF(name, 16, "0x%04x", value);
+		return name;
+	}
+
+	// ***********************************************************************
+	const char* PrimitiveName(GLenum mode)
+	{
+		static const char* primitiveNames[] =
+		{
+			"GL_POINTS", "GL_LINES", "GL_LINE_LOOP", "GL_LINE_STRIP", "GL_TRIANGLES", "GL_TRIANGLE_STRIP", "GL_TRIANGLE_FAN"
+		};
+		return mode <= GL_TRIANGLE_FAN ? primitiveNames[mode] : EnumName(mode);
+	}
+
+	// ***********************************************************************
+	int TypeSize(GLenum type)
+	{
+		switch(type)
+		{
+			case GL_BYTE:
+			case GL_UNSIGNED_BYTE:		return 1;
+			case GL_SHORT:
+			case GL_UNSIGNED_SHORT:		return 2;
+			default:					return 4;
+		}
+	}
+
+	// ***********************************************************************
+	int PixelSize(GLenum format, GLenum type)
+	{
+		if(type == GL_UNSIGNED_SHORT_4_4_4_4 || type == GL_UNSIGNED_SHORT_5_5_5_1 || type == GL_UNSIGNED_SHORT_5_6_5)
+			return 2;
+
+		switch(format)
+		{
+			case GL_RGBA:				return 4;
+			case GL_RGB:				return 3;
+			case GL_LUMINANCE_ALPHA:	return 2;
+			default:					return 1;
+		}
+	}
+
+	// ***********************************************************************
+	GLenum UniformType(const string& glslType)
+	{
+		static const struct { const char* Name; GLenum Type; } types[] =
+		{
+			{ "float", GL_FLOAT },		{ "vec2", GL_FLOAT_VEC2 },	{ "vec3", GL_FLOAT_VEC3 },	{ "vec4", GL_FLOAT_VEC4 },
+			{ "int", GL_INT },			{ "ivec2", GL_INT_VEC2 },	{ "ivec3", GL_INT_VEC3 },	{ "ivec4", GL_INT_VEC4 },
+			{ "bool", GL_BOOL },		{ "bvec2", GL_BOOL_VEC2 },	{ "bvec3", GL_BOOL_VEC3 },	{ "bvec4", GL_BOOL_VEC4 },
+			{ "mat2", GL_FLOAT_MAT2 },	{ "mat3", GL_FLOAT_MAT3 },	{ "mat4", GL_FLOAT_MAT4 },
+			{ "sampler2D", GL_SAMPLER_2D }, { "samplerCube", GL_SAMPLER_CUBE },
+		};
+
+		for(size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++)
+		{
+			if(glslType == types[i].Name)
+				return types[i].Type;
+		}
+
+		LOG_WARN("Null graphics device: Unknown uniform type [%s]", glslType.c_str());
+		return GL_FLOAT;
+	}
+
+	// ***********************************************************************
+	vector<string> SplitTokens(const string& text, const char* delimiters)
+	{
+		vector<string> tokens;
+		size_t start = text.find_first_not_of(delimiters);
+		while(start != string::npos)
+		{
+			size_t end = text.find_first_of(delimiters, start);
+			tokens.push_back(text.substr(start, end - start));
+			start = text.find_first_not_of(delimiters, end);
+		}
+		return tokens;
+	}
+
+	// ***********************************************************************
+	GLint EvaluateArraySize(const string& expression, const map<string, string>& defines)
+	{
+		// Array sizes are products of integers & #define'd constants.  ie: "MAX_BONES * 3"
+		GLint size = 1;
+		vector<string> factors = SplitTokens(expression, " \t*");
+		for(vector<string>::iterator factor = factors.begin(); factor != factors.end(); factor++)
+		{
+			map<string, string>::const_iterator define = defines.find(*factor);
+			size *= atoi(define != defines.end() ? define->second.c_str() : factor->c_str());
+		}
+
+		return size > 0 ? size : 1;
+	}
+
+	// ***********************************************************************
+	void ParseUniforms(const string& source, vector<NullUniform>& uniforms)
+	{
+		map<string, string> defines;
+
+		// Strip the comments
+		string code;
+		size_t position = 0;
+		while(position < source.size())
+		{
+			if(source.compare(position, 2, "//") == 0)
+				position = source.find('\n', position);
+			else if(source.compare(position, 2, "/*") == 0)
+			{
+				position = source.find("*/", position);
+				if(position != string::npos)
+					position += 2;
+			}
+			else
+				code += source[position++];
+		}
+
+		// Go through the code, a line at a time
+		vector<string> lines = SplitTokens(code, "\n");
+		for(vector<string>::iterator line = lines.begin(); line != lines.end(); line++)
+		{
+			vector<string> tokens = SplitTokens(*line, " \t\r;");
+			if(tokens.size() >= 3 && tokens[0] == "#define")
+			{
+				defines[tokens[1]] = tokens[2];
+				continue;
+			}
+
+			// Find the uniform declarations:  "uniform [precision] type name[size], name2;"
+			size_t start = line->find("uniform ");
+			if(start == string::npos || (start > 0 && isalnum((*line)[start - 1])))
+				continue;
+			string declaration = line->substr(start, line->find(';', start) - start);
+
+			vector<string> words = SplitTokens(declaration, " \t,");
+			size_t wordIndex = 1;
+			if(wordIndex < words.size() && (words[wordIndex] == "lowp" || words[wordIndex] == "mediump" || words[wordIndex] == "highp"))
+				wordIndex++;
+			if(wordIndex >= words.size())
+				continue;
+			GLenum type = UniformType(words[wordIndex]);
+
+			// The names come after the type
+			size_t namesStart = declaration.find(words[wordIndex]) + words[wordIndex].size();
+			vector<string> names = SplitTokens(declaration.substr(namesStart), ",");
+			for(vector<string>::iterator name = names.begin(); name != names.end(); name++)
+			{
+				NullUniform uniform;
+				uniform.Type = type;
+				uniform.Size = 1;
+
+				size_t bracket = name->find('[');
+				if(bracket != string::npos)
+					uniform.Size = EvaluateArraySize(name->substr(bracket + 1, name->find(']') - bracket - 1), defines);
+
+				vector<string> nameTokens = SplitTokens(name->substr(0, bracket), " \t");
+				uniform.Name = nameTokens.empty() ? string() : nameTokens[0];
+
+				if(uniform.Name.empty() == false)
+					uniforms.push_back(uniform);
+			}
+		}
+	}
+
+	// ***********************************************************************
+	const NullUniform* FindUniform(GLuint program, const char* name, GLint* location)
+	{
+		// Ignore any "[0]" on the end of an array uniform name
+		string uniformName(name);
+		size_t bracket = uniformName.find('[');
+		if(bracket != string::npos)
+			uniformName.erase(bracket);
+
+		vector<NullUniform>& uniforms = programUniforms[program];
+		for(size_t index = 0; index < uniforms.size(); index++)
+		{
+			if(uniforms[index].Name == uniformName)
+			{
+				*location = (GLint) index;
+				return &uniforms[index];
+			}
+		}
+		return NULL;
+	}
+
+	// ***********************************************************************
+	void GenNames(GLsizei n, GLuint* names)
+	{
+		for(GLsizei i = 0; i < n; i++)
+			names[i] = nextObjectName++;
+	}
+
+	// ***********************************************************************
+	void CountUniform(const char* command, GLint location, GLsizei count, const void* values, int valueSize)
+	{
+		Int64 numBytes = (Int64) count * valueSize;
+		CountBytes(&GLCommandStats::UniformBytes, numBytes);
+		NULLGL_COMMAND(values, (size_t) numBytes, "%s(%d, %d)", command, location, count);
+	}
+
+	// ***********************************************************************
+	void CountDraw(GLsizei numVertices)
+	{
+		GLCommandStats& stats = GLCommandRecorder::Platform_GetStats();
+		stats.DrawCalls++;
+		if(numVertices <= 0)
+			return;
+
+		// Get the memory ranges of the vertex arrays in client memory, which the draw call reads
+		pair<const UInt8*, const UInt8*> ranges[NULLGL_MAX_VERTEX_ATTRIBS];
+		int numRanges = 0;
+		for(int index = 0; index < NULLGL_MAX_VERTEX_ATTRIBS; index++)
+		{
+			NullVertexAttrib& attrib = vertexAttribs[index];
+			if(attrib.Enabled == false || attrib.Buffer != 0 || attrib.Pointer == NULL)
+				continue;
+
+			size_t elementSize = attrib.Size * TypeSize(attrib.Type);
+			size_t stride = attrib.Stride != 0 ? attrib.Stride : elementSize;
+			const UInt8* start = (const UInt8*) attrib.Pointer;
+			ranges[numRanges++] = make_pair(start, start + (numVertices - 1) * stride + elementSize);
+		}
+
+		// Interleaved attributes share the same memory, which is only read once
+		sort(ranges, ranges + numRanges);
+		for(int index = 0; index < numRanges; index++)
+		{
+			const UInt8* start = ranges[index].first;
+			const UInt8* end = ranges[index].second;
+			while(index + 1 < numRanges && ranges[index + 1].first <= end)
+				end = max(end, ranges[++index].second);
+
+			size_t numBytes = end - start;
+			CountBytes(&GLCommandStats::ClientArrayBytes, numBytes);
+			if(GLCommandRecorder::IsCapturing())
+				GLCommandRecorder::Platform_Capture(start, numBytes, "    client vertex array");
+		}
+	}
+
+} // namespace
+
+// ===========================================================================================
+// OpenGL ES 2.0 entry points
+// ===========================================================================================
+
+extern "C"
+{
+
+// -------------------------------------------------------------------------------------------
+// Queries
+
+GL_APICALL const GLubyte* GL_APIENTRY glGetString(GLenum name)
+{
+	NULLGL_COMMAND(NULL, 0, "glGetString(%s)", EnumName(name));
+	switch(name)
+	{
+		case GL_VENDOR:						return (const GLubyte*) "GDK";
+		case GL_RENDERER:					return (const GLubyte*) "Null Device  (GL command recorder)";
+		case GL_VERSION:					return (const GLubyte*) "OpenGL ES 2.0 GDK Null";
+		case GL_SHADING_LANGUAGE_VERSION:	return (const GLubyte*) "OpenGL ES GLSL ES 1.00";
+		default:							return (const GLubyte*) "";
+	}
+}
+
+GL_APICALL void GL_APIENTRY glGetIntegerv(GLenum pname, GLint* params)
+{
+	NULLGL_COMMAND(NULL, 0, "glGetIntegerv(%s)", EnumName(pname));
+	switch(pname)
+	{
+		case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+		case GL_MAX_TEXTURE_IMAGE_UNITS:	*params = 8; break;
+		case GL_MAX_VERTEX_ATTRIBS:			*params = NULLGL_MAX_VERTEX_ATTRIBS; break;
+		case GL_MAX_TEXTURE_SIZE:			*params = 4096; break;
+		default:							*params = 0; break;
+	}
+}
+
+GL_APICALL GLenum GL_APIENTRY glGetError(void)
+{
+	return GL_NO_ERROR;
+}
+
+GL_APICALL void GL_APIENTRY glFinish(void)
+{
+	NULLGL_COMMAND(NULL, 0, "glFinish()");
+}
+
+GL_APICALL void GL_APIENTRY glFlush(void)
+{
+	NULLGL_COMMAND(NULL, 0, "glFlush()");
+}
+
+// -------------------------------------------------------------------------------------------
+// Render state
+
+GL_APICALL void GL_APIENTRY glEnable(GLenum cap)
+{
+	NULLGL_COMMAND(NULL, 0, "glEnable(%s)", EnumName(cap));
+}
+
+GL_APICALL void GL_APIENTRY glDisable(GLenum cap)
+{
+	NULLGL_COMMAND(NULL, 0, "glDisable(%s)", EnumName(cap));
+}
+
+GL_APICALL void GL_APIENTRY glBlendColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+	NULLGL_COMMAND(NULL, 0, "glBlendColor(%g, %g, %g, %g)", red, green, blue, alpha);
+}
+
+GL_APICALL void GL_APIENTRY glBlendEquation(GLenum mode)
+{
+	NULLGL_COMMAND(NULL, 0, "glBlendEquation(%s)", EnumName(mode));
+}
+
+GL_APICALL void GL_APIENTRY glBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha)
+{
+	NULLGL_COMMAND(NULL, 0, "glBlendEquationSeparate(%s, %s)", EnumName(modeRGB), EnumName(modeAlpha));
+}
+
+GL_APICALL void GL_APIENTRY glBlendFunc(GLenum sfactor, GLenum dfactor)
+{
+	NULLGL_COMMAND(NULL, 0, "glBlendFunc(%s, %s)", EnumName(sfactor), EnumName(dfactor));
+}
+
+GL_APICALL void GL_APIENTRY glBlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha)
+{
+	NULLGL_COMMAND(NULL, 0, "glBlendFuncSeparate(%s, %s, %s, %s)", EnumName(srcRGB), EnumName(dstRGB), EnumName(srcAlpha), EnumName(dstAlpha));
+}
+
+GL_APICALL void GL_APIENTRY glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
+{
+	NULLGL_COMMAND(NULL, 0, "glColorMask(%d, %d, %d, %d)", red, green, blue, alpha);
+}
+
+GL_APICALL void GL_APIENTRY glCullFace(GLenum mode)
+{
+	NULLGL_COMMAND(NULL, 0, "glCullFace(%s)", EnumName(mode));
+}
+
+GL_APICALL void GL_APIENTRY glFrontFace(GLenum mode)
+{
+	NULLGL_COMMAND(NULL, 0, "glFrontFace(%s)", EnumName(mode));
+}
+
+GL_APICALL void GL_APIENTRY glDepthFunc(GLenum func)
+{
+	NULLGL_COMMAND(NULL, 0, "glDepthFunc(%s)", EnumName(func));
+}
+
+GL_APICALL void GL_APIENTRY glDepthMask(GLboolean flag)
+{
+	NULLGL_COMMAND(NULL, 0, "glDepthMask(%d)", flag);
+}
+
+GL_APICALL void GL_APIENTRY glPolygonOffset(GLfloat factor, GLfloat units)
+{
+	NULLGL_COMMAND(NULL, 0, "glPolygonOffset(%g, %g)", factor, units);
+}
+
+GL_APICALL void GL_APIENTRY glScissor(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+	NULLGL_COMMAND(NULL, 0, "glScissor(%d, %d, %d, %d)", x, y, width, height);
+}
+
+GL_APICALL void GL_APIENTRY glViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+	NULLGL_COMMAND(NULL, 0, "glViewport(%d, %d, %d, %d)", x, y, width, height);
+}
+
+GL_APICALL void GL_APIENTRY glClear(GLbitfield mask)
+{
+	NULLGL_COMMAND(NULL, 0, "glClear(0x%04x)", mask);
+}
+
+GL_APICALL void GL_APIENTRY glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+	NULLGL_COMMAND(NULL, 0, "glClearColor(%g, %g, %g, %g)", red, green, blue, alpha);
+}
+
+GL_APICALL void GL_APIENTRY glClearDepthf(GLfloat depth)
+{
+	NULLGL_COMMAND(NULL, 0, "glClearDepthf(%g)", depth);
+}
+
+GL_APICALL void GL_APIENTRY glClearStencil(GLint s)
+{
+	NULLGL_COMMAND(NULL, 0, "glClearStencil(%d)", s);
+}
+
+// -------------------------------------------------------------------------------------------
+// Buffers
+
+GL_APICALL void GL_APIENTRY glGenBuffers(GLsizei n, GLuint* buffers)
+{
+	GenNames(n, buffers);
+	NULLGL_COMMAND(NULL, 0, "glGenBuffers(%d) = %u", n, buffers[0]);
+}
+
+GL_APICALL void GL_APIENTRY glDeleteBuffers(GLsizei n, const GLuint* buffers)
+{
+	NULLGL_COMMAND(NULL, 0, "glDeleteBuffers(%d, %u)", n, buffers[0]);
+}
+
+GL_APICALL void GL_APIENTRY glBindBuffer(GLenum target, GLuint buffer)
+{
+	if(target == GL_ARRAY_BUFFER)
+		arrayBuffer = buffer;
+	else if(target == GL_ELEMENT_ARRAY_BUFFER)
+		elementArrayBuffer = buffer;
+
+	NULLGL_COMMAND(NULL, 0, "glBindBuffer(%s, %u)", EnumName(target), buffer);
+}
+
+GL_APICALL void GL_APIENTRY glBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+{
+	// Allocating the storage, without any data, is free
+	if(data != NULL)
+		CountBytes(&GLCommandStats::BufferBytes, size);
+	NULLGL_COMMAND(data, data != NULL ? size : 0, "glBufferData(%s, %ld, %s)", EnumName(target), (long) size, EnumName(usage));
+}
+
+GL_APICALL void GL_APIENTRY glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+{
+	CountBytes(&GLCommandStats::BufferBytes, size);
+	NULLGL_COMMAND(data, size, "glBufferSubData(%s, %ld, %ld)", EnumName(target), (long) offset, (long) size);
+}
+
+// -------------------------------------------------------------------------------------------
+// Textures
+
+GL_APICALL void GL_APIENTRY glGenTextures(GLsizei n, GLuint* textures)
+{
+	GenNames(n, textures);
+	NULLGL_COMMAND(NULL, 0, "glGenTextures(%d) = %u", n, textures[0]);
+}
+
+GL_APICALL void GL_APIENTRY glDeleteTextures(GLsizei n, const GLuint* textures)
+{
+	NULLGL_COMMAND(NULL, 0, "glDeleteTextures(%d, %u)", n, textures[0]);
+}
+
+GL_APICALL void GL_APIENTRY glActiveTexture(GLenum texture)
+{
+	NULLGL_COMMAND(NULL, 0, "glActiveTexture(GL_TEXTURE%d)", texture - GL_TEXTURE0);
+}
+
+GL_APICALL void GL_APIENTRY glBindTexture(GLenum target, GLuint texture)
+{
+	NULLGL_COMMAND(NULL, 0, "glBindTexture(%s, %u)", EnumName(target), texture);
+}
+
+GL_APICALL void GL_APIENTRY glTexParameteri(GLenum target, GLenum pname, GLint param)
+{
+	NULLGL_COMMAND(NULL, 0, "glTexParameteri(%s, %s, %s)", EnumName(target), EnumName(pname), EnumName(param));
+}
+
+GL_APICALL void GL_APIENTRY glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels)
+{
+	GDK_NOT_USED(internalformat);
+	GDK_NOT_USED(border);
+	size_t numBytes = pixels != NULL ? (size_t) width * height * PixelSize(format, type) : 0;
+	CountBytes(&GLCommandStats::TextureBytes, numBytes);
+	NULLGL_COMMAND(pixels, numBytes, "glTexImage2D(%s, %d, %s, %d, %d, %s)", EnumName(target), level, EnumName(format), width, height, EnumName(type));
+}
+
+GL_APICALL void GL_APIENTRY glGenerateMipmap(GLenum target)
+{
+	NULLGL_COMMAND(NULL, 0, "glGenerateMipmap(%s)", EnumName(target));
+}
+
+// -------------------------------------------------------------------------------------------
+// Frame & render buffers
+
+GL_APICALL void GL_APIENTRY glGenFramebuffers(GLsizei n, GLuint* framebuffers)
+{
+	GenNames(n, framebuffers);
+	NULLGL_COMMAND(NULL, 0, "glGenFramebuffers(%d) = %u", n, framebuffers[0]);
+}
+
+GL_APICALL void GL_APIENTRY glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
+{
+	NULLGL_COMMAND(NULL, 0, "glDeleteFramebuffers(%d, %u)", n, framebuffers[0]);
+}
+
+GL_APICALL void GL_APIENTRY glBindFramebuffer(GLenum target, GLuint framebuffer)
+{
+	NULLGL_COMMAND(NULL, 0, "glBindFramebuffer(%s, %u)", EnumName(target), framebuffer);
+}
+
+GL_APICALL GLenum GL_APIENTRY glCheckFramebufferStatus(GLenum target)
+{
+	NULLGL_COMMAND(NULL, 0, "glCheckFramebufferStatus(%s)", EnumName(target));
+	return GL_FRAMEBUFFER_COMPLETE;
+}
+
+GL_APICALL void GL_APIENTRY glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
+{
+	NULLGL_COMMAND(NULL, 0, "glFramebufferRenderbuffer(%s, %s, %s, %u)", EnumName(target), EnumName(attachment), EnumName(renderbuffertarget), renderbuffer);
+}
+
+GL_APICALL void GL_APIENTRY glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+{
+	NULLGL_COMMAND(NULL, 0, "glFramebufferTexture2D(%s, %s, %s, %u, %d)", EnumName(target), EnumName(attachment), EnumName(textarget), texture, level);
+}
+
+GL_APICALL void GL_APIENTRY glGenRenderbuffers(GLsizei n, GLuint* renderbuffers)
+{
+	GenNames(n, renderbuffers);
+	NULLGL_COMMAND(NULL, 0, "glGenRenderbuffers(%d) = %u", n, renderbuffers[0]);
+}
+
+GL_APICALL void GL_APIENTRY glDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers)
+{
+	NULLGL_COMMAND(NULL, 0, "glDeleteRenderbuffers(%d, %u)", n, renderbuffers[0]);
+}
+
+GL_APICALL void GL_APIENTRY glBindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+	NULLGL_COMMAND(NULL, 0, "glBindRenderbuffer(%s, %u)", EnumName(target), renderbuffer);
+}
+
+GL_APICALL void GL_APIENTRY glRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+{
+	NULLGL_COMMAND(NULL, 0, "glRenderbufferStorage(%s, %s, %d, %d)", EnumName(target), EnumName(internalformat), width, height);
+}
+
+// -------------------------------------------------------------------------------------------
+// Shaders & programs
+
+GL_APICALL GLuint GL_APIENTRY glCreateShader(GLenum type)
+{
+	GLuint shader = nextObjectName++;
+	NULLGL_COMMAND(NULL, 0, "glCreateShader(%s) = %u", EnumName(type), shader);
+	return shader;
+}
+
+GL_APICALL void GL_APIENTRY glDeleteShader(GLuint shader)
+{
+	shaderUniforms.erase(shader);
+	NULLGL_COMMAND(NULL, 0, "glDeleteShader(%u)", shader);
+}
+
+GL_APICALL void GL_APIENTRY glShaderSource(GLuint shader, GLsizei count, const GLchar* const* strings, const GLint* lengths)
+{
+	string source;
+	for(GLsizei i = 0; i < count; i++)
+	{
+		if(lengths == NULL || lengths[i] < 0)
+			source.append(strings[i]);
+		else
+			source.append(strings[i], lengths[i]);
+	}
+
+	vector<NullUniform>& uniforms = shaderUniforms[shader];
+	uniforms.clear();
+	ParseUniforms(source, uniforms);
+
+	NULLGL_COMMAND(source.c_str(), source.size(), "glShaderSource(%u)", shader);
+}
+
+GL_APICALL void GL_APIENTRY glCompileShader(GLuint shader)
+{
+	NULLGL_COMMAND(NULL, 0, "glCompileShader(%u)", shader);
+}
+
+GL_APICALL void GL_APIENTRY glGetShaderiv(GLuint shader, GLenum pname, GLint* params)
+{
+	*params = (pname == GL_COMPILE_STATUS) ? GL_TRUE : 0;
+	NULLGL_COMMAND(NULL, 0, "glGetShaderiv(%u, 0x%04x)", shader, pname);
+}
+
+GL_APICALL void GL_APIENTRY glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+{
+	if(length != NULL)
+		*length = 0;
+	if(bufSize > 0)
+		infoLog[0] = 0;
+	NULLGL_COMMAND(NULL, 0, "glGetShaderInfoLog(%u)", shader);
+}
+
+GL_APICALL GLuint GL_APIENTRY glCreateProgram(void)
+{
+	GLuint program = nextObjectName++;
+	NULLGL_COMMAND(NULL, 0, "glCreateProgram() = %u", program);
+	return program;
+}
+
+GL_APICALL void GL_APIENTRY glDeleteProgram(GLuint program)
+{
+	programShaders.erase(program);
+	programUniforms.erase(program);
+	NULLGL_COMMAND(NULL, 0, "glDeleteProgram(%u)", program);
+}
+
+GL_APICALL void GL_APIENTRY glAttachShader(GLuint program, GLuint shader)
+{
+	programShaders[program].push_back(shader);
+	NULLGL_COMMAND(NULL, 0, "glAttachShader(%u, %u)", program, shader);
+}
+
+GL_APICALL void GL_APIENTRY glBindAttribLocation(GLuint program, GLuint index, const GLchar* name)
+{
+	NULLGL_COMMAND(NULL, 0, "glBindAttribLocation(%u, %u, %s)", program, index, name);
+}
+
+GL_APICALL void GL_APIENTRY glLinkProgram(GLuint program)
+{
+	// The program has the uniforms of all its shaders  (A uniform can be declared in both)
+	vector<NullUniform>& uniforms = programUniforms[program];
+	uniforms.clear();
+
+	vector<GLuint>& shaders = programShaders[program];
+	for(vector<GLuint>::iterator shader = shaders.begin(); shader != shaders.end(); shader++)
+	{
+		vector<NullUniform>& declared = shaderUniforms[*shader];
+		for(vector<NullUniform>::iterator uniform = declared.begin(); uniform != declared.end(); uniform++)
+		{
+			GLint location;
+			if(FindUniform(program, uniform->Name.c_str(), &location) == NULL)
+				uniforms.push_back(*uniform);
+		}
+	}
+
+	NULLGL_COMMAND(NULL, 0, "glLinkProgram(%u)", program);
+}
+
+GL_APICALL void GL_APIENTRY glGetProgramiv(GLuint program, GLenum pname, GLint* params)
+{
+	vector<NullUniform>& uniforms = programUniforms[program];
+	switch(pname)
+	{
+		case GL_LINK_STATUS:
+		case GL_VALIDATE_STATUS:
+			*params = GL_TRUE;
+			break;
+
+		case GL_ACTIVE_UNIFORMS:
+			*params = (GLint) uniforms.size();
+			break;
+
+		case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+			// Array uniform names are reported with a "[0]" on the end
+			*params = 0;
+			for(size_t index = 0; index < uniforms.size(); index++)
+				*params = Math::Max(*params, (GLint) uniforms[index].Name.size() + 4);
+			break;
+
+		default:
+			*params = 0;
+			break;
+	}
+
+	NULLGL_COMMAND(NULL, 0, "glGetProgramiv(%u, 0x%04x)", program, pname);
+}
+
+GL_APICALL void GL_APIENTRY glGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+{
+	if(length != NULL)
+		*length = 0;
+	if(bufSize > 0)
+		infoLog[0] = 0;
+	NULLGL_COMMAND(NULL, 0, "glGetProgramInfoLog(%u)", program);
+}
+
+GL_APICALL void GL_APIENTRY glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+{
+	const NullUniform& uniform = programUniforms[program][index];
+
+	string uniformName = uniform.Size > 1 ? uniform.Name + "[0]" : uniform.Name;
+	GLsizei nameLength = Math::Min((GLsizei) uniformName.size(), bufSize - 1);
+	memcpy(name, uniformName.c_str(), nameLength);
+	name[nameLength] = 0;
+
+	if(length != NULL)
+		*length = nameLength;
+	*size = uniform.Size;
+	*type = uniform.Type;
+
+	NULLGL_COMMAND(NULL, 0, "glGetActiveUniform(%u, %u) = %s", program, index, name);
+}
+
+GL_APICALL GLint GL_APIENTRY glGetUniformLocation(GLuint program, const GLchar* name)
+{
+	GLint location = -1;
+	FindUniform(program, name, &location);
+	NULLGL_COMMAND(NULL, 0, "glGetUniformLocation(%u, %s) = %d", program, name, location);
+	return location;
+}
+
+GL_APICALL void GL_APIENTRY glUseProgram(GLuint program)
+{
+	NULLGL_COMMAND(NULL, 0, "glUseProgram(%u)", program);
+}
+
+// -------------------------------------------------------------------------------------------
+// Uniforms
+
+GL_APICALL void GL_APIENTRY glUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+{
+	GLfloat values[4] = { v0, v1, v2, v3 };
+	CountUniform("glUniform4f", location, 1, values, sizeof(values));
+}
+
+GL_APICALL void GL_APIENTRY glUniform1fv(GLint location, GLsizei count, const GLfloat* value)			{ CountUniform("glUniform1fv", location, count, value, sizeof(GLfloat[1])); }
+GL_APICALL void GL_APIENTRY glUniform2fv(GLint location, GLsizei count, const GLfloat* value)			{ CountUniform("glUniform2fv", location, count, value, sizeof(GLfloat[2])); }
+GL_APICALL void GL_APIENTRY glUniform3fv(GLint location, GLsizei count, const GLfloat* value)			{ CountUniform("glUniform3fv", location, count, value, sizeof(GLfloat[3])); }
+GL_APICALL void GL_APIENTRY glUniform4fv(GLint location, GLsizei count, const GLfloat* value)			{ CountUniform("glUniform4fv", location, count, value, sizeof(GLfloat[4])); }
+GL_APICALL void GL_APIENTRY glUniform1iv(GLint location, GLsizei count, const GLint* value)				{ CountUniform("glUniform1iv", location, count, value, sizeof(GLint[1])); }
+GL_APICALL void GL_APIENTRY glUniform2iv(GLint location, GLsizei count, const GLint* value)				{ CountUniform("glUniform2iv", location, count, value, sizeof(GLint[2])); }
+GL_APICALL void GL_APIENTRY glUniform3iv(GLint location, GLsizei count, const GLint* value)				{ CountUniform("glUniform3iv", location, count, value, sizeof(GLint[3])); }
+GL_APICALL void GL_APIENTRY glUniform4iv(GLint location, GLsizei count, const GLint* value)				{ CountUniform("glUniform4iv", location, count, value, sizeof(GLint[4])); }
+
+GL_APICALL void GL_APIENTRY glUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)	{ GDK_NOT_USED(transpose); CountUniform("glUniformMatrix2fv", location, count, value, sizeof(GLfloat[4])); }
+GL_APICALL void GL_APIENTRY glUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)	{ GDK_NOT_USED(transpose); CountUniform("glUniformMatrix3fv", location, count, value, sizeof(GLfloat[9])); }
+GL_APICALL void GL_APIENTRY glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)	{ GDK_NOT_USED(transpose); CountUniform("glUniformMatrix4fv", location, count, value, sizeof(GLfloat[16])); }
+
+// -------------------------------------------------------------------------------------------
+// Vertex attributes & drawing
+
+GL_APICALL void GL_APIENTRY glEnableVertexAttribArray(GLuint index)
+{
+	if(index < NULLGL_MAX_VERTEX_ATTRIBS)
+		vertexAttribs[index].Enabled = true;
+	NULLGL_COMMAND(NULL, 0, "glEnableVertexAttribArray(%u)", index);
+}
+
+GL_APICALL void GL_APIENTRY glDisableVertexAttribArray(GLuint index)
+{
+	if(index < NULLGL_MAX_VERTEX_ATTRIBS)
+		vertexAttribs[index].Enabled = false;
+	NULLGL_COMMAND(NULL, 0, "glDisableVertexAttribArray(%u)", index);
+}
+
+GL_APICALL void GL_APIENTRY glVertexAttrib4fv(GLuint index, const GLfloat* v)
+{
+	NULLGL_COMMAND(v, sizeof(GLfloat[4]), "glVertexAttrib4fv(%u)", index);
+}
+
+GL_APICALL void GL_APIENTRY glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer)
+{
+	if(index < NULLGL_MAX_VERTEX_ATTRIBS)
+	{
+		NullVertexAttrib& attrib = vertexAttribs[index];
+		attrib.Size = size;
+		attrib.Type = type;
+		attrib.Stride = stride;
+		attrib.Pointer = pointer;
+		attrib.Buffer = arrayBuffer;
+	}
+
+	// Client memory addresses change from run to run, so they aren't captured.  (The data read from them is, by the draw calls)
+	if(arrayBuffer != 0)
+		NULLGL_COMMAND(NULL, 0, "glVertexAttribPointer(%u, %d, %s, %d, %d, %lu)", index, size, EnumName(type), normalized, stride, (unsigned long) pointer);
+	else
+		NULLGL_COMMAND(NULL, 0, "glVertexAttribPointer(%u, %d, %s, %d, %d, client)", index, size, EnumName(type), normalized, stride);
+}
+
+GL_APICALL void GL_APIENTRY glDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+	NULLGL_COMMAND(NULL, 0, "glDrawArrays(%s, %d, %d)", PrimitiveName(mode), first, count);
+	CountDraw(first + count);
+}
+
+GL_APICALL void GL_APIENTRY glDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+{
+	if(elementArrayBuffer != 0)
+	{
+		// The indices are in a buffer, so we can't see how many vertices they use.  Count one per index.
+		NULLGL_COMMAND(NULL, 0, "glDrawElements(%s, %d, %s, %lu)", PrimitiveName(mode), count, EnumName(type), (unsigned long) indices);
+		CountDraw(count);
+		return;
+	}
+
+	// The indices are in client memory, & are read by the draw call
+	size_t numBytes = (size_t) count * TypeSize(type);
+	CountBytes(&GLCommandStats::ClientArrayBytes, numBytes);
+	NULLGL_COMMAND(indices, numBytes, "glDrawElements(%s, %d, %s, client)", PrimitiveName(mode), count, EnumName(type));
+
+	// Find the highest vertex the indices use
+	GLuint maxIndex = 0;
+	for(GLsizei i = 0; i < count; i++)
+	{
+		GLuint index = (type == GL_UNSIGNED_BYTE) ? ((const GLubyte*) indices)[i] : ((const GLushort*) indices)[i];
+		if(index > maxIndex)
+			maxIndex = index;
+	}
+	CountDraw(count > 0 ? maxIndex + 1 : 0);
+}
+
+} // extern "C"
+
+#endif // GDK_NULL_GRAPHICS
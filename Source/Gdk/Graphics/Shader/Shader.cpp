@@ -78,6 +78,8 @@ Shader::~Shader()
 // ***********************************************************************
 void Shader::Apply()
 {
+	GDK_PROFILE_SCOPE("Shader::Apply");
+
 	// Get the current technique in use
 	ShaderTechnique* technique = this->CurrentTechnique;
 	ASSERT(technique != NULL, "Shader::Apply called with a NULL CurrentTechnique");
@@ -226,10 +228,11 @@ void Shader::LoadFromAsset()
     char assetPath[256];
     GDK_SPRINTF(assetPath, 256, "%s.gdkshader", GetName().c_str());
     Stream* stream = AssetManager::GetAssetStream(assetPath);
+    BinaryReader reader(stream);
 
 	// Load the version & shader flags
-	UInt16 version = stream->ReadUInt16();
-	UInt16 shaderFlags = stream->ReadUInt16();
+	UInt16 version = reader.ReadUInt16();
+	UInt16 shaderFlags = reader.ReadUInt16();
     
     GDK_NOT_USED(version);
     
@@ -237,7 +240,7 @@ void Shader::LoadFromAsset()
 	// ===============================
 
 	// Load & parse the render state flags
-	UInt32 renderStateFlags = stream->ReadUInt32();
+	UInt32 renderStateFlags = reader.ReadUInt32();
 
 	// RS-Apply flags
 	this->RenderState.ColorMask.Apply = (renderStateFlags & ShaderRenderStateFlags::ColorMaskApply) > 0;
@@ -253,17 +256,17 @@ void Shader::LoadFromAsset()
 	
 	// Blending
 	this->RenderState.Blending.Enabled = (renderStateFlags & ShaderRenderStateFlags::BlendingEnabled) > 0;
-	this->RenderState.Blending.ConstantColor.R = stream->ReadUInt8();
-	this->RenderState.Blending.ConstantColor.G = stream->ReadUInt8();
-	this->RenderState.Blending.ConstantColor.B = stream->ReadUInt8();
-	this->RenderState.Blending.ConstantColor.A = stream->ReadUInt8();
-	BlendMode::Enum blendMode = (BlendMode::Enum)stream->ReadUInt16();
-	this->RenderState.Blending.SourceRGBFactor = (BlendFactor::Enum)stream->ReadUInt16();
-	this->RenderState.Blending.DestRGBFactor = (BlendFactor::Enum)stream->ReadUInt16();
-	this->RenderState.Blending.RGBBlendEquation = (BlendEquation::Enum)stream->ReadUInt16();
-	this->RenderState.Blending.SourceAlphaFactor = (BlendFactor::Enum)stream->ReadUInt16();
-	this->RenderState.Blending.DestAlphaFactor = (BlendFactor::Enum)stream->ReadUInt16();
-	this->RenderState.Blending.AlphaBlendEquation = (BlendEquation::Enum)stream->ReadUInt16();
+	this->RenderState.Blending.ConstantColor.R = reader.ReadUInt8();
+	this->RenderState.Blending.ConstantColor.G = reader.ReadUInt8();
+	this->RenderState.Blending.ConstantColor.B = reader.ReadUInt8();
+	this->RenderState.Blending.ConstantColor.A = reader.ReadUInt8();
+	BlendMode::Enum blendMode = (BlendMode::Enum)reader.ReadUInt16();
+	this->RenderState.Blending.SourceRGBFactor = (BlendFactor::Enum)reader.ReadUInt16();
+	this->RenderState.Blending.DestRGBFactor = (BlendFactor::Enum)reader.ReadUInt16();
+	this->RenderState.Blending.RGBBlendEquation = (BlendEquation::Enum)reader.ReadUInt16();
+	this->RenderState.Blending.SourceAlphaFactor = (BlendFactor::Enum)reader.ReadUInt16();
+	this->RenderState.Blending.DestAlphaFactor = (BlendFactor::Enum)reader.ReadUInt16();
+	this->RenderState.Blending.AlphaBlendEquation = (BlendEquation::Enum)reader.ReadUInt16();
 	
 	// Does the shader binary use the Simple BlendMode?
 	if((renderStateFlags & ShaderRenderStateFlags::UseSimpleBlendMode) > 0)
@@ -282,27 +285,27 @@ void Shader::LoadFromAsset()
 	this->RenderState.Depth.TestEnabled = (renderStateFlags & ShaderRenderStateFlags::DepthTestEnabled) > 0;
 	this->RenderState.Depth.WriteEnabled = (renderStateFlags & ShaderRenderStateFlags::DepthWriteEnabled) > 0;
 	this->RenderState.Depth.BiasEnabled = (renderStateFlags & ShaderRenderStateFlags::DepthBiasEnabled) > 0;
-	this->RenderState.Depth.TestFunction = (CompareFunction::Enum) stream->ReadUInt16();
-	this->RenderState.Depth.BiasFactor = stream->ReadFloat();
-	this->RenderState.Depth.BiasUnits = stream->ReadFloat();
+	this->RenderState.Depth.TestFunction = (CompareFunction::Enum) reader.ReadUInt16();
+	this->RenderState.Depth.BiasFactor = reader.ReadFloat();
+	this->RenderState.Depth.BiasUnits = reader.ReadFloat();
   
 	// Culling
-	this->RenderState.Culling.CullMode = (CullingMode::Enum) stream->ReadUInt16();
+	this->RenderState.Culling.CullMode = (CullingMode::Enum) reader.ReadUInt16();
 
 	// Load the attributes
 	// ===============================
 
 	// Get the number of attributes
-	UInt16 numAttributes = stream->ReadUInt16();
+	UInt16 numAttributes = reader.ReadUInt16();
 
 	// Loop through the attributes
 	for(UInt16 index=0; index < numAttributes; index++)
 	{
 		// Read the attribute properties
-		string attributeName = stream->ReadString();
-		UInt16 attribueType = stream->ReadUInt16();
-		UInt16 attributeArraySize = stream->ReadUInt16();
-		UInt16 attributeLocation = stream->ReadUInt16();
+		string attributeName = reader.ReadString();
+		UInt16 attribueType = reader.ReadUInt16();
+		UInt16 attributeArraySize = reader.ReadUInt16();
+		UInt16 attributeLocation = reader.ReadUInt16();
 
 		// Create an attribute definition
 		ShaderAttribute* attribute = GdkNew ShaderAttribute(
@@ -321,16 +324,16 @@ void Shader::LoadFromAsset()
 	// ===============================
 
 	// Get the # of parameters
-	UInt16 numParameters = stream->ReadUInt16();
+	UInt16 numParameters = reader.ReadUInt16();
 	
 	// Loop through the parameters
 	for(UInt16 index=0; index < numParameters; index++)
 	{
 		// Read the parameter details
-		UInt16 parameterFlags = stream->ReadUInt16();
-		string parameterName = stream->ReadString();
-		UniformTypes::Enum parameterType = (UniformTypes::Enum)stream->ReadUInt16();
-		UInt16 parameterArraySize = stream->ReadUInt16();
+		UInt16 parameterFlags = reader.ReadUInt16();
+		string parameterName = reader.ReadString();
+		UniformTypes::Enum parameterType = (UniformTypes::Enum)reader.ReadUInt16();
+		UInt16 parameterArraySize = reader.ReadUInt16();
 		
 		// Create a uniform value for this parameter
 		UniformValue* parameter = this->Parameters.Add(parameterName.c_str(), parameterType, parameterArraySize);
@@ -339,7 +342,7 @@ void Shader::LoadFromAsset()
 		if((parameterFlags & ShaderParameterFlags::BindToGlobal) > 0)
 		{
 			// Get the global parameter that we're binding to
-			string parameterBinding = stream->ReadString();
+			string parameterBinding = reader.ReadString();
 			UniformValue* sharedUniformValue = Graphics::GlobalUniformsSet.Get(parameterBinding.c_str());
 			ASSERT(sharedUniformValue != NULL, "Unable to bind shader parameter [%s] to the shared global uniform [%s]", parameterName.c_str(), parameterBinding.c_str());
 
@@ -353,7 +356,7 @@ void Shader::LoadFromAsset()
 			size_t valueDataSize = UniformTypes::SizeOf(parameterType) * parameterArraySize;
 
 			// Read the value data directly into the uniform
-			stream->Read(parameter->valueBuffer, valueDataSize);
+			reader.Read(parameter->valueBuffer, valueDataSize);
 		}
 	}
 
@@ -361,7 +364,7 @@ void Shader::LoadFromAsset()
 	// ===============================
 
 	// Get the # of techniques
-	UInt16 numTechniques = stream->ReadUInt16();
+	UInt16 numTechniques = reader.ReadUInt16();
 
 	// Loop through the techniques
 	for(UInt16 index=0; index < numTechniques; index++)
@@ -370,35 +373,35 @@ void Shader::LoadFromAsset()
 		// ------------------------------------------------------------
 
 		// Load the technique's profile
-		ShaderProfile::Enum shaderProfile = (ShaderProfile::Enum) stream->ReadUInt16();
+		ShaderProfile::Enum shaderProfile = (ShaderProfile::Enum) reader.ReadUInt16();
 
 		// Read the supported platforms
-		UInt16 numSupportedPlatforms = stream->ReadUInt16();
+		UInt16 numSupportedPlatforms = reader.ReadUInt16();
 		vector<UInt16> supportedPlatforms;
 		supportedPlatforms.reserve(numSupportedPlatforms);
 		for(UInt16 platformIndex=0; platformIndex < numSupportedPlatforms; platformIndex++)
-			supportedPlatforms.push_back( stream->ReadUInt16() );
+			supportedPlatforms.push_back( reader.ReadUInt16() );
 
 		// Read the supported devices
-		UInt16 numSupportedDevices = stream->ReadUInt16();
+		UInt16 numSupportedDevices = reader.ReadUInt16();
 		vector<UInt16> supportedDevices;
 		supportedDevices.reserve(numSupportedDevices);
 		for(UInt16 deviceIndex=0; deviceIndex < numSupportedDevices; deviceIndex++)
-			supportedDevices.push_back( stream->ReadUInt16() );
+			supportedDevices.push_back( reader.ReadUInt16() );
 
 		// Read the excluded platforms
-		UInt16 numExcludedPlatforms = stream->ReadUInt16();
+		UInt16 numExcludedPlatforms = reader.ReadUInt16();
 		vector<UInt16> excludedPlatforms;
 		excludedPlatforms.reserve(numExcludedPlatforms);
 		for(UInt16 platformIndex=0; platformIndex < numExcludedPlatforms; platformIndex++)
-			excludedPlatforms.push_back( stream->ReadUInt16() );
+			excludedPlatforms.push_back( reader.ReadUInt16() );
 
 		// Read the excluded devices
-		UInt16 numExcludedDevices = stream->ReadUInt16();
+		UInt16 numExcludedDevices = reader.ReadUInt16();
 		vector<UInt16> excludedDevices;
 		excludedDevices.reserve(numExcludedDevices);
 		for(UInt16 deviceIndex=0; deviceIndex < numExcludedDevices; deviceIndex++)
-			excludedDevices.push_back( stream->ReadUInt16() );
+			excludedDevices.push_back( reader.ReadUInt16() );
 
 		// Check if we should include this technique on this platform/device
 		// ------------------------------------------------------------------
@@ -452,11 +455,11 @@ void Shader::LoadFromAsset()
 		if(techniqueSupported == false)
 		{
 			// Skip the rest of the technique in the stream
-			string techniqueName = stream->ReadString();
-			UInt32 vertexShaderSize = stream->ReadUInt32();
-			stream->Seek(vertexShaderSize, SeekOrigin::Current);
-			UInt32 fragmentShaderSize = stream->ReadUInt32();
-			stream->Seek(fragmentShaderSize, SeekOrigin::Current);
+			string techniqueName = reader.ReadString();
+			UInt32 vertexShaderSize = reader.ReadUInt32();
+			reader.Seek(vertexShaderSize, SeekOrigin::Current);
+			UInt32 fragmentShaderSize = reader.ReadUInt32();
+			reader.Seek(fragmentShaderSize, SeekOrigin::Current);
 
 			// Move on to the next technique
 			continue;
@@ -469,7 +472,7 @@ void Shader::LoadFromAsset()
 		ShaderTechnique* technique = GdkNew ShaderTechnique();
 
 		// Load the technique name
-		technique->Name = stream->ReadString();
+		technique->Name = reader.ReadString();
 
 		// Is the shader in text format?
 		if(shaderFlags & ShaderFlags::ShaderIsText)
@@ -478,20 +481,20 @@ void Shader::LoadFromAsset()
 			// -------------------------
 
 			// Get the size of the Vertex Shader
-			UInt32 vertexShaderSize = stream->ReadUInt32();
+			UInt32 vertexShaderSize = reader.ReadUInt32();
 
 			// Allocate room & load the Vertex Shader
 			char* vertexShaderText = (char*) GdkAlloc(vertexShaderSize + 1);
 			vertexShaderText[vertexShaderSize] = 0;
-			stream->Read(vertexShaderText, vertexShaderSize); 
+			reader.Read(vertexShaderText, vertexShaderSize); 
 
 			// Get the size of the Fragment Shader
-			UInt32 fragmentShaderSize = stream->ReadUInt32();
+			UInt32 fragmentShaderSize = reader.ReadUInt32();
 
 			// Allocate room & load the Fragment Shader
 			char* fragmentShaderText = (char*) GdkAlloc(fragmentShaderSize + 1);
 			fragmentShaderText[fragmentShaderSize] = 0;
-			stream->Read(fragmentShaderText, fragmentShaderSize);
+			reader.Read(fragmentShaderText, fragmentShaderSize);
 
 			// Compile the sources into shaders
 			technique->vertexShaderId = CompileGLShaderFromSource(vertexShaderText, GL_VERTEX_SHADER);
@@ -543,6 +546,11 @@ void Shader::LoadFromAsset()
 
 	// Default the shader to the first technique
 	this->CurrentTechnique = this->Techniques[0];
+
+	// Close the asset stream
+	reader.Close();
+	stream->Close();
+	GdkDelete( stream );
 }
 
 
@@ -551,7 +559,10 @@ void Shader::LoadFromAsset()
 void Shader::LinkProgram(GLuint shaderProgramId)
 {
 	// Link the program
-	glLinkProgram(shaderProgramId);
+	{
+		ResourceLoadTimer loadTimer(ResourceLoadPhase::Upload);
+		glLinkProgram(shaderProgramId);
+	}
 	
 	// Verify the link succeeded!
 	GLint linked = 0;
@@ -621,8 +632,11 @@ GLuint Shader::CompileGLShaderFromSource(const char *shaderSource, GLenum shader
 	}
 	#endif
 
-	// Compile the shader
-	glCompileShader(shaderId);
+	// Compile the shader  (Counted as uploading to GL, by the ResourceLoadStats)
+	{
+		ResourceLoadTimer loadTimer(ResourceLoadPhase::Upload);
+		glCompileShader(shaderId);
+	}
 
 	// Verify the compile succeeded
 	GLint compiled;
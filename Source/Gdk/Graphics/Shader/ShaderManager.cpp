@@ -53,6 +53,17 @@ Resource* ShaderManager::OnCreateNewResourceInstance()
     return new Shader();
 }
 
+// *****************************************************************
+/// @brief
+///     Gets the name of the Shader resource type, for the ResourceLoadStats
+/// @remarks
+///     GDK Internal use only
+// *****************************************************************
+const char* ShaderManager::GetResourceTypeName()
+{
+    return "Shader";
+}
+
 // *****************************************************************
 void ShaderManager::PerformLoadFromAsset(Resource* resource)
 {
@@ -61,4 +72,7 @@ void ShaderManager::PerformLoadFromAsset(Resource* resource)
     
     // Load the Shader from it's corresponding asset
     shader->LoadFromAsset();
+    
+    // The resource is now ready for use
+    shader->State = ResourceState::Ready;
 }
\ No newline at end of file
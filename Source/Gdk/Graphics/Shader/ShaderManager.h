@@ -39,6 +39,7 @@ namespace Gdk
         /// @{
         
         virtual Resource* OnCreateNewResourceInstance();
+        virtual const char* GetResourceTypeName();
         
         /// @}
         
@@ -90,6 +90,7 @@ void ShaderUniform::Apply()
 
 	// Set the actual shader uniform
 	SetUniform(this->valueBuffer, this->arraySize, this->location);
+	Graphics::CountUniformUploads(1);
 }
 
 // ***********************************************************************
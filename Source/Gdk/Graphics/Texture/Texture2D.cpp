@@ -211,29 +211,68 @@ void Texture2D::LoadFromAsset()
     bool generateMipMaps = (flags & 0x0001) > 0;
     TextureWrapMode::Enum wrapMode = (TextureWrapMode::Enum) ((flags >> 1) & 0x3);
     TextureFilterMode::Enum filterMode = (TextureFilterMode::Enum) ((flags >> 3) & 0x3);
+    CompressionType::Enum compressionType = (CompressionType::Enum) ((flags >> 6) & 0x3);
+    ASSERT(Stream::IsCompressionTypeSupported(compressionType),
+        "The GdkImage \"%s\" uses a compression type [%d] that is not supported by this build of GDK", GetName().c_str(), compressionType);
     
     // Initialize the texture
     Initialize(width, height, pixelFormat);
     
-	// Create a buffer to hold the decompressed image data
-	int numBytes = width * height * PixelFormat::GetBytesPerPixel(pixelFormat);
-	UInt8* imageData = (UInt8*) GdkAlloc(numBytes);
+	// Get the size of the decompressed image data
+    int rowSize = width * PixelFormat::GetBytesPerPixel(pixelFormat);
+	int numBytes = rowSize * height;
     
-	// Create a MemoryStream around our buffer
-	MemoryStream memStream(imageData, numBytes);
-    
-	// Decompress the rest of the image data into the buffer
-	bool result = stream->Decompress(&memStream, CompressionType::ZLib);
-	ASSERT(result, 
-           "Failed to decompress the image data in a GdkImage"
-           );
+    // Is the decompressed image data in the decoded asset cache?
+    UInt64 cacheKey = 0;
+    Stream* cacheStream = NULL;
+    const UInt8* cachedData = NULL;
+    if(DecodedAssetCache::IsEnabled())
+    {
+        cacheKey = DecodedAssetCache::GetKey(stream, "Texture2D", TEXTURE2D_DECODER_VERSION);
+        cacheStream = DecodedAssetCache::Open(cacheKey);
+        if(cacheStream != NULL && cacheStream->GetLength() - cacheStream->GetPosition() == numBytes)
+            cachedData = (const UInt8*) cacheStream->GetSpan(cacheStream->GetPosition(), numBytes);
+    }
     
-    // Apply the image data to the texture
-    SetImageData(imageData);
+    UInt8* imageData = NULL;
+    if(cachedData == NULL)
+    {
+        // Create a buffer to hold the decompressed image data
+        imageData = (UInt8*) GdkAlloc(numBytes);
+        
+        // Is the image data stored in independently compressed chunks?
+        if((flags & 0x0020) > 0)
+        {
+            // Decompress the chunks in parallel, straight into the buffer
+            ReadImageChunks(stream, imageData, rowSize, height, compressionType);
+        }
+        else
+        {
+            // Create a MemoryStream around our buffer
+            MemoryStream memStream(imageData, numBytes);
+            
+            // Decompress the rest of the image data into the buffer
+            bool result = stream->Decompress(&memStream, compressionType);
+            ASSERT(result, 
+                   "Failed to decompress the image data in a GdkImage"
+                   );
+        }
+        
+        // Store the decompressed image data, so the next load can skip decompressing it
+        if(cacheKey != 0)
+            DecodedAssetCache::Store(cacheKey, imageData, numBytes);
+    }
     
-    // Generate mipmaps if we're supposed to
-    if(generateMipMaps)
-        GenerateMipMaps();
+    // Apply the image data to the texture.  Cached image data is used in place
+    {
+        ResourceLoadTimer loadTimer(ResourceLoadPhase::Upload);
+        SetImageData(cachedData != NULL ? (void*) cachedData : imageData);
+        ResourceLoadStats::AddBytes(ResourceLoadPhase::Upload, numBytes);
+        
+        // Generate mipmaps if we're supposed to
+        if(generateMipMaps)
+            GenerateMipMaps();
+    }
     
     // Set wrap mode
     this->SetWrapMode(wrapMode);
@@ -241,15 +280,120 @@ void Texture2D::LoadFromAsset()
     // Set filter mode
     this->SetFilterMode(filterMode);
 
-    // Release the image data buffer
-    GdkFree(imageData);
+    // Release the image data buffer, or the cached image data
+    if(imageData != NULL)
+        GdkFree(imageData);
+    if(cacheStream != NULL)
+    {
+        cacheStream->Close();
+        GdkDelete( cacheStream );
+    }
+
+    // Close the asset stream
+    stream->Close();
+    GdkDelete( stream );
+}
+
+// *****************************************************************
+/// @brief
+///     Reads the image data of a chunked .gdkimage, & decompresses it into the image buffer
+/// @param stream
+///     The asset stream, positioned at the chunk table
+/// @param imageData
+///     Buffer to decompress the image data into
+/// @param rowSize
+///     Size of a row of pixels (in bytes)
+/// @param numRows
+///     Number of rows in the image
+/// @param compressionType
+///     Which compression type the chunks are compressed with
+/// @remarks
+///     Each chunk is a band of rows that was compressed on its own, so the chunks are decompressed in parallel
+///     with ResourceManager::RunParallelTasks().  The compressed data is used in place if the stream is memory 
+///     backed.
+///     GDK Internal Use Only
+// *****************************************************************
+void Texture2D::ReadImageChunks(Stream* stream, UInt8* imageData, int rowSize, int numRows, CompressionType::Enum compressionType)
+{
+    ImageChunks chunks;
+    chunks.Compression = compressionType;
+    chunks.ImageData = imageData;
+    chunks.RowSize = rowSize;
+    chunks.NumRows = numRows;
+    chunks.Failed = false;
+    
+    // Read the chunk table
+    chunks.RowsPerChunk = stream->ReadUInt16();
+    UInt16 numChunks = stream->ReadUInt16();
+    ASSERT(chunks.RowsPerChunk > 0 && numChunks == (numRows + chunks.RowsPerChunk - 1) / chunks.RowsPerChunk,
+        "The GdkImage \"%s\" has an invalid chunk table", GetName().c_str());
+    
+    int totalSize = 0;
+    chunks.Sizes.resize(numChunks);
+    for(UInt16 chunkIndex = 0; chunkIndex < numChunks; chunkIndex++)
+    {
+        chunks.Sizes[chunkIndex] = (int) stream->ReadUInt32();
+        totalSize += chunks.Sizes[chunkIndex];
+    }
+    
+    // Get the compressed data, in place if possible
+    UInt8* compressedCopy = NULL;
+    const UInt8* compressedData = (const UInt8*) stream->GetSpan(stream->GetPosition(), totalSize);
+    if(compressedData == NULL)
+    {
+        compressedCopy = (UInt8*) GdkAlloc(totalSize > 0 ? totalSize : 1);
+        stream->Read(compressedCopy, totalSize);
+        compressedData = compressedCopy;
+    }
+    
+    // Find the start of each chunk
+    chunks.Data.resize(numChunks);
+    for(UInt16 chunkIndex = 0; chunkIndex < numChunks; chunkIndex++)
+    {
+        chunks.Data[chunkIndex] = compressedData;
+        compressedData += chunks.Sizes[chunkIndex];
+    }
+    
+    // Decompress the chunks.  (The helper threads are not loading a resource, so their time is the wait here)
+    {
+        ResourceLoadTimer loadTimer(ResourceLoadPhase::Decompress);
+        ResourceManager::RunParallelTasks(this, numChunks, &Texture2D::DecodeImageChunk, &chunks);
+    }
+    ASSERT(chunks.Failed == false, "Failed to decompress the image data in the GdkImage \"%s\"", GetName().c_str());
+    ResourceLoadStats::AddBytes(ResourceLoadPhase::Decompress, (Int64) rowSize * numRows);
+    
+    if(compressedCopy != NULL)
+        GdkFree(compressedCopy);
+}
+
+// *****************************************************************
+/// @brief
+///     Decompresses a single chunk of a chunked .gdkimage
+/// @remarks
+///     This is called on multiple threads at once, through ResourceManager::RunParallelTasks()
+///     GDK Internal Use Only
+// *****************************************************************
+void Texture2D::DecodeImageChunk(Resource* resource, void* context, int chunkIndex)
+{
+    ImageChunks* chunks = (ImageChunks*) context;
+    
+    // Get the rows of the image covered by this chunk
+    int firstRow = chunkIndex * chunks->RowsPerChunk;
+    int numRows = chunks->NumRows - firstRow;
+    if(numRows > chunks->RowsPerChunk)
+        numRows = chunks->RowsPerChunk;
+    
+    // Decompress the chunk straight into its rows
+    UInt8* destination = chunks->ImageData + firstRow * chunks->RowSize;
+    if(Stream::Decompress(chunks->Data[chunkIndex], chunks->Sizes[chunkIndex], destination, numRows * chunks->RowSize, chunks->Compression) == false)
+        chunks->Failed = true;
 }
 
 // *****************************************************************
 /// @brief
 ///     This virtual is called by the resource manager to request the memory size of this asset
 // *****************************************************************
-UInt32 Texture2D::GetMemoryUsed()
+size_t Texture2D::GetMemoryUsed()
 {
     int numBytes = this->Width * this->Height * PixelFormat::GetBytesPerPixel(this->Format);
     return numBytes;
@@ -9,6 +9,9 @@
 #include "../Enums.h"
 #include "../../Resource/Resource.h"
 
+// Version of the image data stored in the DecodedAssetCache.  (Bump this if the stored layout changes)
+#define TEXTURE2D_DECODER_VERSION   1
+
 namespace Gdk
 {
 	/// @addtogroup Graphics
@@ -74,12 +77,28 @@ namespace Gdk
         /// @name Virtuals from Resouce
         /// @{
         
-        virtual UInt32 GetMemoryUsed();
+        virtual size_t GetMemoryUsed();
         
         /// @}
         
 	private:
 
+        // Private Types
+		// =====================================================
+        
+        // ***********************************************************************
+        struct ImageChunks
+        {
+            vector<const UInt8*> Data;
+            vector<int> Sizes;
+            UInt8* ImageData;
+            int RowSize;
+            int RowsPerChunk;
+            int NumRows;
+            CompressionType::Enum Compression;
+            volatile bool Failed;
+        };
+        
         // Private Properties
 		// =====================================================
         
@@ -97,6 +116,8 @@ namespace Gdk
         
         void Initialize(int width, int height, PixelFormat::Enum pixelFormat);
         void LoadFromAsset();
+        void ReadImageChunks(Stream* stream, UInt8* imageData, int rowSize, int numRows, CompressionType::Enum compressionType);
+        static void DecodeImageChunk(Resource* resource, void* context, int chunkIndex);
 	};
     
     /// @}
@@ -83,6 +83,17 @@ Resource* Texture2DManager::OnCreateNewResourceInstance()
     return new Texture2D();
 }
 
+// *****************************************************************
+/// @brief
+///     Gets the name of the Texture2D resource type, for the ResourceLoadStats
+/// @remarks
+///     GDK Internal use only
+// *****************************************************************
+const char* Texture2DManager::GetResourceTypeName()
+{
+    return "Texture2D";
+}
+
 // *****************************************************************
 void Texture2DManager::PerformLoadFromAsset(Resource* resource)
 {
@@ -91,6 +102,9 @@ void Texture2DManager::PerformLoadFromAsset(Resource* resource)
     
     // Load the texture from it's corresponding asset
     texture->LoadFromAsset();
+    
+    // The resource is now ready for use
+    texture->State = ResourceState::Ready;
 }
 
 
@@ -44,6 +44,7 @@ namespace Gdk
         /// @{
         
         virtual Resource* OnCreateNewResourceInstance();
+        virtual const char* GetResourceTypeName();
         
         /// @}
         
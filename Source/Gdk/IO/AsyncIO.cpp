@@ -0,0 +1,746 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "BasePCH.h"
+#include "AsyncIO.h"
+
+#ifdef GDKPLATFORM_LINUX
+    #include <sys/syscall.h>
+    #include <sys/mman.h>
+    #include <linux/io_uring.h>
+#endif
+
+using namespace Gdk;
+
+// Static Instantiations
+AsyncIO::WorkQueue* AsyncIO::workQueue = NULL;
+int AsyncIO::numThreads = 0;
+#ifdef GDKPLATFORM_LINUX
+AsyncIORing* AsyncIO::ring = NULL;
+#endif
+
+// Size of the pages touched when preloading a memory mapped stream
+#define ASYNCIO_PAGE_SIZE   4096
+
+// Largest single read done when preloading a stream
+#define ASYNCIO_MAX_READ_SIZE   (1 << 30)
+
+// Number of entries in the io_uring submission queue.  (The most requests that can be in the ring at once)
+#define ASYNCIO_RING_ENTRIES    128
+
+#ifdef GDKPLATFORM_LINUX
+namespace Gdk
+{
+    // ***********************************************************************
+    struct AsyncIORing
+    {
+        int FileDescriptor;
+        UInt32 NumEntries;
+
+        // Submission queue  (Shared with the kernel)
+        void* SubmitMemory;
+        size_t SubmitMemorySize;
+        volatile UInt32* SubmitHead;
+        volatile UInt32* SubmitTail;
+        UInt32 SubmitMask;
+        UInt32* SubmitArray;
+        io_uring_sqe* SubmitEntries;
+        size_t SubmitEntriesSize;
+
+        // Completion queue  (Shared with the kernel)
+        void* CompleteMemory;
+        size_t CompleteMemorySize;
+        volatile UInt32* CompleteHead;
+        volatile UInt32* CompleteTail;
+        UInt32 CompleteMask;
+        io_uring_cqe* CompleteEntries;
+
+        Mutex* SubmitMutex;
+        int NumInFlight;            // Requests submitted & not yet completed  (Guarded by SubmitMutex)
+        Thread* CompletionThread;
+    };
+}
+#endif
+
+// *****************************************************************
+/// @brief
+///     Constructor
+// *****************************************************************
+AsyncIORequest::AsyncIORequest(RequestType type)
+{
+    this->type = type;
+    stream = NULL;
+    buffer = NULL;
+    offset = 0;
+    size = 0;
+    provider = NULL;
+
+    status = AsyncIOStatus::Pending;
+    bytesRead = 0;
+    completionEvent = Event::Create();
+}
+
+// *****************************************************************
+/// @brief
+///     Destructor
+/// @remarks
+///     If the request is still pending, this waits for it to complete.
+// *****************************************************************
+AsyncIORequest::~AsyncIORequest()
+{
+    Wait();
+    GdkDelete( completionEvent );
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the current status of the request
+// *****************************************************************
+AsyncIOStatus::Enum AsyncIORequest::GetStatus()
+{
+    return status;
+}
+
+// *****************************************************************
+/// @brief
+///     Checks if the request has completed  (Whether it succeeded or failed)
+// *****************************************************************
+bool AsyncIORequest::IsComplete()
+{
+    return status != AsyncIOStatus::Pending;
+}
+
+// *****************************************************************
+/// @brief
+///     Blocks the calling thread until the request is complete
+// *****************************************************************
+void AsyncIORequest::Wait()
+{
+    completionEvent->Wait(false);
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the number of bytes that were read
+/// @remarks
+///     For write requests, this is the number of bytes written.
+///     For asset stream requests, this is the length of the asset stream.
+// *****************************************************************
+Int64 AsyncIORequest::GetBytesRead()
+{
+    return bytesRead;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the asset path of an asset stream request
+// *****************************************************************
+const string& AsyncIORequest::GetAssetPath()
+{
+    return assetPath;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the stream of the request
+/// @remarks
+///     For read & write requests, this is the stream that was read from or written to.
+///     For asset stream requests, this is the asset stream, or NULL if the asset was not found.  The caller
+///     owns the asset stream, and must Close() and GdkDelete it when done.
+// *****************************************************************
+Stream* AsyncIORequest::GetStream()
+{
+    return stream;
+}
+
+// *****************************************************************
+/// @brief
+///     Marks the request as complete, & wakes any threads waiting on it
+// *****************************************************************
+void AsyncIORequest::Complete(bool succeeded)
+{
+    status = succeeded ? AsyncIOStatus::Complete : AsyncIOStatus::Failed;
+    completionEvent->Set();
+}
+
+// *****************************************************************
+/// @brief
+///     Static Initializer for the AsyncIO sub-system
+/// @param numThreads
+///     Number of I/O threads to create.  (0 = do all requests on the calling thread)
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void AsyncIO::Init(int numThreads)
+{
+    AsyncIO::numThreads = numThreads;
+    if(numThreads > 0)
+    {
+        workQueue = GdkNew WorkQueue(numThreads);
+#ifdef GDKPLATFORM_LINUX
+        ring = CreateRing();
+#endif
+    }
+}
+
+// *****************************************************************
+/// @brief
+///     Static Shutdown for the AsyncIO sub-system
+/// @remarks
+///     Requests that are still queued are processed before the I/O threads stop, so nothing waiting on them
+///     (such as a write-behind FileStream that is still open) is left blocked.  Any request made after the
+///     shutdown is done on the calling thread.
+///     GDK Internal Use Only
+// *****************************************************************
+void AsyncIO::Shutdown()
+{
+#ifdef GDKPLATFORM_LINUX
+    // Wait for the reads & writes in the io_uring.  (Any made from here on go to the I/O threads)
+    if(ring != NULL)
+    {
+        AsyncIORing* oldRing = ring;
+        ring = NULL;
+        DestroyRing(oldRing);
+    }
+#endif
+
+    if(workQueue != NULL)
+    {
+        // Let the I/O threads drain the queue.  (The requests they are working on are finished before the threads are joined)
+        while(workQueue->GetQueueCount() > 0)
+            Thread::Sleep(1);
+
+        GdkDelete( workQueue );
+        workQueue = NULL;
+    }
+    numThreads = 0;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the number of threads servicing asynchronous reads
+// *****************************************************************
+int AsyncIO::GetNumThreads()
+{
+    return numThreads;
+}
+
+// *****************************************************************
+/// @brief
+///     Changes the number of threads servicing asynchronous reads
+/// @param numThreads
+///     The new number of I/O threads.  (0 = do all requests on the calling thread)
+/// @remarks
+///     Every request that has already been made is completed first, the same as at shutdown.
+///     Don't make new requests from other threads while the threads are being replaced.
+// *****************************************************************
+void AsyncIO::SetNumThreads(int numThreads)
+{
+    Shutdown();
+    Init(numThreads);
+}
+
+// *****************************************************************
+/// @brief
+///     Checks if reads & writes of files are being submitted to the kernel through an io_uring
+/// @remarks
+///     This is only ever true on Linux, with a kernel that supports io_uring (5.6 or later), & with at least one I/O thread.
+// *****************************************************************
+bool AsyncIO::IsUsingIORing()
+{
+#ifdef GDKPLATFORM_LINUX
+    return ring != NULL;
+#else
+    return false;
+#endif
+}
+
+// *****************************************************************
+/// @brief
+///     Queues a read from a stream
+/// @param stream
+///     The stream to read from.  The stream must stay open until the request is complete.
+/// @param destination
+///     Buffer to read the bytes into.  The buffer must stay valid until the request is complete.
+/// @param offset
+///     Offset (from the beginning of the stream) of the first byte to read
+/// @param size
+///     Number of bytes to read.
+/// @param priority
+///     The priority of the request.  Higher priority requests are serviced sooner.
+/// @remarks
+///     The read is done with Stream::ReadAt().  Memory backed streams are copied right away,
+///     as there is no I/O to wait on.
+// *****************************************************************
+AsyncIORequest* AsyncIO::QueueRead(Stream* stream, void* destination, Int64 offset, int size, short priority)
+{
+    AsyncIORequest* request = GdkNew AsyncIORequest(AsyncIORequest::ReadRequest);
+    request->stream = stream;
+    request->buffer = destination;
+    request->offset = offset;
+    request->size = size;
+
+    // Memory backed streams dont need an I/O thread
+    if(stream->GetSpan(offset, size) != NULL)
+    {
+        ProcessRequest(request);
+        return request;
+    }
+
+    Queue(request, priority);
+    return request;
+}
+
+// *****************************************************************
+/// @brief
+///     Queues a write to a stream
+/// @param stream
+///     The stream to write to.  The stream must stay open until the request is complete.
+/// @param source
+///     Buffer of bytes to write.  The buffer must stay valid (and unchanged) until the request is complete.
+/// @param offset
+///     Offset (from the beginning of the stream) to write the bytes at
+/// @param size
+///     Number of bytes to write.
+/// @param priority
+///     The priority of the request.  Higher priority requests are serviced sooner.
+/// @remarks
+///     The write is done with Stream::WriteAt().  Writes to the same stream are not ordered, so a caller that
+///     writes overlapping ranges must wait for one write to complete before queueing the next.
+// *****************************************************************
+AsyncIORequest* AsyncIO::QueueWrite(Stream* stream, void* source, Int64 offset, int size, short priority)
+{
+    AsyncIORequest* request = GdkNew AsyncIORequest(AsyncIORequest::WriteRequest);
+    request->stream = stream;
+    request->buffer = source;
+    request->offset = offset;
+    request->size = size;
+
+    Queue(request, priority);
+    return request;
+}
+
+// *****************************************************************
+/// @brief
+///     Queues a request to open an asset stream
+/// @param provider
+///     The provider to get the asset from.  If NULL, the asset is found through the AssetManager.
+/// @param assetPath
+///     Path to the asset
+/// @param priority
+///     The priority of the request.  Higher priority requests are serviced sooner.
+/// @remarks
+///     Once the I/O thread has the asset stream, it reads the asset in.  Memory mapped assets have
+///     their pages touched, everything else is read into a MemoryStream.
+// *****************************************************************
+AsyncIORequest* AsyncIO::QueueGetAssetStream(AssetProvider* provider, const char* assetPath, short priority)
+{
+    AsyncIORequest* request = GdkNew AsyncIORequest(AsyncIORequest::AssetStreamRequest);
+    request->provider = provider;
+    request->assetPath = assetPath;
+
+    Queue(request, priority);
+    return request;
+}
+
+// *****************************************************************
+/// @brief
+///     Queues a request on the I/O threads, or processes it right away if there are none
+/// @remarks
+///     Requests in the io_uring are serviced by the kernel in the order they are submitted, so the priority
+///     only orders the requests waiting for the I/O threads.
+///     GDK Internal Use Only
+// *****************************************************************
+void AsyncIO::Queue(AsyncIORequest* request, short priority)
+{
+    if(workQueue == NULL)
+    {
+        ProcessRequest(request);
+        return;
+    }
+
+#ifdef GDKPLATFORM_LINUX
+    // Reads & writes of files go straight to the kernel  (Unless the ring is full)
+    if(ring != NULL && request->type != AsyncIORequest::AssetStreamRequest && SubmitToRing(request))
+        return;
+#endif
+
+    workQueue->Enqueue(request, priority);
+}
+
+// *****************************************************************
+/// @brief
+///     Processes a request & marks it complete
+/// @remarks
+///     This is called from the I/O threads.
+///     GDK Internal Use Only
+// *****************************************************************
+void AsyncIO::ProcessRequest(AsyncIORequest* request)
+{
+    switch(request->type)
+    {
+        case AsyncIORequest::ReadRequest:
+        {
+            request->bytesRead = request->stream->ReadAt(request->buffer, request->offset, request->size);
+            request->Complete(request->bytesRead == request->size);
+            break;
+        }
+
+        case AsyncIORequest::WriteRequest:
+        {
+            request->bytesRead = request->stream->WriteAt(request->buffer, request->offset, request->size);
+            request->Complete(request->bytesRead == request->size);
+            break;
+        }
+
+        case AsyncIORequest::AssetStreamRequest:
+        {
+            // Open the asset stream
+            const char* assetPath = request->assetPath.c_str();
+            Stream* stream = request->provider != NULL
+                ? request->provider->GetAssetStream(assetPath)
+                : AssetManager::GetAssetStream(assetPath);
+
+            if(stream == NULL)
+            {
+                request->Complete(false);
+                break;
+            }
+
+            // Read it in
+            request->stream = PreloadStream(stream);
+            request->bytesRead = request->stream->GetLength();
+            request->Complete(true);
+            break;
+        }
+    }
+}
+
+// *****************************************************************
+/// @brief
+///     Reads in the whole of a stream, so later reads from it do not block on I/O
+/// @param stream
+///     The stream to preload
+/// @return
+///     The preloaded stream.  This is either the given stream, or a MemoryStream that replaces it.
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+Stream* AsyncIO::PreloadStream(Stream* stream)
+{
+    Int64 length = stream->GetLength();
+
+    // Is the stream memory backed?
+    const UInt8* span = (const UInt8*) stream->GetSpan(0, length);
+    if(span != NULL)
+    {
+        // Touch each page, so any page faults (of a mapped file) are taken here, rather than by the loader
+        volatile UInt8 touch = 0;
+        for(Int64 offset = 0; offset < length; offset += ASYNCIO_PAGE_SIZE)
+            touch += span[offset];
+
+        return stream;
+    }
+
+    // Read the stream into memory, in blocks that fit in a single ReadAt()
+    MemoryStream* memoryStream = GdkNew MemoryStream(length > 0 ? length : 1);
+    UInt8* memory = (UInt8*) memoryStream->GetBufferStartPtr();
+    Int64 bytesRead = 0;
+    while(bytesRead < length)
+    {
+        int blockSize = length - bytesRead > ASYNCIO_MAX_READ_SIZE ? ASYNCIO_MAX_READ_SIZE : (int)(length - bytesRead);
+        int blockRead = stream->ReadAt(memory + bytesRead, bytesRead, blockSize);
+        if(blockRead <= 0)
+            break;
+        bytesRead += blockRead;
+    }
+    memoryStream->SetLength(bytesRead);
+
+    // Close the original stream
+    stream->Close();
+    GdkDelete( stream );
+
+    return memoryStream;
+}
+
+#ifdef GDKPLATFORM_LINUX
+
+// *****************************************************************
+/// @brief
+///     Creates the io_uring that file reads & writes are submitted to, along with the thread that completes them
+/// @return
+///     The ring, or NULL if the kernel doesn't support io_uring  (Such as an old kernel, or a sandbox that blocks it)
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+AsyncIORing* AsyncIO::CreateRing()
+{
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = (int) syscall(__NR_io_uring_setup, ASYNCIO_RING_ENTRIES, &params);
+    if(fd < 0)
+    {
+        LOG_INFO("io_uring is not available [errno %d], so the AsyncIO threads will do every read & write", errno);
+        return NULL;
+    }
+
+    // The plain read & write operations need Linux 5.6.  (As does the probe)
+    size_t probeSize = sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op);
+    io_uring_probe* probe = (io_uring_probe*) GdkAlloc(probeSize);
+    memset(probe, 0, probeSize);
+    bool supported = syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, 256) >= 0
+        && probe->last_op >= IORING_OP_WRITE
+        && (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED) != 0
+        && (probe->ops[IORING_OP_WRITE].flags & IO_URING_OP_SUPPORTED) != 0;
+    GdkFree(probe);
+    if(supported == false)
+    {
+        LOG_INFO("io_uring doesn't support plain reads & writes on this kernel, so the AsyncIO threads will do every read & write");
+        close(fd);
+        return NULL;
+    }
+
+    // Map the submission & completion queues
+    AsyncIORing* ring = GdkNew AsyncIORing();
+    memset(ring, 0, sizeof(AsyncIORing));
+    ring->FileDescriptor = fd;
+    ring->NumEntries = params.sq_entries;
+    ring->SubmitMemorySize = params.sq_off.array + params.sq_entries * sizeof(UInt32);
+    ring->SubmitEntriesSize = params.sq_entries * sizeof(io_uring_sqe);
+    ring->CompleteMemorySize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    ring->SubmitMemory = mmap(NULL, ring->SubmitMemorySize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    ring->CompleteMemory = mmap(NULL, ring->CompleteMemorySize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    void* submitEntries = mmap(NULL, ring->SubmitEntriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    ring->SubmitEntries = submitEntries != MAP_FAILED ? (io_uring_sqe*) submitEntries : NULL;
+    if(ring->SubmitMemory == MAP_FAILED || ring->CompleteMemory == MAP_FAILED || ring->SubmitEntries == NULL)
+    {
+        LOG_ERROR("Unable to map the io_uring queues [errno %d]", errno);
+        DestroyRing(ring);
+        return NULL;
+    }
+
+    UInt8* submitMemory = (UInt8*) ring->SubmitMemory;
+    ring->SubmitHead = (volatile UInt32*)(submitMemory + params.sq_off.head);
+    ring->SubmitTail = (volatile UInt32*)(submitMemory + params.sq_off.tail);
+    ring->SubmitMask = *(UInt32*)(submitMemory + params.sq_off.ring_mask);
+    ring->SubmitArray = (UInt32*)(submitMemory + params.sq_off.array);
+
+    UInt8* completeMemory = (UInt8*) ring->CompleteMemory;
+    ring->CompleteHead = (volatile UInt32*)(completeMemory + params.cq_off.head);
+    ring->CompleteTail = (volatile UInt32*)(completeMemory + params.cq_off.tail);
+    ring->CompleteMask = *(UInt32*)(completeMemory + params.cq_off.ring_mask);
+    ring->CompleteEntries = (io_uring_cqe*)(completeMemory + params.cq_off.cqes);
+
+    // Start the completion thread
+    ring->SubmitMutex = Mutex::Create("AsyncIORing");
+    ring->CompletionThread = GdkNew Thread(Thread::Create(&AsyncIO::RingCompletionThread, ring));
+
+    return ring;
+}
+
+// *****************************************************************
+/// @brief
+///     Waits for the requests in the io_uring to complete, then stops the completion thread & frees the ring
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void AsyncIO::DestroyRing(AsyncIORing* ring)
+{
+    if(ring->CompletionThread != NULL)
+    {
+        // Wait for the requests in flight
+        while(true)
+        {
+            ring->SubmitMutex->Lock();
+            int numInFlight = ring->NumInFlight;
+            ring->SubmitMutex->Unlock();
+
+            if(numInFlight == 0)
+                break;
+            Thread::Sleep(1);
+        }
+
+        // Submit an empty entry, which tells the completion thread to stop
+        ring->SubmitMutex->Lock();
+        UInt32 tail = *ring->SubmitTail;
+        UInt32 index = tail & ring->SubmitMask;
+        memset(&ring->SubmitEntries[index], 0, sizeof(io_uring_sqe));
+        ring->SubmitEntries[index].opcode = IORING_OP_NOP;
+        ring->SubmitArray[index] = index;
+        __sync_synchronize();
+        *ring->SubmitTail = tail + 1;
+        __sync_synchronize();
+
+        int submitted;
+        do
+        {
+            submitted = (int) syscall(__NR_io_uring_enter, ring->FileDescriptor, 1, 0, 0, NULL, 0);
+        } while(submitted < 0 && errno == EINTR);
+        ring->SubmitMutex->Unlock();
+
+        ring->CompletionThread->Join();
+        GdkDelete( ring->CompletionThread );
+    }
+
+    if(ring->SubmitMutex != NULL)
+        GdkDelete( ring->SubmitMutex );
+
+    // Unmap the queues & close the ring
+    if(ring->SubmitEntries != NULL)
+        munmap(ring->SubmitEntries, ring->SubmitEntriesSize);
+    if(ring->CompleteMemory != NULL && ring->CompleteMemory != MAP_FAILED)
+        munmap(ring->CompleteMemory, ring->CompleteMemorySize);
+    if(ring->SubmitMemory != NULL && ring->SubmitMemory != MAP_FAILED)
+        munmap(ring->SubmitMemory, ring->SubmitMemorySize);
+    close(ring->FileDescriptor);
+
+    GdkDelete( ring );
+}
+
+// *****************************************************************
+/// @brief
+///     Submits a read or write request to the io_uring
+/// @return
+///     False if the request can't go through the ring, such as when the stream isn't a file, or the ring is full.
+///     The request should then be given to the I/O threads.
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+bool AsyncIO::SubmitToRing(AsyncIORequest* request)
+{
+    int fd = request->stream->GetFileDescriptor();
+    if(fd < 0)
+        return false;
+
+    // Keep the requests in flight within the completion queue  (Which is twice the size of the submission queue)
+    ring->SubmitMutex->Lock();
+    if(ring->NumInFlight >= (int) ring->NumEntries)
+    {
+        ring->SubmitMutex->Unlock();
+        return false;
+    }
+
+    // Fill in the next submission entry
+    UInt32 tail = *ring->SubmitTail;
+    UInt32 index = tail & ring->SubmitMask;
+    io_uring_sqe* entry = &ring->SubmitEntries[index];
+    memset(entry, 0, sizeof(io_uring_sqe));
+    entry->opcode = request->type == AsyncIORequest::WriteRequest ? IORING_OP_WRITE : IORING_OP_READ;
+    entry->fd = fd;
+    entry->off = (UInt64) request->offset;
+    entry->addr = (UInt64)(size_t) request->buffer;
+    entry->len = (UInt32) request->size;
+    entry->user_data = (UInt64)(size_t) request;
+    ring->SubmitArray[index] = index;
+
+    // Publish the entry to the kernel, & submit it
+    __sync_synchronize();
+    *ring->SubmitTail = tail + 1;
+    __sync_synchronize();
+
+    int submitted;
+    do
+    {
+        submitted = (int) syscall(__NR_io_uring_enter, ring->FileDescriptor, 1, 0, 0, NULL, 0);
+    } while(submitted < 0 && errno == EINTR);
+
+    // Take the entry back if the kernel didn't consume it
+    if(submitted < 1 && *ring->SubmitHead == tail)
+    {
+        *ring->SubmitTail = tail;
+        ring->SubmitMutex->Unlock();
+        return false;
+    }
+
+    ring->NumInFlight++;
+    ring->SubmitMutex->Unlock();
+    return true;
+}
+
+// *****************************************************************
+/// @brief
+///     Worker method of the thread that waits on the io_uring completion queue, & completes the requests
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void* AsyncIO::RingCompletionThread(void* argument)
+{
+    AsyncIORing* ring = (AsyncIORing*) argument;
+    Profiler::SetThreadName("AsyncIO Completion");
+
+    bool stopping = false;
+    while(stopping == false)
+    {
+        // Wait for at least one completion
+        int result = (int) syscall(__NR_io_uring_enter, ring->FileDescriptor, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+        if(result < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+        {
+            LOG_ERROR("Waiting on the io_uring failed [errno %d]", errno);
+            Thread::Sleep(1);
+        }
+
+        // Complete every request in the completion queue
+        UInt32 head = *ring->CompleteHead;
+        __sync_synchronize();
+        UInt32 tail = *ring->CompleteTail;
+        while(head != tail)
+        {
+            io_uring_cqe* completion = &ring->CompleteEntries[head & ring->CompleteMask];
+            AsyncIORequest* request = (AsyncIORequest*)(size_t) completion->user_data;
+            int requestResult = completion->res;
+
+            // Hand the entry back to the kernel
+            head++;
+            __sync_synchronize();
+            *ring->CompleteHead = head;
+
+            // An empty entry is the signal to stop
+            if(request == NULL)
+            {
+                stopping = true;
+                continue;
+            }
+
+            ring->SubmitMutex->Lock();
+            ring->NumInFlight--;
+            ring->SubmitMutex->Unlock();
+
+            CompleteRingRequest(request, requestResult);
+        }
+    }
+
+    return NULL;
+}
+
+// *****************************************************************
+/// @brief
+///     Completes a request that came back from the io_uring
+/// @param request
+///     The request
+/// @param result
+///     The number of bytes transferred, or a negative errno value if the read or write failed
+/// @remarks
+///     A short transfer (which the kernel may return, at the end of a file or when interrupted) is finished
+///     with a positioned read or write here, so a request is complete only when all of it is done.
+///     GDK Internal Use Only
+// *****************************************************************
+void AsyncIO::CompleteRingRequest(AsyncIORequest* request, int result)
+{
+    int transferred = result > 0 ? result : 0;
+    if(result > 0 && result < request->size)
+    {
+        UInt8* rest = (UInt8*) request->buffer + result;
+        if(request->type == AsyncIORequest::WriteRequest)
+            transferred += request->stream->WriteAt(rest, request->offset + result, request->size - result);
+        else
+            transferred += request->stream->ReadAt(rest, request->offset + result, request->size - result);
+    }
+
+    request->bytesRead = transferred;
+    request->Complete(transferred == request->size);
+}
+
+#endif
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+
+#include "Stream.h"
+
+namespace Gdk
+{
+    class AssetProvider;
+
+    /// @addtogroup IO
+    /// @{
+
+	// =================================================================================
+    /// @brief
+    ///     Enumeration of the states of an AsyncIORequest
+	// =================================================================================
+	namespace AsyncIOStatus
+	{
+		enum Enum
+		{
+            /// The request is queued, or is being processed by an I/O thread
+			Pending,
+
+            /// The request completed successfully
+			Complete,
+
+            /// The request completed, but failed.  (The asset was not found, or fewer bytes were read or written than requested)
+			Failed
+		};
+	}
+
+	// =================================================================================
+    /// @brief
+    ///     Tracks a single read or write that is being done by the AsyncIO threads.
+    /// @remarks
+    ///     Requests are created by Stream::ReadAsync(), AssetProvider::GetAssetStreamAsync(),
+    ///     AssetManager::GetAssetStreamAsync(), and by write-behind FileStreams.  The caller owns the request, and must GdkDelete it
+    ///     once it is complete.  (Deleting a pending request waits for it to complete first)
+	// =================================================================================
+	class AsyncIORequest
+	{
+	public:
+
+        // Public Methods
+		// ================================
+
+        // ---------------------------------
+        /// @name Constructor / Destructor
+        /// @{
+
+        ~AsyncIORequest();
+
+        /// @}
+
+        // ---------------------------------
+        /// @name Status Methods
+        /// @{
+
+        AsyncIOStatus::Enum GetStatus();
+        bool IsComplete();
+        void Wait();
+
+        /// @}
+
+        // ---------------------------------
+        /// @name Result Methods
+        /// @{
+
+        Int64 GetBytesRead();
+        const string& GetAssetPath();
+        Stream* GetStream();
+
+        /// @}
+
+    private:
+
+        // Private Types
+		// ================================
+
+        friend class AsyncIO;
+
+        // ***********************************************************************
+        enum RequestType
+        {
+            ReadRequest,
+            WriteRequest,
+            AssetStreamRequest
+        };
+
+        // Private Properties
+		// ================================
+
+        // Request details
+        RequestType type;
+        Stream* stream;
+        void* buffer;
+        Int64 offset;
+        int size;
+        AssetProvider* provider;
+        string assetPath;
+
+        // Results
+        volatile AsyncIOStatus::Enum status;
+        Int64 bytesRead;
+        Event* completionEvent;
+
+        // Private Methods
+		// ================================
+
+        AsyncIORequest(RequestType type);
+
+        void Complete(bool succeeded);
+	};
+
+	// =================================================================================
+    /// @brief
+    ///     Static interface to the pool of threads that service asynchronous reads & writes.
+    /// @remarks
+    ///     The resource loader threads each do one blocking read at a time, so the number of
+    ///     reads in flight is normally the number of loader threads.  Loaders can instead hand
+    ///     their reads to the AsyncIO threads, keep several of them in flight at once, and
+    ///     inflate or parse the data that has already arrived in the meantime.
+    ///   @par
+    ///     The number of threads is set by ApplicationSettings::AsyncIOThreads.  With no threads, every
+    ///     request is done on the calling thread, and is complete before it is returned.
+    ///   @par
+    ///     On Linux, reads & writes of FileStreams are submitted straight to the kernel through an io_uring,
+    ///     rather than tying up an I/O thread each.  (The threads still open asset streams, & service any
+    ///     other stream)  If the kernel doesn't support io_uring, every request goes to the I/O threads.
+	// =================================================================================
+	class AsyncIO
+	{
+	public:
+
+        // Public Methods
+		// ================================
+
+        // ---------------------------------
+        /// @name Request Methods
+        /// @{
+
+        static AsyncIORequest* QueueRead(Stream* stream, void* destination, Int64 offset, int size, short priority = 1);
+        static AsyncIORequest* QueueWrite(Stream* stream, void* source, Int64 offset, int size, short priority = 1);
+        static AsyncIORequest* QueueGetAssetStream(AssetProvider* provider, const char* assetPath, short priority = 1);
+
+        /// @}
+
+        // ---------------------------------
+        /// @name Utility Methods
+        /// @{
+
+        static int GetNumThreads();
+        static void SetNumThreads(int numThreads);
+        static bool IsUsingIORing();
+
+        /// @}
+
+    private:
+
+        // Private Types
+		// ================================
+
+        // ***********************************************************************
+        class WorkQueue : public ThreadedWorkQueue<AsyncIORequest*>
+        {
+        public:
+            WorkQueue(int numThreads) : ThreadedWorkQueue<AsyncIORequest*>(numThreads, "AsyncIO")  {}
+
+        protected:
+            virtual void OnProcessWorkItem(AsyncIORequest* request)
+            {
+                AsyncIO::ProcessRequest(request);
+            }
+        };
+
+        // Private Methods
+		// ================================
+
+        friend class Application;
+
+        static void Init(int numThreads);
+        static void Shutdown();
+
+        static void Queue(AsyncIORequest* request, short priority);
+        static void ProcessRequest(AsyncIORequest* request);
+        static Stream* PreloadStream(Stream* stream);
+
+        #ifdef GDKPLATFORM_LINUX
+        // io_uring backend
+        static struct AsyncIORing* CreateRing();
+        static void DestroyRing(struct AsyncIORing* ring);
+        static bool SubmitToRing(AsyncIORequest* request);
+        static void* RingCompletionThread(void* argument);
+        static void CompleteRingRequest(AsyncIORequest* request, int result);
+        #endif
+
+        // Private Properties
+		// ================================
+
+        static WorkQueue* workQueue;
+        static int numThreads;
+
+        #ifdef GDKPLATFORM_LINUX
+        static struct AsyncIORing* ring;
+        #endif
+	};
+
+    /// @} // IO
+
+} // namespace Gdk
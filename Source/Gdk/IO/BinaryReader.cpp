@@ -0,0 +1,374 @@
+/* 
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "BasePCH.h"
+#include "BinaryReader.h"
+
+using namespace Gdk;
+
+// *****************************************************************
+/// @brief
+///     Creates a reader over the given stream, starting at the stream's current position
+/// @param baseStream
+///     The stream to read from.  The reader does not take ownership of the stream.
+/// @param bufferSize
+///     Size (in bytes) of the blocks read from the base stream.  Not used for memory backed streams.
+// *****************************************************************
+BinaryReader::BinaryReader(Stream* baseStream, int bufferSize)
+{
+	this->baseStream = baseStream;
+	this->buffer = NULL;
+	this->bufferSize = bufferSize;
+    
+	// Read from a span of the base stream if we can, otherwise use a block buffer
+	Int64 position = baseStream->GetPosition();
+	const void* span = baseStream->GetSpan(position, baseStream->GetLength() - position);
+	if(span == NULL)
+		this->buffer = (UInt8*) GdkAlloc(bufferSize);
+    
+	ResetWindow(position);
+}
+
+// *****************************************************************
+/// @brief
+///     Destructor
+/// @remarks
+///     Moves the base stream to the position of the reader, if the reader was not already closed.
+// *****************************************************************
+BinaryReader::~BinaryReader()
+{
+	Close();
+    
+	if(this->buffer != NULL)
+		GdkFree(this->buffer);
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the stream this reader is reading from
+// *****************************************************************
+Stream* BinaryReader::GetBaseStream()
+{
+	return this->baseStream;
+}
+
+// *****************************************************************
+/// @brief
+///     Points the readable window at the given position of the base stream
+/// @remarks
+///     For memory backed streams, the window is the span from the position to the end
+///     of the stream.  Otherwise the window is left empty, and the next read fills it.
+// *****************************************************************
+void BinaryReader::ResetWindow(Int64 position)
+{
+	this->windowPosition = position;
+    
+	if(this->buffer == NULL)
+	{
+		Int64 length = baseStream->GetLength();
+		if(position > length)
+			position = length;
+		this->windowPosition = position;
+        
+		const UInt8* span = (const UInt8*) baseStream->GetSpan(position, length - position);
+		this->windowStart = span;
+		this->windowEnd = span + (size_t)(length - position);
+	}
+	else
+	{
+		this->windowStart = this->buffer;
+		this->windowEnd = this->buffer;
+	}
+    
+	this->cursor = this->windowStart;
+}
+
+// *****************************************************************
+/// @brief
+///     Reads the next block of the base stream into the buffer
+// *****************************************************************
+void BinaryReader::FillBuffer()
+{
+	// The base stream is always positioned at the end of the window
+	this->windowPosition += (Int64)(this->windowEnd - this->windowStart);
+    
+	int bytesRead = baseStream->Read(this->buffer, this->bufferSize);
+	this->windowStart = this->buffer;
+	this->windowEnd = this->buffer + (bytesRead > 0 ? bytesRead : 0);
+	this->cursor = this->windowStart;
+}
+
+// *****************************************************************
+/// @brief
+///     Reads a string value from the stream.
+/// @remarks
+///     Strings are stored as a 2-byte string length, followed by the 8-bit characters of the string.
+// *****************************************************************
+string BinaryReader::ReadString()
+{
+	int length = ReadUInt16();
+    
+	// Is the whole string in the window?
+	if(this->cursor + length <= this->windowEnd)
+	{
+		string result((const char*) this->cursor, length);
+		this->cursor += length;
+		return result;
+	}
+    
+	string result(length, '\0');
+	if(length > 0)
+		Read(&result[0], length);
+	return result;
+}
+
+// *****************************************************************
+/// @brief
+///     Borrows a pointer to the next bytes of the stream, and moves past them
+/// @param size
+///     Number of bytes to borrow
+/// @return
+///     A read-only pointer to the bytes, or NULL if the base stream is not memory backed
+///     (or there are not enough bytes left).  If NULL is returned, the position does not change.
+/// @remarks
+///     The pointer is valid for as long as the base stream is open.
+// *****************************************************************
+const void* BinaryReader::ReadSpan(int size)
+{
+	if(this->buffer != NULL || size < 0 || this->cursor + size > this->windowEnd)
+		return NULL;
+    
+	const void* span = this->cursor;
+	this->cursor += size;
+	return span;
+}
+
+// *****************************************************************
+/// @brief
+///     Checks if the stream can be Read from
+// *****************************************************************
+bool BinaryReader::CanRead()
+{
+	return true;
+}
+
+// *****************************************************************
+/// @brief
+///     Checks if the stream can be Written to
+// *****************************************************************
+bool BinaryReader::CanWrite()
+{
+	return false;
+}
+
+// *****************************************************************
+/// @brief
+///     Checks if the current position within the stream can be changed [via the Seek() method] 
+// *****************************************************************
+bool BinaryReader::CanSeek()
+{
+	return baseStream->CanSeek();
+}
+
+// *****************************************************************
+/// @brief
+///     Sets the current position within the stream.
+/// @param position
+///     The new position to set in the stream
+// *****************************************************************
+void BinaryReader::SetPosition(Int64 position)
+{
+	Seek(position, SeekOrigin::Begin);
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the current position within the stream
+// *****************************************************************
+Int64 BinaryReader::GetPosition()
+{
+	return this->windowPosition + (Int64)(this->cursor - this->windowStart);
+}
+
+// *****************************************************************
+/// @brief
+///     Changes the current position within the stream
+/// @param offset
+///     Offset to seek within the stream.
+/// @param origin
+///     Origin which the offset is relative to.
+/// @remarks
+///     Seeks within the current window do not touch the base stream.
+// *****************************************************************
+void BinaryReader::Seek(Int64 offset, SeekOrigin::Enum origin)
+{
+	// Get the absolute position to seek to
+	Int64 position = offset;
+	if(origin == SeekOrigin::Current)
+		position += GetPosition();
+	else if(origin == SeekOrigin::End)
+		position += GetLength();
+    
+	// Is the position within the window?
+	Int64 windowSize = (Int64)(this->windowEnd - this->windowStart);
+	if(position >= this->windowPosition && position <= this->windowPosition + windowSize)
+	{
+		this->cursor = this->windowStart + (size_t)(position - this->windowPosition);
+		return;
+	}
+    
+	// Move the base stream & start a new window
+	if(this->buffer != NULL)
+		baseStream->SetPosition(position);
+	ResetWindow(position);
+}
+
+// *****************************************************************
+/// @brief
+///     Changes the length of the stream. (in bytes)
+/// @note
+///     Not supported for BinaryReaders
+// *****************************************************************
+void BinaryReader::SetLength(Int64 length)
+{
+	ASSERT(false, "BinaryReaders are read-only and can not be resized");
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the length of the base stream.  (in bytes)
+// *****************************************************************
+Int64 BinaryReader::GetLength()
+{
+	return baseStream->GetLength();
+}
+
+// *****************************************************************
+/// @brief
+///     Closes the reader, and moves the base stream to the position of the reader
+/// @remarks
+///     The base stream itself is not closed.
+// *****************************************************************
+void BinaryReader::Close()
+{
+	if(this->baseStream == NULL)
+		return;
+    
+	// Put the base stream where the caller would expect it to be
+	if(baseStream->CanSeek())
+		baseStream->SetPosition(GetPosition());
+    
+	// Detach from the base stream, with an empty window
+	this->baseStream = NULL;
+	this->windowPosition = 0;
+	this->windowStart = this->windowEnd = this->cursor = this->buffer;
+}
+
+// *****************************************************************
+/// @brief
+///     Flushes any intermediate buffers
+/// @note
+///     BinaryReaders are read-only, so this does nothing
+// *****************************************************************
+void BinaryReader::Flush()
+{
+}
+
+// *****************************************************************
+/// @brief
+///     Reads a fixed size set of bytes from the stream into a buffer
+///     and moves the current position within the stream.
+/// @param destination
+///     Buffer to read the bytes into.
+/// @param size
+///     Number of bytes to read.
+// *****************************************************************
+int BinaryReader::Read(void* destination, int size)
+{
+	UInt8* dest = (UInt8*) destination;
+    
+	// Copy what we can from the window  (A span window can be larger than an int)
+	if(size <= this->windowEnd - this->cursor)
+	{
+		memcpy(dest, this->cursor, size);
+		this->cursor += size;
+		return size;
+	}
+    
+	int available = (int)(this->windowEnd - this->cursor);
+	memcpy(dest, this->cursor, available);
+	this->cursor += available;
+    
+	// Reading from a span, the window goes to the end of the stream
+	if(this->buffer == NULL || this->baseStream == NULL)
+		return available;
+    
+	dest += available;
+	size -= available;
+    
+	// Large reads go straight from the base stream into the destination
+	if(size >= this->bufferSize)
+	{
+		this->windowPosition += (Int64)(this->windowEnd - this->windowStart);
+		int bytesRead = baseStream->Read(dest, size);
+		if(bytesRead < 0)
+			bytesRead = 0;
+		this->windowPosition += bytesRead;
+		this->windowStart = this->windowEnd = this->cursor = this->buffer;
+		return available + bytesRead;
+	}
+    
+	// Otherwise, refill the buffer & copy the rest from it
+	FillBuffer();
+	int remaining = (int)(this->windowEnd - this->cursor);
+	if(size > remaining)
+		size = remaining;
+	memcpy(dest, this->cursor, size);
+	this->cursor += size;
+    
+	return available + size;
+}
+
+// *****************************************************************
+/// @brief
+///     Writes a buffer of bytes to the stream
+/// @note
+///     Not supported for BinaryReaders
+// *****************************************************************
+int BinaryReader::Write(void* source, int size)
+{
+	ASSERT(false, "BinaryReaders are read-only");
+	return 0;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets a pointer directly into the memory behind the base stream
+/// @param offset
+///     Offset (from the beginning of the stream) of the first byte of the span
+/// @param size
+///     Number of bytes in the span
+// *****************************************************************
+const void* BinaryReader::GetSpan(Int64 offset, Int64 size)
+{
+	return baseStream != NULL ? baseStream->GetSpan(offset, size) : NULL;
+}
+
+// *****************************************************************
+/// @brief
+///     Reads a fixed size set of bytes from the given offset in the base stream
+/// @param destination
+///     Buffer to read the bytes into.
+/// @param offset
+///     Offset (from the beginning of the stream) of the first byte to read
+/// @param size
+///     Number of bytes to read.
+/// @remarks
+///     The read bypasses the reader's buffer, and does not move the reader's position.
+// *****************************************************************
+int BinaryReader::ReadAt(void* destination, Int64 offset, int size)
+{
+	return baseStream != NULL ? baseStream->ReadAt(destination, offset, size) : 0;
+}
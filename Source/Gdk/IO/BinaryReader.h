@@ -0,0 +1,174 @@
+/* 
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+
+#include "Stream.h"
+
+namespace Gdk
+{
+    /// @addtogroup IO
+    /// @{
+
+	// =================================================================================
+    /// @brief
+    ///     Provides fast, buffered reading of binary data from another stream.
+    /// @remarks
+    ///     Every Stream::ReadXXX() call is a virtual Read() of just a few bytes, which adds up
+    ///     when loading assets with tens of thousands of values.  The BinaryReader reads the base
+    ///     stream in large blocks, and its ReadXXX() methods are inline copies out of that block.
+    ///   @par
+    ///     If the base stream is memory backed (Stream::GetSpan() is supported), the reader
+    ///     reads straight from that memory with no block copies at all.  ReadSpan() can then
+    ///     also be used to borrow pointers into the data.
+    ///   @par
+    ///     The reader is itself a Stream, so it can be passed to any ReadFromStream() method.  
+    ///     The reader reads ahead of its position, so do not use the base stream directly while
+    ///     reading through a reader.  Close() (or the destructor) moves the base stream to the
+    ///     reader's position.
+	// =================================================================================
+	class BinaryReader : public Stream
+	{
+	public:
+        
+        // Public Methods
+		// ================================
+        
+        // ---------------------------------
+        /// @name Constructor / Destructor
+        /// @{
+        
+		BinaryReader(Stream* baseStream, int bufferSize = 4096); 
+        virtual ~BinaryReader();
+	    
+        /// @}
+        
+        // ---------------------------------
+        /// @name Reader Methods
+        /// @{
+        
+		Stream* GetBaseStream();
+        
+		/// @brief
+        ///     Reads a bool value from the stream.
+        inline bool ReadBool()		{return ReadValue<Int8>() != 0;}
+        
+        /// @brief
+        ///     Reads an Int8 value from the stream.
+        inline Int8 ReadInt8()		{return ReadValue<Int8>();}
+        
+        /// @brief
+        ///     Reads an Int16 value from the stream.
+        inline Int16 ReadInt16()	{return ReadValue<Int16>();}
+        
+        /// @brief
+        ///     Reads an Int32 value from the stream.
+        inline Int32 ReadInt32()	{return ReadValue<Int32>();}
+        
+        /// @brief
+        ///     Reads an Int64 value from the stream.
+        inline Int64 ReadInt64()	{return ReadValue<Int64>();}
+        
+        /// @brief
+        ///     Reads an UInt8 value from the stream.
+        inline UInt8 ReadUInt8()	{return ReadValue<UInt8>();}
+        
+        /// @brief
+        ///     Reads an UInt16 value from the stream.
+        inline UInt16 ReadUInt16()	{return ReadValue<UInt16>();}
+        
+        /// @brief
+        ///     Reads an UInt32 value from the stream.
+        inline UInt32 ReadUInt32()	{return ReadValue<UInt32>();}
+        
+        /// @brief
+        ///     Reads an UInt64 value from the stream.
+        inline UInt64 ReadUInt64()	{return ReadValue<UInt64>();}
+        
+        /// @brief
+        ///     Reads a float value from the stream.
+        inline float ReadFloat()	{return ReadValue<float>();}
+        
+        /// @brief
+        ///     Reads a double value from the stream.
+        inline double ReadDouble()	{return ReadValue<double>();}
+        
+        std::string ReadString();
+        
+        const void* ReadSpan(int size);
+        
+        /// @}
+		        
+        // ---------------------------------
+        /// @name Override Methods
+        /// @{
+        
+		virtual bool CanRead();
+		virtual bool CanWrite();
+		virtual bool CanSeek();
+		virtual void SetPosition(Int64 position);
+        virtual Int64 GetPosition();
+		virtual void Seek(Int64 offset, SeekOrigin::Enum origin);
+		virtual void SetLength(Int64 length);
+		virtual Int64 GetLength();
+		virtual void Close();
+		virtual void Flush();
+        
+		virtual int Read(void* destination, int size);
+		virtual int ReadAt(void* destination, Int64 offset, int size);
+        virtual int Write(void* source, int size);
+        virtual const void* GetSpan(Int64 offset, Int64 size);
+        
+        /// @}
+ 
+    private:
+        
+        // Private Properties
+		// ================================
+        
+		Stream* baseStream;
+        
+		// The window of the base stream that is currently readable  (Either the block buffer, or a span of the base stream)
+		const UInt8* windowStart;
+		const UInt8* windowEnd;
+		const UInt8* cursor;
+		Int64 windowPosition;
+        
+		// Block buffer  (NULL when reading directly from a span of the base stream)
+		UInt8* buffer;
+		int bufferSize;
+        
+        // Private Methods
+		// ================================
+        
+		// *****************************************************************
+		/// @brief
+		///     Reads a single value, from the window if it is all there
+		// *****************************************************************
+		template<typename T>
+		inline T ReadValue()
+		{
+			T value;
+			if(cursor + sizeof(T) <= windowEnd)
+			{
+				memcpy(&value, cursor, sizeof(T));
+				cursor += sizeof(T);
+			}
+			else
+			{
+				memset(&value, 0, sizeof(T));
+				Read(&value, sizeof(T));
+			}
+			return value;
+		}
+        
+		void ResetWindow(Int64 position);
+		void FillBuffer();
+	};
+    
+    /// @} // IO
+
+} // namespace Gdk
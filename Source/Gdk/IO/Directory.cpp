@@ -11,10 +11,75 @@
 
 #ifdef GDKPLATFORM_WINDOWS
 #include <direct.h>
+#else
+#include <dirent.h>
 #endif
 
 using namespace Gdk;
 
+// *****************************************************************
+/// @brief
+///     Deletes all the files & sub-directories in a directory, leaving the directory itself
+// *****************************************************************
+static void DeleteDirectoryContents(const string& directoryPath)
+{
+#ifdef GDKPLATFORM_WINDOWS
+    
+    WIN32_FIND_DATAA findData;
+    string searchPath = Path::Combine(directoryPath.c_str(), "*");
+    HANDLE findHandle = FindFirstFileA(searchPath.c_str(), &findData);
+    if(findHandle == INVALID_HANDLE_VALUE)
+        return;
+    
+    do
+    {
+        string name = findData.cFileName;
+        if(name == "." || name == "..")
+            continue;
+        
+        string fullPath = Path::Combine(directoryPath.c_str(), name.c_str());
+        if(findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+        {
+            DeleteDirectoryContents(fullPath);
+            _rmdir(fullPath.c_str());
+        }
+        else
+            remove(fullPath.c_str());
+    } 
+    while(FindNextFileA(findHandle, &findData));
+    
+    FindClose(findHandle);
+    
+#else
+    
+    DIR* dir = opendir(directoryPath.c_str());
+    if(dir == NULL)
+        return;
+    
+    struct dirent* entry;
+    while((entry = readdir(dir)) != NULL)
+    {
+        string name = entry->d_name;
+        if(name == "." || name == "..")
+            continue;
+        
+        // Dont follow links to directories, just remove the link
+        string fullPath = Path::Combine(directoryPath.c_str(), name.c_str());
+        struct stat entryStat;
+        if(lstat(fullPath.c_str(), &entryStat) == 0 && S_ISDIR(entryStat.st_mode))
+        {
+            DeleteDirectoryContents(fullPath);
+            rmdir(fullPath.c_str());
+        }
+        else
+            unlink(fullPath.c_str());
+    }
+    
+    closedir(dir);
+    
+#endif
+}
+
 // *****************************************************************
 /// @brief
 ///     Creates a new directory.
@@ -69,7 +134,14 @@ bool Directory::Exists(const char* directoryPath)
 // *****************************************************************
 void Directory::Delete(const char* directoryPath, bool recursive)
 {
-	remove(directoryPath);
+    if(recursive)
+        DeleteDirectoryContents(directoryPath);
+    
+#ifdef GDKPLATFORM_WINDOWS
+	_rmdir(directoryPath);
+#else
+	rmdir(directoryPath);
+#endif
 }
 
 // *****************************************************************
@@ -86,3 +158,90 @@ void Directory::Move(const char* originalFilePath, const char* newFilePath)
 {
 	rename(originalFilePath, newFilePath);
 }
+
+// *****************************************************************
+/// @brief
+///     Gets the files in a directory, and optionally in all of its sub-directories
+/// @param directoryPath
+///     Path of the directory to search.
+/// @param files
+///     [Out] The paths of the files are added to this vector.  The paths are relative to the
+///     directoryPath, with '/' separators.  (For example: "Textures/Grass.gdkimage")
+/// @param recursive
+///     Specify true to also get the files in all the sub-directories
+/// @note
+///     Use the '/' forward-slash path delimiter to ensure cross-platform support.
+// *****************************************************************
+void Directory::GetFiles(const char* directoryPath, vector<string>& files, bool recursive)
+{
+    // Directories still to be searched, relative to the directoryPath
+    vector<string> folders;
+    folders.push_back("");
+    
+    while(folders.empty() == false)
+    {
+        string relativeFolder = folders.back();
+        folders.pop_back();
+        string folder = relativeFolder.empty() ? string(directoryPath) : Path::Combine(directoryPath, relativeFolder.c_str());
+        
+#ifdef GDKPLATFORM_WINDOWS
+        
+        WIN32_FIND_DATAA findData;
+        string searchPath = Path::Combine(folder.c_str(), "*");
+        HANDLE findHandle = FindFirstFileA(searchPath.c_str(), &findData);
+        if(findHandle == INVALID_HANDLE_VALUE)
+            continue;
+        
+        do
+        {
+            string name = findData.cFileName;
+            if(name == "." || name == "..")
+                continue;
+            
+            string relativePath = relativeFolder.empty() ? name : relativeFolder + "/" + name;
+            if(findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+            {
+                if(recursive)
+                    folders.push_back(relativePath);
+            }
+            else
+                files.push_back(relativePath);
+        } 
+        while(FindNextFileA(findHandle, &findData));
+        
+        FindClose(findHandle);
+        
+#else
+        
+        DIR* dir = opendir(folder.c_str());
+        if(dir == NULL)
+            continue;
+        
+        struct dirent* entry;
+        while((entry = readdir(dir)) != NULL)
+        {
+            string name = entry->d_name;
+            if(name == "." || name == "..")
+                continue;
+            
+            // Stat the entry, as not all file systems fill in dirent::d_type
+            string relativePath = relativeFolder.empty() ? name : relativeFolder + "/" + name;
+            string fullPath = Path::Combine(directoryPath, relativePath.c_str());
+            struct stat entryStat;
+            if(stat(fullPath.c_str(), &entryStat) != 0)
+                continue;
+            
+            if(S_ISDIR(entryStat.st_mode))
+            {
+                if(recursive)
+                    folders.push_back(relativePath);
+            }
+            else if(S_ISREG(entryStat.st_mode))
+                files.push_back(relativePath);
+        }
+        
+        closedir(dir);
+        
+#endif
+    }
+}
@@ -31,12 +31,12 @@ namespace Gdk
         static bool Exists(const char* directoryPath);
 		static void Delete(const char* directoryPath, bool recursive);
 		static void Move(const char* originalDirectoryPath, const char* newDirectoryPath);
+		static void GetFiles(const char* directoryPath, vector<string>& files, bool recursive);
 
         /// @}
         
 		// TODO(P2): 
 		//   Get Child Dirs
-		//   Get Child Files
 		//   Search with wildcards!
 	    
 	};
@@ -10,19 +10,89 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 
+#ifndef GDKPLATFORM_WINDOWS
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+#ifdef GDKPLATFORM_APPLE
+    #include <copyfile.h>
+#endif
+#ifdef __linux__
+    #include <sys/sendfile.h>
+    #include <sys/syscall.h>
+#endif
+
+// Size of the buffer used by the fallback File::Copy()
+#define FILE_COPY_BUFFER_SIZE   (1024 * 1024)
+
 using namespace Gdk;
 
+#ifndef GDKPLATFORM_WINDOWS
+
+// *****************************************************************
+/// @brief
+///     Copies the contents of one file descriptor to another, without passing the data through user memory
+/// @return
+///     true if the whole file was copied.  false if the platform has no such copy, or it failed.
+// *****************************************************************
+static bool CopyFileContents(int sourceFd, int outputFd, Int64 length)
+{
+#if defined(GDKPLATFORM_APPLE)
+    
+    return fcopyfile(sourceFd, outputFd, NULL, COPYFILE_DATA) == 0;
+    
+#elif defined(__linux__)
+    
+    Int64 bytesCopied = 0;
+    
+    // copy_file_range() copies within the kernel, & can share the extents on file systems that support it
+    #ifdef SYS_copy_file_range
+    while(bytesCopied < length)
+    {
+        size_t blockSize = length - bytesCopied > (1 << 30) ? (1 << 30) : (size_t)(length - bytesCopied);
+        long result = syscall(SYS_copy_file_range, sourceFd, NULL, outputFd, NULL, blockSize, 0);
+        if(result <= 0)
+            break;
+        bytesCopied += result;
+    }
+    if(bytesCopied == length)
+        return true;
+    #endif
+    
+    // Older kernels (& copies between file systems) fall back to sendfile()
+    while(bytesCopied < length)
+    {
+        off_t offset = (off_t) bytesCopied;
+        size_t blockSize = length - bytesCopied > (1 << 30) ? (1 << 30) : (size_t)(length - bytesCopied);
+        ssize_t result = sendfile(outputFd, sourceFd, &offset, blockSize);
+        if(result <= 0)
+            break;
+        bytesCopied += result;
+    }
+    return bytesCopied == length;
+    
+#else
+    
+    return false;
+    
+#endif
+}
+
+#endif
+
 // *****************************************************************
 /// @brief
 ///     Creates or overwrites a file at the specified path.
 /// @param filePath
 ///     Path and name of the file to create.
+/// @return
+///     The stream to the new file, or NULL if the file could not be created.  (The error is logged)
 /// @note
 ///     Use the '/' forward-slash path delimiter to ensure cross-platform support.
 // *****************************************************************
 FileStream* File::Create(const char* filePath)
 {
-	return GdkNew FileStream(filePath, FileMode::Write);
+	return Open(filePath, FileMode::Write);
 }
 
 // *****************************************************************
@@ -32,12 +102,20 @@ FileStream* File::Create(const char* filePath)
 ///     Path and name of the file to open.
 /// @param mode
 ///     Read/Write mode to use when opening the file.
+/// @return
+///     The stream to the file, or NULL if the file could not be opened.  (The error is logged)
 /// @note
 ///     Use the '/' forward-slash path delimiter to ensure cross-platform support.
 // *****************************************************************
 FileStream* File::Open(const char* filePath, FileMode::Enum mode)
 {
-	return GdkNew FileStream(filePath, mode);
+	FileStream* stream = GdkNew FileStream(filePath, mode);
+	if(stream->IsOpen() == false)
+	{
+		GdkDelete( stream );
+		return NULL;
+	}
+	return stream;
 }
 
 // *****************************************************************
@@ -69,14 +147,20 @@ bool File::Exists(const char* filePath)
 /// @note
 ///     Use the '/' forward-slash path delimiter to ensure cross-platform support.
 // *****************************************************************
-int File::GetFileSize(const char* filePath)
+Int64 File::GetFileSize(const char* filePath)
 {
-	// Get the file stats
+	// Get the file stats  (With a 64-bit size on Windows, where stat() has a 32-bit size)
+#ifdef GDKPLATFORM_WINDOWS
+	struct _stat64 fileStat;
+	if(_stat64(filePath, &fileStat) != 0)
+        return 0;
+#else
 	struct stat fileStat;
-	//int result = 
-        stat(filePath, &fileStat);
+	if(stat(filePath, &fileStat) != 0)
+        return 0;
+#endif
 
-	return (int) fileStat.st_size;
+	return (Int64) fileStat.st_size;
 }
 
 // *****************************************************************
@@ -99,12 +183,22 @@ void File::Delete(const char* filePath)
 ///     Path and name of the source file
 /// @param newFilePath
 ///     Path to the new location for the file.
+/// @remarks
+///     An existing file at the new path is replaced.  Moves between volumes are done as a copy & delete.
 /// @note
 ///     Use the '/' forward-slash path delimiter to ensure cross-platform support.
 // *****************************************************************
 void File::Move(const char* originalFilePath, const char* newFilePath)
 {
-	rename(originalFilePath, newFilePath);
+#ifdef GDKPLATFORM_WINDOWS
+    MoveFileExA(originalFilePath, newFilePath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_COPY_ALLOWED);
+#else
+	if(rename(originalFilePath, newFilePath) != 0 && errno == EXDEV)
+    {
+        Copy(originalFilePath, newFilePath);
+        Delete(originalFilePath);
+    }
+#endif
 }
 
 // *****************************************************************
@@ -114,11 +208,43 @@ void File::Move(const char* originalFilePath, const char* newFilePath)
 ///     Path and name of the source file to copy.
 /// @param newFilePath
 //      Path and name of the new file.
+/// @remarks
+///     The copy is done by the OS where possible.  (CopyFile on Windows, fcopyfile on Apple platforms, 
+///     copy_file_range / sendfile on Linux)  Otherwise the file is copied through a buffer.
 /// @note
 ///     Use the '/' forward-slash path delimiter to ensure cross-platform support.
 // *****************************************************************
 void File::Copy(const char* originalFilePath, const char* newFilePath)
 {
+    // Let the OS copy the file, without reading it into memory
+#ifdef GDKPLATFORM_WINDOWS
+    if(CopyFileA(originalFilePath, newFilePath, FALSE))
+        return;
+#else
+    int sourceFd = open(originalFilePath, O_RDONLY);
+    if(sourceFd >= 0)
+    {
+        struct stat sourceStat;
+        bool copied = false;
+        if(fstat(sourceFd, &sourceStat) == 0)
+        {
+            int outputFd = open(newFilePath, O_WRONLY | O_CREAT | O_TRUNC, sourceStat.st_mode & 0777);
+            if(outputFd >= 0)
+            {
+                copied = CopyFileContents(sourceFd, outputFd, (Int64) sourceStat.st_size);
+                close(outputFd);
+            }
+        }
+        close(sourceFd);
+        
+        if(copied)
+            return;
+    }
+#endif
+    
+    // Otherwise, copy through a buffer
+    // ------------------------------------
+    
     // Open the source file stream
     FileStream* source = Open(originalFilePath, FileMode::Read);
 
@@ -126,25 +252,30 @@ void File::Copy(const char* originalFilePath, const char* newFilePath)
     FileStream* output = Open(newFilePath, FileMode::Write);
     
     // Loop through the file, a chunk at a time
-    char tempBuffer[16000];
-    int bytesLeft = source->GetLength();
+    char* tempBuffer = (char*) GdkAlloc(FILE_COPY_BUFFER_SIZE);
+    Int64 bytesLeft = source->GetLength();
     while(bytesLeft > 0)
     {
-        int bytesToCopy = bytesLeft;
-        if(bytesToCopy > 16000)
-            bytesToCopy = 16000;
+        int bytesToCopy = FILE_COPY_BUFFER_SIZE;
+        if(bytesLeft < bytesToCopy)
+            bytesToCopy = (int) bytesLeft;
         
         // Read the next chunk from the source file
-        source->Read(tempBuffer, bytesToCopy);
+        int bytesRead = source->Read(tempBuffer, bytesToCopy);
+        if(bytesRead <= 0)
+            break;
         
         // Write the chunk to the output file
-        output->Write(tempBuffer, bytesToCopy);
+        output->Write(tempBuffer, bytesRead);
         
         // Decrement the bytes counter
-        bytesLeft -= bytesToCopy;
+        bytesLeft -= bytesRead;
     }
+    GdkFree(tempBuffer);
     
     // Close the streams
     source->Close();
     output->Close();
+    GdkDelete( source );
+    GdkDelete( output );
 }
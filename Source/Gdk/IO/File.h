@@ -32,7 +32,7 @@ namespace Gdk
 		static FileStream* Create(const char* filePath);
         static FileStream* Open(const char* filePath, FileMode::Enum mode);
 		static bool Exists(const char* filePath);
-		static int GetFileSize(const char* filePath);
+		static Int64 GetFileSize(const char* filePath);
 		static void Delete(const char* filePath);
 		static void Move(const char* originalFilePath, const char* newFilePath);
 		static void Copy(const char* originalFilePath, const char* newFilePath);
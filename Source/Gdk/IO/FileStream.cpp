@@ -6,25 +6,169 @@
 #include "BasePCH.h"
 #include "FileStream.h"
 
+#ifdef GDKPLATFORM_WINDOWS
+#include <io.h>
+#else
+#include <unistd.h>
+#include <sys/uio.h>
+#endif
+
+// 64-bit file seeking
+#ifdef GDKPLATFORM_WINDOWS
+    #define GDK_FSEEK(file, offset, origin)     _fseeki64(file, offset, origin)
+    #define GDK_FTELL(file)                     _ftelli64(file)
+#else
+    #define GDK_FSEEK(file, offset, origin)     fseeko(file, (off_t) offset, origin)
+    #define GDK_FTELL(file)                     ((Int64) ftello(file))
+#endif
+
+// Size of each of the two buffers of a write-behind stream
+#define FILESTREAM_WRITEBEHIND_BUFFER_SIZE  (256 * 1024)
+
+// Vectored reads & writes smaller than this go through the stdio buffer, rather than readv() / writev()
+#define FILESTREAM_VECTORED_MIN_SIZE        (64 * 1024)
+
+// Most buffers passed to a single readv() / writev()
+#define FILESTREAM_MAX_IOVECS               64
+
 using namespace std;
 using namespace Gdk;
 
+#ifdef GDKPLATFORM_WINDOWS
+
+// *****************************************************************
+/// @brief
+///     Reads or writes a block at the given offset of a file, without moving the position of the stream
+/// @param positionedHandle
+///     The stream's second handle to the file, or INVALID_HANDLE_VALUE if it couldn't be opened
+/// @return
+///     Number of bytes transferred
+/// @remarks
+///     A ReadFile / WriteFile at an OVERLAPPED offset, on a synchronous handle, still leaves the handle's file
+///     pointer after the transferred bytes.  So the transfer goes through the second handle, whose pointer
+///     nothing else uses.  Without one, the pointer of the stdio handle is saved & restored instead.
+// *****************************************************************
+static int TransferAt(HANDLE positionedHandle, FILE* file, void* buffer, Int64 offset, int size, bool write)
+{
+    HANDLE handle = positionedHandle;
+    LARGE_INTEGER savedPosition;
+    LARGE_INTEGER zero;
+    zero.QuadPart = 0;
+    if(handle == INVALID_HANDLE_VALUE)
+    {
+        handle = (HANDLE) _get_osfhandle(_fileno(file));
+        SetFilePointerEx(handle, zero, &savedPosition, FILE_CURRENT);
+    }
+    
+    OVERLAPPED overlapped;
+    memset(&overlapped, 0, sizeof(overlapped));
+    overlapped.Offset = (DWORD) offset;
+    overlapped.OffsetHigh = (DWORD) (offset >> 32);
+    
+    DWORD bytesTransferred = 0;
+    BOOL result = write ? WriteFile(handle, buffer, (DWORD) size, &bytesTransferred, &overlapped)
+                        : ReadFile(handle, buffer, (DWORD) size, &bytesTransferred, &overlapped);
+    
+    if(handle != positionedHandle)
+        SetFilePointerEx(handle, savedPosition, NULL, FILE_BEGIN);
+    
+    return result == FALSE ? 0 : (int) bytesTransferred;
+}
+
+#else
+
+// *****************************************************************
+/// @brief
+///     Reads or writes a set of buffers at the given offset of a file descriptor, with readv() / writev()
+/// @return
+///     Total number of bytes transferred
+// *****************************************************************
+static int TransferVectored(int fd, const StreamBuffer* buffers, int count, Int64 offset, bool write)
+{
+    if(lseek(fd, (off_t) offset, SEEK_SET) < 0)
+        return 0;
+    
+    int totalTransferred = 0;
+    int bufferIndex = 0;
+    int bufferOffset = 0;
+    while(bufferIndex < count)
+    {
+        // Gather the next batch of buffers
+        struct iovec vectors[FILESTREAM_MAX_IOVECS];
+        int numVectors = 0;
+        int batchSize = 0;
+        for(int index = bufferIndex; index < count && numVectors < FILESTREAM_MAX_IOVECS; index++)
+        {
+            int skip = index == bufferIndex ? bufferOffset : 0;
+            vectors[numVectors].iov_base = (UInt8*) buffers[index].Data + skip;
+            vectors[numVectors].iov_len = buffers[index].Size - skip;
+            batchSize += buffers[index].Size - skip;
+            numVectors++;
+        }
+        
+        ssize_t result = write ? writev(fd, vectors, numVectors) : readv(fd, vectors, numVectors);
+        if(result <= 0)
+            break;
+        totalTransferred += (int) result;
+        
+        // Step past the transferred bytes
+        ssize_t bytesLeft = result;
+        while(bytesLeft > 0 && bufferIndex < count)
+        {
+            int remaining = buffers[bufferIndex].Size - bufferOffset;
+            if(bytesLeft >= remaining)
+            {
+                bytesLeft -= remaining;
+                bufferIndex++;
+                bufferOffset = 0;
+            }
+            else
+            {
+                bufferOffset += (int) bytesLeft;
+                bytesLeft = 0;
+            }
+        }
+        
+        // A short read means the end of the file was reached
+        if(write == false && result < batchSize)
+            break;
+    }
+    
+    return totalTransferred;
+}
+
+#endif
+
 // *****************************************************************
 /// @brief
 ///     Creates a file stream to the given file path
 /// @param filePath
 ///     Path and name of the file.
+/// @param mode
+///     Whether to read or write the file.  FileMode::WriteBehind writes the file from the AsyncIO threads.
 /// @note
 ///     If the file already exists, it is opened, with the stream position at the beginning of the file.
 ///     If the file does not exist, a new one is created.
+///   @par
+///     If the file can not be opened, the stream is left closed & an error is logged.  Use IsOpen() to check.
 // *****************************************************************
 FileStream::FileStream(const char *filePath, FileMode::Enum mode)
 {
 	file = NULL;
+	writeBuffer = NULL;
+	writeBufferUsed = 0;
+	writeBufferOffset = 0;
+	pendingBuffer = NULL;
+	pendingWrite = NULL;
+	writeBehindLength = 0;
+	writeBehindFailed = false;
+	#ifdef GDKPLATFORM_WINDOWS
+	positionedHandle = INVALID_HANDLE_VALUE;
+	#endif
 	
 	// Select the file mode string for the fopen call
 	const char *fopenMode = "rb";
-	if(mode == FileMode::Write)
+	if(mode == FileMode::Write || mode == FileMode::WriteBehind)
 		fopenMode = "wb";
 
 	// Open the file stream
@@ -32,22 +176,38 @@ FileStream::FileStream(const char *filePath, FileMode::Enum mode)
 		
 		errno_t result = fopen_s(&file, filePath, fopenMode);
 
-		// Asset the file opened
-		#ifdef GDK_ASSERTS
-		char errString[256];
-		strerror_s(errString, 256, errno);
-		ASSERT(result == 0 && file != NULL, "Failed to open the file [%s] Result(%d) Error(%d): %s", filePath, result, errno, errString);
-		#endif
+		// Did the file open?
+		if(result != 0 || file == NULL)
+		{
+			char errString[256];
+			strerror_s(errString, 256, errno);
+			LOG_ERROR("Failed to open the file [%s] Result(%d) Error(%d): %s", filePath, result, errno, errString);
+			file = NULL;
+		}
+		else
+		{
+			// Open a second handle to the file, for ReadAt() & WriteAt()  (See TransferAt)
+			DWORD access = mode == FileMode::Read ? GENERIC_READ : GENERIC_WRITE;
+			positionedHandle = ReOpenFile((HANDLE) _get_osfhandle(_fileno(file)), access, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, 0);
+		}
 	#else
 		
 		file = fopen(filePath, fopenMode);
 
-		// Asset the file opened
-		ASSERT(file != NULL, "Failed to open the file [%s] Error(%d): %s", filePath, errno, sys_errlist[errno]);
+		// Did the file open?
+		if(file == NULL)
+			LOG_ERROR("Failed to open the file [%s] Error(%d): %s", filePath, errno, strerror(errno));
 
 	#endif
         
 	this->mode = mode;
+    
+	// Write-behind streams fill one buffer, while the other is being written
+	if(mode == FileMode::WriteBehind && file != NULL)
+	{
+		writeBuffer = (UInt8*) GdkAlloc(FILESTREAM_WRITEBEHIND_BUFFER_SIZE);
+		pendingBuffer = (UInt8*) GdkAlloc(FILESTREAM_WRITEBEHIND_BUFFER_SIZE);
+	}
 }
 
 // *****************************************************************
@@ -62,6 +222,15 @@ FileStream::~FileStream()
 	Close();
 }
 
+// *****************************************************************
+/// @brief
+///     Checks if the file was successfully opened  (And has not been closed)
+// *****************************************************************
+bool FileStream::IsOpen()
+{
+	return this->file != NULL;
+}
+
 // *****************************************************************
 /// @brief
 ///     Checks if the stream can be Read from
@@ -77,7 +246,7 @@ bool FileStream::CanRead()
 // *****************************************************************
 bool FileStream::CanWrite()
 {
-	return this->mode == FileMode::Write;
+	return this->mode == FileMode::Write || this->mode == FileMode::WriteBehind;
 }
 
 // *****************************************************************
@@ -95,18 +264,32 @@ bool FileStream::CanSeek()
 /// @param position
 ///     The new position to set in the stream
 // *****************************************************************
-void FileStream::SetPosition(int position)
+void FileStream::SetPosition(Int64 position)
 {
-	fseek(this->file, position, SEEK_SET);
+	// Write-behind streams start a new buffer at the new position
+	if(writeBuffer != NULL)
+	{
+		if(position != writeBufferOffset + writeBufferUsed)
+		{
+			QueueWriteBehind();
+			writeBufferOffset = position;
+		}
+		return;
+	}
+    
+	GDK_FSEEK(this->file, position, SEEK_SET);
 }
 
 // *****************************************************************
 /// @brief
 ///     Gets the current position within the stream
 // *****************************************************************
-int FileStream::GetPosition()
+Int64 FileStream::GetPosition()
 {
-	return ftell(this->file);
+	if(writeBuffer != NULL)
+		return writeBufferOffset + writeBufferUsed;
+    
+	return GDK_FTELL(this->file);
 }
 
 // *****************************************************************
@@ -117,14 +300,25 @@ int FileStream::GetPosition()
 /// @param origin
 ///     Origin which the offset is relative to.
 // *****************************************************************
-void FileStream::Seek(int offset, SeekOrigin::Enum origin)
+void FileStream::Seek(Int64 offset, SeekOrigin::Enum origin)
 {
+	if(writeBuffer != NULL)
+	{
+		if(origin == SeekOrigin::Begin)
+			SetPosition(offset);
+		else if(origin == SeekOrigin::End)
+			SetPosition(writeBehindLength + offset);
+		else
+			SetPosition(GetPosition() + offset);
+		return;
+	}
+    
 	if(origin == SeekOrigin::Begin)
-		fseek(this->file, offset, SEEK_SET);
+		GDK_FSEEK(this->file, offset, SEEK_SET);
 	else if(origin == SeekOrigin::End)
-		fseek(this->file, offset, SEEK_END);
+		GDK_FSEEK(this->file, offset, SEEK_END);
 	else
-		fseek(this->file, offset, SEEK_CUR);
+		GDK_FSEEK(this->file, offset, SEEK_CUR);
 }
 
 // *****************************************************************
@@ -135,7 +329,7 @@ void FileStream::Seek(int offset, SeekOrigin::Enum origin)
 /// @note
 ///     Not supported for FileStreams
 // *****************************************************************
-void FileStream::SetLength(int length)
+void FileStream::SetLength(Int64 length)
 {
 	// TODO(P2):   Implement stream re-sizing for file streams
 }
@@ -144,17 +338,21 @@ void FileStream::SetLength(int length)
 /// @brief
 ///     Gets the current length of the stream.  (in bytes)
 // *****************************************************************
-int FileStream::GetLength()
+Int64 FileStream::GetLength()
 {
+	// Write-behind streams track the length themselves, as the file may not have caught up yet
+	if(writeBuffer != NULL)
+		return writeBehindLength;
+    
 	// Store the current cursor
 	fpos_t currentPosition;
 	fgetpos(this->file, &currentPosition);
 
 	// Move to the end of the file
-	fseek(this->file, 0, SEEK_END);
+	GDK_FSEEK(this->file, 0, SEEK_END);
 
 	// Get the file size
-	int length = ftell(this->file);
+	Int64 length = GDK_FTELL(this->file);
 
 	// Restore the cusor
 	fsetpos(this->file, &currentPosition);
@@ -165,16 +363,37 @@ int FileStream::GetLength()
 // *****************************************************************
 /// @brief
 ///     Closes the stream
+/// @remarks
+///     Write-behind streams wait for their buffered bytes to be written first.
 // *****************************************************************
 void FileStream::Close()
 {
-	// If the stream is open, close it
+	// Finish the write-behind writes
+	if(writeBuffer != NULL)
+	{
+		QueueWriteBehind();
+		WaitForWriteBehind();
+        
+		GdkFree(writeBuffer);
+		GdkFree(pendingBuffer);
+		writeBuffer = NULL;
+		pendingBuffer = NULL;
+	}
+    
+	// If the stream is open, close it.  (fclose flushes the stdio buffer)
 	if(this->file != NULL)
 	{
-		fflush(this->file);
 		fclose(this->file);
 		this->file = NULL;
 	}
+	
+	#ifdef GDKPLATFORM_WINDOWS
+	if(this->positionedHandle != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(this->positionedHandle);
+		this->positionedHandle = INVALID_HANDLE_VALUE;
+	}
+	#endif
 }
 
 // *****************************************************************
@@ -184,6 +403,14 @@ void FileStream::Close()
 // *****************************************************************
 void FileStream::Flush()
 {
+	// Write out the write-behind buffer, & wait for it to reach the file
+	if(writeBuffer != NULL)
+	{
+		QueueWriteBehind();
+		WaitForWriteBehind();
+		return;
+	}
+    
 	// Flush the stream
 	fflush(this->file);
 }
@@ -199,7 +426,53 @@ void FileStream::Flush()
 // *****************************************************************
 int FileStream::Read(void* destination, int size)
 {
-	return (int) fread(destination, 1, size, this->file);
+	ResourceLoadTimer loadTimer(ResourceLoadPhase::Read);
+	int bytesRead = (int) fread(destination, 1, size, this->file);
+	ResourceLoadStats::AddBytes(ResourceLoadPhase::Read, bytesRead);
+	return bytesRead;
+}
+
+// *****************************************************************
+/// @brief
+///     Reads a fixed size set of bytes from the given offset in the file,
+///     without using or moving the current position.
+/// @param destination
+///     Buffer to read the bytes into.
+/// @param offset
+///     Offset (from the beginning of the file) of the first byte to read
+/// @param size
+///     Number of bytes to read.
+/// @remarks
+///     The read goes straight to the file descriptor, so it is safe to do from several threads at once.  
+///     It does not see data that is still buffered by Write(), so Flush() before reading back written data.
+// *****************************************************************
+int FileStream::ReadAt(void* destination, Int64 offset, int size)
+{
+    ResourceLoadTimer loadTimer(ResourceLoadPhase::Read);
+    
+#ifdef GDKPLATFORM_WINDOWS
+    
+    // Read through the second OS file handle, so the stream position is not touched
+    int bytesRead = TransferAt(this->positionedHandle, this->file, destination, offset, size, false);
+    ResourceLoadStats::AddBytes(ResourceLoadPhase::Read, bytesRead);
+    return bytesRead;
+    
+#else
+    
+    // Read through the file descriptor, with pread() so the stdio position is not touched
+    int fd = fileno(this->file);
+    int totalRead = 0;
+    while(totalRead < size)
+    {
+        ssize_t bytesRead = pread(fd, (UInt8*)destination + totalRead, size - totalRead, (off_t)(offset + totalRead));
+        if(bytesRead <= 0)
+            break;
+        totalRead += (int) bytesRead;
+    }
+    ResourceLoadStats::AddBytes(ResourceLoadPhase::Read, totalRead);
+    return totalRead;
+    
+#endif
 }
 
 // *****************************************************************
@@ -210,8 +483,208 @@ int FileStream::Read(void* destination, int size)
 ///     Buffer of bytes to be written.
 /// @param size
 ///     Number of bytes to write.
+/// @remarks
+///     Write-behind streams copy the bytes into the write buffer, & return right away.  If an earlier
+///     buffer failed to be written, nothing more is written.
 // *****************************************************************
 int FileStream::Write(void* source, int size)
 {
+	if(writeBuffer != NULL)
+	{
+		if(writeBehindFailed)
+			return 0;
+        
+		// Fill the write buffer, queueing it whenever it is full
+		const UInt8* bytes = (const UInt8*) source;
+		int bytesLeft = size;
+		while(bytesLeft > 0)
+		{
+			if(writeBufferUsed == FILESTREAM_WRITEBEHIND_BUFFER_SIZE)
+				QueueWriteBehind();
+            
+			int bytesToCopy = FILESTREAM_WRITEBEHIND_BUFFER_SIZE - writeBufferUsed;
+			if(bytesToCopy > bytesLeft)
+				bytesToCopy = bytesLeft;
+            
+			memcpy(writeBuffer + writeBufferUsed, bytes, bytesToCopy);
+			writeBufferUsed += bytesToCopy;
+			bytes += bytesToCopy;
+			bytesLeft -= bytesToCopy;
+		}
+        
+		Int64 end = writeBufferOffset + writeBufferUsed;
+		if(end > writeBehindLength)
+			writeBehindLength = end;
+        
+		return size;
+	}
+    
 	return (int) fwrite(source, 1, size, this->file);
 }
+
+// *****************************************************************
+/// @brief
+///     Writes a buffer of bytes at the given offset in the file,
+///     without using or moving the current position.
+/// @param source
+///     Buffer of bytes to be written.
+/// @param offset
+///     Offset (from the beginning of the file) to write the bytes at
+/// @param size
+///     Number of bytes to write.
+/// @remarks
+///     The write goes straight to the file descriptor, bypassing the bytes still buffered by Write().  
+///     Write-behind streams use this to write their buffers from the AsyncIO threads.
+// *****************************************************************
+int FileStream::WriteAt(void* source, Int64 offset, int size)
+{
+#ifdef GDKPLATFORM_WINDOWS
+    
+    // Write through the second OS file handle, so the stream position is not touched
+    return TransferAt(this->positionedHandle, this->file, source, offset, size, true);
+    
+#else
+    
+    // Write through the file descriptor, with pwrite() so the stdio position is not touched
+    int fd = fileno(this->file);
+    int totalWritten = 0;
+    while(totalWritten < size)
+    {
+        ssize_t bytesWritten = pwrite(fd, (const UInt8*)source + totalWritten, size - totalWritten, (off_t)(offset + totalWritten));
+        if(bytesWritten <= 0)
+            break;
+        totalWritten += (int) bytesWritten;
+    }
+    return totalWritten;
+    
+#endif
+}
+
+// *****************************************************************
+/// @brief
+///     Reads consecutive bytes from the file into several buffers, in order
+/// @param buffers
+///     The buffers to fill.
+/// @param count
+///     Number of buffers
+/// @remarks
+///     Large reads are done with a single readv() at the stream position, where available.  Small reads
+///     are served from the stdio buffer.
+// *****************************************************************
+int FileStream::ReadV(const StreamBuffer* buffers, int count)
+{
+#ifndef GDKPLATFORM_WINDOWS
+    int totalSize = 0;
+    for(int bufferIndex = 0; bufferIndex < count; bufferIndex++)
+        totalSize += buffers[bufferIndex].Size;
+    
+    if(this->mode == FileMode::Read && totalSize >= FILESTREAM_VECTORED_MIN_SIZE)
+    {
+        ResourceLoadTimer loadTimer(ResourceLoadPhase::Read);
+        
+        // Read at the stdio position, then move stdio past the data.  (Which also drops its stale buffer)
+        Int64 position = GDK_FTELL(this->file);
+        int totalRead = TransferVectored(fileno(this->file), buffers, count, position, false);
+        GDK_FSEEK(this->file, position + totalRead, SEEK_SET);
+        ResourceLoadStats::AddBytes(ResourceLoadPhase::Read, totalRead);
+        return totalRead;
+    }
+#endif
+    
+    return Stream::ReadV(buffers, count);
+}
+
+// *****************************************************************
+/// @brief
+///     Writes the bytes of several buffers to the file, one after another
+/// @param buffers
+///     The buffers to write
+/// @param count
+///     Number of buffers
+/// @remarks
+///     Large writes are done with a single writev() at the stream position, where available.  Small writes,
+///     and writes to write-behind streams, go through the stream's buffer.
+// *****************************************************************
+int FileStream::WriteV(const StreamBuffer* buffers, int count)
+{
+#ifndef GDKPLATFORM_WINDOWS
+    int totalSize = 0;
+    for(int bufferIndex = 0; bufferIndex < count; bufferIndex++)
+        totalSize += buffers[bufferIndex].Size;
+    
+    if(this->mode == FileMode::Write && totalSize >= FILESTREAM_VECTORED_MIN_SIZE)
+    {
+        // Write out anything stdio has buffered, then write at the stdio position & move stdio past the data
+        fflush(this->file);
+        Int64 position = GDK_FTELL(this->file);
+        int totalWritten = TransferVectored(fileno(this->file), buffers, count, position, true);
+        GDK_FSEEK(this->file, position + totalWritten, SEEK_SET);
+        return totalWritten;
+    }
+#endif
+    
+    return Stream::WriteV(buffers, count);
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the file descriptor that ReadAt() & WriteAt() transfer through
+/// @return
+///     The file descriptor, or -1 on Windows  (Where the positioned reads & writes use a second file handle)
+// *****************************************************************
+int FileStream::GetFileDescriptor()
+{
+#ifndef GDKPLATFORM_WINDOWS
+    if(this->file != NULL)
+        return fileno(this->file);
+#endif
+    
+    return -1;
+}
+
+// *****************************************************************
+/// @brief
+///     Hands the write buffer to the AsyncIO threads, & starts filling the other buffer
+/// @remarks
+///     Only one buffer is written at a time, so the writes reach the file in the order they were made.
+///     GDK Internal Use Only
+// *****************************************************************
+void FileStream::QueueWriteBehind()
+{
+    if(writeBufferUsed == 0)
+        return;
+    
+    // Wait for the previous buffer to be written
+    WaitForWriteBehind();
+    
+    // Swap the buffers, & queue the full one
+    UInt8* fullBuffer = writeBuffer;
+    writeBuffer = pendingBuffer;
+    pendingBuffer = fullBuffer;
+    pendingWrite = AsyncIO::QueueWrite(this, pendingBuffer, writeBufferOffset, writeBufferUsed);
+    
+    writeBufferOffset += writeBufferUsed;
+    writeBufferUsed = 0;
+}
+
+// *****************************************************************
+/// @brief
+///     Waits for the buffer that is being written by the AsyncIO threads
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void FileStream::WaitForWriteBehind()
+{
+    if(pendingWrite == NULL)
+        return;
+    
+    pendingWrite->Wait();
+    if(pendingWrite->GetStatus() == AsyncIOStatus::Failed && writeBehindFailed == false)
+    {
+        LOG_ERROR("A write-behind FileStream failed to write its buffer.  Only %lld bytes were written", pendingWrite->GetBytesRead());
+        writeBehindFailed = true;
+    }
+    
+    GdkDelete( pendingWrite );
+    pendingWrite = NULL;
+}
@@ -21,14 +21,25 @@ namespace Gdk
 	{
 		enum Enum
 		{	
+            /// Open the file for reading
 			Read,
-			Write
+
+            /// Create (or truncate) the file for writing
+			Write,
+
+            /// Create (or truncate) the file for writing.  Writes are buffered, and the buffers are written
+            /// to the file by the AsyncIO threads, so the calling thread does not block on disk I/O.
+            WriteBehind
 		};
 	}
 
 	// =================================================================================
     /// @brief
     ///     Provides a stream based interface to a file.
+    /// @remarks
+    ///     In FileMode::WriteBehind, written bytes are gathered into a buffer.  Full buffers are handed to the 
+    ///     AsyncIO threads, while the next buffer is filled, so writing many small records does not stall the 
+    ///     caller.  Flush() and Close() wait for the buffered bytes to reach the file.
 	// =================================================================================
 	class FileStream : public Stream
 	{
@@ -44,6 +55,8 @@ namespace Gdk
 		FileStream(const char *filePath, FileMode::Enum mode); 
         virtual ~FileStream();
 	    
+        bool IsOpen();
+        
         /// @}
 		        
         // ---------------------------------
@@ -53,28 +66,52 @@ namespace Gdk
 		virtual bool CanRead();
 		virtual bool CanWrite();
 		virtual bool CanSeek();
-		virtual void SetPosition(int position);
-        virtual int GetPosition();
-		virtual void Seek(int offset, SeekOrigin::Enum origin);
-		virtual void SetLength(int length);
-		virtual int GetLength();
+		virtual void SetPosition(Int64 position);
+        virtual Int64 GetPosition();
+		virtual void Seek(Int64 offset, SeekOrigin::Enum origin);
+		virtual void SetLength(Int64 length);
+		virtual Int64 GetLength();
 		virtual void Close();
 		virtual void Flush();
         
 		virtual int Read(void* destination, int size);
+		virtual int ReadAt(void* destination, Int64 offset, int size);
         virtual int Write(void* source, int size);
+        virtual int WriteAt(void* source, Int64 offset, int size);
+        virtual int ReadV(const StreamBuffer* buffers, int count);
+        virtual int WriteV(const StreamBuffer* buffers, int count);
+        virtual int GetFileDescriptor();
         
         /// @}
         
  
     private:
         
+        // Private Methods
+		// ================================
+        
+        void QueueWriteBehind();
+        void WaitForWriteBehind();
+        
         // Private Properties
 		// ================================
         
 		// File handle
 		FILE *file;
 		FileMode::Enum mode;
+        
+        #ifdef GDKPLATFORM_WINDOWS
+        HANDLE positionedHandle;            // Second handle to the file, used by ReadAt() & WriteAt()
+        #endif
+        
+        // Write-behind buffers
+        UInt8* writeBuffer;                 // Buffer being filled by Write()
+        int writeBufferUsed;
+        Int64 writeBufferOffset;            // File offset of the first byte in the write buffer
+        UInt8* pendingBuffer;               // Buffer being written by the AsyncIO threads
+        AsyncIORequest* pendingWrite;
+        Int64 writeBehindLength;            // Length of the file, including the buffered bytes
+        bool writeBehindFailed;
 	};
     
     /// @} // IO
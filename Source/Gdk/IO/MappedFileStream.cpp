@@ -0,0 +1,339 @@
+/* 
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "BasePCH.h"
+#include "MappedFileStream.h"
+
+#ifndef GDKPLATFORM_WINDOWS
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace Gdk;
+
+// *****************************************************************
+/// @brief
+///     Opens the given file & maps it into memory
+/// @param filePath
+///     Path and name of the file.
+/// @param accessHint
+///     How the file will be read, which the OS uses to tune its read-ahead for the mapping.  (Default = Sequential)
+/// @note
+///     If the file can not be mapped, the stream is left closed & an error is logged.  Use IsOpen() to check.
+// *****************************************************************
+MappedFileStream::MappedFileStream(const char *filePath, FileAccessHint::Enum accessHint)
+{
+    mapping = NULL;
+    length = 0;
+    position = 0;
+    opened = false;
+    
+#ifdef GDKPLATFORM_WINDOWS
+    
+    fileMapping = NULL;
+    
+    // Open the file, with the cache hint for the access pattern
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+    if(accessHint == FileAccessHint::Sequential)
+        flags = FILE_FLAG_SEQUENTIAL_SCAN;
+    else if(accessHint == FileAccessHint::Random)
+        flags = FILE_FLAG_RANDOM_ACCESS;
+    HANDLE file = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, flags, NULL);
+    if(file == INVALID_HANDLE_VALUE)
+    {
+        LOG_ERROR("Failed to open the file [%s] Error(%d)", filePath, GetLastError());
+        return;
+    }
+    
+    // Get the file size
+    LARGE_INTEGER fileSize;
+    if(GetFileSizeEx(file, &fileSize))
+        length = (Int64) fileSize.QuadPart;
+    
+    // The whole file must fit in the address space  (Large files can only be mapped by 64-bit processes)
+    if((UInt64) length > (UInt64)(size_t)-1)
+    {
+        LOG_ERROR("The file [%s] is too large to map: %lld bytes", filePath, length);
+        CloseHandle(file);
+        length = 0;
+        return;
+    }
+    
+    // Map the file  (Empty files can not be mapped, but are still valid streams)
+    opened = true;
+    if(length > 0)
+    {
+        fileMapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if(fileMapping != NULL)
+            mapping = (const UInt8*) MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+        
+        if(mapping == NULL)
+        {
+            LOG_ERROR("Failed to map the file [%s] Error(%d)", filePath, GetLastError());
+            length = 0;
+            opened = false;
+        }
+    }
+    
+    // The mapping keeps its own reference to the file
+    CloseHandle(file);
+    
+#else
+    
+    // Open the file
+    int fd = open(filePath, O_RDONLY);
+    if(fd < 0)
+    {
+        LOG_ERROR("Failed to open the file [%s] Error(%d): %s", filePath, errno, strerror(errno));
+        return;
+    }
+    
+    // Get the file size
+    struct stat fileStat;
+    if(fstat(fd, &fileStat) == 0)
+        length = (Int64) fileStat.st_size;
+    
+    // The whole file must fit in the address space  (Large files can only be mapped by 64-bit processes)
+    if((UInt64) length > (UInt64)(size_t)-1)
+    {
+        LOG_ERROR("The file [%s] is too large to map: %lld bytes", filePath, length);
+        close(fd);
+        length = 0;
+        return;
+    }
+    
+    // Map the file  (Empty files can not be mapped, but are still valid streams)
+    opened = true;
+    if(length > 0)
+    {
+        void* view = mmap(NULL, (size_t) length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(view == MAP_FAILED)
+        {
+            LOG_ERROR("Failed to map the file [%s] Error(%d): %s", filePath, errno, strerror(errno));
+            length = 0;
+            opened = false;
+        }
+        else
+        {
+            // Tune the read-ahead for the access pattern
+            if(accessHint == FileAccessHint::Sequential)
+                madvise(view, (size_t) length, MADV_SEQUENTIAL);
+            else if(accessHint == FileAccessHint::Random)
+                madvise(view, (size_t) length, MADV_RANDOM);
+            mapping = (const UInt8*) view;
+        }
+    }
+    
+    // The mapping keeps its own reference to the file
+    close(fd);
+    
+#endif
+}
+
+// *****************************************************************
+/// @brief
+///     Destructor
+/// @remarks
+///     Closes the stream if it is not already closed.
+// *****************************************************************
+MappedFileStream::~MappedFileStream()
+{
+	Close();
+}
+
+// *****************************************************************
+/// @brief
+///     Checks if the file was successfully mapped  (Or is empty)
+// *****************************************************************
+bool MappedFileStream::IsOpen()
+{
+    return opened;
+}
+
+// *****************************************************************
+/// @brief
+///     Checks if the stream can be Read from
+// *****************************************************************
+bool MappedFileStream::CanRead()
+{
+	return true;
+}
+
+// *****************************************************************
+/// @brief
+///     Checks if the stream can be Written to
+// *****************************************************************
+bool MappedFileStream::CanWrite()
+{
+	return false;
+}
+
+// *****************************************************************
+/// @brief
+///     Checks if the current position within the stream can be changed [via the Seek() method] 
+// *****************************************************************
+bool MappedFileStream::CanSeek()
+{
+	return true;
+}
+
+// *****************************************************************
+/// @brief
+///     Sets the current position within the stream.
+/// @param position
+///     The new position to set in the stream
+// *****************************************************************
+void MappedFileStream::SetPosition(Int64 position)
+{
+	Seek(position, SeekOrigin::Begin);
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the current position within the stream
+// *****************************************************************
+Int64 MappedFileStream::GetPosition()
+{
+	return this->position;
+}
+
+// *****************************************************************
+/// @brief
+///     Changes the current position within the stream
+/// @param offset
+///     Offset to seek within the stream.
+/// @param origin
+///     Origin which the offset is relative to.
+/// @remarks
+///     The position is clamped to the bounds of the file
+// *****************************************************************
+void MappedFileStream::Seek(Int64 offset, SeekOrigin::Enum origin)
+{
+	Int64 newPosition = offset;
+	if(origin == SeekOrigin::Current)
+		newPosition += this->position;
+	else if(origin == SeekOrigin::End)
+		newPosition += this->length;
+    
+	this->position = newPosition < 0 ? 0 : (newPosition > this->length ? this->length : newPosition);
+}
+
+// *****************************************************************
+/// @brief
+///     Changes the length of the stream. (in bytes)
+/// @param length
+///     New length for the stream (in bytes)
+/// @note
+///     Not supported for MappedFileStreams
+// *****************************************************************
+void MappedFileStream::SetLength(Int64 length)
+{
+	ASSERT(false, "MappedFileStreams are read-only and can not be resized");
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the current length of the stream.  (in bytes)
+// *****************************************************************
+Int64 MappedFileStream::GetLength()
+{
+	return this->length;
+}
+
+// *****************************************************************
+/// @brief
+///     Closes the stream & unmaps the file
+/// @remarks
+///     Any pointers returned by GetSpan() are invalid after the stream is closed
+// *****************************************************************
+void MappedFileStream::Close()
+{
+	if(this->mapping != NULL)
+	{
+#ifdef GDKPLATFORM_WINDOWS
+		UnmapViewOfFile(this->mapping);
+		CloseHandle(this->fileMapping);
+		this->fileMapping = NULL;
+#else
+		munmap((void*)this->mapping, (size_t) this->length);
+#endif
+		this->mapping = NULL;
+	}
+    
+	this->length = 0;
+	this->position = 0;
+	this->opened = false;
+}
+
+// *****************************************************************
+/// @brief
+///     Flushes any intermediate buffers
+/// @note
+///     MappedFileStreams are read-only, so this does nothing
+// *****************************************************************
+void MappedFileStream::Flush()
+{
+}
+
+// *****************************************************************
+/// @brief
+///     Reads a fixed size set of bytes from the stream into a buffer
+///     and moves the current position within the stream.
+/// @param destination
+///     Buffer to read the bytes into.
+/// @param size
+///     Number of bytes to read.
+// *****************************************************************
+int MappedFileStream::Read(void* destination, int size)
+{
+	// Clamp the read to the end of the file
+	Int64 bytesLeft = this->length - this->position;
+	if(size > bytesLeft)
+		size = (int) bytesLeft;
+	if(size <= 0)
+		return 0;
+    
+	// The copy is where the pages are faulted in from the file
+	ResourceLoadTimer loadTimer(ResourceLoadPhase::Read);
+	memcpy(destination, this->mapping + this->position, size);
+	this->position += size;
+	ResourceLoadStats::AddBytes(ResourceLoadPhase::Read, size);
+    
+	return size;
+}
+
+// *****************************************************************
+/// @brief
+///     Writes a buffer of bytes to the stream
+/// @note
+///     Not supported for MappedFileStreams
+// *****************************************************************
+int MappedFileStream::Write(void* source, int size)
+{
+	ASSERT(false, "MappedFileStreams are read-only");
+	return 0;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets a pointer directly into the mapped file
+/// @param offset
+///     Offset (from the beginning of the file) of the first byte of the span
+/// @param size
+///     Number of bytes in the span
+/// @remarks
+///     Returns NULL if the span extends beyond the end of the file.  The pointer is
+///     read-only, and is valid until the stream is closed.
+// *****************************************************************
+const void* MappedFileStream::GetSpan(Int64 offset, Int64 size)
+{
+	if(this->mapping == NULL || offset < 0 || size < 0 || offset + size > this->length)
+		return NULL;
+    
+	return this->mapping + offset;
+}
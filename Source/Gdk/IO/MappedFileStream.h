@@ -0,0 +1,110 @@
+/* 
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+
+#include "Stream.h"
+
+namespace Gdk
+{
+    /// @addtogroup IO
+    /// @{
+
+	// =================================================================================
+    /// @brief
+    ///     Enumeration of the ways a mapped file will be read, which the OS uses to tune its read-ahead
+    /// @see
+    ///     MappedFileStream
+	// =================================================================================
+    namespace FileAccessHint
+	{
+		enum Enum
+		{	
+            /// No hint, the OS default read-ahead is used.  (Such as for a pack, where each asset is read through, but the assets are in any order)
+			Normal,
+
+            /// The file is read front to back, so the OS can read well ahead.  (Such as a single asset)
+			Sequential,
+
+            /// The file is read in small pieces, in any order.  The OS reads ahead as little as possible
+			Random
+		};
+	}
+
+	// =================================================================================
+    /// @brief
+    ///     Provides a read-only stream over a file that is mapped into memory.
+    /// @remarks
+    ///     The whole file is mapped when the stream is opened, and reads are copies out of
+    ///     the mapping, with no per-read system calls.  GetSpan() can be used to borrow a pointer
+    ///     directly into the mapping, so large blocks (like vertex data) can be used without
+    ///     being copied at all.  The mapped pages come from the OS file cache, so they are
+    ///     shared with any other process (or later run) that reads the same file.
+	// =================================================================================
+	class MappedFileStream : public Stream
+	{
+	public:
+        
+        // Public Methods
+		// ================================
+        
+        // ---------------------------------
+        /// @name Constructor / Destructor
+        /// @{
+        
+		MappedFileStream(const char *filePath, FileAccessHint::Enum accessHint = FileAccessHint::Sequential); 
+        virtual ~MappedFileStream();
+	    
+        /// @}
+		        
+        // ---------------------------------
+        /// @name Override Methods
+        /// @{
+        
+		virtual bool CanRead();
+		virtual bool CanWrite();
+		virtual bool CanSeek();
+		virtual void SetPosition(Int64 position);
+        virtual Int64 GetPosition();
+		virtual void Seek(Int64 offset, SeekOrigin::Enum origin);
+		virtual void SetLength(Int64 length);
+		virtual Int64 GetLength();
+		virtual void Close();
+		virtual void Flush();
+        
+		virtual int Read(void* destination, int size);
+        virtual int Write(void* source, int size);
+        virtual const void* GetSpan(Int64 offset, Int64 size);
+        
+        /// @}
+        
+        // ---------------------------------
+        /// @name Mapping Methods
+        /// @{
+        
+        bool IsOpen();
+        
+        /// @}
+ 
+    private:
+        
+        // Private Properties
+		// ================================
+        
+		// Mapped view of the file
+		const UInt8* mapping;
+		Int64 length;
+		Int64 position;
+		bool opened;
+        
+        #ifdef GDKPLATFORM_WINDOWS
+        HANDLE fileMapping;
+        #endif
+	};
+    
+    /// @} // IO
+
+} // namespace Gdk
@@ -19,7 +19,7 @@ using namespace Gdk;
 /// @note
 ///     The caller is responsible for managing and freeing the buffer memory.
 // *****************************************************************
-MemoryStream::MemoryStream(void* buffer, int size)
+MemoryStream::MemoryStream(void* buffer, Int64 size)
 {
 	// Use the given buffer pointer
 	this->buffer = buffer;
@@ -39,10 +39,11 @@ MemoryStream::MemoryStream(void* buffer, int size)
 ///     The MemoryStream owns the buffer memory, and will free it when the 
 ///     stream is destroyed.
 // *****************************************************************
-MemoryStream::MemoryStream(int initialSize)
+MemoryStream::MemoryStream(Int64 initialSize)
 {
 	// Allocate the initial buffer
-	this->buffer = GdkAlloc(initialSize);
+	ASSERT(initialSize >= 0 && (UInt64)initialSize <= (UInt64)(size_t)-1, "Memorystream size is too large for this platform: Bytes[%lld]", initialSize);
+	this->buffer = GdkAlloc((size_t) initialSize);
 	this->bufferSize = initialSize;
 	this->streamLength = 0;
 	this->autoGrow = true;
@@ -50,7 +51,7 @@ MemoryStream::MemoryStream(int initialSize)
 	this->bufferOwner = true;
 	
 	// Verify the allocation
-	ASSERT(this->buffer != NULL, "Memorystream Allocation Failed: Bytes[%d]", initialSize);
+	ASSERT(this->buffer != NULL, "Memorystream Allocation Failed: Bytes[%lld]", initialSize);
 }
 
 // *****************************************************************
@@ -106,7 +107,7 @@ bool MemoryStream::CanSeek()
 /// @param position
 ///     The new position to set in the stream
 // *****************************************************************
-void MemoryStream::SetPosition(int position)
+void MemoryStream::SetPosition(Int64 position)
 {
 	this->position = position;
 }
@@ -115,7 +116,7 @@ void MemoryStream::SetPosition(int position)
 /// @brief
 ///     Gets the current position within the stream
 // *****************************************************************
-int MemoryStream::GetPosition()
+Int64 MemoryStream::GetPosition()
 {
 	return this->position;
 }
@@ -128,7 +129,7 @@ int MemoryStream::GetPosition()
 /// @param origin
 ///     Origin which the offset is relative to.
 // *****************************************************************
-void MemoryStream::Seek(int offset, SeekOrigin::Enum origin)
+void MemoryStream::Seek(Int64 offset, SeekOrigin::Enum origin)
 {
 	if(origin == SeekOrigin::Begin)
 		this->position = offset;
@@ -150,7 +151,7 @@ void MemoryStream::Seek(int offset, SeekOrigin::Enum origin)
 ///     If the length is greater than the current buffer size and the
 ///     MemoryStream instance supports Auto-growing, the buffer will be resized
 // *****************************************************************
-void MemoryStream::SetLength(int length)
+void MemoryStream::SetLength(Int64 length)
 {
 	// Ensure the buffer is big enough for the new length
 	EnsureSizeIsBigEnough(length);
@@ -167,7 +168,7 @@ void MemoryStream::SetLength(int length)
 /// @brief
 ///     Gets the current length of the stream.  (in bytes)
 // *****************************************************************
-int MemoryStream::GetLength()
+Int64 MemoryStream::GetLength()
 {
 	return this->streamLength;
 }
@@ -203,7 +204,7 @@ int MemoryStream::Read(void* destination, int size)
 	// Limit the size if the requested size will go outside the stream
 	int actualSize = size;
 	if(size + this->position > this->streamLength)
-		actualSize = this->streamLength - this->position;
+		actualSize = this->position < this->streamLength ? (int)(this->streamLength - this->position) : 0;
 
 	// Copy memory from the current position to the given buffer
 	void* cursor = (void*)((Byte*)this->buffer + this->position);
@@ -242,6 +243,76 @@ int MemoryStream::Write(void* source, int size)
 	return size;
 }
 
+// *****************************************************************
+/// @brief
+///     Reads consecutive bytes from the stream into several buffers, in order
+/// @param buffers
+///     The buffers to fill.
+/// @param count
+///     Number of buffers
+/// @remarks
+///     The buffers are filled with straight memory copies, with a single bounds check.
+// *****************************************************************
+int MemoryStream::ReadV(const StreamBuffer* buffers, int count)
+{
+	Int64 available = this->position < this->streamLength ? this->streamLength - this->position : 0;
+	const Byte* cursor = (const Byte*)this->buffer + this->position;
+
+	int totalRead = 0;
+	for(int bufferIndex = 0; bufferIndex < count; bufferIndex++)
+	{
+		int size = buffers[bufferIndex].Size;
+		if(size > available)
+			size = (int) available;
+
+		memcpy(buffers[bufferIndex].Data, cursor, size);
+		cursor += size;
+		available -= size;
+		totalRead += size;
+
+		if(size < buffers[bufferIndex].Size)
+			break;
+	}
+
+	// Advance the stream position
+	this->position += totalRead;
+	return totalRead;
+}
+
+// *****************************************************************
+/// @brief
+///     Writes the bytes of several buffers to the stream, one after another
+/// @param buffers
+///     The buffers to write
+/// @param count
+///     Number of buffers
+/// @remarks
+///     The stream is grown once, to fit all of the buffers.
+// *****************************************************************
+int MemoryStream::WriteV(const StreamBuffer* buffers, int count)
+{
+	// Ensure there is enough space for all of the buffers
+	int totalSize = 0;
+	for(int bufferIndex = 0; bufferIndex < count; bufferIndex++)
+		totalSize += buffers[bufferIndex].Size;
+	EnsureSizeIsBigEnough(this->position + totalSize);
+
+	// Copy each buffer to the stream
+	Byte* cursor = (Byte*)this->buffer + this->position;
+	for(int bufferIndex = 0; bufferIndex < count; bufferIndex++)
+	{
+		memcpy(cursor, buffers[bufferIndex].Data, buffers[bufferIndex].Size);
+		cursor += buffers[bufferIndex].Size;
+	}
+
+	// Advance the stream position & length
+	this->position += totalSize;
+	if(this->position > this->streamLength)
+		this->streamLength = this->position;
+
+	return totalSize;
+}
+
 // *****************************************************************
 /// @brief
 ///     Makes sure the buffer is at least as big as the given number of bytes.
@@ -253,13 +324,13 @@ int MemoryStream::Write(void* source, int size)
 /// @note
 ///     This is only supported on internally managed buffers
 // *****************************************************************
-void MemoryStream::EnsureSizeIsBigEnough(int totalBytes)
+void MemoryStream::EnsureSizeIsBigEnough(Int64 totalBytes)
 {
 	// Is the requested space bigger than the current buffer size?
 	if(totalBytes > this->bufferSize)
 	{
 		// Calculate the new size for the buffer  (using the 2X growth method)
-		int newSize = this->bufferSize;
+		Int64 newSize = this->bufferSize > 0 ? this->bufferSize : 1;
 		while(newSize < totalBytes)
 			newSize *= 2;
 
@@ -276,7 +347,7 @@ void MemoryStream::EnsureSizeIsBigEnough(int totalBytes)
 /// @note
 ///     This is only supported on internally managed buffers
 // *****************************************************************
-void MemoryStream::Resize(int newSize)
+void MemoryStream::Resize(Int64 newSize)
 {
 	// Is this NOT an autogrow buffer?
 	if(this->autoGrow == false)
@@ -284,14 +355,16 @@ void MemoryStream::Resize(int newSize)
 		ASSERT(false, "Resize called on a non-growing MemoryStream");
 	}
 
-	// Allocate a new buffer
-	void* newBuffer = GdkAlloc(newSize);
+	// Allocate a new buffer  (The 64-bit size must also fit in the address space of the platform)
+	ASSERT((UInt64)newSize <= (UInt64)(size_t)-1, "Memorystream size is too large for this platform: Bytes[%lld]", newSize);
+	void* newBuffer = GdkAlloc((size_t) newSize);
+	ASSERT(newBuffer != NULL, "Memorystream Allocation Failed: Bytes[%lld]", newSize);
 
 	// Copy the memory over
-    int bytesToCopy = this->streamLength;
-    if(bytesToCopy > newSize)
-        bytesToCopy = newSize;
-	memcpy(newBuffer, this->buffer, bytesToCopy);
+	Int64 bytesToCopy = this->streamLength;
+	if(bytesToCopy > newSize)
+		bytesToCopy = newSize;
+	memcpy(newBuffer, this->buffer, (size_t) bytesToCopy);
 
 	// Release the old buffer
 	GdkFree(this->buffer);
@@ -314,7 +387,7 @@ void MemoryStream::Resize(int newSize)
 ///     The capacity is the total size of the internal buffer, which
 ///     can be more than the number of bytes in the stream.
 // *****************************************************************
-int MemoryStream::GetCapacity()
+Int64 MemoryStream::GetCapacity()
 {
 	return this->bufferSize;
 }
@@ -349,4 +422,22 @@ void* MemoryStream::GetBufferStartPtr()
 void* MemoryStream::GetBufferCurrentPtr()
 {
 	return (void*)((Byte*)this->buffer + this->position);
+}
+
+// *****************************************************************
+/// @brief
+///     Gets a pointer directly into the stream's buffer
+/// @param offset
+///     Offset (from the beginning of the stream) of the first byte of the span
+/// @param size
+///     Number of bytes in the span
+/// @remarks
+///     Returns NULL if the span extends beyond the end of the stream
+// *****************************************************************
+const void* MemoryStream::GetSpan(Int64 offset, Int64 size)
+{
+	if(offset < 0 || size < 0 || offset + size > this->streamLength)
+		return NULL;
+
+	return (const void*)((Byte*)this->buffer + offset);
 }
\ No newline at end of file
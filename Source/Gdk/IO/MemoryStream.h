@@ -28,8 +28,8 @@ namespace Gdk
         /// @name Constructor / Destructor
         /// @{
         
-		MemoryStream(void* buffer, int size);
-		MemoryStream(int initialSize);
+		MemoryStream(void* buffer, Int64 size);
+		MemoryStream(Int64 initialSize);
 		virtual ~MemoryStream();
 
         /// @}
@@ -37,7 +37,7 @@ namespace Gdk
         /// @name Buffer Management Methods
         /// @{
         
-		int GetCapacity();
+		Int64 GetCapacity();
 		void SetCapacity();
 		void* GetBufferStartPtr();
 		void* GetBufferCurrentPtr();
@@ -50,15 +50,18 @@ namespace Gdk
         virtual bool CanRead();
 		virtual bool CanWrite();
 		virtual bool CanSeek();
-		virtual void SetPosition(int position);
-		virtual int GetPosition();
-		virtual void Seek(int offset, SeekOrigin::Enum origin);
-		virtual void SetLength(int length);
-		virtual int GetLength();
+		virtual void SetPosition(Int64 position);
+		virtual Int64 GetPosition();
+		virtual void Seek(Int64 offset, SeekOrigin::Enum origin);
+		virtual void SetLength(Int64 length);
+		virtual Int64 GetLength();
 		virtual void Close();
 		virtual void Flush();
 		virtual int Read(void* destination, int size);
 		virtual int Write(void* source, int size);
+		virtual int ReadV(const StreamBuffer* buffers, int count);
+		virtual int WriteV(const StreamBuffer* buffers, int count);
+		virtual const void* GetSpan(Int64 offset, Int64 size);
         
         /// @}
         
@@ -68,17 +71,17 @@ namespace Gdk
 		// ================================
         
 		void* buffer;			// Pointer to the buffer containing the stream data
-		int bufferSize;			// Size of the buffer (NOT the stream)
-		int streamLength;		// Size of the data in the stream (streamLength <= bufferSize)
+		Int64 bufferSize;		// Size of the buffer (NOT the stream)
+		Int64 streamLength;		// Size of the data in the stream (streamLength <= bufferSize)
 		bool autoGrow;			// Does the stream auto-grow when the buffer is full?
-		int position;			// Current position within the stream
+		Int64 position;			// Current position within the stream
 		bool bufferOwner;		// Do we own the buffer?  (IE: Are we responsible for cleanup)
         
         // Private Methods
 		// ================================
         
-		void EnsureSizeIsBigEnough(int totalBytes);
-		void Resize(int newSize);
+		void EnsureSizeIsBigEnough(Int64 totalBytes);
+		void Resize(Int64 newSize);
 	};
     
     /// @} // IO
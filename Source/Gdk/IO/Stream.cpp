@@ -9,6 +9,14 @@
 #include "zlib.h"
 #include "zconf.h"
 
+#ifdef GDK_LZ4
+#include "lz4frame.h"
+#endif
+
+#ifdef GDK_ZSTD
+#include "zstd.h"
+#endif
+
 using namespace std;
 using namespace Gdk;
 
@@ -41,19 +49,173 @@ string Stream::ReadString()
 {
 	// Read the string length
 	string::size_type length = ReadUInt16();
-	string result;
-	result.reserve(length + 1);
-
-	// Read the string characters
-	for(string::size_type i=0; i<length; i++) 
-	{ 
-		char c = ReadUInt8();
-		result.push_back(c); 
-	}
+	string result(length, '\0');
+
+	// Read the string characters, all at once
+	if(length > 0)
+		Read(&result[0], (int)length);
 
 	return result;
 }
 
+// *****************************************************************
+/// @brief
+///     Reads a fixed size set of bytes from the given offset in the stream
+/// @param destination
+///     Buffer to read the bytes into.
+/// @param offset
+///     Offset (from the beginning of the stream) of the first byte to read
+/// @param size
+///     Number of bytes to read.
+/// @return
+///     The number of bytes read
+/// @remarks
+///     Streams that override this method (such as FileStream) do not use the current position,
+///     and can be read at several offsets from several threads at once.  This default copies
+///     straight out of GetSpan() if the stream is memory backed, and otherwise seeks & reads,
+///     which leaves the stream positioned after the data that was read.
+// *****************************************************************
+int Stream::ReadAt(void* destination, Int64 offset, int size)
+{
+    // Copy straight from memory, if the stream is memory backed
+    const void* span = GetSpan(offset, size);
+    if(span != NULL)
+    {
+        memcpy(destination, span, size);
+        return size;
+    }
+    
+    SetPosition(offset);
+    return Read(destination, size);
+}
+
+// *****************************************************************
+/// @brief
+///     Queues a read of a fixed size set of bytes from the given offset in the stream
+/// @param destination
+///     Buffer to read the bytes into.  The buffer must stay valid until the request completes.
+/// @param offset
+///     Offset (from the beginning of the stream) of the first byte to read
+/// @param size
+///     Number of bytes to read.
+/// @param priority
+///     The priority of the read.  Higher priority reads are serviced sooner.
+/// @return
+///     The request tracking the read.  The caller owns the request, and must GdkDelete it once it is complete.
+/// @remarks
+///     The read is done through ReadAt() on one of the AsyncIO threads, so many reads can be in flight at
+///     once, while the calling thread carries on with other work.  Reads of memory backed streams are simply
+///     copied, and the request is complete by the time this method returns.
+///   @par
+///     The stream must not be closed until all of its requests are complete.
+// *****************************************************************
+AsyncIORequest* Stream::ReadAsync(void* destination, Int64 offset, int size, short priority)
+{
+    return AsyncIO::QueueRead(this, destination, offset, size, priority);
+}
+
+// *****************************************************************
+/// @brief
+///     Reads consecutive bytes from the stream into several buffers, in order
+/// @param buffers
+///     The buffers to fill.  Each buffer is filled completely before the next one.
+/// @param count
+///     Number of buffers
+/// @return
+///     Total number of bytes read.  This is less than the total size of the buffers if the end of the stream was reached.
+/// @remarks
+///     The base implementation does one Read() per buffer.  Streams that can fill all of the buffers
+///     at once (such as with readv) override this.
+// *****************************************************************
+int Stream::ReadV(const StreamBuffer* buffers, int count)
+{
+    int totalRead = 0;
+    for(int bufferIndex = 0; bufferIndex < count; bufferIndex++)
+    {
+        int bytesRead = Read(buffers[bufferIndex].Data, buffers[bufferIndex].Size);
+        totalRead += bytesRead;
+        if(bytesRead < buffers[bufferIndex].Size)
+            break;
+    }
+    return totalRead;
+}
+
+// *****************************************************************
+/// @brief
+///     Reads an array of Matrix3D values from the stream, in a single read
+/// @param destination
+///     Array to read the matrices into
+/// @param count
+///     Number of matrices to read
+/// @return
+///     The number of whole matrices that were read
+// *****************************************************************
+int Stream::ReadMatrices(Matrix3D* destination, int count)
+{
+    return ReadArray(destination, count);
+}
+
+// *****************************************************************
+/// @brief
+///     Writes a buffer of bytes at the given offset in the stream, without moving the current position
+/// @param source
+///     Buffer of bytes to be written.
+/// @param offset
+///     Offset (from the beginning of the stream) to write the bytes at
+/// @param size
+///     Number of bytes to write.
+/// @remarks
+///     The base implementation seeks, writes, & seeks back, so it is not safe to call from several
+///     threads at once.  Streams that can write at an offset directly override this.
+// *****************************************************************
+int Stream::WriteAt(void* source, Int64 offset, int size)
+{
+    Int64 position = GetPosition();
+    SetPosition(offset);
+    int bytesWritten = Write(source, size);
+    SetPosition(position);
+    return bytesWritten;
+}
+
+// *****************************************************************
+/// @brief
+///     Writes the bytes of several buffers to the stream, one after another
+/// @param buffers
+///     The buffers to write
+/// @param count
+///     Number of buffers
+/// @return
+///     Total number of bytes written
+/// @remarks
+///     The base implementation does one Write() per buffer.  Streams that can write all of the buffers
+///     at once (such as with writev) override this.
+// *****************************************************************
+int Stream::WriteV(const StreamBuffer* buffers, int count)
+{
+    int totalWritten = 0;
+    for(int bufferIndex = 0; bufferIndex < count; bufferIndex++)
+    {
+        int bytesWritten = Write(buffers[bufferIndex].Data, buffers[bufferIndex].Size);
+        totalWritten += bytesWritten;
+        if(bytesWritten < buffers[bufferIndex].Size)
+            break;
+    }
+    return totalWritten;
+}
+
+// *****************************************************************
+/// @brief
+///     Writes an array of Matrix3D values to the stream, in a single write
+/// @param source
+///     The matrices to write
+/// @param count
+///     Number of matrices to write
+// *****************************************************************
+void Stream::WriteMatrices(const Matrix3D* source, int count)
+{
+    WriteArray(source, count);
+}
+
 // *****************************************************************
 /// @brief
 ///     Writes a char* string to the stream
@@ -71,6 +233,32 @@ void Stream::WriteString(const char* value)
 	Write((Byte*)value, length);
 }
 
+// *****************************************************************
+/// @brief
+///     Checks if the given compression type is available in this build of GDK
+/// @remarks
+///     ZLib is always available.  LZ4 & Zstd are only available when GDK is built with
+///     GDK_LZ4 and GDK_ZSTD defined. (See Stream.h)
+// *****************************************************************
+bool Stream::IsCompressionTypeSupported(CompressionType::Enum compressionType)
+{
+	switch(compressionType)
+	{
+		case CompressionType::ZLib:
+			return true;
+#ifdef GDK_LZ4
+		case CompressionType::LZ4:
+			return true;
+#endif
+#ifdef GDK_ZSTD
+		case CompressionType::Zstd:
+			return true;
+#endif
+		default:
+			return false;
+	}
+}
+
 // *****************************************************************
 /// @brief
 ///     Decompresses this stream into another stream
@@ -78,11 +266,17 @@ void Stream::WriteString(const char* value)
 ///     Stream to where the decompressed data is to be written
 /// @param compressionType
 ///     Which compression type the data is compressed with
+/// @param sourceSize
+///     Number of bytes of compressed data to read from this stream.  (-1 = read to the end of the stream)
 // *****************************************************************
-bool Stream::Decompress(Stream* destination, CompressionType::Enum compressionType)
+bool Stream::Decompress(Stream* destination, CompressionType::Enum compressionType, Int64 sourceSize)
 {
-    // TODO(P2): This method should take a # of bytes to decompress...   
-    
+	GDK_PROFILE_SCOPE("Stream::Decompress");
+	ResourceLoadTimer loadTimer(ResourceLoadPhase::Decompress);
+
+	unsigned char in[COMPRESSION_BUFFER_SIZE];
+	unsigned char out[COMPRESSION_BUFFER_SIZE];
+
 	switch(compressionType)
 	{
 		// ---------------------------------- ZLib ------------------------------------
@@ -91,8 +285,6 @@ bool Stream::Decompress(Stream* destination, CompressionType::Enum compressionTy
 			int ret;
 			unsigned have;
 			z_stream strm;
-			unsigned char in[COMPRESSION_BUFFER_SIZE];
-			unsigned char out[COMPRESSION_BUFFER_SIZE];
 
 			/* allocate inflate state */
 			strm.zalloc = Z_NULL;
@@ -107,8 +299,13 @@ bool Stream::Decompress(Stream* destination, CompressionType::Enum compressionTy
 			/* decompress until deflate stream ends or end of file */
 			do 
 			{
-				// Read in from this stream
-				strm.avail_in = this->Read(in, COMPRESSION_BUFFER_SIZE);
+				// Read in from this stream  (Up to the remaining source size)
+				int readSize = COMPRESSION_BUFFER_SIZE;
+				if(sourceSize >= 0 && sourceSize < readSize)
+					readSize = (int) sourceSize;
+				strm.avail_in = readSize > 0 ? this->Read(in, readSize) : 0;
+				if(sourceSize >= 0)
+					sourceSize -= strm.avail_in;
 		        
 				// Was there no data left in the stream?
 				if (strm.avail_in == 0)
@@ -139,6 +336,7 @@ bool Stream::Decompress(Stream* destination, CompressionType::Enum compressionTy
 
 					// Write the decompressed data to the destination stream
 					destination->Write(out, have);
+					ResourceLoadStats::AddBytes(ResourceLoadPhase::Decompress, have);
 
 				} while (strm.avail_out == 0);
 
@@ -149,7 +347,338 @@ bool Stream::Decompress(Stream* destination, CompressionType::Enum compressionTy
 			(void)inflateEnd(&strm);
 		}
 		break;
+
+#ifdef GDK_LZ4
+		// ---------------------------------- LZ4 ------------------------------------
+		case CompressionType::LZ4:
+		{
+			LZ4F_dctx* context = NULL;
+			if(LZ4F_isError(LZ4F_createDecompressionContext(&context, LZ4F_VERSION)))
+				return false;
+
+			// Decompress until the end of the frame.  The decoder may hold more output than fits in the out buffer,
+			// so it's called until it has nothing left, even once all the input has been read
+			size_t ret = 1;
+			int inSize = 0;
+			int inPosition = 0;
+			bool inputEnded = false;
+			while(ret != 0)
+			{
+				// Read in from this stream once the last read is used up  (Up to the remaining source size)
+				if(inPosition == inSize && inputEnded == false)
+				{
+					int readSize = COMPRESSION_BUFFER_SIZE;
+					if(sourceSize >= 0 && sourceSize < readSize)
+						readSize = (int) sourceSize;
+					inSize = readSize > 0 ? this->Read(in, readSize) : 0;
+					inPosition = 0;
+					if(sourceSize >= 0)
+						sourceSize -= inSize;
+					inputEnded = (inSize == 0);
+				}
+
+				size_t outSize = COMPRESSION_BUFFER_SIZE;
+				size_t consumed = inSize - inPosition;
+				ret = LZ4F_decompress(context, out, &outSize, in + inPosition, &consumed, NULL);
+				if(LZ4F_isError(ret))
+				{
+					LZ4F_freeDecompressionContext(context);
+					return false;
+				}
+
+				inPosition += (int) consumed;
+				destination->Write(out, (int) outSize);
+				ResourceLoadStats::AddBytes(ResourceLoadPhase::Decompress, outSize);
+
+				// Is the frame truncated?  (There is no input left, and the decoder has nothing more to give)
+				if(inputEnded && outSize == 0)
+					break;
+			}
+
+			LZ4F_freeDecompressionContext(context);
+			return ret == 0;
+		}
+#endif
+
+#ifdef GDK_ZSTD
+		// ---------------------------------- Zstd ------------------------------------
+		case CompressionType::Zstd:
+		{
+			ZSTD_DStream* zstream = ZSTD_createDStream();
+			if(zstream == NULL)
+				return false;
+			ZSTD_initDStream(zstream);
+
+			// Decompress until the end of the frame.  A block can decode to more than fits in the out buffer,
+			// so the decoder is called until it has nothing left, even once all the input has been read
+			size_t ret = 1;
+			ZSTD_inBuffer inBuffer = { in, 0, 0 };
+			bool inputEnded = false;
+			while(ret != 0)
+			{
+				// Read in from this stream once the last read is used up  (Up to the remaining source size)
+				if(inBuffer.pos == inBuffer.size && inputEnded == false)
+				{
+					int readSize = COMPRESSION_BUFFER_SIZE;
+					if(sourceSize >= 0 && sourceSize < readSize)
+						readSize = (int) sourceSize;
+					int inSize = readSize > 0 ? this->Read(in, readSize) : 0;
+					if(sourceSize >= 0)
+						sourceSize -= inSize;
+					inBuffer.size = (size_t) inSize;
+					inBuffer.pos = 0;
+					inputEnded = (inSize == 0);
+				}
+
+				ZSTD_outBuffer outBuffer = { out, COMPRESSION_BUFFER_SIZE, 0 };
+				ret = ZSTD_decompressStream(zstream, &outBuffer, &inBuffer);
+				if(ZSTD_isError(ret))
+				{
+					ZSTD_freeDStream(zstream);
+					return false;
+				}
+
+				destination->Write(out, (int) outBuffer.pos);
+				ResourceLoadStats::AddBytes(ResourceLoadPhase::Decompress, outBuffer.pos);
+
+				// Is the frame truncated?  (There is no input left, and the decoder has nothing more to give)
+				if(inputEnded && outBuffer.pos == 0)
+					break;
+			}
+
+			ZSTD_freeDStream(zstream);
+			return ret == 0;
+		}
+#endif
+
+		default:
+			LOG_ERROR("Compression type [%d] is not supported by this build of GDK", compressionType);
+			return false;
 	}
 
 	return true;
-}
\ No newline at end of file
+}
+
+// *****************************************************************
+/// @brief
+///     Decompresses a block of memory straight into another block of memory
+/// @param source
+///     The compressed data
+/// @param sourceSize
+///     Size of the compressed data (in bytes)
+/// @param destination
+///     Buffer to decompress the data into
+/// @param destinationSize
+///     Size of the decompressed data (in bytes)
+/// @param compressionType
+///     Which compression type the data is compressed with
+/// @return
+///     True if the data decompressed to exactly destinationSize bytes
+/// @remarks
+///     The data is inflated in a single pass, with no intermediate buffers, so this is the fastest way to
+///     decompress data that is already in memory.  It is safe to call from several threads at once.
+// *****************************************************************
+bool Stream::Decompress(const void* source, int sourceSize, void* destination, int destinationSize, CompressionType::Enum compressionType)
+{
+	GDK_PROFILE_SCOPE("Stream::Decompress");
+	ResourceLoadTimer loadTimer(ResourceLoadPhase::Decompress);
+
+	switch(compressionType)
+	{
+		// ---------------------------------- ZLib ------------------------------------
+		case CompressionType::ZLib:
+		{
+			z_stream strm;
+			strm.zalloc = Z_NULL;
+			strm.zfree = Z_NULL;
+			strm.opaque = Z_NULL;
+			strm.next_in = (Bytef*) source;
+			strm.avail_in = (uInt) sourceSize;
+			strm.next_out = (Bytef*) destination;
+			strm.avail_out = (uInt) destinationSize;
+			if(inflateInit(&strm) != Z_OK)
+				return false;
+
+			// Inflate the whole block at once
+			int ret = inflate(&strm, Z_FINISH);
+			(void)inflateEnd(&strm);
+
+			return ret == Z_STREAM_END && strm.avail_out == 0;
+		}
+
+#ifdef GDK_LZ4
+		// ---------------------------------- LZ4 ------------------------------------
+		case CompressionType::LZ4:
+		{
+			LZ4F_dctx* context = NULL;
+			if(LZ4F_isError(LZ4F_createDecompressionContext(&context, LZ4F_VERSION)))
+				return false;
+
+			// Decompress the frame straight into the destination
+			size_t inPosition = 0;
+			size_t outPosition = 0;
+			size_t ret = 1;
+			while(ret != 0 && inPosition < (size_t) sourceSize)
+			{
+				size_t inSize = sourceSize - inPosition;
+				size_t outSize = destinationSize - outPosition;
+				ret = LZ4F_decompress(context, (UInt8*) destination + outPosition, &outSize, (const UInt8*) source + inPosition, &inSize, NULL);
+				if(LZ4F_isError(ret) || (inSize == 0 && outSize == 0))
+					break;
+
+				inPosition += inSize;
+				outPosition += outSize;
+			}
+
+			LZ4F_freeDecompressionContext(context);
+			return ret == 0 && outPosition == (size_t) destinationSize;
+		}
+#endif
+
+#ifdef GDK_ZSTD
+		// ---------------------------------- Zstd ------------------------------------
+		case CompressionType::Zstd:
+		{
+			size_t ret = ZSTD_decompress(destination, destinationSize, source, sourceSize);
+			return ZSTD_isError(ret) == 0 && ret == (size_t) destinationSize;
+		}
+#endif
+
+		default:
+			LOG_ERROR("Compression type [%d] is not supported by this build of GDK", compressionType);
+			return false;
+	}
+}
+
+// *****************************************************************
+/// @brief
+///     Compresses the rest of this stream (from the current position) into another stream
+/// @param destination
+///     Stream to where the compressed data is to be written
+/// @param compressionType
+///     Which compression type to compress the data with
+/// @return
+///     The number of compressed bytes written to the destination, or -1 if the compression failed
+// *****************************************************************
+int Stream::Compress(Stream* destination, CompressionType::Enum compressionType)
+{
+	// The block compressors work on int sized buffers
+	Int64 remaining = GetLength() - GetPosition();
+	if(remaining > INT_MAX)
+	{
+		LOG_ERROR("Unable to compress %lld bytes in one block", remaining);
+		return -1;
+	}
+	int sourceSize = (int) remaining;
+
+	// Get the source data, in place if possible
+	UInt8* sourceCopy = NULL;
+	const void* source = GetSpan(GetPosition(), sourceSize);
+	if(source != NULL)
+	{
+		Seek(sourceSize, SeekOrigin::Current);
+	}
+	else
+	{
+		sourceCopy = (UInt8*) GdkAlloc(sourceSize > 0 ? sourceSize : 1);
+		sourceSize = Read(sourceCopy, sourceSize);
+		source = sourceCopy;
+	}
+
+	// Compress it into a temp buffer
+	int maxCompressedSize = GetMaxCompressedSize(sourceSize, compressionType);
+	UInt8* compressed = (UInt8*) GdkAlloc(maxCompressedSize > 0 ? maxCompressedSize : 1);
+	int compressedSize = Compress(source, sourceSize, compressed, maxCompressedSize, compressionType);
+
+	// Write out the compressed data
+	if(compressedSize >= 0)
+		destination->Write(compressed, compressedSize);
+
+	GdkFree(compressed);
+	if(sourceCopy != NULL)
+		GdkFree(sourceCopy);
+
+	return compressedSize;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the largest size that a block of data can be, once compressed
+/// @param sourceSize
+///     Size of the uncompressed data (in bytes)
+/// @param compressionType
+///     Which compression type the data will be compressed with
+// *****************************************************************
+int Stream::GetMaxCompressedSize(int sourceSize, CompressionType::Enum compressionType)
+{
+	switch(compressionType)
+	{
+		case CompressionType::ZLib:
+			return (int) compressBound((uLong) sourceSize);
+#ifdef GDK_LZ4
+		case CompressionType::LZ4:
+			return (int) LZ4F_compressFrameBound(sourceSize, NULL);
+#endif
+#ifdef GDK_ZSTD
+		case CompressionType::Zstd:
+			return (int) ZSTD_compressBound(sourceSize);
+#endif
+		default:
+			return 0;
+	}
+}
+
+// *****************************************************************
+/// @brief
+///     Compresses a block of memory into another block of memory
+/// @param source
+///     The data to compress
+/// @param sourceSize
+///     Size of the data (in bytes)
+/// @param destination
+///     Buffer to compress the data into.  Use GetMaxCompressedSize() for the size needed.
+/// @param destinationSize
+///     Size of the destination buffer (in bytes)
+/// @param compressionType
+///     Which compression type to compress the data with
+/// @return
+///     The size of the compressed data, or -1 if the compression failed
+/// @remarks
+///     Each compression type produces a complete zlib stream, LZ4 frame or Zstd frame, at the library's default level.
+// *****************************************************************
+int Stream::Compress(const void* source, int sourceSize, void* destination, int destinationSize, CompressionType::Enum compressionType)
+{
+	switch(compressionType)
+	{
+		// ---------------------------------- ZLib ------------------------------------
+		case CompressionType::ZLib:
+		{
+			uLongf compressedSize = (uLongf) destinationSize;
+			if(compress((Bytef*) destination, &compressedSize, (const Bytef*) source, (uLong) sourceSize) != Z_OK)
+				return -1;
+			return (int) compressedSize;
+		}
+
+#ifdef GDK_LZ4
+		// ---------------------------------- LZ4 ------------------------------------
+		case CompressionType::LZ4:
+		{
+			size_t ret = LZ4F_compressFrame(destination, destinationSize, source, sourceSize, NULL);
+			return LZ4F_isError(ret) ? -1 : (int) ret;
+		}
+#endif
+
+#ifdef GDK_ZSTD
+		// ---------------------------------- Zstd ------------------------------------
+		case CompressionType::Zstd:
+		{
+			size_t ret = ZSTD_compress(destination, destinationSize, source, sourceSize, ZSTD_CLEVEL_DEFAULT);
+			return ZSTD_isError(ret) ? -1 : (int) ret;
+		}
+#endif
+
+		default:
+			LOG_ERROR("Compression type [%d] is not supported by this build of GDK", compressionType);
+			return -1;
+	}
+}
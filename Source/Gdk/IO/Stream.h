@@ -6,9 +6,15 @@
 #pragma once
 
 
+// Uncomment these lines to enable the LZ4 & Zstandard compression types.  (The lz4 & zstd libraries must then be linked)
+//#define GDK_LZ4
+//#define GDK_ZSTD
 
 namespace Gdk
 {
+    class AsyncIORequest;
+    class Matrix3D;
+    
 	/// @addtogroup IO
     /// @{
     
@@ -36,19 +42,46 @@ namespace Gdk
     // =================================================================================
     /// @brief
     ///     Enumeration of compression types supported by streams
+    /// @remarks
+    ///     The values are stored in asset files, so new types must be added to the end.
+    ///     LZ4 & Zstd must be enabled when building GDK.  (See GDK_LZ4 & GDK_ZSTD)
 	// =================================================================================
 	namespace CompressionType
 	{
 		enum Enum
 		{	
             /// Standard ZLib based compression
-			ZLib
+			ZLib = 0,
+            
+            /// LZ4 frame compression.  Decompresses several times faster than ZLib, at a lower ratio.
+            LZ4 = 1,
+            
+            /// Zstandard frame compression.  Close to the ratio of ZLib, while decompressing much faster.
+            Zstd = 2
 		};
 	}
 
 	// =================================================================================
     /// @brief
+    ///     One of the buffers of a vectored read or write
+    /// @see
+    ///     Stream::ReadV, Stream::WriteV
+	// =================================================================================
+    struct StreamBuffer
+    {
+        /// The bytes to read into, or write from
+        void* Data;
+        
+        /// Number of bytes
+        int Size;
+    };
+
+	// =================================================================================
+    /// @brief
     ///     Provides methods for reading, writing, and accessing a generic stream of bytes
+    /// @remarks
+    ///     Positions, lengths & offsets are 64-bit, so streams can be larger than 2 GB.  The sizes of
+    ///     individual reads & writes are still ints, as they are bounded by the caller's buffer.
 	// =================================================================================
 	class Stream
 	{
@@ -79,11 +112,11 @@ namespace Gdk
         ///     Sets the current position within the stream
         /// @param position
         ///     The new position to set in the stream
-        virtual void SetPosition(int position) = 0;
+        virtual void SetPosition(Int64 position) = 0;
 
         /// @brief
         ///     Gets the current position within the stream
-        virtual int GetPosition() = 0;
+        virtual Int64 GetPosition() = 0;
 
         /// @brief
         ///     Changes the current position within the stream
@@ -91,7 +124,7 @@ namespace Gdk
         ///     Offset to seek within the stream.
         /// @param origin
         ///     Origin which the offset is relative to.
-        virtual void Seek(int offset, SeekOrigin::Enum origin) = 0;
+        virtual void Seek(Int64 offset, SeekOrigin::Enum origin) = 0;
 
         /// @brief
         ///     Changes the length of the stream. (in bytes)
@@ -99,11 +132,11 @@ namespace Gdk
         ///     New length for the stream (in bytes)
         /// @note
         ///     Not all streams support resizing
-        virtual void SetLength(int length) = 0;
+        virtual void SetLength(Int64 length) = 0;
 
         /// @brief
         ///     Gets the current length of the stream.  (in bytes)
-        virtual int GetLength() = 0;
+        virtual Int64 GetLength() = 0;
 
         /// @brief
         ///     Closes the stream
@@ -118,6 +151,26 @@ namespace Gdk
         ///     Checks if the internal stream position is at the end of the stream
         inline bool AtEnd() { return this->GetPosition() >= this->GetLength(); }
 
+        /// @brief
+        ///     Gets a pointer directly into the memory behind the stream, so data can be used without copying it.
+        /// @param offset
+        ///     Offset (from the beginning of the stream) of the first byte of the span
+        /// @param size
+        ///     Number of bytes in the span
+        /// @return
+        ///     A read-only pointer to the span, or NULL if the stream is not backed by memory or the span is out of range.
+        /// @note
+        ///     The pointer is owned by the stream, and is only valid until the stream is closed.
+        virtual const void* GetSpan(Int64 offset, Int64 size) { return NULL; }
+
+        /// @brief
+        ///     Gets the OS file descriptor behind the stream, that ReadAt() & WriteAt() transfer through.
+        /// @return
+        ///     The file descriptor, or -1 if the stream is not a plain file.
+        /// @remarks
+        ///     The AsyncIO system uses this to hand reads & writes straight to the kernel.
+        virtual int GetFileDescriptor() { return -1; }
+
         
         /// @}
 		// -----------------------------------------------------------------------------------------
@@ -133,6 +186,40 @@ namespace Gdk
         ///     Number of bytes to read.
         virtual int Read(void* destination, int size) = 0;
 
+        /// @brief
+        ///     Reads a fixed size set of bytes from the given offset, without using or moving the current position.
+        virtual int ReadAt(void* destination, Int64 offset, int size);
+        
+        /// @brief
+        ///     Queues a read of a fixed size set of bytes from the given offset, to be done on an I/O thread.
+        AsyncIORequest* ReadAsync(void* destination, Int64 offset, int size, short priority = 1);
+        
+        /// @brief
+        ///     Reads consecutive bytes from the stream into several buffers, in order.  (Scatter read)
+        virtual int ReadV(const StreamBuffer* buffers, int count);
+        
+        /// @brief
+        ///     Reads an array of values from the stream, in a single read.
+        /// @param destination
+        ///     Array to read the values into
+        /// @param count
+        ///     Number of values to read
+        /// @return
+        ///     The number of whole values that were read
+        /// @note
+        ///     T must be a plain data type, stored in the stream with the same layout it has in memory.  
+        ///     (Such as Matrix3D, Vector3 or UInt16)
+        template<typename T>
+        inline int ReadArray(T* destination, int count)	{return count > 0 ? Read(destination, count * (int)sizeof(T)) / (int)sizeof(T) : 0;}
+        
+        /// @brief
+        ///     Reads an array of values from the stream, into a vector.  The vector is resized to the count.
+        template<typename T>
+        inline int ReadArray(vector<T>& destination, int count)	{destination.resize(count); return count > 0 ? ReadArray(&destination[0], count) : 0;}
+        
+        /// @brief
+        ///     Reads an array of matrices from the stream, in a single read.
+        int ReadMatrices(Matrix3D* destination, int count);
         
 		/// @brief
         ///     Reads a bool value from the stream.
@@ -196,6 +283,23 @@ namespace Gdk
         ///     Number of bytes to write.
         virtual int Write(void* source, int size) = 0;
 
+        /// @brief
+        ///     Writes a buffer of bytes at the given offset, without using or moving the current position.
+        virtual int WriteAt(void* source, Int64 offset, int size);
+        
+        /// @brief
+        ///     Writes the bytes of several buffers to the stream, one after another.  (Gather write)
+        virtual int WriteV(const StreamBuffer* buffers, int count);
+        
+        /// @brief
+        ///     Writes an array of plain data values to the stream, in a single write.
+        template<typename T>
+        inline void WriteArray(const T* source, int count)	{if(count > 0) Write((void*)source, count * (int)sizeof(T));}
+        
+        /// @brief
+        ///     Writes an array of matrices to the stream, in a single write.
+        void WriteMatrices(const Matrix3D* source, int count);
+
         /// @brief
         ///     Writes a bool value to the stream.
         inline void WriteBool(bool value)		{Int8 realValue = value; Write(&realValue, sizeof(Int8));}
@@ -249,10 +353,13 @@ namespace Gdk
         /// @name Compression Methods
         /// @{
 
-        bool Decompress(Stream* destination, CompressionType::Enum compressionType);	
-
-		// Compresses this stream into the given stream
-		// TODO(P2)  int Compress(Stream* destination, CompressionType::Enum compressionType);
+        bool Decompress(Stream* destination, CompressionType::Enum compressionType, Int64 sourceSize = -1);
+        int Compress(Stream* destination, CompressionType::Enum compressionType);
+        
+        static bool Decompress(const void* source, int sourceSize, void* destination, int destinationSize, CompressionType::Enum compressionType);
+        static int Compress(const void* source, int sourceSize, void* destination, int destinationSize, CompressionType::Enum compressionType);
+        static int GetMaxCompressedSize(int sourceSize, CompressionType::Enum compressionType);
+        static bool IsCompressionTypeSupported(CompressionType::Enum compressionType);
         
         /// @}
         
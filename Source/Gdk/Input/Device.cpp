@@ -51,7 +51,7 @@ const char* PlatformType::ToString(PlatformType::Enum value)
 {
 	static const char* windows = "Windows";
 	static const char* mac = "Mac";
-	static const char* linux = "Linux";
+	static const char* linuxOS = "Linux";
 	static const char* iOS = "iOS";
 	static const char* android = "Android";
 	static const char* naCl = "NaCl";
@@ -60,7 +60,7 @@ const char* PlatformType::ToString(PlatformType::Enum value)
 	{
 		case PlatformType::Windows:		return windows;
 		case PlatformType::Mac:			return mac;
-		case PlatformType::Linux:		return linux;
+		case PlatformType::Linux:		return linuxOS;
 		case PlatformType::iOS:			return iOS;
 		case PlatformType::Android:		return android;
 		case PlatformType::NaCl:		return naCl;
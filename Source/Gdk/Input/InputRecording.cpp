@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "BasePCH.h"
+#include "InputRecording.h"
+
+// Input recording file header:  "GDKINPUT", UInt32 version, UInt32 flags, float fixed time step
+#define INPUTRECORDING_VERSION              1
+#define INPUTRECORDING_HEADER_SIZE          20
+#define INPUTRECORDING_FLAG_FIXEDTIMESTEP   0x01
+
+using namespace Gdk;
+
+// Static Instantiations
+FileStream* InputRecording::recordFile = NULL;
+vector<InputEvent> InputRecording::playbackEvents;
+size_t InputRecording::nextPlaybackEvent = 0;
+int InputRecording::playbackFrame = 0;
+int InputRecording::playbackFrameCount = 0;
+bool InputRecording::isPlaying = false;
+bool InputRecording::isDispatching = false;
+bool InputRecording::exitWhenPlaybackFinishes = false;
+
+// Events
+MulticastDelegate0<void> InputRecording::PlaybackFinished;
+
+// *****************************************************************
+/// @brief
+///     Gets the name of an InputEventType
+// *****************************************************************
+const char* InputEventType::ToString(InputEventType::Enum eventType)
+{
+	static const char* eventTypeNames[] =
+	{
+		"Frame",
+		"KeyDown",
+		"KeyUp",
+		"Char",
+		"MouseMove",
+		"MouseButtonDown",
+		"MouseButtonUp",
+		"MouseWheelScroll",
+		"MouseEnterApp",
+		"MouseLeaveApp",
+		"TouchUpdate",
+		"ShakingBegan",
+		"ShakingEnded",
+		"Accelerometer",
+	};
+	if(eventType < 0 || eventType >= InputEventType::Count)
+		return StringUtilities::Unknown;
+	return eventTypeNames[eventType];
+}
+
+// *****************************************************************
+/// @brief
+///     Shuts down the input recording, closing any recording or playback in progress
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void InputRecording::Shutdown()
+{
+    StopRecording();
+    StopPlayback();
+}
+
+// *****************************************************************
+/// @brief
+///     Starts recording the input & frame times to a file
+/// @param filePath
+///     Path of the recording file.  An existing file is replaced.
+/// @remarks
+///     The keys & mouse buttons that are already down are recorded first, so the playback starts from the same state.
+///     Touches that are already in progress are not.
+/// @return
+///     false if the file couldn't be created.
+// *****************************************************************
+bool InputRecording::StartRecording(const char* filePath)
+{
+    ASSERT(isPlaying == false, "Can not record the input during a playback");
+    StopRecording();
+
+    recordFile = File::Open(filePath, FileMode::WriteBehind);
+    if(recordFile == NULL)
+    {
+        LOG_WARN("Unable to create the input recording: %s", filePath);
+        return false;
+    }
+
+    // Write the header
+    UInt32 flags = Application::IsUsingFixedTimeStep ? INPUTRECORDING_FLAG_FIXEDTIMESTEP : 0;
+    recordFile->Write((void*) "GDKINPUT", 8);
+    recordFile->WriteUInt32(INPUTRECORDING_VERSION);
+    recordFile->WriteUInt32(flags);
+    recordFile->WriteFloat(Application::FixedTimeStep);
+
+    // Record the current input state
+    WriteEvent(Mouse::IsMouseOverApp() ? InputEventType::MouseEnterApp : InputEventType::MouseLeaveApp, 0, 0, 0.0f, 0.0f, 0.0f);
+    WriteEvent(InputEventType::MouseMove, Mouse::GetX(), Mouse::GetY(), 0.0f, 0.0f, 0.0f);
+    for(int button = 0; button < MouseButton::MAX_BUTTONS; button++)
+    {
+        if(Mouse::IsButtonDown((MouseButton::Enum)button))
+            WriteEvent(InputEventType::MouseButtonDown, button, 0, 0.0f, 0.0f, 0.0f);
+    }
+    for(int key = 0; key < 256; key++)
+    {
+        if(Keyboard::IsKeyDown((Keys::Enum)key))
+            WriteEvent(InputEventType::KeyDown, key, 0, 0.0f, 0.0f, 0.0f);
+    }
+    Vector3 acceleration = MotionInput::GetAccelerometerAcceleration();
+    WriteEvent(InputEventType::Accelerometer, 0, 0, acceleration.X, acceleration.Y, acceleration.Z);
+
+    LOG_INFO("Recording the input to: %s", filePath);
+    return true;
+}
+
+// *****************************************************************
+/// @brief
+///     Stops the current recording, and closes the recording file
+// *****************************************************************
+void InputRecording::StopRecording()
+{
+    if(recordFile == NULL)
+        return;
+
+    recordFile->Close();
+    GdkDelete(recordFile);
+    recordFile = NULL;
+}
+
+// *****************************************************************
+/// @brief
+///     Returns true if the input is being recorded
+// *****************************************************************
+bool InputRecording::IsRecording()
+{
+    return recordFile != NULL;
+}
+
+// *****************************************************************
+/// @brief
+///     Starts playing back an input recording
+/// @param filePath
+///     Path of the recording file.
+/// @param exitWhenFinished
+///     If true, Application::Exit() is called when the playback reaches the end of the recording.
+/// @remarks
+///     The recording is loaded into memory, and played from the next main loop.  The fixed time step settings
+///     of the recorded session are restored.
+/// @return
+///     false if the file doesn't exist, can't be opened, or isn't an input recording.
+// *****************************************************************
+bool InputRecording::StartPlayback(const char* filePath, bool exitWhenFinished)
+{
+    ASSERT(recordFile == NULL, "Can not play back a recording while the input is being recorded");
+    StopPlayback();
+
+    if(File::Exists(filePath) == false)
+    {
+        LOG_WARN("Input recording not found: %s", filePath);
+        return false;
+    }
+
+    // Read & check the header
+    FileStream* file = File::Open(filePath, FileMode::Read);
+    if(file == NULL)
+    {
+        LOG_WARN("Unable to open the input recording: %s", filePath);
+        return false;
+    }
+    char magic[8];
+    file->Read(magic, 8);
+    UInt32 version = file->ReadUInt32();
+    UInt32 flags = file->ReadUInt32();
+    float fixedTimeStep = file->ReadFloat();
+
+    Int64 length = file->GetLength();
+    if(length < INPUTRECORDING_HEADER_SIZE || memcmp(magic, "GDKINPUT", 8) != 0 || version != INPUTRECORDING_VERSION)
+    {
+        LOG_WARN("Not a version %d input recording: %s", INPUTRECORDING_VERSION, filePath);
+        file->Close();
+        GdkDelete(file);
+        return false;
+    }
+
+    // Read all the events
+    int numEvents = (int)((length - INPUTRECORDING_HEADER_SIZE) / sizeof(InputEvent));
+    file->ReadArray(playbackEvents, numEvents);
+    file->Close();
+    GdkDelete(file);
+
+    // Count the frames
+    playbackFrameCount = 0;
+    for(vector<InputEvent>::iterator iter = playbackEvents.begin(); iter != playbackEvents.end(); iter++)
+    {
+        if(iter->Type == InputEventType::Frame)
+            playbackFrameCount++;
+    }
+
+    // Restore the update loop settings of the recorded session
+    Application::IsUsingFixedTimeStep = (flags & INPUTRECORDING_FLAG_FIXEDTIMESTEP) != 0;
+    Application::FixedTimeStep = fixedTimeStep;
+
+    nextPlaybackEvent = 0;
+    playbackFrame = 0;
+    exitWhenPlaybackFinishes = exitWhenFinished;
+    isPlaying = true;
+
+    LOG_INFO("Playing back the input from: %s  (%d frames)", filePath, playbackFrameCount);
+    return true;
+}
+
+// *****************************************************************
+/// @brief
+///     Stops the current playback.  Live input is processed again from this point.
+// *****************************************************************
+void InputRecording::StopPlayback()
+{
+    isPlaying = false;
+    playbackEvents.clear();
+    nextPlaybackEvent = 0;
+}
+
+// *****************************************************************
+/// @brief
+///     Returns true if a recording is being played back
+// *****************************************************************
+bool InputRecording::IsPlaying()
+{
+    return isPlaying;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the number of recorded frames that have been played back
+// *****************************************************************
+int InputRecording::GetPlaybackFrame()
+{
+    return playbackFrame;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the number of frames in the recording being played back
+// *****************************************************************
+int InputRecording::GetPlaybackFrameCount()
+{
+    return playbackFrameCount;
+}
+
+// *****************************************************************
+/// @brief
+///     Tells the input recording about an input from the platform
+/// @remarks
+///     Called at the start of each Platform_ input method, before the input is processed.  The input is
+///     recorded if a recording is in progress.
+/// @return
+///     false if the input should be ignored.  (Live input is ignored during a playback)
+/// @note
+///     GDK Internal Use Only
+// *****************************************************************
+bool InputRecording::Platform_OnInput(InputEventType::Enum eventType, Int32 value1, Int32 value2, float x, float y, float z)
+{
+    if(isPlaying)
+        return isDispatching;
+
+    if(recordFile != NULL)
+        WriteEvent(eventType, value1, value2, x, y, z);
+
+    return true;
+}
+
+// *****************************************************************
+/// @brief
+///     Records or plays back the start of a main loop
+/// @param elapsedSeconds
+///     Seconds since the last main loop.  Replaced by the recorded time, during a playback.
+/// @param secondsSinceLastUpdate
+///     The fixed time step accumulator.  Restored to the recorded value on the first frame of a playback.
+/// @remarks
+///     During a playback, the input recorded before this frame is dispatched.  When the last recorded frame has
+///     been played, the playback stops & PlaybackFinished is raised.
+///   @par
+///     Called by the Application at the start of every main loop.  (And by the unit tests, to run frames of their own)
+/// @note
+///     GDK Internal Use Only
+// *****************************************************************
+void InputRecording::Platform_BeginFrame(float& elapsedSeconds, float& secondsSinceLastUpdate)
+{
+    // Recording
+    if(recordFile != NULL)
+    {
+        WriteEvent(InputEventType::Frame, 0, 0, elapsedSeconds, secondsSinceLastUpdate, 0.0f);
+        return;
+    }
+
+    if(isPlaying == false)
+        return;
+
+    // Has the whole recording been played?
+    if(playbackFrame >= playbackFrameCount)
+    {
+        LOG_INFO("Input playback finished after %d frames", playbackFrame);
+        StopPlayback();
+        PlaybackFinished.Invoke();
+        if(exitWhenPlaybackFinishes)
+            Application::Exit();
+        return;
+    }
+
+    // Dispatch the input, up to this frame's record
+    isDispatching = true;
+    while(nextPlaybackEvent < playbackEvents.size())
+    {
+        const InputEvent& inputEvent = playbackEvents[nextPlaybackEvent++];
+        if(inputEvent.Type == InputEventType::Frame)
+        {
+            elapsedSeconds = inputEvent.X;
+            if(playbackFrame == 0)
+                secondsSinceLastUpdate = inputEvent.Y;
+            playbackFrame++;
+            break;
+        }
+
+        DispatchEvent(inputEvent);
+    }
+    isDispatching = false;
+}
+
+// *****************************************************************
+/// @brief
+///     Writes an event to the recording file
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void InputRecording::WriteEvent(InputEventType::Enum eventType, Int32 value1, Int32 value2, float x, float y, float z)
+{
+    InputEvent inputEvent;
+    inputEvent.Type = (UInt8) eventType;
+    inputEvent.Reserved[0] = inputEvent.Reserved[1] = inputEvent.Reserved[2] = 0;
+    inputEvent.Value1 = value1;
+    inputEvent.Value2 = value2;
+    inputEvent.X = x;
+    inputEvent.Y = y;
+    inputEvent.Z = z;
+
+    recordFile->Write(&inputEvent, sizeof(InputEvent));
+}
+
+// *****************************************************************
+/// @brief
+///     Passes a recorded event to the input system it came from
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void InputRecording::DispatchEvent(const InputEvent& inputEvent)
+{
+    switch(inputEvent.Type)
+    {
+        case InputEventType::KeyDown:
+            Keyboard::Platform_ProcessKeyDown((Keys::Enum) inputEvent.Value1);
+            break;
+        case InputEventType::KeyUp:
+            Keyboard::Platform_ProcessKeyUp((Keys::Enum) inputEvent.Value1);
+            break;
+        case InputEventType::Char:
+            Keyboard::Platform_ProcessChar((char) inputEvent.Value1);
+            break;
+        case InputEventType::MouseMove:
+            Mouse::Platform_ProcessMouseMove(inputEvent.Value1, inputEvent.Value2);
+            break;
+        case InputEventType::MouseButtonDown:
+            Mouse::Platform_ProcessMouseButtonDown((MouseButton::Enum) inputEvent.Value1);
+            break;
+        case InputEventType::MouseButtonUp:
+            Mouse::Platform_ProcessMouseButtonUp((MouseButton::Enum) inputEvent.Value1);
+            break;
+        case InputEventType::MouseWheelScroll:
+            Mouse::Platform_ProcessMouseWheelScroll(inputEvent.X, inputEvent.Y);
+            break;
+        case InputEventType::MouseEnterApp:
+            Mouse::Platform_ProcessMouseEnterApp();
+            break;
+        case InputEventType::MouseLeaveApp:
+            Mouse::Platform_ProcessMouseLeaveApp();
+            break;
+        case InputEventType::TouchUpdate:
+            TouchInput::Platform_ProcessTouchUpdate(inputEvent.Value1, Vector2(inputEvent.X, inputEvent.Y), (TouchState::Enum) inputEvent.Value2);
+            break;
+        case InputEventType::ShakingBegan:
+            MotionInput::Platform_ShakingBegan();
+            break;
+        case InputEventType::ShakingEnded:
+            MotionInput::Platform_ShakingEnded();
+            break;
+        case InputEventType::Accelerometer:
+            MotionInput::Platform_UpdateAccelerometer(Vector3(inputEvent.X, inputEvent.Y, inputEvent.Z));
+            break;
+        default:
+            LOG_WARN("Unknown input recording event type: %d", inputEvent.Type);
+            break;
+    }
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+
+
+namespace Gdk
+{
+	/// @addtogroup Input
+    /// @{
+
+	// =================================================================================
+    /// @brief
+    ///     Enumeration of the events stored in an input recording
+	// =================================================================================
+	namespace InputEventType
+	{
+		enum Enum
+		{
+            /// The start of a main loop.  X = elapsed seconds, Y = fixed time step accumulator
+            Frame = 0,
+
+            /// Keyboard::Platform_ProcessKeyDown.  Value1 = key
+            KeyDown,
+
+            /// Keyboard::Platform_ProcessKeyUp.  Value1 = key
+            KeyUp,
+
+            /// Keyboard::Platform_ProcessChar.  Value1 = character
+            Char,
+
+            /// Mouse::Platform_ProcessMouseMove.  Value1 = x, Value2 = y
+            MouseMove,
+
+            /// Mouse::Platform_ProcessMouseButtonDown.  Value1 = button
+            MouseButtonDown,
+
+            /// Mouse::Platform_ProcessMouseButtonUp.  Value1 = button
+            MouseButtonUp,
+
+            /// Mouse::Platform_ProcessMouseWheelScroll.  X = delta x, Y = delta y
+            MouseWheelScroll,
+
+            /// Mouse::Platform_ProcessMouseEnterApp
+            MouseEnterApp,
+
+            /// Mouse::Platform_ProcessMouseLeaveApp
+            MouseLeaveApp,
+
+            /// TouchInput::Platform_ProcessTouchUpdate.  Value1 = internal id, Value2 = state, X,Y = position
+            TouchUpdate,
+
+            /// MotionInput::Platform_ShakingBegan
+            ShakingBegan,
+
+            /// MotionInput::Platform_ShakingEnded
+            ShakingEnded,
+
+            /// MotionInput::Platform_UpdateAccelerometer.  X,Y,Z = acceleration
+            Accelerometer,
+
+            /// Number of event types
+            Count
+		};
+
+		const char* ToString(InputEventType::Enum eventType);
+	}
+
+    // =================================================================================
+    /// @brief
+    ///     One event in an input recording
+    /// @remarks
+    ///     Every event is the same fixed size, so a recording can be read straight into an array.
+    // =================================================================================
+    struct InputEvent
+    {
+        UInt8 Type;             ///< InputEventType of the event
+        UInt8 Reserved[3];
+        Int32 Value1;
+        Int32 Value2;
+        float X;
+        float Y;
+        float Z;
+    };
+
+    // =================================================================================
+    ///	@brief
+    ///		Records the platform input & frame times of a session, and plays them back.
+    ///	@remarks
+    ///		The recorder captures every input the platform passes to Keyboard, Mouse, TouchInput & MotionInput,
+    ///     along with the elapsed time of each main loop.  The player feeds the recorded input back in at the same
+    ///     frames, and substitutes the recorded elapsed times for the real ones.  Live input is ignored while playing.
+    ///   @par
+    ///     With a fixed time step, a playback runs the exact same sequence of updates as the recorded session.  So the
+    ///     same capture can be run against different builds, and their FrameStats compared.  (FrameStats always measures
+    ///     the real frame times)  For the updates to match, the game itself must be deterministic too: It shouldn't read
+    ///     the clock or use an unseeded Random.
+    ///   @par
+    ///     Recording & playback can be started from code, or with ApplicationSettings::InputRecordFile &
+    ///     ApplicationSettings::InputPlaybackFile.  The file format is described in "Docs/File Formats/Input Recording Format.txt".
+    // =================================================================================
+	class InputRecording
+	{
+	public:
+
+        // Public Methods
+		// =====================================================
+
+        // ---------------------------------
+        /// @name Recording Methods
+        /// @{
+
+        static bool StartRecording(const char* filePath);
+        static void StopRecording();
+        static bool IsRecording();
+
+        /// @}
+
+        // ---------------------------------
+        /// @name Playback Methods
+        /// @{
+
+        static bool StartPlayback(const char* filePath, bool exitWhenFinished = false);
+        static void StopPlayback();
+        static bool IsPlaying();
+        static int GetPlaybackFrame();
+        static int GetPlaybackFrameCount();
+
+        /// @}
+
+        // Public Events
+		// =====================================================
+
+        /// @name Events
+        /// @{
+
+		/// @brief
+        ///     This event is raised when a playback reaches the end of the recording.
+        static MulticastDelegate0<void>  PlaybackFinished;
+
+        /// @}
+
+    public:
+
+        // INTERNAL ONLY - Platform Interfaces
+		// =====================================================
+
+        /// @cond INTERNAL
+
+        // ---------------------------------
+        /// @name Internal Platform Methods
+        /// @{
+
+        static bool Platform_OnInput(InputEventType::Enum eventType, Int32 value1 = 0, Int32 value2 = 0, float x = 0.0f, float y = 0.0f, float z = 0.0f);
+        static void Platform_BeginFrame(float& elapsedSeconds, float& secondsSinceLastUpdate);
+
+        /// @}
+
+        /// @endcond
+
+	private:
+
+        // Private Methods
+		// =====================================================
+
+        friend class Application;
+
+        static void Shutdown();
+
+        static void WriteEvent(InputEventType::Enum eventType, Int32 value1, Int32 value2, float x, float y, float z);
+        static void DispatchEvent(const InputEvent& inputEvent);
+
+		// Private Properties
+		// =====================================================
+
+        // Recording
+        static FileStream* recordFile;
+
+        // Playback
+        static vector<InputEvent> playbackEvents;
+        static size_t nextPlaybackEvent;
+        static int playbackFrame;
+        static int playbackFrameCount;
+        static bool isPlaying;
+        static bool isDispatching;
+        static bool exitWhenPlaybackFinishes;
+	};
+
+    /// @} // Input
+
+} // namespace Gdk
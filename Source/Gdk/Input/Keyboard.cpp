@@ -72,6 +72,10 @@ void Keyboard::PostUpdate(float elapsedSeconds)
 // *****************************************************************
 void Keyboard::Platform_ProcessKeyDown(Keys::Enum key)
 {
+	// Record the input  (Or ignore it, during a playback)
+	if(InputRecording::Platform_OnInput(InputEventType::KeyDown, (Int32) key) == false)
+		return;
+
 	// Determine if the key was already down
 	bool wasAlreadyDown = (keyStates[(int)key] & KBFLAG_KEY_DOWN) == KBFLAG_KEY_DOWN;
 
@@ -109,6 +113,10 @@ void Keyboard::Platform_ProcessKeyDown(Keys::Enum key)
 // *****************************************************************
 void Keyboard::Platform_ProcessKeyUp(Keys::Enum key)
 {
+	// Record the input  (Or ignore it, during a playback)
+	if(InputRecording::Platform_OnInput(InputEventType::KeyUp, (Int32) key) == false)
+		return;
+
 	// Determine if the key was already up
 	bool wasAlreadyUp = (keyStates[(int)key] & KBFLAG_KEY_DOWN) == 0;
 
@@ -131,6 +139,10 @@ void Keyboard::Platform_ProcessKeyUp(Keys::Enum key)
 // *****************************************************************
 void Keyboard::Platform_ProcessChar(char c)
 {
+	// Record the input  (Or ignore it, during a playback)
+	if(InputRecording::Platform_OnInput(InputEventType::Char, (Int32) c) == false)
+		return;
+
 	// Call the event
 	CharTyped.Invoke(c);
 }
@@ -585,6 +597,11 @@ void Keyboard::InitScanCodeToKeyTable()
     
     // iOS has no keyboard keyDown/keyUp support..   yet  TODO(P2)
     
+    // ==================================================================================================================
+#elif defined(GDKPLATFORM_LINUX)
+    
+    // The headless Linux platform has no keyboard.  (An InputRecording playback passes Keys values straight to the Keyboard)
+    
     // ==================================================================================================================
 #else
     
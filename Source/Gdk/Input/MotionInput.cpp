@@ -52,6 +52,10 @@ Vector3 MotionInput::GetAccelerometerAcceleration()
 // *****************************************************************
 void MotionInput::Platform_ShakingBegan()
 {
+    // Record the input  (Or ignore it, during a playback)
+    if(InputRecording::Platform_OnInput(InputEventType::ShakingBegan) == false)
+        return;
+
     // Was the device not already shaking?
     if(isShaking == false)
     {
@@ -69,6 +73,10 @@ void MotionInput::Platform_ShakingBegan()
 // *****************************************************************
 void MotionInput::Platform_ShakingEnded()
 {
+	// Record the input  (Or ignore it, during a playback)
+	if(InputRecording::Platform_OnInput(InputEventType::ShakingEnded) == false)
+		return;
+
 	// Was the device not already shaking?
     if(isShaking == true)
     {
@@ -86,6 +94,10 @@ void MotionInput::Platform_ShakingEnded()
 // *****************************************************************
 void MotionInput::Platform_UpdateAccelerometer(Vector3 acceleration)
 {
+	// Record the input  (Or ignore it, during a playback)
+	if(InputRecording::Platform_OnInput(InputEventType::Accelerometer, 0, 0, acceleration.X, acceleration.Y, acceleration.Z) == false)
+		return;
+
 	accelerometerAcceleration = acceleration;
 }
 
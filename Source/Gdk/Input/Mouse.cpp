@@ -74,6 +74,10 @@ void Mouse::PostUpdate(float elapsedSeconds)
 // *****************************************************************
 void Mouse::Platform_ProcessMouseMove(int x, int y)
 {
+    // Record the input  (Or ignore it, during a playback)
+    if(InputRecording::Platform_OnInput(InputEventType::MouseMove, x, y) == false)
+        return;
+
     MouseMoveArgs args(x, y, mouseX, mouseY);
 
     // Set the new mouse position
@@ -92,6 +96,10 @@ void Mouse::Platform_ProcessMouseMove(int x, int y)
 // *****************************************************************
 void Mouse::Platform_ProcessMouseButtonDown(MouseButton::Enum button)
 {
+    // Record the input  (Or ignore it, during a playback)
+    if(InputRecording::Platform_OnInput(InputEventType::MouseButtonDown, (Int32) button) == false)
+        return;
+
     // Did the state change?
     if(buttonDown[(int)button] == false)
         buttonStateChanged[(int)button] = true;
@@ -109,6 +117,10 @@ void Mouse::Platform_ProcessMouseButtonDown(MouseButton::Enum button)
 // *****************************************************************
 void Mouse::Platform_ProcessMouseButtonUp(MouseButton::Enum button)
 {
+    // Record the input  (Or ignore it, during a playback)
+    if(InputRecording::Platform_OnInput(InputEventType::MouseButtonUp, (Int32) button) == false)
+        return;
+
     // Did the state change?
     if(buttonDown[(int)button] == true)
         buttonStateChanged[(int)button] = true;
@@ -126,6 +138,10 @@ void Mouse::Platform_ProcessMouseButtonUp(MouseButton::Enum button)
 // *****************************************************************
 void Mouse::Platform_ProcessMouseWheelScroll(float deltaX, float deltaY)
 {
+	// Record the input  (Or ignore it, during a playback)
+	if(InputRecording::Platform_OnInput(InputEventType::MouseWheelScroll, 0, 0, deltaX, deltaY) == false)
+		return;
+
 	// Call the event
 	MouseWheelScroll.Invoke(deltaX, deltaY);
 }
@@ -138,6 +154,10 @@ void Mouse::Platform_ProcessMouseWheelScroll(float deltaX, float deltaY)
 // *****************************************************************
 void Mouse::Platform_ProcessMouseEnterApp()
 {
+    // Record the input  (Or ignore it, during a playback)
+    if(InputRecording::Platform_OnInput(InputEventType::MouseEnterApp) == false)
+        return;
+
     // Are we not currently in the app?
     if(mouseIsOverApp == false)
     {
@@ -156,6 +176,10 @@ void Mouse::Platform_ProcessMouseEnterApp()
 // *****************************************************************
 void Mouse::Platform_ProcessMouseLeaveApp()
 {
+    // Record the input  (Or ignore it, during a playback)
+    if(InputRecording::Platform_OnInput(InputEventType::MouseLeaveApp) == false)
+        return;
+
     // Are we currently in the app?
     if(mouseIsOverApp == true)
     {
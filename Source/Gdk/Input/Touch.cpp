@@ -359,6 +359,10 @@ Touch* TouchInput::GetTouchById(int internalId, bool ignoreEndedTouches)
 // *****************************************************************
 void TouchInput::Platform_ProcessTouchUpdate(int internalId, Vector2 position, TouchState::Enum state)
 {
+	// Record the input  (Or ignore it, during a playback)
+	if(InputRecording::Platform_OnInput(InputEventType::TouchUpdate, internalId, (Int32) state, position.X, position.Y) == false)
+		return;
+
 	// Create a touch update & add it to the processing queue
 	touchUpdates.push_back(TouchUpdate(internalId, position, state));
 }
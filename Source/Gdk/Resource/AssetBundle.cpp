@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "BasePCH.h"
+#include "AssetBundle.h"
+
+using namespace Gdk;
+
+// *****************************************************************
+/// @brief
+///     Constructor
+// *****************************************************************
+AssetBundle::AssetBundle()
+{
+    // Create the thread sync objects
+    progressMutex = Mutex::Create("AssetBundleProgress");
+    completionEvent = Event::Create();
+    loadedAssetCount = 0;
+    asyncPriority = 1;
+}
+
+// *****************************************************************
+/// @brief
+///     Destructor
+// *****************************************************************
+AssetBundle::~AssetBundle()
+{
+    // Release our references to the bundled assets
+    for(size_t index = 0; index < entries.size(); index++)
+    {
+        if(entries[index].Asset != NULL)
+            entries[index].Asset->Release();
+    }
+
+    // Destroy the thread sync objects
+    GdkDelete( completionEvent );
+    GdkDelete( progressMutex );
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the number of assets listed in this bundle
+// *****************************************************************
+size_t AssetBundle::GetAssetCount()
+{
+    return entries.size();
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the name of an asset in this bundle
+/// @param index
+///     Index of the asset within the bundle
+// *****************************************************************
+const string& AssetBundle::GetAssetName(size_t index)
+{
+    return entries[index].Name;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the resource type of an asset in this bundle
+/// @param index
+///     Index of the asset within the bundle
+// *****************************************************************
+BundleAssetType::Enum AssetBundle::GetAssetType(size_t index)
+{
+    return entries[index].Type;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the resource that was loaded for an asset in this bundle
+/// @param index
+///     Index of the asset within the bundle
+/// @remarks
+///     Returns NULL if the asset has not been loaded yet.  The returned resource is
+///     owned by the bundle; call AddRef() on it if you need to keep it after the bundle
+///     is released.
+// *****************************************************************
+Resource* AssetBundle::GetAsset(size_t index)
+{
+    progressMutex->Lock();
+    Resource* asset = entries[index].Asset;
+    progressMutex->Unlock();
+
+    return asset;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the number of assets in this bundle that have finished loading
+// *****************************************************************
+size_t AssetBundle::GetLoadedAssetCount()
+{
+    return loadedAssetCount;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the loading progress of the whole bundle, from 0.0 to 1.0
+/// @remarks
+///     Progress is measured by asset count, not by asset size.
+// *****************************************************************
+float AssetBundle::GetProgress()
+{
+    // An empty bundle is complete once its manifest has been loaded
+    if(entries.size() == 0)
+        return IsReady() ? 1.0f : 0.0f;
+
+    return (float)loadedAssetCount / (float)entries.size();
+}
+
+// *****************************************************************
+/// @brief
+///     Blocks the calling thread until every asset in the bundle has been loaded
+/// @remarks
+///     Do not call this from a resource loader thread, as it may be the thread
+///     that would have loaded the remaining assets.
+// *****************************************************************
+void AssetBundle::WaitForCompletion()
+{
+    completionEvent->Wait(false);
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the amount of memory used by the bundle's manifest
+/// @remarks
+///     The bundled assets are not included, as they are owned by their own resource managers.
+// *****************************************************************
+size_t AssetBundle::GetMemoryUsed()
+{
+    size_t memoryUsed = sizeof(AssetBundle);
+    for(size_t index = 0; index < entries.size(); index++)
+    {
+        memoryUsed += sizeof(BundleEntry) + entries[index].Name.size()
+            + (entries[index].Dependencies.size() + entries[index].Dependents.size()) * sizeof(UInt16);
+    }
+    return memoryUsed;
+}
+
+// *****************************************************************
+/// @brief
+///     Loads the bundle manifest from the corresponding .gdkbundle asset
+/// @return
+///     False if the manifest is missing or invalid, such as one with a dependency cycle.  (The error is logged)
+/// @remarks
+///     This only reads the manifest, the bundled assets are scheduled by the AssetBundleManager.
+///     GDK Internal Use Only
+// *****************************************************************
+bool AssetBundle::LoadFromAsset()
+{
+    // Get a stream to the asset
+    char assetPath[256];
+    GDK_SNPRINTF(assetPath, 256, "%s.gdkbundle", GetName().c_str());
+    Stream* stream = AssetManager::GetAssetStream(assetPath);
+    if(stream == NULL)
+    {
+        LOG_ERROR("Unable to find the asset bundle: %s", assetPath);
+        return false;
+    }
+
+    // Read the header
+    UInt16 version = stream->ReadUInt16();
+    if(version != 1)
+    {
+        LOG_ERROR("Unsupported asset bundle version [%d] in %s", version, assetPath);
+        stream->Close();
+        GdkDelete( stream );
+        return false;
+    }
+
+    UInt16 numAssets = stream->ReadUInt16();
+    entries.resize(numAssets);
+
+    // Read the assets
+    bool valid = true;
+    for(UInt16 assetIndex = 0; assetIndex < numAssets; assetIndex++)
+    {
+        BundleEntry& entry = entries[assetIndex];
+        entry.Type = (BundleAssetType::Enum) stream->ReadUInt8();
+        entry.Name = stream->ReadString();
+        entry.PendingDependencies = 0;
+        entry.Asset = NULL;
+
+        // Read the indices of the assets this asset depends on
+        UInt16 numDependencies = stream->ReadUInt16();
+        entry.Dependencies.resize(numDependencies);
+        for(UInt16 dependencyIndex = 0; dependencyIndex < numDependencies; dependencyIndex++)
+        {
+            UInt16 dependency = stream->ReadUInt16();
+            if(dependency >= numAssets || dependency == assetIndex)
+            {
+                LOG_ERROR("Invalid dependency [%d] for \"%s\" in %s", dependency, entry.Name.c_str(), assetPath);
+                valid = false;
+                dependency = 0;
+            }
+            entry.Dependencies[dependencyIndex] = dependency;
+        }
+    }
+
+    // Close the stream
+    stream->Close();
+    GdkDelete( stream );
+
+    // Link the dependents & work out a valid load order
+    return valid && BuildLoadOrder();
+}
+
+// *****************************************************************
+/// @brief
+///     Links each asset to its dependents, and sorts the assets into a dependency-first order.
+/// @return
+///     False if the assets have a circular dependency.  (The assets in the cycle could never be loaded)
+/// @remarks
+///     The load order is only used when there are no background threads to load the bundle with.
+///     GDK Internal Use Only
+// *****************************************************************
+bool AssetBundle::BuildLoadOrder()
+{
+    // Reverse the dependency links & count the pending dependencies of each asset
+    for(UInt16 index = 0; index < entries.size(); index++)
+    {
+        BundleEntry& entry = entries[index];
+        entry.PendingDependencies = (int) entry.Dependencies.size();
+        for(size_t dependencyIndex = 0; dependencyIndex < entry.Dependencies.size(); dependencyIndex++)
+        {
+            entries[ entry.Dependencies[dependencyIndex] ].Dependents.push_back(index);
+        }
+    }
+
+    // Start with the assets that have no dependencies
+    vector<int> remaining(entries.size());
+    loadOrder.clear();
+    for(UInt16 index = 0; index < entries.size(); index++)
+    {
+        remaining[index] = entries[index].PendingDependencies;
+        if(remaining[index] == 0)
+            loadOrder.push_back(index);
+    }
+
+    // Walk the dependents, adding each asset once all of its dependencies are in the order
+    for(size_t orderIndex = 0; orderIndex < loadOrder.size(); orderIndex++)
+    {
+        BundleEntry& entry = entries[ loadOrder[orderIndex] ];
+        for(size_t dependentIndex = 0; dependentIndex < entry.Dependents.size(); dependentIndex++)
+        {
+            UInt16 dependent = entry.Dependents[dependentIndex];
+            if(--remaining[dependent] == 0)
+                loadOrder.push_back(dependent);
+        }
+    }
+
+    // Any asset not in the load order is part of (or depends on) a dependency cycle
+    if(loadOrder.size() != entries.size())
+    {
+        LOG_ERROR("The asset bundle \"%s\" has a circular dependency.  %d of its %d assets can't be loaded",
+            GetName().c_str(), (int)(entries.size() - loadOrder.size()), (int)entries.size());
+        return false;
+    }
+    return true;
+}
+
+// *****************************************************************
+/// @brief
+///     Loads a single asset of the bundle, through its resource manager
+/// @param index
+///     Index of the asset within the bundle
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void AssetBundle::LoadEntry(UInt16 index)
+{
+    BundleEntry& entry = entries[index];
+
+    // Load the asset through its manager.  The manager reference becomes the bundle's reference
+    Resource* asset = LoadAsset(entry.Type, entry.Name.c_str());
+    if(asset == NULL)
+        LOG_ERROR("Unknown asset type [%d] for \"%s\" in the asset bundle \"%s\"", entry.Type, entry.Name.c_str(), GetName().c_str());
+
+    progressMutex->Lock();
+    entry.Asset = asset;
+    progressMutex->Unlock();
+}
+
+// *****************************************************************
+/// @brief
+///     Marks an asset of the bundle as loaded
+/// @param index
+///     Index of the asset within the bundle
+/// @param[out] readyDependents
+///     Receives the assets whose dependencies have now all been loaded
+/// @return
+///     True if this was the last asset of the bundle to finish loading
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+bool AssetBundle::FinishEntry(UInt16 index, vector<UInt16>& readyDependents)
+{
+    progressMutex->Lock();
+
+    // Release the dependents that were only waiting on this asset
+    BundleEntry& entry = entries[index];
+    for(size_t dependentIndex = 0; dependentIndex < entry.Dependents.size(); dependentIndex++)
+    {
+        UInt16 dependent = entry.Dependents[dependentIndex];
+        if(--entries[dependent].PendingDependencies == 0)
+            readyDependents.push_back(dependent);
+    }
+
+    // Update the progress
+    loadedAssetCount++;
+    bool complete = (loadedAssetCount == entries.size());
+
+    progressMutex->Unlock();
+
+    return complete;
+}
+
+// *****************************************************************
+/// @brief
+///     Marks the whole bundle as ready (or failed) & signals its completion
+/// @param state
+///     ResourceState::Ready, or ResourceState::LoadFailed if the manifest couldn't be loaded
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void AssetBundle::FinishLoading(ResourceState::Enum state)
+{
+    this->State = state;
+    completionEvent->Set();
+
+    LoadComplete.Invoke(this);
+}
+
+// *****************************************************************
+/// @brief
+///     Loads an asset of the given type, through its resource manager
+/// @param type
+///     Type of the asset
+/// @param name
+///     Name of the asset
+/// @return
+///     A new reference to the asset, or NULL if the type is unknown
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+Resource* AssetBundle::LoadAsset(BundleAssetType::Enum type, const char* name)
+{
+    switch(type)
+    {
+        case BundleAssetType::Texture2D:    return Texture2DManager::FromAsset(name);
+        case BundleAssetType::Shader:       return ShaderManager::FromAsset(name);
+        case BundleAssetType::Atlas:        return AtlasManager::FromAsset(name);
+        case BundleAssetType::BMFont:       return BMFontManager::FromAsset(name);
+        case BundleAssetType::Model:        return ModelManager::FromAsset(name);
+    }
+    return NULL;
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+#include "Resource.h"
+
+namespace Gdk
+{
+	/// @addtogroup Resources & Assets
+    /// @{
+
+    // =================================================================================
+    ///	@brief
+    ///	    An enumeration of the resource types that can be listed in an asset bundle.
+    // =================================================================================
+    namespace BundleAssetType
+	{
+		enum Enum
+		{
+            /// A Texture2D  (.gdkimage)
+			Texture2D = 1,
+
+            /// A Shader  (.gdkshader)
+			Shader = 2,
+
+            /// An Atlas  (.gdkatlas)
+			Atlas = 3,
+
+            /// A BMFont  (.gdkfont)
+			BMFont = 4,
+
+            /// A Model  (.gdkmodel)
+			Model = 5,
+		};
+	}
+
+	// =================================================================================
+    ///	@brief
+    ///	    A set of assets that are loaded together, in dependency order.
+    ///	@remarks
+    ///		An asset bundle is loaded from a .gdkbundle manifest, which lists every asset in the
+    ///     set along with the assets it depends on.  (Such as the textures used by a model,
+    ///     the sheets of an atlas or the pages of a font)
+    ///   @par
+    ///     When a bundle loads, every asset with no outstanding dependencies is queued on the
+    ///     resource loader threads at once.  As each asset finishes, the assets that depend on it
+    ///     are queued in turn.  This way, a model only begins loading after its textures are
+    ///     ready, and does not end up loading them one by one from inside Model::LoadFromAsset.
+    ///   @par
+    ///     The bundle holds a reference to every asset it loads, until the bundle is released.
+    ///     Do not release a bundle while it is still loading.
+    // =================================================================================
+	class AssetBundle : public Resource
+	{
+	public:
+
+        // Public Types
+		// ================================
+
+        typedef Gdk::MulticastDelegate1<void, AssetBundle*>	AssetBundleDelegate;
+
+        // Public Events
+		// ================================
+
+        /// Called once every asset in the bundle has been loaded, or the bundle has failed to load.
+        /// @remarks
+        ///     This event is called on whichever thread loads the last asset of the bundle, which is
+        ///     usually one of the resource loader threads.  A bundle whose manifest is missing or invalid
+        ///     (such as one with a dependency cycle) loads none of its assets, & has the LoadFailed state.
+        AssetBundleDelegate LoadComplete;
+
+		// Public Methods
+		// ================================
+
+        // -----------------------------------
+        /// @name Common Methods
+        /// @{
+
+        ~AssetBundle();
+
+        size_t GetAssetCount();
+        const string& GetAssetName(size_t index);
+        BundleAssetType::Enum GetAssetType(size_t index);
+        Resource* GetAsset(size_t index);
+
+        /// @}
+
+        // -----------------------------------
+        /// @name Loading Progress Methods
+        /// @{
+
+        size_t GetLoadedAssetCount();
+        float GetProgress();
+        void WaitForCompletion();
+
+        /// @}
+
+    protected:
+
+        // Protected Methods
+		// ================================
+
+        // -----------------------------------
+        /// @name Virtuals from Resource
+        /// @{
+
+        virtual size_t GetMemoryUsed();
+
+        /// @}
+
+    private:
+
+        // Private Types
+		// ================================
+
+        // ***********************************************************************
+        struct BundleEntry
+        {
+            BundleAssetType::Enum   Type;
+            string                  Name;
+            vector<UInt16>          Dependencies;
+            vector<UInt16>          Dependents;
+            int                     PendingDependencies;
+            Resource*               Asset;
+        };
+
+        // Private Properties
+		// ================================
+
+        // Bundle contents
+        vector<BundleEntry> entries;
+        vector<UInt16> loadOrder;
+
+        // Loading progress
+        Mutex* progressMutex;
+        Event* completionEvent;
+        volatile size_t loadedAssetCount;
+        int asyncPriority;
+
+        // Private Methods
+		// ================================
+
+        friend class AssetBundleManager;
+        friend class AssetBundleWriter;
+
+        AssetBundle();
+
+        bool LoadFromAsset();
+        bool BuildLoadOrder();
+        void LoadEntry(UInt16 index);
+        bool FinishEntry(UInt16 index, vector<UInt16>& readyDependents);
+        void FinishLoading(ResourceState::Enum state);
+        
+        static Resource* LoadAsset(BundleAssetType::Enum type, const char* name);
+	};
+
+    /// @}
+
+} // namespace
@@ -0,0 +1,171 @@
+/* 
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "BasePCH.h"
+#include "AssetBundleManager.h"
+
+using namespace Gdk;
+
+// Static Instantiations
+AssetBundleManager* AssetBundleManager::singleton = NULL;
+
+// *****************************************************************
+/// @brief
+///     Constructor
+// *****************************************************************
+AssetBundleManager::AssetBundleManager()
+{
+}
+
+// *****************************************************************
+/// @brief
+///     Destructor
+// *****************************************************************
+AssetBundleManager::~AssetBundleManager()
+{
+}
+
+// *****************************************************************
+/// @brief
+///     Creates an AssetBundle resource from the given Gdk bundle asset, and loads every asset it lists
+/// @param name
+///     Name of the Gdk bundle asset.  This will also be the resource name.
+/// @param async
+///     If true, the bundle will be loaded by the background threads.  (Default = false)
+/// @param asyncPriority
+///     The priority for the bundled asset loads.  Higher priority items are processed first.
+/// @remarks
+///     The bundled assets are always loaded in parallel on the background threads, when there are any.
+///     A syncronous load simply waits for all of them to complete before returning.  Without background
+///     threads, the whole bundle is loaded on the calling thread, even for an async load.
+///   @par
+///     If the manifest is missing or invalid (such as one with a dependency cycle), none of the bundled
+///     assets are loaded, & the bundle is completed in the ResourceState::LoadFailed state.
+// *****************************************************************
+AssetBundle* AssetBundleManager::FromAsset(const char *name, bool async, int asyncPriority)
+{
+    // Get the existing bundle (or create a new one)
+    bool alreadyExists = false;
+    AssetBundle* bundle = (AssetBundle*) singleton->GetOrCreateResource(name, alreadyExists);
+    
+    // Start loading the bundle, if it is new
+    if(alreadyExists == false)
+    {
+        bundle->asyncPriority = asyncPriority;
+        
+        // (Without background threads, nothing would ever process the queued load)
+        if(async && singleton->HasBackgroundThreads())
+            singleton->QueueBackgroundTask(bundle, asyncPriority, &AssetBundleManager::PerformLoadFromAsset);
+        else
+        {
+            ResourceLoadStats::BeginLoad(bundle, singleton->GetResourceTypeName(), 0.0, false);
+            PerformLoadFromAsset(bundle);
+            ResourceLoadStats::EndLoad();
+        }
+    }
+    
+    // Wait for the bundled assets, if this is a syncronous load
+    if(async == false)
+        bundle->WaitForCompletion();
+    
+    return bundle;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets a new AssetBundle instance for the base ResourceManager.
+/// @remarks
+///     GDK Internal use only
+// *****************************************************************
+Resource* AssetBundleManager::OnCreateNewResourceInstance()
+{
+    return new AssetBundle();
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the name of the AssetBundle resource type, for the ResourceLoadStats
+/// @remarks
+///     GDK Internal use only
+// *****************************************************************
+const char* AssetBundleManager::GetResourceTypeName()
+{
+    return "AssetBundle";
+}
+
+// *****************************************************************
+void AssetBundleManager::PerformLoadFromAsset(Resource* resource)
+{
+    // Get the AssetBundle*
+    AssetBundle* bundle = (AssetBundle*)resource;
+    
+    // Load the bundle manifest.  If it is invalid, none of its assets are loaded, but the completion still fires
+    if(bundle->LoadFromAsset() == false)
+    {
+        bundle->FinishLoading(ResourceState::LoadFailed);
+        return;
+    }
+    
+    // Is the bundle empty?
+    if(bundle->entries.size() == 0)
+    {
+        bundle->FinishLoading(ResourceState::Ready);
+        return;
+    }
+    
+    // Without background threads, load the bundled assets here, in dependency order
+    if(singleton->HasBackgroundThreads() == false)
+    {
+        vector<UInt16> readyDependents;
+        for(size_t orderIndex = 0; orderIndex < bundle->loadOrder.size(); orderIndex++)
+        {
+            bundle->LoadEntry(bundle->loadOrder[orderIndex]);
+            bundle->FinishEntry(bundle->loadOrder[orderIndex], readyDependents);
+        }
+        bundle->FinishLoading(ResourceState::Ready);
+        return;
+    }
+    
+    // Queue all the assets that have no dependencies.  The rest are queued as their dependencies complete
+    for(UInt16 index = 0; index < bundle->entries.size(); index++)
+    {
+        if(bundle->entries[index].Dependencies.size() == 0)
+            singleton->QueueBundledAsset(bundle, index);
+    }
+}
+
+// *****************************************************************
+void AssetBundleManager::PerformLoadBundledAsset(Resource* resource, void* context)
+{
+    // Get the AssetBundle* & the index of the asset to load
+    AssetBundle* bundle = (AssetBundle*)resource;
+    UInt16 index = (UInt16)(size_t)context;
+    
+    // Load the asset
+    bundle->LoadEntry(index);
+    
+    // Queue any assets that were waiting on this one
+    vector<UInt16> readyDependents;
+    bool complete = bundle->FinishEntry(index, readyDependents);
+    for(size_t readyIndex = 0; readyIndex < readyDependents.size(); readyIndex++)
+    {
+        singleton->QueueBundledAsset(bundle, readyDependents[readyIndex]);
+    }
+    
+    // Was this the last asset of the bundle?
+    if(complete)
+        bundle->FinishLoading(ResourceState::Ready);
+}
+
+// *****************************************************************
+/// @brief
+///     Queues a single asset of a bundle on the background threads
+/// @remarks
+///     GDK Internal use only
+// *****************************************************************
+void AssetBundleManager::QueueBundledAsset(AssetBundle* bundle, UInt16 index)
+{
+    QueueBackgroundTask(bundle, bundle->asyncPriority, &AssetBundleManager::PerformLoadBundledAsset, (void*)(size_t)index);
+}
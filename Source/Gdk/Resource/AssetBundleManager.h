@@ -0,0 +1,72 @@
+/* 
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+#include "ResourceManager.h"
+#include "AssetBundle.h"
+
+namespace Gdk
+{
+	/// @addtogroup Resources & Assets
+    /// @{
+    
+    // =================================================================================
+    ///	@brief
+    ///		Manages AssetBundle Resources
+    // =================================================================================
+    class AssetBundleManager : public ResourceManager
+	{
+    public:
+        // Publics
+		// =====================================================
+        
+        virtual ~AssetBundleManager();
+        
+        // ---------------------------------
+        /// @name Creation methods
+        /// @{
+        
+        static AssetBundle* FromAsset(const char *name, bool async = false, int asyncPriority = 1);
+        
+        /// @}
+        
+    protected:
+        // Protecteds
+		// =====================================================
+        
+        // ---------------------------------
+        /// @name Resource overrides
+        /// @{
+        
+        virtual Resource* OnCreateNewResourceInstance();
+        virtual const char* GetResourceTypeName();
+        
+        /// @}
+        
+    private:
+        // Privates
+		// =====================================================
+        
+        // Creation Worker Methods
+        static void PerformLoadFromAsset(Resource* resource);
+        static void PerformLoadBundledAsset(Resource* resource, void* context);
+        
+        // Bundle scheduling
+        void QueueBundledAsset(AssetBundle* bundle, UInt16 index);
+        
+        // CTor/DTor
+        AssetBundleManager();
+        
+        // Singleton
+        static AssetBundleManager* singleton;
+        
+        friend class ResourceManager;
+        
+	};
+    
+    /// @}
+
+} // namespace 
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "BasePCH.h"
+#include "AssetBundleWriter.h"
+
+using namespace Gdk;
+
+// *****************************************************************
+/// @brief
+///     Constructor
+// *****************************************************************
+AssetBundleWriter::AssetBundleWriter()
+{
+}
+
+// *****************************************************************
+/// @brief
+///     Destructor
+// *****************************************************************
+AssetBundleWriter::~AssetBundleWriter()
+{
+}
+
+// *****************************************************************
+/// @brief
+///     Adds an asset to the bundle, along with every resource it loads
+/// @param type
+///     Type of the asset
+/// @param name
+///     Name of the asset  (The same name that would be passed to its manager's FromAsset())
+/// @return
+///     Index of the asset within the bundle, or -1 if the asset couldn't be loaded
+/// @remarks
+///     The asset is loaded syncronously, & released again once its child resources have been added.
+///     Adding an asset that is already in the bundle returns its existing index.
+// *****************************************************************
+int AssetBundleWriter::AddAsset(BundleAssetType::Enum type, const char* name)
+{
+    // Is the asset already in the bundle?
+    int index = FindAsset(type, name);
+    if(index >= 0)
+        return index;
+
+    if(entries.size() >= USHRT_MAX)
+    {
+        LOG_ERROR("Unable to add \"%s\", an asset bundle can't hold more than %d assets", name, USHRT_MAX);
+        return -1;
+    }
+
+    // Load the asset, to find the resources it uses
+    Resource* asset = AssetBundle::LoadAsset(type, name);
+    if(asset == NULL)
+    {
+        LOG_ERROR("Unknown asset type [%d] for \"%s\"", type, name);
+        return -1;
+    }
+    if(asset->State != ResourceState::Ready)
+    {
+        LOG_ERROR("Unable to add \"%s\" to the asset bundle, as it failed to load", name);
+        asset->Release();
+        return -1;
+    }
+
+    // Add the entry for the asset
+    index = (int) entries.size();
+    entries.push_back(WriterEntry());
+    entries[index].Type = type;
+    entries[index].Name = name;
+
+    // Add the child resources as dependencies
+    vector<Resource*> children;
+    asset->GetChildResources(children);
+    for(size_t childIndex = 0; childIndex < children.size(); childIndex++)
+    {
+        Resource* child = children[childIndex];
+
+        BundleAssetType::Enum childType;
+        if(GetBundleAssetType(child, childType) == false)
+        {
+            LOG_WARN("The %s \"%s\" used by \"%s\" can't be added to an asset bundle", child->GetTypeName(), child->GetName().c_str(), name);
+            continue;
+        }
+
+        int dependency = AddAsset(childType, child->GetName().c_str());
+        if(dependency >= 0)
+            AddDependency(index, dependency);
+    }
+
+    asset->Release();
+    return index;
+}
+
+// *****************************************************************
+/// @brief
+///     Makes one asset of the bundle depend on another.  The dependency is loaded before the asset.
+/// @param assetIndex
+///     Index of the dependent asset
+/// @param dependencyIndex
+///     Index of the asset it depends on
+/// @return
+///     False if either index is invalid, or they are the same asset
+/// @remarks
+///     The dependencies of child resources are added by AddAsset().  Extra dependencies
+///     must not form a cycle, or the bundle will fail to load.
+// *****************************************************************
+bool AssetBundleWriter::AddDependency(int assetIndex, int dependencyIndex)
+{
+    if(assetIndex < 0 || assetIndex >= (int) entries.size() || dependencyIndex < 0 || dependencyIndex >= (int) entries.size() || assetIndex == dependencyIndex)
+    {
+        LOG_ERROR("Invalid asset bundle dependency [%d] -> [%d]", assetIndex, dependencyIndex);
+        return false;
+    }
+
+    // Skip duplicates
+    vector<UInt16>& dependencies = entries[assetIndex].Dependencies;
+    if(std::find(dependencies.begin(), dependencies.end(), (UInt16) dependencyIndex) == dependencies.end())
+        dependencies.push_back((UInt16) dependencyIndex);
+
+    return true;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the number of assets in the bundle
+// *****************************************************************
+size_t AssetBundleWriter::GetAssetCount()
+{
+    return entries.size();
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the name of an asset in the bundle
+/// @param index
+///     Index of the asset within the bundle
+// *****************************************************************
+const string& AssetBundleWriter::GetAssetName(size_t index)
+{
+    ASSERT(index < entries.size(), "Asset index [%d] is out of range", (int) index);
+    return entries[index].Name;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the indices of the assets that an asset of the bundle depends on
+/// @param index
+///     Index of the asset within the bundle
+// *****************************************************************
+const vector<UInt16>& AssetBundleWriter::GetDependencies(size_t index)
+{
+    ASSERT(index < entries.size(), "Asset index [%d] is out of range", (int) index);
+    return entries[index].Dependencies;
+}
+
+// *****************************************************************
+/// @brief
+///     Writes the bundle manifest to a stream, in the .gdkbundle format
+/// @param stream
+///     Stream to write the manifest to
+// *****************************************************************
+bool AssetBundleWriter::Write(Stream* stream)
+{
+    // Write the header
+    stream->WriteUInt16(1);
+    stream->WriteUInt16((UInt16) entries.size());
+
+    // Write the assets
+    for(size_t index = 0; index < entries.size(); index++)
+    {
+        WriterEntry& entry = entries[index];
+        stream->WriteUInt8((UInt8) entry.Type);
+        stream->WriteString(entry.Name.c_str());
+
+        stream->WriteUInt16((UInt16) entry.Dependencies.size());
+        for(size_t dependencyIndex = 0; dependencyIndex < entry.Dependencies.size(); dependencyIndex++)
+            stream->WriteUInt16(entry.Dependencies[dependencyIndex]);
+    }
+
+    return true;
+}
+
+// *****************************************************************
+/// @brief
+///     Writes the bundle manifest to a .gdkbundle file
+/// @param filePath
+///     Path of the file to write
+// *****************************************************************
+bool AssetBundleWriter::Write(const char* filePath)
+{
+    FileStream file(filePath, FileMode::Write);
+    if(file.IsOpen() == false)
+    {
+        LOG_ERROR("Unable to create the asset bundle file: %s", filePath);
+        return false;
+    }
+
+    bool result = Write(&file);
+    file.Close();
+    return result;
+}
+
+// *****************************************************************
+/// @brief
+///     Finds an asset that has already been added to the bundle
+/// @return
+///     Index of the asset, or -1 if it isnt in the bundle
+// *****************************************************************
+int AssetBundleWriter::FindAsset(BundleAssetType::Enum type, const char* name)
+{
+    for(size_t index = 0; index < entries.size(); index++)
+    {
+        if(entries[index].Type == type && entries[index].Name == name)
+            return (int) index;
+    }
+    return -1;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the bundle asset type of a loaded resource
+/// @return
+///     False if resources of this type can't be listed in a bundle
+// *****************************************************************
+bool AssetBundleWriter::GetBundleAssetType(Resource* resource, BundleAssetType::Enum& type)
+{
+    const char* typeName = resource->GetTypeName();
+
+    if(strcmp(typeName, "Texture2D") == 0)      type = BundleAssetType::Texture2D;
+    else if(strcmp(typeName, "Shader") == 0)    type = BundleAssetType::Shader;
+    else if(strcmp(typeName, "Atlas") == 0)     type = BundleAssetType::Atlas;
+    else if(strcmp(typeName, "BMFont") == 0)    type = BundleAssetType::BMFont;
+    else if(strcmp(typeName, "Model") == 0)     type = BundleAssetType::Model;
+    else
+        return false;
+
+    return true;
+}
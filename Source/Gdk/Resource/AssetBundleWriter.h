@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+#include "AssetBundle.h"
+
+namespace Gdk
+{
+	/// @addtogroup Resources & Assets
+    /// @{
+
+	// =================================================================================
+    ///	@brief
+    ///	    Builds a .gdkbundle manifest from a set of assets
+    ///	@remarks
+    ///		Each asset added to the writer is loaded once through its resource manager, & the resources
+    ///     it loads in turn (from Resource::GetChildResources(), such as the textures of a model, the sheets
+    ///     of an atlas or the pages of a font) are added to the bundle as its dependencies.  So a bundle
+    ///     only needs to be given its top level assets.
+    ///   @par
+    ///     The writer is meant for content tools & tests.  It needs the resource managers, so it can only
+    ///     be used once the GDK is initialized.
+    // =================================================================================
+	class AssetBundleWriter
+	{
+	public:
+
+		// Public Methods
+		// ================================
+
+        // -----------------------------------
+        /// @name Common Methods
+        /// @{
+
+        AssetBundleWriter();
+        ~AssetBundleWriter();
+
+        int AddAsset(BundleAssetType::Enum type, const char* name);
+        bool AddDependency(int assetIndex, int dependencyIndex);
+
+        size_t GetAssetCount();
+        const string& GetAssetName(size_t index);
+        const vector<UInt16>& GetDependencies(size_t index);
+
+        bool Write(Stream* stream);
+        bool Write(const char* filePath);
+
+        /// @}
+
+    private:
+
+        // Private Types
+		// ================================
+
+        // ***********************************************************************
+        struct WriterEntry
+        {
+            BundleAssetType::Enum   Type;
+            string                  Name;
+            vector<UInt16>          Dependencies;
+        };
+
+        // Private Properties
+		// ================================
+
+        vector<WriterEntry> entries;
+
+        // Private Methods
+		// ================================
+
+        int FindAsset(BundleAssetType::Enum type, const char* name);
+        static bool GetBundleAssetType(Resource* resource, BundleAssetType::Enum& type);
+	};
+
+    /// @}
+
+} // namespace
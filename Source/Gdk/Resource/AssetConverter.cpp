@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "BasePCH.h"
+#include "AssetConverter.h"
+
+using namespace Gdk;
+
+// The .gdkmodel version that the converter understands
+#define ASSETCONVERTER_MODEL_VERSION    3
+
+// ***********************************************************************
+static void SkipString(Stream& stream)
+{
+    UInt16 length = stream.ReadUInt16();
+    stream.Seek(length, SeekOrigin::Current);
+}
+
+// *****************************************************************
+/// @brief
+///     Converts a .gdkimage or .gdkmodel file to another compression type
+/// @param sourcePath
+///     Path of the asset file to convert.  The type of asset is taken from its extension
+/// @param destinationPath
+///     Path of the file to write the converted asset to.  (Must not be the source file)
+/// @param compressionType
+///     The compression type to store the asset's data with
+/// @return
+///     False if the asset couldn't be read or converted.  No destination file is left behind in that case.
+// *****************************************************************
+bool AssetConverter::ConvertAsset(const char* sourcePath, const char* destinationPath, CompressionType::Enum compressionType)
+{
+    string extension = Path::GetExtension(sourcePath);
+    bool isImage = extension == "gdkimage";
+    if(isImage == false && extension != "gdkmodel")
+    {
+        LOG_ERROR("Unable to convert \"%s\", only .gdkimage & .gdkmodel assets can be converted", sourcePath);
+        return false;
+    }
+
+    FileStream source(sourcePath, FileMode::Read);
+    if(source.IsOpen() == false)
+    {
+        LOG_ERROR("Unable to open the asset file: %s", sourcePath);
+        return false;
+    }
+    FileStream destination(destinationPath, FileMode::Write);
+    if(destination.IsOpen() == false)
+    {
+        LOG_ERROR("Unable to create the converted asset file: %s", destinationPath);
+        source.Close();
+        return false;
+    }
+
+    bool result = isImage ? ConvertImage(&source, &destination, compressionType) : ConvertModel(&source, &destination, compressionType);
+    source.Close();
+    destination.Close();
+
+    if(result == false)
+    {
+        LOG_ERROR("Failed to convert the asset \"%s\"", sourcePath);
+        File::Delete(destinationPath);
+    }
+    return result;
+}
+
+// *****************************************************************
+/// @brief
+///     Converts a .gdkimage to another compression type
+/// @param source
+///     Stream positioned at the start of the image asset
+/// @param destination
+///     Stream to write the converted image to
+/// @param compressionType
+///     The compression type to store the image data with
+/// @remarks
+///     A chunked image is converted chunk by chunk, so it keeps the same rows in each chunk.
+// *****************************************************************
+bool AssetConverter::ConvertImage(Stream* source, Stream* destination, CompressionType::Enum compressionType)
+{
+    // Read the header
+    UInt16 width = source->ReadUInt16();
+    UInt16 height = source->ReadUInt16();
+    UInt16 pixelFormat = source->ReadUInt16();
+    UInt16 flags = source->ReadUInt16();
+
+    CompressionType::Enum sourceCompression = (CompressionType::Enum) ((flags >> 6) & 0x3);
+    if(Stream::IsCompressionTypeSupported(sourceCompression) == false || Stream::IsCompressionTypeSupported(compressionType) == false)
+    {
+        LOG_ERROR("Unable to convert an image from compression type [%d] to [%d] in this build of GDK", sourceCompression, compressionType);
+        return false;
+    }
+
+    // Write the header, with the new compression type
+    destination->WriteUInt16(width);
+    destination->WriteUInt16(height);
+    destination->WriteUInt16(pixelFormat);
+    destination->WriteUInt16((UInt16) ((flags & ~0x00C0) | (compressionType << 6)));
+
+    // Is the image data a single compressed stream?
+    if((flags & 0x0020) == 0)
+    {
+        MemoryStream decoded(64 * 1024);
+        if(source->Decompress(&decoded, sourceCompression) == false)
+            return false;
+
+        decoded.Seek(0, SeekOrigin::Begin);
+        return decoded.Compress(destination, compressionType) >= 0;
+    }
+
+    // Read the chunk table
+    UInt16 rowsPerChunk = source->ReadUInt16();
+    UInt16 numChunks = source->ReadUInt16();
+    vector<UInt32> chunkSizes(numChunks);
+    for(UInt16 chunkIndex = 0; chunkIndex < numChunks; chunkIndex++)
+        chunkSizes[chunkIndex] = source->ReadUInt32();
+
+    // Convert each chunk on its own, as the loader decompresses them independently
+    MemoryStream chunks(64 * 1024);
+    MemoryStream decoded(64 * 1024);
+    for(UInt16 chunkIndex = 0; chunkIndex < numChunks; chunkIndex++)
+    {
+        decoded.SetLength(0);
+        if(source->Decompress(&decoded, sourceCompression, chunkSizes[chunkIndex]) == false)
+            return false;
+
+        decoded.Seek(0, SeekOrigin::Begin);
+        int chunkSize = decoded.Compress(&chunks, compressionType);
+        if(chunkSize < 0)
+            return false;
+        chunkSizes[chunkIndex] = (UInt32) chunkSize;
+    }
+
+    // Write the new chunk table, then the chunks
+    destination->WriteUInt16(rowsPerChunk);
+    destination->WriteUInt16(numChunks);
+    for(UInt16 chunkIndex = 0; chunkIndex < numChunks; chunkIndex++)
+        destination->WriteUInt32(chunkSizes[chunkIndex]);
+    destination->Write(chunks.GetBufferStartPtr(), (int) chunks.GetLength());
+
+    return true;
+}
+
+// *****************************************************************
+/// @brief
+///     Converts a .gdkmodel to another compression type
+/// @param source
+///     Stream positioned at the start of the model asset
+/// @param destination
+///     Stream to write the converted model to
+/// @param compressionType
+///     The compression type to store the vertex & index data with
+/// @remarks
+///     The model may be uncompressed, or compressed with any supported type.  Only the vertex & index
+///     data blocks are re-encoded, the rest of the model is copied across unchanged.
+// *****************************************************************
+bool AssetConverter::ConvertModel(Stream* source, Stream* destination, CompressionType::Enum compressionType)
+{
+    // Read in the whole model, so the unchanged parts can be copied straight across
+    Int64 size = source->GetLength() - source->GetPosition();
+    if(size < 16 || size > INT_MAX)
+        return false;
+    vector<UInt8> modelData((size_t) size);
+    if(source->Read(&modelData[0], (int) size) != (int) size)
+        return false;
+    MemoryStream model(&modelData[0], size);
+
+    // Header
+    UInt16 version = model.ReadUInt16();
+    UInt16 headerFlags = model.ReadUInt16();
+    if(version != ASSETCONVERTER_MODEL_VERSION)
+    {
+        LOG_ERROR("The model asset is an unsupported version: %d [Expected: %d]", version, ASSETCONVERTER_MODEL_VERSION);
+        return false;
+    }
+
+    // Get the compression of the mesh data.  (0 = Uncompressed, otherwise CompressionType + 1)
+    int sourceCompression = (headerFlags & 0x0003) - 1;
+    if((sourceCompression >= 0 && Stream::IsCompressionTypeSupported((CompressionType::Enum) sourceCompression) == false)
+        || Stream::IsCompressionTypeSupported(compressionType) == false)
+    {
+        LOG_ERROR("Unable to convert a model from compression type [%d] to [%d] in this build of GDK", sourceCompression, compressionType);
+        return false;
+    }
+
+    destination->WriteUInt16(version);
+    destination->WriteUInt16((UInt16) ((headerFlags & ~0x0003) | (compressionType + 1)));
+    Int64 copyStart = model.GetPosition();
+
+    // Sub-object counts
+    UInt16 numNodes = model.ReadUInt16();
+    UInt16 numMaterials = model.ReadUInt16();
+    UInt16 numMeshes = model.ReadUInt16();
+    model.Seek(3 * sizeof(UInt16), SeekOrigin::Current);
+
+    // Nodes:  Name, parent node index, local transform
+    for(UInt16 nodeIndex = 0; nodeIndex < numNodes; nodeIndex++)
+    {
+        SkipString(model);
+        model.Seek(sizeof(UInt16) + sizeof(Matrix3D), SeekOrigin::Current);
+    }
+
+    // Materials:  Name, flags, 4 colors, shininess, & the texture names
+    for(UInt16 materialIndex = 0; materialIndex < numMaterials; materialIndex++)
+    {
+        SkipString(model);
+        UInt16 materialFlags = model.ReadUInt16();
+        model.Seek(4 * sizeof(UInt8[4]) + sizeof(float), SeekOrigin::Current);
+        if(materialFlags & ModelMaterialFlags::DiffuseTextured)
+            SkipString(model);
+        if(materialFlags & ModelMaterialFlags::BumpTextured)
+            SkipString(model);
+    }
+
+    // Meshes.  Everything up to each vertex & index data block is copied across as is
+    for(UInt16 meshIndex = 0; meshIndex < numMeshes; meshIndex++)
+    {
+        SkipString(model);
+        UInt16 meshFlags = model.ReadUInt16();
+        UInt16 numVertices = model.ReadUInt16();
+        UInt16 numIndices = model.ReadUInt16();
+        UInt16 numMeshParts = model.ReadUInt16();
+        UInt16 numJoints = model.ReadUInt16();
+        model.Seek(numJoints * sizeof(Matrix3D) + sizeof(Vector3) + sizeof(float), SeekOrigin::Current);
+
+        destination->Write(&modelData[(size_t) copyStart], (int) (model.GetPosition() - copyStart));
+        int vertexDataSize = (int) (numVertices * ModelMeshFlags::GetVertexStrideFromFlags(meshFlags));
+        if(ConvertMeshData(model, destination, vertexDataSize, sourceCompression, compressionType) == false)
+            return false;
+        if(ConvertMeshData(model, destination, numIndices * sizeof(UInt16), sourceCompression, compressionType) == false)
+            return false;
+        copyStart = model.GetPosition();
+
+        // Mesh parts:  Index start & count, material symbol
+        for(UInt16 meshPartIndex = 0; meshPartIndex < numMeshParts; meshPartIndex++)
+        {
+            model.Seek(2 * sizeof(UInt16), SeekOrigin::Current);
+            SkipString(model);
+        }
+    }
+
+    // Copy the rest of the model
+    destination->Write(&modelData[(size_t) copyStart], (int) (size - copyStart));
+    return true;
+}
+
+// *****************************************************************
+/// @brief
+///     Converts one vertex or index data block of a .gdkmodel
+/// @param source
+///     The model data, positioned at the block
+/// @param destination
+///     Stream to write the converted block to
+/// @param dataSize
+///     Size of the (uncompressed) data, in bytes
+/// @param sourceCompression
+///     The CompressionType of the source block, or -1 if it is not compressed
+/// @param compressionType
+///     The compression type to store the block with
+// *****************************************************************
+bool AssetConverter::ConvertMeshData(MemoryStream& source, Stream* destination, int dataSize, int sourceCompression, CompressionType::Enum compressionType)
+{
+    // Get the uncompressed data, in place if it isnt compressed
+    vector<UInt8> decoded;
+    const void* data = source.GetBufferCurrentPtr();
+    int storedSize = dataSize;
+    if(sourceCompression >= 0)
+    {
+        storedSize = (int) source.ReadUInt32();
+        if(source.GetPosition() + storedSize > source.GetLength())
+            return false;
+
+        decoded.resize(dataSize > 0 ? dataSize : 1);
+        if(Stream::Decompress(source.GetBufferCurrentPtr(), storedSize, &decoded[0], dataSize, (CompressionType::Enum) sourceCompression) == false)
+            return false;
+        data = &decoded[0];
+    }
+    else if(source.GetPosition() + storedSize > source.GetLength())
+        return false;
+    source.Seek(storedSize, SeekOrigin::Current);
+
+    // Compress it, & write it out with its compressed size
+    int maxCompressedSize = Stream::GetMaxCompressedSize(dataSize, compressionType);
+    vector<UInt8> compressed(maxCompressedSize > 0 ? maxCompressedSize : 1);
+    int compressedSize = Stream::Compress(data, dataSize, &compressed[0], maxCompressedSize, compressionType);
+    if(compressedSize < 0)
+        return false;
+
+    destination->WriteUInt32((UInt32) compressedSize);
+    destination->Write(&compressed[0], compressedSize);
+    return true;
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+
+namespace Gdk
+{
+	/// @addtogroup Resources & Assets
+    /// @{
+
+	// =================================================================================
+    ///	@brief
+    ///	    Re-compresses .gdkimage & .gdkmodel assets with another CompressionType
+    ///	@remarks
+    ///		The content pipeline writes images & models with ZLib.  The converter decodes the compressed data of
+    ///     an existing asset, encodes it again with the given codec, & sets the codec bits of the asset header
+    ///     to match.  Chunked images keep their chunks, & everything else in the asset is copied as is.
+    ///   @par
+    ///     The converter is meant for content tools & tests.  The codecs of both the source asset & the
+    ///     converted asset must be enabled in this build of GDK.  (See GDK_LZ4 & GDK_ZSTD)
+    // =================================================================================
+	class AssetConverter
+	{
+	public:
+
+		// Public Methods
+		// ================================
+
+        // -----------------------------------
+        /// @name Common Methods
+        /// @{
+
+        static bool ConvertAsset(const char* sourcePath, const char* destinationPath, CompressionType::Enum compressionType);
+        static bool ConvertImage(Stream* source, Stream* destination, CompressionType::Enum compressionType);
+        static bool ConvertModel(Stream* source, Stream* destination, CompressionType::Enum compressionType);
+
+        /// @}
+
+    private:
+
+        // Private Methods
+		// ================================
+
+        static bool ConvertMeshData(MemoryStream& source, Stream* destination, int dataSize, int sourceCompression, CompressionType::Enum compressionType);
+	};
+
+    /// @}
+
+} // namespace
@@ -10,6 +10,9 @@ using namespace Gdk;
 
 // Static Instantiations
 AssetManager::ProviderRegistrationSet AssetManager::registeredProviders;
+AssetManager::LookupCache AssetManager::lookupCache;
+UInt32 AssetManager::lookupCacheGeneration = 0;
+Mutex* AssetManager::lookupCacheMutex = NULL;
 
 // *****************************************************************
 /// @brief
@@ -19,6 +22,8 @@ AssetManager::ProviderRegistrationSet AssetManager::registeredProviders;
 // *****************************************************************
 void AssetManager::Init()
 {
+    lookupCacheMutex = Mutex::Create("AssetLookupCache");
+    
     // Setup the "Base" FileAssetProvider
     // ----------------------------------------
     
@@ -29,6 +34,17 @@ void AssetManager::Init()
     string baseFolder = Path::Combine(assetsFolder.c_str(), "Base");
     FileAssetProvider* provider = GdkNew FileAssetProvider(baseFolder.c_str());
     RegisterProvider(provider, 0);
+    
+    // Setup the "Base" PackAssetProvider
+    // ----------------------------------------
+    
+    // If the "Base" bundle has been packed, search the pack before the loose files
+    string basePack = Path::Combine(assetsFolder.c_str(), "Base.gdkpack");
+    if(File::Exists(basePack.c_str()))
+    {
+        PackAssetProvider* packProvider = GdkNew PackAssetProvider(basePack.c_str());
+        RegisterProvider(packProvider, 1);
+    }
 }
 
 // *****************************************************************
@@ -46,6 +62,10 @@ void AssetManager::Shutdown()
         GdkDelete( iter->Provider );
     }
     registeredProviders.clear();
+    
+    ClearLookupCache();
+    GdkDelete( lookupCacheMutex );
+    lookupCacheMutex = NULL;
 }
 
 // *****************************************************************
@@ -55,11 +75,19 @@ void AssetManager::Shutdown()
 ///     The provider to register.  The AssetManager assumes ownership of the provider, and will delete it when shutting down
 /// @param priority
 ///     The priority of the provider registration.  Higher priority providers are searched first.
+/// @remarks
+///     The lookup cache is cleared, as the new provider may now be the source of assets that were
+///     found in (or missing from) the other providers.
 // *****************************************************************
 void AssetManager::RegisterProvider(AssetProvider* provider, int priority)
 {
 	// Add the provider (sorted by priority)
 	registeredProviders.AddSorted( ProviderRegistration(provider, priority) );
+    
+    // Let the provider do its up-front work
+    provider->OnRegistered();
+    
+    ClearLookupCache();
 }
 
 // *****************************************************************
@@ -81,6 +109,7 @@ void AssetManager::UnRegisterProvider(AssetProvider* provider, bool deleteProvid
 		{
 			// Remove the provider
 			registeredProviders.erase(iter);
+            ClearLookupCache();
             
             // Does the caller want to delete the provider?
             if(deleteProvider)
@@ -106,25 +135,112 @@ const AssetManager::ProviderRegistrationSet& AssetManager::GetRegisteredProvider
 /// @param assetPath
 ///     Path to the asset.  This path is assumed to be relative to the source AssetProvider.
 ///     For FileAssetProvider's, the path is relative to the RootFolder
+///     For PackAssetProvider's, the path is relative to the folder the pack was built from.
 ///     For ZipAssetProvider's, the path is relative to the ZIP root.
+/// @remarks
+///     The provider each path is found in (or that it is missing from every provider) is cached, so
+///     later requests for the same path go straight to the right provider.  See ClearLookupCache().
 // *****************************************************************
 Stream* AssetManager::GetAssetStream(const char* assetPath)
 {
+    // Finding & opening the asset is part of the read time of a resource load
+    ResourceLoadTimer loadTimer(ResourceLoadPhase::Read);
+    
+    // Has this asset been looked up before?
+    bool cached = false;
+    AssetProvider* cachedProvider = NULL;
+    UInt32 generation = 0;
+    if(lookupCacheMutex != NULL)
+    {
+        lookupCacheMutex->Lock();
+        generation = lookupCacheGeneration;
+        LookupCache::iterator cacheIter = lookupCache.find(assetPath);
+        if(cacheIter != lookupCache.end())
+        {
+            cached = true;
+            cachedProvider = cacheIter->second;
+        }
+        lookupCacheMutex->Unlock();
+    }
+    
+    if(cached)
+    {
+        // The asset is not in any provider
+        if(cachedProvider == NULL)
+            return NULL;
+        
+        // Get the stream from the provider that had it last time
+        Stream* stream = cachedProvider->GetAssetStream(assetPath);
+        if(stream != NULL)
+            return stream;
+        
+        // The asset has gone missing from that provider, so search them all again
+    }
+    
+    // Find the provider with the asset
+    Stream* stream = NULL;
+    AssetProvider* provider = NULL;
+    
     // Loop through the registered providers in priority order
     for(ProviderRegistrationSet::iterator providerIter = registeredProviders.begin(); providerIter != registeredProviders.end(); providerIter++)
     {
         // Attempt to get the stream through this provider
-        AssetProvider* provider = providerIter->Provider;
-        Stream* stream = provider->GetAssetStream(assetPath);
+        stream = providerIter->Provider->GetAssetStream(assetPath);
         
         // Did we get the stream?
         if(stream != NULL)
         {
-            return stream;
+            provider = providerIter->Provider;
+            break;
         }
         
         // Otherwise, continue on to the next provider
     }
     
-    return NULL;
+    // Cache the result, unless the cache was cleared while we were searching
+    if(lookupCacheMutex != NULL)
+    {
+        lookupCacheMutex->Lock();
+        if(generation == lookupCacheGeneration)
+            lookupCache[assetPath] = provider;
+        lookupCacheMutex->Unlock();
+    }
+    
+    return stream;
+}
+
+// *****************************************************************
+/// @brief
+///     Clears the cache of which provider each asset path was found in
+/// @remarks
+///     The cache is cleared whenever a provider is registered or unregistered.  Call this when 
+///     assets have been added to (or removed from) a registered provider by other means, such as
+///     files being downloaded into the folder of a FileAssetProvider.
+// *****************************************************************
+void AssetManager::ClearLookupCache()
+{
+    if(lookupCacheMutex == NULL)
+        return;
+    
+    lookupCacheMutex->Lock();
+    lookupCache.clear();
+    lookupCacheGeneration++;
+    lookupCacheMutex->Unlock();
+}
+
+// *****************************************************************
+/// @brief
+///     Queues a GetAssetStream() call to be done on one of the AsyncIO threads.
+/// @param assetPath
+///     Path to the asset.  (See GetAssetStream())
+/// @param priority
+///     The priority of the request.  Higher priority requests are serviced sooner.
+/// @remarks
+///     Once the request is complete, AsyncIORequest::GetStream() returns the stream from the first 
+///     provider that has the asset, or NULL if no provider has it.  The caller owns both the request & the stream.
+// *****************************************************************
+AsyncIORequest* AssetManager::GetAssetStreamAsync(const char* assetPath, short priority)
+{
+    // A request with no provider searches all the registered providers
+    return AsyncIO::QueueGetAssetStream(NULL, assetPath, priority);
 }
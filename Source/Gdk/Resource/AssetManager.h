@@ -79,6 +79,7 @@ namespace Gdk
         /// @{
         
         static Stream* GetAssetStream(const char* assetPath);
+        static AsyncIORequest* GetAssetStreamAsync(const char* assetPath, short priority = 1);
         
         /// @}
         // -----------------------------------
@@ -90,6 +91,13 @@ namespace Gdk
 		static const ProviderRegistrationSet& GetRegisteredProviders();
         
         /// @}
+        // -----------------------------------
+        /// @name Lookup Cache Methods
+        /// @{
+        
+        static void ClearLookupCache();
+        
+        /// @}
 
     private:
 
@@ -101,7 +109,16 @@ namespace Gdk
 		static void Init();
 		static void Shutdown();
         
+        // Private Properties
+		// =====================================================
+        
         static ProviderRegistrationSet registeredProviders;
+        
+        // Cache of which provider each asset path was found in  (NULL = not found in any provider)
+        typedef map<string, AssetProvider*> LookupCache;
+        static LookupCache lookupCache;
+        static UInt32 lookupCacheGeneration;
+        static Mutex* lookupCacheMutex;
 	};
 
     /// @}
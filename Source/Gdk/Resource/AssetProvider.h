@@ -56,6 +56,44 @@ namespace Gdk
         // *****************************************************************
 		virtual Stream* GetAssetStream(const char* assetPath) = 0;
         
+        /// @}
+        
+        // -----------------------------------
+        /// @name Registration Methods
+        /// @{
+        
+        // *****************************************************************
+        /// @brief
+        ///     Called by the AssetManager when this provider is registered
+        /// @remarks
+        ///     Providers can do any up-front work here, such as indexing their assets, so that
+        ///     lookups are cheap once the provider is in use.
+        // *****************************************************************
+        virtual void OnRegistered() {}
+        
+        /// @}
+        
+        // -----------------------------------
+        /// @name Asynchronous Methods
+        /// @{
+        
+        // *****************************************************************
+        /// @brief
+        ///     Queues a GetAssetStream() call to be done on one of the AsyncIO threads.
+        /// @param assetPath 
+        ///     Path to the asset.  This path is assumed to be relative to the AssetProvider root.
+        /// @param priority
+        ///     The priority of the request.  Higher priority requests are serviced sooner.
+        /// @remarks
+        ///     Once the request is complete, AsyncIORequest::GetStream() returns the stream, or NULL if the 
+        ///     asset doesnt exist.  The stream is read in by the I/O thread, so reading it does not block.
+        ///     Providers that can do better than a blocking GetAssetStream() on another thread may override this.
+        // *****************************************************************
+        virtual AsyncIORequest* GetAssetStreamAsync(const char* assetPath, short priority = 1)
+        {
+            return AsyncIO::QueueGetAssetStream(this, assetPath, priority);
+        }
+        
         /// @}
 	};
     
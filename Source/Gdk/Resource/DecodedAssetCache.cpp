@@ -0,0 +1,555 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "BasePCH.h"
+#include "DecodedAssetCache.h"
+
+using namespace Gdk;
+
+// Static Instantiations
+string DecodedAssetCache::folder;
+Mutex* DecodedAssetCache::mutex = NULL;
+DecodedAssetCache::EntryMap DecodedAssetCache::entries;
+Int64 DecodedAssetCache::size = 0;
+Int64 DecodedAssetCache::maxSize = 0;
+UInt32 DecodedAssetCache::useCounter = 0;
+UInt32 DecodedAssetCache::tempCounter = 0;
+
+// Layout of a cache file:  "GDKC", UInt16 version, UInt16 reserved, UInt64 key, Int64 data size, UInt64 reserved, data
+#define DECODEDASSETCACHE_FORMAT_VERSION    1
+#define DECODEDASSETCACHE_HEADER_SIZE       32
+
+// Size of the blocks read when hashing a stream that isnt memory backed
+#define DECODEDASSETCACHE_HASH_BLOCK_SIZE   (64 * 1024)
+
+// Largest single write done when storing an entry
+#define DECODEDASSETCACHE_MAX_WRITE_SIZE    (1 << 30)
+
+// Constants of the 64-bit hash used for the cache keys
+#define HASH_PRIME1     0x9E3779B185EBCA87ULL
+#define HASH_PRIME2     0xC2B2AE3D27D4EB4FULL
+#define HASH_PRIME3     0x165667B19E3779F9ULL
+#define HASH_ROTL(x, r) (((x) << (r)) | ((x) >> (64 - (r))))
+
+// *****************************************************************
+/// @brief
+///     Mixes a block of bytes into a 64-bit hash, a word at a time
+// *****************************************************************
+static UInt64 HashBytes(UInt64 hash, const UInt8* data, int size)
+{
+    const UInt8* end = data + size;
+
+    // Whole words
+    for(; data + 8 <= end; data += 8)
+    {
+        UInt64 word;
+        memcpy(&word, data, 8);
+        hash ^= HASH_ROTL(word * HASH_PRIME2, 31) * HASH_PRIME1;
+        hash = HASH_ROTL(hash, 27) * HASH_PRIME1 + HASH_PRIME3;
+    }
+
+    // Trailing bytes
+    for(; data < end; data++)
+    {
+        hash ^= (*data) * HASH_PRIME3;
+        hash = HASH_ROTL(hash, 11) * HASH_PRIME1;
+    }
+
+    return hash;
+}
+
+// *****************************************************************
+/// @brief
+///     Static Initialization of the DecodedAssetCache
+/// @param maxSize
+///     Maximum size of the cache (in bytes).  (0 = disable the cache)
+/// @remarks
+///     The entries left by previous runs are found by scanning the cache folder.  Their use order
+///     comes from the index that was saved at the last shutdown.
+///     GDK Internal Use Only
+// *****************************************************************
+void DecodedAssetCache::Init(Int64 maxSize)
+{
+    mutex = Mutex::Create("DecodedAssetCache");
+    DecodedAssetCache::maxSize = maxSize > 0 ? maxSize : 0;
+    size = 0;
+    useCounter = 0;
+
+    string workingFolder = Path::GetCommonPath(CommonPaths::WorkingFolder);
+    folder = Path::Combine(workingFolder.c_str(), "DecodedAssetCache");
+
+    if(IsEnabled() == false || Directory::Exists(folder.c_str()) == false)
+        return;
+
+    // Find the existing cache files
+    vector<string> files;
+    Directory::GetFiles(folder.c_str(), files, false);
+    for(vector<string>::iterator iter = files.begin(); iter != files.end(); iter++)
+    {
+        string filePath = Path::Combine(folder.c_str(), iter->c_str());
+
+        // Remove any files left by an interrupted store
+        string extension = Path::GetExtension(iter->c_str());
+        if(extension == "tmp")
+        {
+            File::Delete(filePath.c_str());
+            continue;
+        }
+        if(extension != "gdkcache")
+            continue;
+
+        // The file name is the key, in hex
+        string name = Path::GetFileNameWithoutExtension(iter->c_str());
+        if(name.size() != 16)
+            continue;
+
+        UInt64 key = 0;
+        bool validName = true;
+        for(size_t i = 0; i < name.size(); i++)
+        {
+            char c = name[i];
+            int digit = (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : -1;
+            if(digit < 0)
+            {
+                validName = false;
+                break;
+            }
+            key = (key << 4) | (UInt64) digit;
+        }
+        if(validName == false)
+            continue;
+
+        Entry entry;
+        entry.Size = File::GetFileSize(filePath.c_str());
+        entry.LastUsed = 0;
+        entries[key] = entry;
+        size += entry.Size;
+    }
+
+    // Restore the use order, & trim the cache to the current max size
+    LoadIndex();
+    EvictEntries(DecodedAssetCache::maxSize);
+}
+
+// *****************************************************************
+/// @brief
+///     Static Shutdown of the DecodedAssetCache
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void DecodedAssetCache::Shutdown()
+{
+    if(IsEnabled())
+        SaveIndex();
+
+    entries.clear();
+    size = 0;
+    maxSize = 0;
+
+    GdkDelete( mutex );
+    mutex = NULL;
+}
+
+// *****************************************************************
+/// @brief
+///     Checks if the cache is enabled
+/// @remarks
+///     Loaders should skip the cache (and the cost of computing a key) when this is false.
+// *****************************************************************
+bool DecodedAssetCache::IsEnabled()
+{
+    return mutex != NULL && maxSize > 0;
+}
+
+// *****************************************************************
+/// @brief
+///     Computes the cache key of an asset
+/// @param source
+///     Stream of the source asset.  The whole stream is hashed, & its position is left unchanged.
+/// @param decoderName
+///     Name of the decoder  (Usually the name of the resource type)
+/// @param decoderVersion
+///     Version of the decoded data layout.  Loaders must bump this whenever the data they store changes,
+///     so that entries stored by older builds are no longer found.
+/// @remarks
+///     Every byte of the source is read, so a hit still costs a read of the whole (compressed) asset.  Memory
+///     backed streams are hashed in place, at several GB/s, which is small next to the decode a hit saves.
+///     The key is on the content rather than on the path, size & modification time, because assets also come
+///     from packs & memory, which have no modification time, and a content key can't miss an edited file.
+// *****************************************************************
+UInt64 DecodedAssetCache::GetKey(Stream* source, const char* decoderName, UInt32 decoderVersion)
+{
+    Int64 length = source->GetLength();
+    UInt64 hash = HASH_PRIME3 ^ ((UInt64) length * HASH_PRIME1);
+
+    // Hash the stream in place, if it is memory backed
+    const UInt8* span = (const UInt8*) source->GetSpan(0, length);
+    if(span != NULL)
+    {
+        for(Int64 offset = 0; offset < length; offset += DECODEDASSETCACHE_HASH_BLOCK_SIZE)
+        {
+            int blockSize = length - offset > DECODEDASSETCACHE_HASH_BLOCK_SIZE ? DECODEDASSETCACHE_HASH_BLOCK_SIZE : (int)(length - offset);
+            hash = HashBytes(hash, span + offset, blockSize);
+        }
+    }
+    else
+    {
+        // Otherwise, read it in blocks
+        Int64 position = source->GetPosition();
+        UInt8* block = (UInt8*) GdkAlloc(DECODEDASSETCACHE_HASH_BLOCK_SIZE);
+        for(Int64 offset = 0; offset < length; offset += DECODEDASSETCACHE_HASH_BLOCK_SIZE)
+        {
+            int blockSize = length - offset > DECODEDASSETCACHE_HASH_BLOCK_SIZE ? DECODEDASSETCACHE_HASH_BLOCK_SIZE : (int)(length - offset);
+            int bytesRead = source->ReadAt(block, offset, blockSize);
+            if(bytesRead <= 0)
+                break;
+            hash = HashBytes(hash, block, bytesRead);
+        }
+        GdkFree(block);
+        source->SetPosition(position);
+    }
+
+    // Mix in the decoder
+    hash = HashBytes(hash, (const UInt8*) decoderName, (int) strlen(decoderName));
+    hash = HashBytes(hash, (const UInt8*) &decoderVersion, sizeof(decoderVersion));
+
+    // Final avalanche
+    hash ^= hash >> 33;
+    hash *= HASH_PRIME2;
+    hash ^= hash >> 29;
+    hash *= HASH_PRIME3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+// *****************************************************************
+/// @brief
+///     Opens the cached data of an asset
+/// @param key
+///     The cache key of the asset, from GetKey()
+/// @return
+///     A memory mapped stream, positioned at the start of the cached data, or NULL if the asset isnt in the cache.
+///     The length of the data is GetLength() - GetPosition().  The caller must Close() and GdkDelete the stream.
+/// @remarks
+///     The stream is memory backed, so the data can be used in place through Stream::GetSpan().
+// *****************************************************************
+Stream* DecodedAssetCache::Open(UInt64 key)
+{
+    if(IsEnabled() == false)
+        return NULL;
+
+    // Is the key in the cache?
+    mutex->Lock();
+    EntryMap::iterator iter = entries.find(key);
+    bool found = iter != entries.end();
+    if(found)
+        iter->second.LastUsed = ++useCounter;
+    mutex->Unlock();
+
+    if(found == false)
+        return NULL;
+
+    // Map the cache file
+    string filePath = GetEntryPath(key);
+    MappedFileStream* stream = GdkNew MappedFileStream(filePath.c_str());
+
+    // Verify the header
+    Int64 length = stream->GetLength();
+    const UInt8* header = (const UInt8*) stream->GetSpan(0, DECODEDASSETCACHE_HEADER_SIZE);
+    bool valid = header != NULL && memcmp(header, "GDKC", 4) == 0;
+    if(valid)
+    {
+        UInt16 formatVersion;
+        UInt64 fileKey;
+        Int64 dataSize;
+        memcpy(&formatVersion, header + 4, sizeof(UInt16));
+        memcpy(&fileKey, header + 8, sizeof(UInt64));
+        memcpy(&dataSize, header + 16, sizeof(Int64));
+        valid = formatVersion == DECODEDASSETCACHE_FORMAT_VERSION && fileKey == key && dataSize == length - DECODEDASSETCACHE_HEADER_SIZE;
+    }
+
+    if(valid == false)
+    {
+        LOG_WARN("The decoded asset cache file [%s] is invalid, and was removed", filePath.c_str());
+        stream->Close();
+        GdkDelete( stream );
+
+        mutex->Lock();
+        iter = entries.find(key);
+        if(iter != entries.end())
+            RemoveEntry(iter);
+        mutex->Unlock();
+        return NULL;
+    }
+
+    stream->SetPosition(DECODEDASSETCACHE_HEADER_SIZE);
+    return stream;
+}
+
+// *****************************************************************
+/// @brief
+///     Stores the decoded data of an asset in the cache
+/// @param key
+///     The cache key of the asset, from GetKey()
+/// @param data
+///     The decoded data
+/// @param size
+///     Size of the decoded data (in bytes)
+/// @remarks
+///     Least recently used entries are evicted to make room for the new entry.  Data that is larger than
+///     the whole cache is not stored.
+///   @par
+///     The data is written to a temporary file that is renamed into place, so a partially written entry
+///     is never opened.
+// *****************************************************************
+void DecodedAssetCache::Store(UInt64 key, const void* data, Int64 size)
+{
+    if(IsEnabled() == false)
+        return;
+
+    Int64 fileSize = size + DECODEDASSETCACHE_HEADER_SIZE;
+    if(fileSize > maxSize)
+        return;
+
+    // Skip entries that are already stored
+    mutex->Lock();
+    bool exists = entries.find(key) != entries.end();
+    if(exists == false && Directory::Exists(folder.c_str()) == false)
+        Directory::Create(folder.c_str());
+    UInt32 tempIndex = ++tempCounter;
+    mutex->Unlock();
+
+    if(exists)
+        return;
+
+    // Write the entry to a temporary file.  (Named uniquely, as other threads may be storing the same key)
+    string filePath = GetEntryPath(key);
+    char tempExtension[32];
+    GDK_SNPRINTF(tempExtension, sizeof(tempExtension), ".%u.tmp", (unsigned int) tempIndex);
+    string tempPath = Path::ChangeExtension(filePath.c_str(), tempExtension);
+    FileStream* stream = File::Create(tempPath.c_str());
+    if(stream == NULL)
+    {
+        LOG_WARN("Failed to create the decoded asset cache file [%s]", tempPath.c_str());
+        return;
+    }
+
+    char magic[4] = {'G', 'D', 'K', 'C'};
+    stream->Write(magic, 4);
+    stream->WriteUInt16(DECODEDASSETCACHE_FORMAT_VERSION);
+    stream->WriteUInt16(0);
+    stream->WriteUInt64(key);
+    stream->WriteInt64(size);
+    stream->WriteUInt64(0);
+
+    UInt8* bytes = (UInt8*) data;
+    for(Int64 offset = 0; offset < size; offset += DECODEDASSETCACHE_MAX_WRITE_SIZE)
+    {
+        int blockSize = size - offset > DECODEDASSETCACHE_MAX_WRITE_SIZE ? DECODEDASSETCACHE_MAX_WRITE_SIZE : (int)(size - offset);
+        stream->Write(bytes + offset, blockSize);
+    }
+
+    bool written = stream->GetPosition() == fileSize;
+    stream->Close();
+    GdkDelete( stream );
+
+    if(written == false)
+    {
+        LOG_WARN("Failed to write the decoded asset cache file [%s]", tempPath.c_str());
+        File::Delete(tempPath.c_str());
+        return;
+    }
+
+    // Make room for the entry, & move it into place
+    mutex->Lock();
+    if(entries.find(key) == entries.end())
+    {
+        EvictEntries(maxSize - fileSize);
+
+        File::Delete(filePath.c_str());
+        File::Move(tempPath.c_str(), filePath.c_str());
+
+        Entry entry;
+        entry.Size = fileSize;
+        entry.LastUsed = ++useCounter;
+        entries[key] = entry;
+        DecodedAssetCache::size += fileSize;
+    }
+    else
+    {
+        // Another thread stored the same entry in the meantime
+        File::Delete(tempPath.c_str());
+    }
+    mutex->Unlock();
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the total size (in bytes) of the cache files
+// *****************************************************************
+Int64 DecodedAssetCache::GetSize()
+{
+    return size;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the maximum size (in bytes) of the cache
+// *****************************************************************
+Int64 DecodedAssetCache::GetMaxSize()
+{
+    return maxSize;
+}
+
+// *****************************************************************
+/// @brief
+///     Sets the maximum size (in bytes) of the cache
+/// @param maxSize
+///     The new maximum size.  (0 = disable the cache)
+/// @remarks
+///     Entries are evicted right away if the cache is larger than the new size.  Disabling the cache
+///     leaves its files on disk.
+// *****************************************************************
+void DecodedAssetCache::SetMaxSize(Int64 maxSize)
+{
+    if(mutex == NULL)
+        return;
+
+    mutex->Lock();
+    DecodedAssetCache::maxSize = maxSize > 0 ? maxSize : 0;
+    if(DecodedAssetCache::maxSize > 0)
+        EvictEntries(DecodedAssetCache::maxSize);
+    mutex->Unlock();
+}
+
+// *****************************************************************
+/// @brief
+///     Removes every entry from the cache
+// *****************************************************************
+void DecodedAssetCache::Clear()
+{
+    if(mutex == NULL)
+        return;
+
+    mutex->Lock();
+    while(entries.empty() == false)
+        RemoveEntry(entries.begin());
+    mutex->Unlock();
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the path of the cache file of the given key
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+string DecodedAssetCache::GetEntryPath(UInt64 key)
+{
+    char fileName[32];
+    GDK_SPRINTF(fileName, 32, "%016llx.gdkcache", (unsigned long long) key);
+    return Path::Combine(folder.c_str(), fileName);
+}
+
+// *****************************************************************
+/// @brief
+///     Deletes the file of an entry, & removes it from the cache
+/// @remarks
+///     The caller must hold the cache mutex.
+///     GDK Internal Use Only
+// *****************************************************************
+void DecodedAssetCache::RemoveEntry(EntryMap::iterator entry)
+{
+    string filePath = GetEntryPath(entry->first);
+    File::Delete(filePath.c_str());
+
+    size -= entry->second.Size;
+    entries.erase(entry);
+}
+
+// *****************************************************************
+/// @brief
+///     Evicts the least recently used entries, until the cache is no larger than the given size
+/// @remarks
+///     The caller must hold the cache mutex.  (Except during Init)
+///     GDK Internal Use Only
+// *****************************************************************
+void DecodedAssetCache::EvictEntries(Int64 maxSize)
+{
+    while(size > maxSize && entries.empty() == false)
+    {
+        // Find the least recently used entry
+        EntryMap::iterator oldest = entries.begin();
+        for(EntryMap::iterator iter = entries.begin(); iter != entries.end(); iter++)
+        {
+            if(iter->second.LastUsed < oldest->second.LastUsed)
+                oldest = iter;
+        }
+
+        RemoveEntry(oldest);
+    }
+}
+
+// *****************************************************************
+/// @brief
+///     Loads the use order of the entries, from the index saved by SaveIndex()
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void DecodedAssetCache::LoadIndex()
+{
+    string indexPath = Path::Combine(folder.c_str(), "Index.bin");
+    if(File::Exists(indexPath.c_str()) == false)
+        return;
+
+    FileStream* stream = File::Open(indexPath.c_str(), FileMode::Read);
+    if(stream == NULL)
+        return;
+
+    UInt32 numEntries = stream->ReadUInt32();
+    if(stream->GetLength() == 4 + (Int64) numEntries * 12)
+    {
+        for(UInt32 entryIndex = 0; entryIndex < numEntries; entryIndex++)
+        {
+            UInt64 key = stream->ReadUInt64();
+            UInt32 lastUsed = stream->ReadUInt32();
+
+            EntryMap::iterator iter = entries.find(key);
+            if(iter != entries.end())
+                iter->second.LastUsed = lastUsed;
+            if(lastUsed > useCounter)
+                useCounter = lastUsed;
+        }
+    }
+    stream->Close();
+    GdkDelete( stream );
+}
+
+// *****************************************************************
+/// @brief
+///     Saves the use order of the entries, so it survives to the next run
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void DecodedAssetCache::SaveIndex()
+{
+    if(Directory::Exists(folder.c_str()) == false)
+        return;
+
+    string indexPath = Path::Combine(folder.c_str(), "Index.bin");
+    FileStream* stream = File::Create(indexPath.c_str());
+    if(stream == NULL)
+        return;
+
+    stream->WriteUInt32((UInt32) entries.size());
+    for(EntryMap::iterator iter = entries.begin(); iter != entries.end(); iter++)
+    {
+        stream->WriteUInt64(iter->first);
+        stream->WriteUInt32(iter->second.LastUsed);
+    }
+
+    stream->Close();
+    GdkDelete( stream );
+}
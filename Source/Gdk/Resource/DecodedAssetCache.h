@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+
+namespace Gdk
+{
+	/// @addtogroup Resources & Assets
+    /// @{
+
+    // =================================================================================
+    ///	@brief
+    ///		An on-disk cache of asset data, in the form it has after it is decoded.
+    ///	@remarks
+    ///		Loading a texture is mostly spent inflating its image data.  The first time an asset is
+    ///     loaded, its loader stores the decoded data here.  Later loads of the same asset map the
+    ///     cached file & use the decoded data in place, without decompressing or parsing anything.
+    ///   @par
+    ///     Entries are keyed by a hash of the entire source asset, plus the name & version of the decoder.
+    ///     A changed asset (or a loader whose decoded layout changed) simply gets a new key, and the stale
+    ///     entry is eventually evicted.  When the cache is full, the least recently used entries are evicted.
+    ///   @par
+    ///     The cache is stored in the DecodedAssetCache folder of the working folder.  It is disabled by
+    ///     default, and enabled by setting ApplicationSettings::DecodedAssetCacheSize.
+    // =================================================================================
+	class DecodedAssetCache
+	{
+	public:
+
+        // Public Methods
+		// ================================
+
+        // -----------------------------------
+        /// @name Cache Methods
+        /// @{
+
+        static bool IsEnabled();
+        static UInt64 GetKey(Stream* source, const char* decoderName, UInt32 decoderVersion);
+        static Stream* Open(UInt64 key);
+        static void Store(UInt64 key, const void* data, Int64 size);
+
+        /// @}
+        // -----------------------------------
+        /// @name Size Methods
+        /// @{
+
+        static Int64 GetSize();
+        static Int64 GetMaxSize();
+        static void SetMaxSize(Int64 maxSize);
+        static void Clear();
+
+        /// @}
+
+        /// @cond INTERNAL
+
+        // ---------------------------------
+        /// @name Internal Platform Methods
+        /// @{
+
+        // Called by the Application at startup & shutdown.  (The unit tests also use them to restart the cache)
+        static void Init(Int64 maxSize);
+        static void Shutdown();
+
+        /// @}
+
+        /// @endcond
+
+    private:
+
+        // Private Types
+		// =====================================================
+
+        // ***********************************************************************
+        struct Entry
+        {
+            Int64 Size;         // Size of the cache file (in bytes)
+            UInt32 LastUsed;    // Value of the use counter when the entry was last stored or opened
+        };
+
+        typedef map<UInt64, Entry> EntryMap;
+
+        // Private Methods
+		// =====================================================
+
+        static string GetEntryPath(UInt64 key);
+        static void RemoveEntry(EntryMap::iterator entry);
+        static void EvictEntries(Int64 maxSize);
+        static void LoadIndex();
+        static void SaveIndex();
+
+        // Private Properties
+		// =====================================================
+
+        static string folder;
+        static Mutex* mutex;
+        static EntryMap entries;
+        static Int64 size;
+        static Int64 maxSize;
+        static UInt32 useCounter;
+        static UInt32 tempCounter;
+	};
+
+    /// @}
+
+} // namespace
@@ -16,6 +16,10 @@ using namespace Gdk;
 // *****************************************************************
 FileAssetProvider::FileAssetProvider(const char* rootPath)
 {
+    // Assets of 64kb or more are memory mapped by default
+    mappedFileThreshold = 64 * 1024;
+    indexed = false;
+    
 	SetRootPath(rootPath);
 }
 
@@ -33,6 +37,12 @@ void FileAssetProvider::SetRootPath(const char* rootPath)
 	// Update the name
 	this->name = string("File Assets: ");
 	this->name.append(this->rootPath);
+    
+    // The index (& any lookups the AssetManager cached) are of the old root path
+    if(this->indexed)
+        RebuildIndex();
+    else
+        AssetManager::ClearLookupCache();
 }
 
 // *****************************************************************
@@ -61,6 +71,10 @@ const string& FileAssetProvider::GetName()
 // *****************************************************************
 bool FileAssetProvider::HasAsset(const char* assetPath)
 {
+    // Is the asset in the index?
+    if(this->indexed)
+        return fileIndex.find(assetPath) != fileIndex.end();
+    
     // Build the path to the asset
     string fullAssetPath = Path::Combine(rootPath.c_str(), assetPath);
     
@@ -74,20 +88,160 @@ bool FileAssetProvider::HasAsset(const char* assetPath)
 /// @param assetPath 
 ///     Path to the asset.  This path is assumed to be relative to the root folder.
 /// @remarks
-///     If the asset doesnt exist, the method returns NULL.
+///     If the asset doesnt exist, the method returns NULL.  Assets at or above the mapped file
+///     threshold are returned as a MappedFileStream, all others as a FileStream.
+///   @par
+///     When the provider is indexed, assets that are not in the index are not looked for on disk, and
+///     the index is trusted for those that are.  (If the file was deleted since, the open fails & NULL is returned)
 // *****************************************************************
 Stream* FileAssetProvider::GetAssetStream(const char* assetPath)
 {
     // Build the path to the asset
     string fullAssetPath = Path::Combine(rootPath.c_str(), assetPath);
     
-    // Does this asset file exist?
-    if(File::Exists(fullAssetPath.c_str()) == true)
+    Int64 fileSize = 0;
+    FileStream* fileStream = NULL;
+    if(this->indexed)
+    {
+        // Get the size of the asset from the index
+        FileIndex::iterator indexIter = fileIndex.find(assetPath);
+        if(indexIter == fileIndex.end())
+            return NULL;
+        fileSize = indexIter->second;
+    }
+    else
+    {
+        // Does this asset file exist?
+        if(File::Exists(fullAssetPath.c_str()) == false)
+            return NULL;
+        
+        // Open the asset, & get its size from the stream
+        fileStream = File::Open(fullAssetPath.c_str(), Gdk::FileMode::Read);
+        if(fileStream == NULL)
+            return NULL;
+        fileSize = fileStream->GetLength();
+    }
+    
+    // Is this asset big enough to be worth memory mapping?
+    if(mappedFileThreshold > 0 && fileSize >= mappedFileThreshold)
+    {
+        MappedFileStream* mappedStream = GdkNew MappedFileStream(fullAssetPath.c_str());
+        if(mappedStream->IsOpen())
+        {
+            if(fileStream != NULL)
+                GdkDelete( fileStream );
+            return mappedStream;
+        }
+        
+        // The mapping failed, so fall back to a regular file stream
+        GdkDelete( mappedStream );
+    }
+    
+    // Open a stream to the asset, if we dont have one yet
+    if(fileStream == NULL)
+        fileStream = File::Open(fullAssetPath.c_str(), Gdk::FileMode::Read);
+    return fileStream;
+}
+
+// *****************************************************************
+/// @brief
+///     Sets the minimum size of an asset (in bytes) for it to be memory mapped
+/// @param numBytes
+///     Assets of this size or larger are opened as a MappedFileStream.  Use 0 to disable mapping.
+// *****************************************************************
+void FileAssetProvider::SetMappedFileThreshold(int numBytes)
+{
+    this->mappedFileThreshold = numBytes;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the minimum size of an asset (in bytes) for it to be memory mapped
+// *****************************************************************
+int FileAssetProvider::GetMappedFileThreshold()
+{
+    return this->mappedFileThreshold;
+}
+
+// *****************************************************************
+/// @brief
+///     Enables or disables the index of the files under the root path
+/// @param indexed
+///     If true, the provider keeps an index of its files, so HasAsset() & GetAssetStream() do not
+///     touch the file system for assets that are missing, and GetAssetStream() opens those that exist
+///     without a stat() first.
+/// @remarks
+///     The index is built when the provider is registered with the AssetManager (or right away, if
+///     it already is).  Files added under the root path afterwards are not seen until RebuildIndex() is
+///     called.  Asset paths must match the case of the file names, even on case-insensitive file systems.
+///   @par
+///     The AssetManager's lookup cache is cleared, as the provider may now find a different set of assets.
+// *****************************************************************
+void FileAssetProvider::SetIndexed(bool indexed)
+{
+    this->indexed = indexed;
+    fileIndex.clear();
+    
+    // Build the index now, if we are already in use
+    if(indexed)
     {
-        // Found the asset, so lets open a stream to it & return
-        Stream* stream = GdkNew FileStream(fullAssetPath.c_str(), Gdk::FileMode::Read);
-        return stream;
+        const AssetManager::ProviderRegistrationSet& providers = AssetManager::GetRegisteredProviders();
+        for(AssetManager::ProviderRegistrationSet::const_iterator iter = providers.begin(); iter != providers.end(); iter++)
+        {
+            if(iter->Provider == this)
+            {
+                RebuildIndex();
+                break;
+            }
+        }
     }
     
-    return NULL;
-}
\ No newline at end of file
+    // Assets missing from the index may be found on disk now  (or the other way around)
+    AssetManager::ClearLookupCache();
+}
+
+// *****************************************************************
+/// @brief
+///     Checks if the provider keeps an index of its files
+// *****************************************************************
+bool FileAssetProvider::IsIndexed()
+{
+    return this->indexed;
+}
+
+// *****************************************************************
+/// @brief
+///     Rebuilds the index of the files under the root path
+/// @remarks
+///     This should not be called while assets are being loaded from the provider on other threads.
+///     Also clears the AssetManager's lookup cache, as files may have been added or removed.
+// *****************************************************************
+void FileAssetProvider::RebuildIndex()
+{
+    fileIndex.clear();
+    
+    // Get all the files under the root path
+    vector<string> files;
+    Directory::GetFiles(rootPath.c_str(), files, true);
+    
+    // Index them, along with their sizes
+    for(vector<string>::iterator fileIter = files.begin(); fileIter != files.end(); fileIter++)
+    {
+        string fullPath = Path::Combine(rootPath.c_str(), fileIter->c_str());
+        fileIndex[*fileIter] = File::GetFileSize(fullPath.c_str());
+    }
+    
+    AssetManager::ClearLookupCache();
+}
+
+// *****************************************************************
+/// @brief
+///     Called by the AssetManager when this provider is registered
+/// @remarks
+///     Builds the index, if the provider is indexed.
+// *****************************************************************
+void FileAssetProvider::OnRegistered()
+{
+    if(this->indexed)
+        RebuildIndex();
+}
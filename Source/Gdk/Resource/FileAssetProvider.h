@@ -40,6 +40,21 @@ namespace Gdk
         virtual bool HasAsset(const char* assetPath);
 		virtual Stream* GetAssetStream(const char* assetPath);
         
+        void SetMappedFileThreshold(int numBytes);
+        int GetMappedFileThreshold();
+        
+        /// @}
+        
+        // -----------------------------------
+        /// @name Index Methods
+        /// @{
+        
+        void SetIndexed(bool indexed);
+        bool IsIndexed();
+        void RebuildIndex();
+        
+        virtual void OnRegistered();
+        
         /// @}
         
     private:
@@ -49,6 +64,12 @@ namespace Gdk
 		
 		string		rootPath;
 		string		name;
+		int			mappedFileThreshold;
+        
+        // Index of the files under the root path  (Relative path -> file size)
+        typedef map<string, Int64> FileIndex;
+        bool        indexed;
+        FileIndex   fileIndex;
 	};
     
     
@@ -0,0 +1,270 @@
+/* 
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "BasePCH.h"
+#include "PackAssetProvider.h"
+#include "PackFormat.h"
+
+using namespace Gdk;
+
+// *****************************************************************
+/// @brief
+///     Constructor
+/// @param packFilePath
+///     Path to the .gdkpack file on the file-system.
+/// @param allowMapping
+///     If false, the pack is always read with positioned reads, rather than memory mapped.
+/// @remarks
+///     If the pack can not be opened, an error is logged and the provider will not provide any assets.
+// *****************************************************************
+PackAssetProvider::PackAssetProvider(const char* packFilePath, bool allowMapping)
+{
+    mappedPack = NULL;
+    packFile = NULL;
+    
+    // Set the name
+    this->name = string("Pack Assets: ");
+    this->name.append(packFilePath);
+    
+    if(File::Exists(packFilePath) == false)
+    {
+        LOG_ERROR("The asset pack [%s] does not exist", packFilePath);
+        return;
+    }
+    
+    // Try to map the pack into memory.  (Without the sequential read-ahead of a single asset, as the assets are read in any order)
+    if(allowMapping)
+    {
+        mappedPack = GdkNew MappedFileStream(packFilePath, FileAccessHint::Normal);
+        if(mappedPack->IsOpen() == false)
+        {
+            GdkDelete( mappedPack );
+            mappedPack = NULL;
+        }
+    }
+    
+    // Without a mapping, fall back to reading the pack through a file stream
+    if(mappedPack == NULL)
+    {
+        packFile = File::Open(packFilePath, FileMode::Read);
+        if(packFile == NULL)
+            return;
+    }
+    
+    // Read the table of contents
+    Stream* stream = mappedPack != NULL ? (Stream*)mappedPack : (Stream*)packFile;
+    if(ReadTableOfContents(stream) == false)
+    {
+        LOG_ERROR("The asset pack [%s] is not a valid GDK pack", packFilePath);
+        entries.clear();
+        pathTable.clear();
+    }
+}
+
+// *****************************************************************
+/// @brief
+///     Destructor
+/// @remarks
+///     Streams returned for uncompressed assets point into the pack, and must be closed before the provider is destroyed
+// *****************************************************************
+PackAssetProvider::~PackAssetProvider()
+{
+    if(mappedPack != NULL)
+        GdkDelete( mappedPack );
+    if(packFile != NULL)
+        GdkDelete( packFile );
+}
+
+// *****************************************************************
+/// @brief
+///     Reads & validates the header & table of contents of the pack
+/// @param stream
+///     Stream to the pack file
+// *****************************************************************
+bool PackAssetProvider::ReadTableOfContents(Stream* stream)
+{
+    // Read & verify the header
+    char tag[4];
+    if(stream->Read(tag, 4) != 4 || memcmp(tag, "GDKP", 4) != 0)
+        return false;
+    
+    UInt16 version = stream->ReadUInt16();
+    if(version != GDKPACK_VERSION)
+    {
+        LOG_ERROR("Unsupported asset pack version: %d [Expected: %d]", version, GDKPACK_VERSION);
+        return false;
+    }
+    
+    UInt16 flags = stream->ReadUInt16();
+    UInt32 numEntries = stream->ReadUInt32();
+    UInt32 pathTableSize = stream->ReadUInt32();
+    UInt64 packLength = (UInt64) stream->GetLength();
+    GDK_NOT_USED(flags);
+    
+    // Read the table of contents
+    entries.resize(numEntries);
+    for(UInt32 entryIndex = 0; entryIndex < numEntries; entryIndex++)
+    {
+        PackEntry& entry = entries[entryIndex];
+        entry.PathHash = stream->ReadUInt32();
+        entry.PathOffset = stream->ReadUInt32();
+        entry.DataOffset = stream->ReadUInt64();
+        entry.StoredSize = stream->ReadUInt64();
+        entry.Size = stream->ReadUInt64();
+        entry.Compression = stream->ReadUInt16();
+        stream->ReadUInt16();   // Reserved
+        stream->ReadUInt32();   // Reserved
+        
+        // Verify the entry is within the pack, & can be read
+        if(entry.PathOffset >= pathTableSize || entry.StoredSize > GDKPACK_MAX_ASSET_SIZE || entry.Size > GDKPACK_MAX_ASSET_SIZE
+            || entry.DataOffset > packLength || entry.StoredSize > packLength - entry.DataOffset)
+            return false;
+    }
+    
+    // Read the path table
+    pathTable.resize(pathTableSize + 1);
+    if(pathTableSize > 0 && stream->Read(&pathTable[0], pathTableSize) != (int)pathTableSize)
+        return false;
+    pathTable[pathTableSize] = 0;
+    
+    return true;
+}
+
+// *****************************************************************
+/// @brief
+///     Checks if the pack was opened successfully
+// *****************************************************************
+bool PackAssetProvider::IsOpen()
+{
+    return mappedPack != NULL || packFile != NULL;
+}
+
+// *****************************************************************
+/// @brief
+///     Checks if the pack is memory mapped.  (Otherwise it is read with positioned reads)
+// *****************************************************************
+bool PackAssetProvider::IsMapped()
+{
+    return mappedPack != NULL;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the number of assets in the pack
+// *****************************************************************
+size_t PackAssetProvider::GetAssetCount()
+{
+    return entries.size();
+}
+
+// *****************************************************************
+/// @brief
+///     Gets a display friend name for this provider.  Ex: "Pack Assets: /Assets/Base.gdkpack"
+// *****************************************************************
+const string& PackAssetProvider::GetName()
+{
+	return this->name;
+}
+
+// *****************************************************************
+/// @brief
+///     Finds the table of contents entry for an asset
+/// @param assetPath 
+///     Path to the asset, relative to the root of the pack
+/// @remarks
+///     Returns NULL if the asset is not in the pack
+// *****************************************************************
+const PackAssetProvider::PackEntry* PackAssetProvider::FindEntry(const char* assetPath)
+{
+    if(entries.size() == 0)
+        return NULL;
+    
+    // Binary search the table of contents for the path hash
+    PackEntry key;
+    key.PathHash = StringUtilities::FastHash(assetPath);
+    vector<PackEntry>::iterator entryIter = lower_bound(entries.begin(), entries.end(), key);
+    
+    // Check the path of every entry with the same hash
+    for(; entryIter != entries.end() && entryIter->PathHash == key.PathHash; entryIter++)
+    {
+        if(strcmp(&pathTable[entryIter->PathOffset], assetPath) == 0)
+            return &(*entryIter);
+    }
+    
+    return NULL;
+}
+
+// *****************************************************************
+/// @brief
+///     Checks if this provider has an asset at the given path
+/// @param assetPath 
+///     Path to the asset, relative to the root of the pack
+// *****************************************************************
+bool PackAssetProvider::HasAsset(const char* assetPath)
+{
+    return FindEntry(assetPath) != NULL;
+}
+    
+// *****************************************************************
+/// @brief
+///     Gets a Read-Only Stream* to the asset.
+/// @param assetPath 
+///     Path to the asset, relative to the root of the pack
+/// @remarks
+///     If the asset doesnt exist, the method returns NULL.
+// *****************************************************************
+Stream* PackAssetProvider::GetAssetStream(const char* assetPath)
+{
+    const PackEntry* entry = FindEntry(assetPath);
+    if(entry == NULL)
+        return NULL;
+    
+    // Get the stored data of the asset
+    MemoryStream* storedStream = NULL;
+    if(mappedPack != NULL)
+    {
+        // Wrap the stored data right in the mapping
+        void* storedData = (void*) mappedPack->GetSpan(entry->DataOffset, entry->StoredSize);
+        storedStream = GdkNew MemoryStream(storedData, entry->StoredSize);
+        
+        // Uncompressed assets can be used in place
+        if(entry->Compression == GDKPACK_COMPRESSION_NONE)
+            return storedStream;
+    }
+    else
+    {
+        // Read the stored data out of the pack file.  (ReadAt doesn't use the stream position, so the loader threads don't need to take turns)
+        storedStream = GdkNew MemoryStream(entry->StoredSize > 0 ? entry->StoredSize : 1);
+        int bytesRead = packFile->ReadAt(storedStream->GetBufferStartPtr(), entry->DataOffset, (int) entry->StoredSize);
+        storedStream->SetLength(bytesRead);
+        
+        if(entry->Compression == GDKPACK_COMPRESSION_NONE)
+            return storedStream;
+    }
+    
+    // Decompress the asset straight into its own stream.  (The pack compression values are the CompressionType + 1)
+    MemoryStream* assetStream = GdkNew MemoryStream(entry->Size > 0 ? entry->Size : 1);
+    bool result = false;
+    if(entry->Compression >= GDKPACK_COMPRESSION_ZLIB && entry->Compression <= GDKPACK_COMPRESSION_ZSTD)
+    {
+        CompressionType::Enum compressionType = (CompressionType::Enum) (entry->Compression - GDKPACK_COMPRESSION_ZLIB);
+        result = Stream::Decompress(storedStream->GetBufferStartPtr(), (int) storedStream->GetLength(), 
+            assetStream->GetBufferStartPtr(), (int) entry->Size, compressionType);
+        ResourceLoadStats::AddBytes(ResourceLoadPhase::Decompress, entry->Size);
+        assetStream->SetLength(entry->Size);
+    }
+    
+    GdkDelete( storedStream );
+    
+    if(result == false)
+    {
+        LOG_ERROR("Failed to decompress the asset [%s] from %s", assetPath, name.c_str());
+        GdkDelete( assetStream );
+        return NULL;
+    }
+    
+    assetStream->SetPosition(0);
+    return assetStream;
+}
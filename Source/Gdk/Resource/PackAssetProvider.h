@@ -0,0 +1,93 @@
+/* 
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+#include "AssetProvider.h"
+
+namespace Gdk
+{
+	/// @addtogroup Resources & Assets
+    /// @{
+    
+    // =================================================================================
+    ///	@brief
+    ///	    Provides access to assets stored in a single .gdkpack file.
+    ///	@remarks
+    ///		A pack holds many assets in one file, with a table of contents sorted by the hash of
+    ///     each asset path.  The pack is opened & its table of contents is read once, so finding
+    ///     an asset is a binary search instead of a file system stat & open per asset.
+    ///   @par
+    ///     The pack file is memory mapped when possible.  Uncompressed assets are then returned
+    ///     as streams directly over the mapping (with no copy), and so are only valid while the
+    ///     provider exists.  Compressed assets are inflated into their own memory stream.  When the pack
+    ///     can't be mapped (such as a pack larger than the address space), assets are read with positioned
+    ///     reads, which several loader threads can do at once.
+    ///   @par
+    ///     Packs are built from an asset folder with the GdkPack tool.  (Tools/GdkPack)
+    // =================================================================================
+    class PackAssetProvider : public AssetProvider
+	{
+	public:
+		// Public Methods
+		// ================================
+        
+        // -----------------------------------
+        /// @name Common Methods 
+        /// @{
+        
+		PackAssetProvider(const char* packFilePath, bool allowMapping = true); 
+		virtual ~PackAssetProvider();
+        
+		bool IsOpen();
+		bool IsMapped();
+		size_t GetAssetCount();
+		
+		virtual const string& GetName();
+        virtual bool HasAsset(const char* assetPath);
+		virtual Stream* GetAssetStream(const char* assetPath);
+        
+        /// @}
+        
+    private:
+        
+		// Internal Types
+		// ---------------------
+		
+		struct PackEntry
+		{
+			UInt32 PathHash;
+			UInt32 PathOffset;
+			UInt64 DataOffset;
+			UInt64 StoredSize;
+			UInt64 Size;
+			UInt16 Compression;
+			
+			/// Less-than operator, for searching the table of contents by hash
+			inline bool operator< (const PackEntry& input) const { return this->PathHash < input.PathHash; }
+		};
+		
+		// Internals
+		// ---------------------
+		
+		string				name;
+		vector<PackEntry>	entries;
+		vector<char>		pathTable;
+		
+		// Pack file access.  (Mapped if possible, otherwise read with FileStream::ReadAt)
+		MappedFileStream*	mappedPack;
+		FileStream*			packFile;
+		
+		// Internal Methods
+		// ---------------------
+		
+		bool ReadTableOfContents(Stream* stream);
+		const PackEntry* FindEntry(const char* assetPath);
+	};
+    
+    
+    /// @}
+
+} // namespace 
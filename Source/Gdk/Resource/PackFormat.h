@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+
+// Pack format constants, shared by the PackAssetProvider & the PackWriter  (See "Docs/File Formats/Pack File Format.txt")
+#define GDKPACK_VERSION             2
+#define GDKPACK_HEADER_SIZE         16
+#define GDKPACK_ENTRY_SIZE          40
+
+// Compression of the assets in a pack  (The CompressionType + 1)
+#define GDKPACK_COMPRESSION_NONE    0
+#define GDKPACK_COMPRESSION_ZLIB    1
+#define GDKPACK_COMPRESSION_LZ4     2
+#define GDKPACK_COMPRESSION_ZSTD    3
+
+// Largest asset that can be read from a pack.  (Each asset is read & decompressed with a single int sized call)
+#define GDKPACK_MAX_ASSET_SIZE      0x7FFFFFFFULL
+
+// Alignment of each asset within a pack, unless the PackWriter is given another
+#define GDKPACK_DEFAULT_ALIGNMENT   16
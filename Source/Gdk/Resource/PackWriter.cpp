@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "BasePCH.h"
+#include "PackWriter.h"
+
+#include "zlib.h"
+
+#ifdef GDK_LZ4
+#include "lz4frame.h"
+#include "lz4hc.h"
+#endif
+
+#ifdef GDK_ZSTD
+#include "zstd.h"
+#endif
+
+// 64 bit file offsets, as a pack (or the assets in it) can be larger than 2GB
+#ifdef GDKPLATFORM_WINDOWS
+    #define PACKWRITER_FSEEK(file, offset, origin)      _fseeki64(file, (__int64) (offset), origin)
+    #define PACKWRITER_FTELL(file)                      ((UInt64) _ftelli64(file))
+#else
+    #define PACKWRITER_FSEEK(file, offset, origin)      fseeko(file, (off_t) (offset), origin)
+    #define PACKWRITER_FTELL(file)                      ((UInt64) ftello(file))
+#endif
+
+using namespace Gdk;
+
+// *****************************************************************
+/// @brief
+///     Constructor
+// *****************************************************************
+PackWriter::PackWriter()
+{
+    this->pathTableSize = 0;
+    this->alignment = GDKPACK_DEFAULT_ALIGNMENT;
+    this->packSize = 0;
+}
+
+// *****************************************************************
+/// @brief
+///     Destructor
+// *****************************************************************
+PackWriter::~PackWriter()
+{
+}
+
+// *****************************************************************
+/// @brief
+///     Sets the alignment of each asset within the pack, in bytes.  (Default = GDKPACK_DEFAULT_ALIGNMENT)
+/// @remarks
+///     The padding between assets is skipped over rather than written, so a large alignment
+///     leaves holes in the pack file, which are sparse on file systems that support it.
+// *****************************************************************
+void PackWriter::SetAlignment(UInt64 alignment)
+{
+    this->alignment = alignment > 0 ? alignment : 1;
+}
+
+// *****************************************************************
+/// @brief
+///     Adds a file to the pack.  The file isnt read until the pack is written.
+/// @param assetPath
+///     The path of the asset within the pack, as passed to AssetManager::GetAssetStream()
+/// @param filePath
+///     Path of the file to read the asset data from
+/// @param compression
+///     The GDKPACK_COMPRESSION_ type to store the asset with.  The asset is only stored compressed
+///     if that makes it at least 10% smaller.
+/// @return
+///     False if the compression type isnt supported in this build
+// *****************************************************************
+bool PackWriter::AddFile(const char* assetPath, const char* filePath, UInt16 compression)
+{
+    if(IsCompressionSupported(compression) == false)
+    {
+        LOG_ERROR("Unable to pack \"%s\", compression type [%d] is not supported in this build", assetPath, compression);
+        return false;
+    }
+
+    WriterEntry entry;
+    entry.Path = assetPath;
+    entry.FilePath = filePath;
+    entry.PathHash = StringUtilities::FastHash(assetPath);
+    entry.PathOffset = (UInt32) this->pathTableSize;
+    entry.DataOffset = 0;
+    entry.StoredSize = 0;
+    entry.Size = 0;
+    entry.Compression = GDKPACK_COMPRESSION_NONE;
+    entry.RequestedCompression = compression;
+    this->entries.push_back(entry);
+
+    this->pathTableSize += entry.Path.size() + 1;
+    return true;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the number of assets added to the pack
+// *****************************************************************
+size_t PackWriter::GetAssetCount()
+{
+    return this->entries.size();
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the size of the last pack written, in bytes
+// *****************************************************************
+UInt64 PackWriter::GetPackSize()
+{
+    return this->packSize;
+}
+
+// *****************************************************************
+/// @brief
+///     Writes the pack file
+/// @param packPath
+///     Path of the pack file to create
+/// @return
+///     False if an asset couldn't be read, or the pack couldn't be written.  No pack file is left behind in that case.
+// *****************************************************************
+bool PackWriter::Write(const char* packPath)
+{
+    if(this->entries.size() > 0xFFFFFFFFULL || this->pathTableSize > 0xFFFFFFFFULL)
+    {
+        LOG_ERROR("Too many assets to pack: %d assets, with %llu bytes of paths", (int) this->entries.size(), (unsigned long long) this->pathTableSize);
+        return false;
+    }
+
+    FILE* file = fopen(packPath, "wb");
+    if(file == NULL)
+    {
+        LOG_ERROR("Unable to create the pack: %s", packPath);
+        return false;
+    }
+
+    // Header
+    fwrite("GDKP", 1, 4, file);
+    WriteUInt16(file, GDKPACK_VERSION);
+    WriteUInt16(file, 0);
+    WriteUInt32(file, (UInt32) this->entries.size());
+    WriteUInt32(file, (UInt32) this->pathTableSize);
+
+    // Leave room for the table of contents, which is written once the data offsets are known
+    UInt64 pathTableOffset = GDKPACK_HEADER_SIZE + this->entries.size() * GDKPACK_ENTRY_SIZE;
+    PACKWRITER_FSEEK(file, pathTableOffset, SEEK_SET);
+
+    // Path table
+    for(size_t entryIndex = 0; entryIndex < this->entries.size(); entryIndex++)
+        fwrite(this->entries[entryIndex].Path.c_str(), 1, this->entries[entryIndex].Path.size() + 1, file);
+
+    // Asset data
+    if(WriteAssets(file, pathTableOffset + this->pathTableSize) == false)
+    {
+        fclose(file);
+        remove(packPath);
+        return false;
+    }
+
+    // Table of contents  (sorted by path hash, but the data & paths stay in the order they were added)
+    vector<WriterEntry*> sortedEntries;
+    for(size_t entryIndex = 0; entryIndex < this->entries.size(); entryIndex++)
+        sortedEntries.push_back(&this->entries[entryIndex]);
+    stable_sort(sortedEntries.begin(), sortedEntries.end(), IsEntryPtrLess);
+
+    PACKWRITER_FSEEK(file, GDKPACK_HEADER_SIZE, SEEK_SET);
+    for(size_t entryIndex = 0; entryIndex < sortedEntries.size(); entryIndex++)
+    {
+        WriterEntry* entry = sortedEntries[entryIndex];
+        WriteUInt32(file, entry->PathHash);
+        WriteUInt32(file, entry->PathOffset);
+        WriteUInt64(file, entry->DataOffset);
+        WriteUInt64(file, entry->StoredSize);
+        WriteUInt64(file, entry->Size);
+        WriteUInt16(file, entry->Compression);
+        WriteUInt16(file, 0);
+        WriteUInt32(file, 0);
+    }
+
+    bool writeFailed = ferror(file) != 0;
+    if(fclose(file) != 0 || writeFailed)
+    {
+        LOG_ERROR("Unable to write the pack: %s", packPath);
+        remove(packPath);
+        return false;
+    }
+
+    return true;
+}
+
+// *****************************************************************
+/// @brief
+///     Reads (and compresses) the assets, & writes them out one at a time
+/// @param file
+///     The pack file, positioned at the end of the path table
+/// @param dataOffset
+///     Offset of the end of the path table
+// *****************************************************************
+bool PackWriter::WriteAssets(FILE* file, UInt64 dataOffset)
+{
+    for(size_t entryIndex = 0; entryIndex < this->entries.size(); entryIndex++)
+    {
+        WriterEntry& entry = this->entries[entryIndex];
+
+        vector<UInt8> storedData;
+        if(ReadFile(entry.FilePath.c_str(), storedData) == false)
+        {
+            LOG_ERROR("Unable to read the asset \"%s\" from: %s", entry.Path.c_str(), entry.FilePath.c_str());
+            return false;
+        }
+        entry.Size = storedData.size();
+
+        // Keep the compressed data, if it is worth it
+        UInt16 compression = entry.RequestedCompression;
+        entry.Compression = GDKPACK_COMPRESSION_NONE;
+        if(compression != GDKPACK_COMPRESSION_NONE && entry.Size > 0)
+        {
+            vector<UInt8> compressedData;
+            if(CompressData(compression, storedData, compressedData)
+                && compressedData.size() < entry.Size - entry.Size / 10)
+            {
+                storedData.swap(compressedData);
+                entry.Compression = compression;
+            }
+        }
+        entry.StoredSize = storedData.size();
+
+        // An empty asset takes no space, so it is left unaligned rather than seeking past the end of the pack
+        if(entry.StoredSize == 0)
+        {
+            entry.DataOffset = dataOffset;
+            continue;
+        }
+
+        // Write the data at the next aligned offset
+        entry.DataOffset = (dataOffset + this->alignment - 1) / this->alignment * this->alignment;
+        PACKWRITER_FSEEK(file, entry.DataOffset, SEEK_SET);
+        if(fwrite(&storedData[0], 1, storedData.size(), file) != storedData.size())
+        {
+            LOG_ERROR("Unable to write the asset \"%s\" to the pack", entry.Path.c_str());
+            return false;
+        }
+        dataOffset = entry.DataOffset + entry.StoredSize;
+    }
+
+    this->packSize = dataOffset;
+    return true;
+}
+
+// *****************************************************************
+/// @brief
+///     Checks if a GDKPACK_COMPRESSION_ type is supported in this build
+// *****************************************************************
+bool PackWriter::IsCompressionSupported(UInt16 compression)
+{
+    switch(compression)
+    {
+        case GDKPACK_COMPRESSION_NONE:
+        case GDKPACK_COMPRESSION_ZLIB:
+            return true;
+
+#ifdef GDK_LZ4
+        case GDKPACK_COMPRESSION_LZ4:
+            return true;
+#endif
+
+#ifdef GDK_ZSTD
+        case GDKPACK_COMPRESSION_ZSTD:
+            return true;
+#endif
+
+        default:
+            return false;
+    }
+}
+
+// *****************************************************************
+/// @brief
+///     Reads an entire file into a byte vector
+/// @return
+///     False if the file can't be read, or is too large for the runtime to read from a pack
+// *****************************************************************
+bool PackWriter::ReadFile(const char* filePath, vector<UInt8>& data)
+{
+    FILE* file = fopen(filePath, "rb");
+    if(file == NULL)
+        return false;
+
+    PACKWRITER_FSEEK(file, 0, SEEK_END);
+    UInt64 size = PACKWRITER_FTELL(file);
+    PACKWRITER_FSEEK(file, 0, SEEK_SET);
+    if(size > GDKPACK_MAX_ASSET_SIZE)
+    {
+        LOG_ERROR("%s is %llu bytes.  Assets in a pack can be at most %llu bytes", filePath, (unsigned long long) size, GDKPACK_MAX_ASSET_SIZE);
+        fclose(file);
+        return false;
+    }
+
+    data.resize((size_t) size);
+    bool result = size == 0 || fread(&data[0], 1, (size_t) size, file) == (size_t) size;
+    fclose(file);
+    return result;
+}
+
+// *****************************************************************
+/// @brief
+///     Compresses a block of data with the given pack compression type
+/// @return
+///     False if the codec failed, or is not built in
+/// @remarks
+///     Each codec is run at its highest level, as packs are built offline & only decompression speed matters at runtime.
+// *****************************************************************
+bool PackWriter::CompressData(UInt16 compression, const vector<UInt8>& source, vector<UInt8>& compressed)
+{
+    switch(compression)
+    {
+        case GDKPACK_COMPRESSION_ZLIB:
+        {
+            uLongf compressedSize = compressBound((uLong) source.size());
+            compressed.resize(compressedSize);
+            if(compress2(&compressed[0], &compressedSize, &source[0], (uLong) source.size(), Z_BEST_COMPRESSION) != Z_OK)
+                return false;
+            compressed.resize(compressedSize);
+            return true;
+        }
+
+#ifdef GDK_LZ4
+        case GDKPACK_COMPRESSION_LZ4:
+        {
+            LZ4F_preferences_t preferences;
+            memset(&preferences, 0, sizeof(preferences));
+            preferences.compressionLevel = LZ4HC_CLEVEL_MAX;
+            preferences.frameInfo.contentSize = source.size();
+
+            compressed.resize(LZ4F_compressFrameBound(source.size(), &preferences));
+            size_t compressedSize = LZ4F_compressFrame(&compressed[0], compressed.size(), &source[0], source.size(), &preferences);
+            if(LZ4F_isError(compressedSize))
+                return false;
+            compressed.resize(compressedSize);
+            return true;
+        }
+#endif
+
+#ifdef GDK_ZSTD
+        case GDKPACK_COMPRESSION_ZSTD:
+        {
+            compressed.resize(ZSTD_compressBound(source.size()));
+            size_t compressedSize = ZSTD_compress(&compressed[0], compressed.size(), &source[0], source.size(), 19);
+            if(ZSTD_isError(compressedSize))
+                return false;
+            compressed.resize(compressedSize);
+            return true;
+        }
+#endif
+
+        default:
+            return false;
+    }
+}
+
+// *****************************************************************
+/// @brief
+///     Sorts pack entries by their path hash
+// *****************************************************************
+bool PackWriter::IsEntryPtrLess(const WriterEntry* a, const WriterEntry* b)
+{
+    return a->PathHash < b->PathHash;
+}
+
+// *****************************************************************
+/// @brief
+///     Little endian writers  (The runtime reads packs in native order, which is little endian on all GDK platforms)
+// *****************************************************************
+void PackWriter::WriteUInt16(FILE* file, UInt16 value)
+{
+    UInt8 bytes[2] = { (UInt8)(value), (UInt8)(value >> 8) };
+    fwrite(bytes, 1, 2, file);
+}
+
+// *****************************************************************
+void PackWriter::WriteUInt32(FILE* file, UInt32 value)
+{
+    UInt8 bytes[4] = { (UInt8)(value), (UInt8)(value >> 8), (UInt8)(value >> 16), (UInt8)(value >> 24) };
+    fwrite(bytes, 1, 4, file);
+}
+
+// *****************************************************************
+void PackWriter::WriteUInt64(FILE* file, UInt64 value)
+{
+    WriteUInt32(file, (UInt32) value);
+    WriteUInt32(file, (UInt32) (value >> 32));
+}
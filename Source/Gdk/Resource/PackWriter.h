@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+#include "PackFormat.h"
+
+namespace Gdk
+{
+	/// @addtogroup Resources & Assets
+    /// @{
+
+	// =================================================================================
+    ///	@brief
+    ///	    Builds a .gdkpack asset pack from a set of files
+    ///	@remarks
+    ///		The asset data & paths are written in the order the files were added, each asset at an aligned
+    ///     offset, and the table of contents is sorted by path hash for the PackAssetProvider's lookups.
+    ///     The files are read, compressed & written one at a time, so only one asset is in memory at once.
+    ///   @par
+    ///     The writer is shared by the GdkPack tool & the unit tests.  It only uses the C runtime, the compression
+    ///     libraries & StringUtilities, so it builds into GdkPack without the rest of the GDK.  (See Tools/GdkPack)
+    // =================================================================================
+	class PackWriter
+	{
+	public:
+
+		// Public Methods
+		// ================================
+
+        // -----------------------------------
+        /// @name Common Methods
+        /// @{
+
+        PackWriter();
+        ~PackWriter();
+
+        void SetAlignment(UInt64 alignment);
+        bool AddFile(const char* assetPath, const char* filePath, UInt16 compression = GDKPACK_COMPRESSION_NONE);
+
+        size_t GetAssetCount();
+        UInt64 GetPackSize();
+
+        bool Write(const char* packPath);
+
+        static bool IsCompressionSupported(UInt16 compression);
+
+        /// @}
+
+    private:
+
+        // Private Types
+		// ================================
+
+        // ***********************************************************************
+        struct WriterEntry
+        {
+            string      Path;
+            string      FilePath;
+            UInt32      PathHash;
+            UInt32      PathOffset;
+            UInt64      DataOffset;
+            UInt64      StoredSize;
+            UInt64      Size;
+            UInt16      Compression;
+            UInt16      RequestedCompression;
+        };
+
+        // Private Properties
+		// ================================
+
+        vector<WriterEntry> entries;
+        UInt64 pathTableSize;
+        UInt64 alignment;
+        UInt64 packSize;
+
+        // Private Methods
+		// ================================
+
+        bool WriteAssets(FILE* file, UInt64 dataOffset);
+
+        static bool ReadFile(const char* filePath, vector<UInt8>& data);
+        static bool CompressData(UInt16 compression, const vector<UInt8>& source, vector<UInt8>& compressed);
+        static bool IsEntryPtrLess(const WriterEntry* a, const WriterEntry* b);
+
+        static void WriteUInt16(FILE* file, UInt16 value);
+        static void WriteUInt32(FILE* file, UInt32 value);
+        static void WriteUInt64(FILE* file, UInt64 value);
+	};
+
+    /// @}
+
+} // namespace
@@ -34,6 +34,15 @@ const string& Resource::GetName()
     return this->name; 
 }
 
+// *****************************************************************
+/// @brief
+///     Gets the name of the type of this resource.  (Such as "Texture2D" or "Model")
+// *****************************************************************
+const char* Resource::GetTypeName()
+{
+    return this->manager->GetResourceTypeName();
+}
+
 // *****************************************************************
 /// @brief
 ///     Checks if this resource is in the Ready state.  Meaning it has finished loading
@@ -110,3 +119,17 @@ size_t Resource::GetMemoryUsed()
 {
     return 0; 
 }
+
+// *****************************************************************
+/// @brief
+///     Gets the resources that this resource loaded & holds references to.  (Such as the textures of a model)
+/// @param[out] children
+///     The child resources are appended to this vector.  No references are added to them.
+/// @remarks
+///     This virtual method should be overriden in derived classes that load other resources.
+///     The AssetBundleWriter uses it to fill in the dependencies of each asset in a bundle.
+// *****************************************************************
+void Resource::GetChildResources(vector<Resource*>& children)
+{
+    GDK_NOT_USED(children);
+}
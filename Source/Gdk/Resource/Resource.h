@@ -57,7 +57,7 @@ namespace Gdk
         /// @{
 
         /// Current state of the resource.   [read-only]
-        ResourceState::Enum State;
+        volatile ResourceState::Enum State;
         
         /// @}
         
@@ -71,6 +71,7 @@ namespace Gdk
         virtual ~Resource();
         
 		const string& GetName();
+		const char* GetTypeName();
 		bool IsReady();
 
 		UInt32 GetHashCode();
@@ -79,6 +80,8 @@ namespace Gdk
         int AddRef();
 		int Release();
         
+        virtual void GetChildResources(vector<Resource*>& children);
+        
         /// @}
         
     protected:
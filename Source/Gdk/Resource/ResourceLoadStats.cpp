@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "BasePCH.h"
+#include "ResourceLoadStats.h"
+
+using namespace Gdk;
+
+// Static Instantiations
+bool ResourceLoadStats::Enabled = false;
+vector<ResourceLoadRecord> ResourceLoadStats::records;
+Mutex* ResourceLoadStats::mutex = NULL;
+
+// Thread local slot holding the load in progress on each thread
+static pthread_key_t activeLoadKey;
+
+// *****************************************************************
+/// @brief
+///     Writes a text field to a CSV file, in quotes  (With any quotes in the text doubled)
+// *****************************************************************
+static void WriteQuotedCSVField(FileStream* file, const char* text)
+{
+    file->Write((void*) "\"", 1);
+    for(const char* quote = strchr(text, '"'); quote != NULL; quote = strchr(text, '"'))
+    {
+        file->Write((void*) text, (int)(quote - text) + 1);
+        file->Write((void*) "\"", 1);
+        text = quote + 1;
+    }
+    file->Write((void*) text, (int) strlen(text));
+    file->Write((void*) "\"", 1);
+}
+
+// *****************************************************************
+const char* ResourceLoadPhase::ToString(ResourceLoadPhase::Enum phase)
+{
+	static const char* phaseNames[] =
+	{
+		"Queued",
+		"Read",
+		"Decompress",
+		"Parse",
+		"Upload",
+	};
+	return phaseNames[phase];
+}
+
+// *****************************************************************
+/// @brief
+///     Static Initializer for the ResourceLoadStats
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void ResourceLoadStats::Init()
+{
+    mutex = Mutex::Create();
+    pthread_key_create(&activeLoadKey, NULL);
+}
+
+// *****************************************************************
+/// @brief
+///     Static Shutdown for the ResourceLoadStats
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void ResourceLoadStats::Shutdown()
+{
+    records.clear();
+    pthread_key_delete(activeLoadKey);
+
+    GdkDelete(mutex);
+    mutex = NULL;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the load in progress on the calling thread  (NULL if there is none)
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+ResourceLoadStats::ActiveLoad* ResourceLoadStats::GetActiveLoad()
+{
+    if(mutex == NULL)
+        return NULL;
+    return (ActiveLoad*) pthread_getspecific(activeLoadKey);
+}
+
+// *****************************************************************
+/// @brief
+///     Starts recording a resource load on the calling thread
+/// @param resource
+///     The resource being loaded
+/// @param type
+///     Name of the type of the resource  (Must be a string literal)
+/// @param queuedTime
+///     Seconds the load spent waiting in the background work queue
+/// @param async
+///     True if the load is being done by a background thread
+/// @remarks
+///     Every BeginLoad() must be matched by an EndLoad() on the same thread.
+///     GDK Internal Use Only
+// *****************************************************************
+void ResourceLoadStats::BeginLoad(Resource* resource, const char* type, double queuedTime, bool async)
+{
+    if(mutex == NULL)
+        return;
+
+    double currentTime = HighResTimer::GetSeconds();
+
+    ActiveLoad* load = GdkNew ActiveLoad();
+    load->Record.Name = resource->GetName();
+    load->Record.Type = type;
+    load->Record.Async = async;
+    load->Record.StartTime = currentTime;
+    load->Record.LoadTime = 0.0;
+    for(int phase = 0; phase < ResourceLoadPhase::Count; phase++)
+    {
+        load->Record.Times[phase] = 0.0;
+        load->Record.Bytes[phase] = 0;
+    }
+    load->Record.Times[ResourceLoadPhase::Queued] = queuedTime;
+    load->CurrentPhase = -1;
+    load->PhaseStartTime = currentTime;
+    load->NestedLoadTime = 0.0;
+
+    // Pause the phase of the load this one is nested in
+    load->Parent = (ActiveLoad*) pthread_getspecific(activeLoadKey);
+    if(load->Parent != NULL && load->Parent->CurrentPhase >= 0)
+        load->Parent->Record.Times[load->Parent->CurrentPhase] += currentTime - load->Parent->PhaseStartTime;
+
+    pthread_setspecific(activeLoadKey, load);
+}
+
+// *****************************************************************
+/// @brief
+///     Finishes recording the resource load in progress on the calling thread
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void ResourceLoadStats::EndLoad()
+{
+    ActiveLoad* load = GetActiveLoad();
+    if(load == NULL)
+        return;
+
+    double currentTime = HighResTimer::GetSeconds();
+    ResourceLoadRecord& record = load->Record;
+    record.LoadTime = currentTime - record.StartTime;
+
+    // Parse is the time that was not spent in any other phase, or in nested loads
+    double parseTime = record.LoadTime - load->NestedLoadTime
+        - record.Times[ResourceLoadPhase::Read] - record.Times[ResourceLoadPhase::Decompress] - record.Times[ResourceLoadPhase::Upload];
+    record.Times[ResourceLoadPhase::Parse] = parseTime > 0.0 ? parseTime : 0.0;
+
+    // Resume the phase of the load this one was nested in
+    ActiveLoad* parent = load->Parent;
+    if(parent != NULL)
+    {
+        parent->NestedLoadTime += record.LoadTime;
+        parent->PhaseStartTime = currentTime;
+    }
+    pthread_setspecific(activeLoadKey, parent);
+
+    if(Enabled == true)
+    {
+        mutex->Lock();
+        records.push_back(record);
+        mutex->Unlock();
+    }
+
+    GdkDelete(load);
+}
+
+// *****************************************************************
+/// @brief
+///     Adds to the byte count of a phase of the resource load in progress on the calling thread
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void ResourceLoadStats::AddBytes(ResourceLoadPhase::Enum phase, Int64 bytes)
+{
+    ActiveLoad* load = GetActiveLoad();
+    if(load != NULL)
+        load->Record.Bytes[phase] += bytes;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets a copy of the records of every load, in the order they finished
+// *****************************************************************
+void ResourceLoadStats::GetRecords(vector<ResourceLoadRecord>& records)
+{
+    mutex->Lock();
+    records = ResourceLoadStats::records;
+    mutex->Unlock();
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the totals of the loads of each resource type
+// *****************************************************************
+void ResourceLoadStats::GetTypeStats(vector<ResourceLoadTypeStats>& typeStats)
+{
+    typeStats.clear();
+
+    mutex->Lock();
+    for(vector<ResourceLoadRecord>::iterator iter = records.begin(); iter != records.end(); iter++)
+    {
+        const ResourceLoadRecord& record = *iter;
+
+        // Find the stats for this type  (There are only a handful of types)
+        size_t index = 0;
+        while(index < typeStats.size() && strcmp(typeStats[index].Type, record.Type) != 0)
+            index++;
+        if(index == typeStats.size())
+        {
+            ResourceLoadTypeStats stats;
+            memset(&stats, 0, sizeof(stats));
+            stats.Type = record.Type;
+            typeStats.push_back(stats);
+        }
+
+        ResourceLoadTypeStats& stats = typeStats[index];
+        stats.NumLoads++;
+        stats.TotalLoadTime += record.LoadTime;
+        if(record.LoadTime > stats.MaxLoadTime)
+            stats.MaxLoadTime = record.LoadTime;
+        for(int phase = 0; phase < ResourceLoadPhase::Count; phase++)
+        {
+            stats.Times[phase] += record.Times[phase];
+            stats.Bytes[phase] += record.Bytes[phase];
+        }
+    }
+    mutex->Unlock();
+}
+
+// *****************************************************************
+/// @brief
+///     Discards the records of all the loads so far
+// *****************************************************************
+void ResourceLoadStats::Clear()
+{
+    mutex->Lock();
+    records.clear();
+    mutex->Unlock();
+}
+
+// *****************************************************************
+/// @brief
+///     Writes the record of every load to a CSV file
+/// @remarks
+///     There is a row for each load, with the times in milliseconds.
+///     If the file can't be created, nothing is written.  (The error is logged)
+// *****************************************************************
+void ResourceLoadStats::WriteCSV(const char* filePath)
+{
+    vector<ResourceLoadRecord> records;
+    GetRecords(records);
+
+    FileStream* file = File::Create(filePath);
+    if(file == NULL)
+        return;
+
+    char line[512];
+    int length = GDK_SNPRINTF(line, sizeof(line),
+        "Name,Type,Async,StartMs,LoadMs,QueuedMs,ReadMs,DecompressMs,ParseMs,UploadMs,BytesRead,BytesDecompressed,BytesUploaded\n");
+    file->Write(line, length);
+
+    for(vector<ResourceLoadRecord>::iterator iter = records.begin(); iter != records.end(); iter++)
+    {
+        const ResourceLoadRecord& record = *iter;
+
+        // The name can be any length, so it is written on its own
+        WriteQuotedCSVField(file, record.Name.c_str());
+
+        length = GDK_SNPRINTF(line, sizeof(line),
+            ",%s,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%lld,%lld,%lld\n",
+            record.Type, record.Async ? 1 : 0,
+            record.StartTime * 1000.0, record.LoadTime * 1000.0,
+            record.Times[ResourceLoadPhase::Queued] * 1000.0, record.Times[ResourceLoadPhase::Read] * 1000.0,
+            record.Times[ResourceLoadPhase::Decompress] * 1000.0, record.Times[ResourceLoadPhase::Parse] * 1000.0,
+            record.Times[ResourceLoadPhase::Upload] * 1000.0,
+            (long long) record.Bytes[ResourceLoadPhase::Read], (long long) record.Bytes[ResourceLoadPhase::Decompress],
+            (long long) record.Bytes[ResourceLoadPhase::Upload]
+            );
+        if(length < 0 || length >= (int) sizeof(line))
+            length = (int) strlen(line);
+        file->Write(line, length);
+    }
+
+    file->Close();
+    GdkDelete(file);
+}
+
+// *****************************************************************
+/// @brief
+///     Writes the totals of each resource type to a CSV file
+/// @remarks
+///     There is a row for each type, with the times in milliseconds.
+///     If the file can't be created, nothing is written.  (The error is logged)
+// *****************************************************************
+void ResourceLoadStats::WriteTypeStatsCSV(const char* filePath)
+{
+    vector<ResourceLoadTypeStats> typeStats;
+    GetTypeStats(typeStats);
+
+    FileStream* file = File::Create(filePath);
+    if(file == NULL)
+        return;
+
+    char line[512];
+    int length = GDK_SNPRINTF(line, sizeof(line),
+        "Type,Loads,TotalMs,MaxMs,QueuedMs,ReadMs,DecompressMs,ParseMs,UploadMs,BytesRead,BytesDecompressed,BytesUploaded\n");
+    file->Write(line, length);
+
+    for(vector<ResourceLoadTypeStats>::iterator iter = typeStats.begin(); iter != typeStats.end(); iter++)
+    {
+        const ResourceLoadTypeStats& stats = *iter;
+        WriteQuotedCSVField(file, stats.Type);
+
+        length = GDK_SNPRINTF(line, sizeof(line),
+            ",%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%lld,%lld,%lld\n",
+            stats.NumLoads, stats.TotalLoadTime * 1000.0, stats.MaxLoadTime * 1000.0,
+            stats.Times[ResourceLoadPhase::Queued] * 1000.0, stats.Times[ResourceLoadPhase::Read] * 1000.0,
+            stats.Times[ResourceLoadPhase::Decompress] * 1000.0, stats.Times[ResourceLoadPhase::Parse] * 1000.0,
+            stats.Times[ResourceLoadPhase::Upload] * 1000.0,
+            (long long) stats.Bytes[ResourceLoadPhase::Read], (long long) stats.Bytes[ResourceLoadPhase::Decompress],
+            (long long) stats.Bytes[ResourceLoadPhase::Upload]
+            );
+        if(length < 0 || length >= (int) sizeof(line))
+            length = (int) strlen(line);
+        file->Write(line, length);
+    }
+
+    file->Close();
+    GdkDelete(file);
+}
+
+// *****************************************************************
+/// @brief
+///     Writes the totals of each resource type to the log
+// *****************************************************************
+void ResourceLoadStats::LogTypeStats()
+{
+    vector<ResourceLoadTypeStats> typeStats;
+    GetTypeStats(typeStats);
+
+    LOG_INFO("Resource loads (ms):");
+    for(vector<ResourceLoadTypeStats>::iterator iter = typeStats.begin(); iter != typeStats.end(); iter++)
+    {
+        const ResourceLoadTypeStats& stats = *iter;
+        LOG_INFO("  %-12s loads %4d  total %.1f  max %.1f  queued %.1f  read %.1f  decompress %.1f  parse %.1f  upload %.1f",
+            stats.Type, stats.NumLoads, stats.TotalLoadTime * 1000.0, stats.MaxLoadTime * 1000.0,
+            stats.Times[ResourceLoadPhase::Queued] * 1000.0, stats.Times[ResourceLoadPhase::Read] * 1000.0,
+            stats.Times[ResourceLoadPhase::Decompress] * 1000.0, stats.Times[ResourceLoadPhase::Parse] * 1000.0,
+            stats.Times[ResourceLoadPhase::Upload] * 1000.0
+            );
+    }
+}
+
+// *****************************************************************
+/// @brief
+///     Starts timing a phase of the load in progress on the calling thread
+/// @param phase
+///     The phase to time.  Any phase that was already being timed is paused until this timer ends.
+// *****************************************************************
+ResourceLoadTimer::ResourceLoadTimer(ResourceLoadPhase::Enum phase)
+{
+    load = ResourceLoadStats::GetActiveLoad();
+    if(load == NULL)
+        return;
+
+    double currentTime = HighResTimer::GetSeconds();
+    if(load->CurrentPhase >= 0)
+        load->Record.Times[load->CurrentPhase] += currentTime - load->PhaseStartTime;
+
+    previousPhase = load->CurrentPhase;
+    load->CurrentPhase = phase;
+    load->PhaseStartTime = currentTime;
+}
+
+// *****************************************************************
+/// @brief
+///     Stops timing the phase, & resumes timing the phase it interrupted
+// *****************************************************************
+ResourceLoadTimer::~ResourceLoadTimer()
+{
+    if(load == NULL)
+        return;
+
+    double currentTime = HighResTimer::GetSeconds();
+    load->Record.Times[load->CurrentPhase] += currentTime - load->PhaseStartTime;
+
+    load->CurrentPhase = previousPhase;
+    load->PhaseStartTime = currentTime;
+}
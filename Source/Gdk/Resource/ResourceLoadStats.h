@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+
+namespace Gdk
+{
+    class Resource;
+
+	/// @addtogroup Resources & Assets
+    /// @{
+
+	// =================================================================================
+    /// @brief
+    ///     Enumeration of the phases that the time of a resource load is split into
+	// =================================================================================
+	namespace ResourceLoadPhase
+	{
+		enum Enum
+		{
+            /// Waiting in the background work queue  (Async loads only)
+			Queued,
+
+            /// Opening the asset stream & reading from files
+			Read,
+
+            /// Decompressing asset data
+			Decompress,
+
+            /// Everything else the loader does  (Parsing the asset, building the resource, etc)
+			Parse,
+
+            /// Uploading data to GL  (Textures, vertex & index buffers, shader programs)
+			Upload,
+
+            /// Number of phases
+            Count
+		};
+
+		const char* ToString(ResourceLoadPhase::Enum phase);
+	}
+
+    // =================================================================================
+    ///	@brief
+    ///		Timings & byte counts of a single resource load
+    ///	@remarks
+    ///		All times are in seconds.  The Bytes of a phase are the bytes read, decompressed (output) or
+    ///     uploaded by that phase.
+    // =================================================================================
+    struct ResourceLoadRecord
+    {
+        string Name;
+        const char* Type;
+        bool Async;
+
+        /// HighResTimer time when the loader started  (After any time spent queued)
+        double StartTime;
+
+        /// Time from the start of the loader to its end.  (Excludes the queue time)
+        double LoadTime;
+
+        double Times[ResourceLoadPhase::Count];
+        Int64 Bytes[ResourceLoadPhase::Count];
+    };
+
+    // =================================================================================
+    ///	@brief
+    ///		Totals of the loads of a single resource type
+    // =================================================================================
+    struct ResourceLoadTypeStats
+    {
+        const char* Type;
+        int NumLoads;
+        double TotalLoadTime;
+        double MaxLoadTime;
+        double Times[ResourceLoadPhase::Count];
+        Int64 Bytes[ResourceLoadPhase::Count];
+    };
+
+    // =================================================================================
+    ///	@brief
+    ///		Records where the time of each resource load goes
+    ///	@remarks
+    ///		Each load done through a ResourceManager is timed, & its time split into the ResourceLoadPhase's.
+    ///     The phases are timed by ResourceLoadTimer's in the loaders & I/O code, on the thread doing the load.
+    ///     When phases nest (such as a file read during a decompress), the time goes to the inner phase.  The
+    ///     time of a resource loaded from within another load counts only towards the inner resource.
+    ///   @par
+    ///     Reads through memory mapped streams are page faults rather than calls, so they are counted by the
+    ///     phase that touched the memory.  Work a loader hands to other threads (such as the parallel
+    ///     decompression of a chunked image) is counted as the time the loader spent waiting for it.
+    ///   @par
+    ///     Use GetRecords() & GetTypeStats() to query the loads, or WriteCSV() & WriteTypeStatsCSV() to dump them.
+    // =================================================================================
+	class ResourceLoadStats
+	{
+	public:
+
+        // Public Properties
+		// =====================================================
+
+        /// Should resource loads be recorded?  (Default = false)
+        /// @remarks
+        ///     A record is kept for every load until Clear() is called, so leave this off unless the loads are being profiled.
+        static bool Enabled;
+
+        // Public Methods
+		// =====================================================
+
+        // ---------------------------------
+        /// @name Query Methods
+        /// @{
+
+        static void GetRecords(vector<ResourceLoadRecord>& records);
+        static void GetTypeStats(vector<ResourceLoadTypeStats>& typeStats);
+        static void Clear();
+
+        /// @}
+
+        // ---------------------------------
+        /// @name Output Methods
+        /// @{
+
+        static void WriteCSV(const char* filePath);
+        static void WriteTypeStatsCSV(const char* filePath);
+        static void LogTypeStats();
+
+        /// @}
+
+		// INTERNAL ONLY - Loader Interfaces
+		// =====================================================
+
+        /// @cond INTERNAL
+
+        // ---------------------------------
+        /// @name Internal Recording Methods
+        /// @{
+
+        static void BeginLoad(Resource* resource, const char* type, double queuedTime, bool async);
+        static void EndLoad();
+        static void AddBytes(ResourceLoadPhase::Enum phase, Int64 bytes);
+
+        /// @}
+
+        /// @endcond
+
+    private:
+
+        // Private Types
+		// =====================================================
+
+        // ***********************************************************************
+        struct ActiveLoad
+        {
+            ResourceLoadRecord Record;
+            int CurrentPhase;           // Phase being timed  (-1 = none)
+            double PhaseStartTime;
+            double NestedLoadTime;      // Time spent in loads done from within this one
+            ActiveLoad* Parent;         // The load this one was started from  (If any)
+        };
+
+        // Private Methods
+		// =====================================================
+
+        friend class Application;
+        friend class ResourceLoadTimer;
+
+        static void Init();
+        static void Shutdown();
+
+        static ActiveLoad* GetActiveLoad();
+
+        // Private Properties
+		// =====================================================
+
+        static vector<ResourceLoadRecord> records;
+        static Mutex* mutex;
+	};
+
+    // =================================================================================
+    ///	@brief
+    ///		Times a phase of the resource load in progress on the calling thread, for the life of the timer
+    ///	@remarks
+    ///		This does nothing if the calling thread is not loading a resource.
+    // =================================================================================
+    class ResourceLoadTimer
+    {
+    public:
+        ResourceLoadTimer(ResourceLoadPhase::Enum phase);
+        ~ResourceLoadTimer();
+
+    private:
+        ResourceLoadStats::ActiveLoad* load;
+        int previousPhase;
+    };
+
+    /// @}
+
+} // namespace
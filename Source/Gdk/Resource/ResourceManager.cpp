@@ -10,6 +10,7 @@ using namespace Gdk;
 
 // Static instantiations
 ResourceManager::BackgroundWorkQueue* ResourceManager::BGWorkQueue = NULL;
+int ResourceManager::numBGThreads = 0;
 
 // *****************************************************************
 /// @brief
@@ -21,6 +22,7 @@ void ResourceManager::Init(int numBackgroundThreads)
 {
     // Create the background work queue
     BGWorkQueue = GdkNew BackgroundWorkQueue(numBackgroundThreads);
+    numBGThreads = numBackgroundThreads;
     
     // Create the singleton resource managers
     Texture2DManager::singleton = GdkNew Texture2DManager();
@@ -28,6 +30,7 @@ void ResourceManager::Init(int numBackgroundThreads)
     AtlasManager::singleton = GdkNew AtlasManager();
     BMFontManager::singleton = GdkNew BMFontManager();
     ModelManager::singleton = GdkNew ModelManager();
+    AssetBundleManager::singleton = GdkNew AssetBundleManager();
 }
 
 // *****************************************************************
@@ -42,6 +45,7 @@ void ResourceManager::Shutdown()
     GdkDelete( BGWorkQueue );
     
     // Destroy the singleton resource managers
+    GdkDelete( AssetBundleManager::singleton );
     GdkDelete( ModelManager::singleton );
     GdkDelete( BMFontManager::singleton );
     GdkDelete( AtlasManager::singleton );
@@ -56,7 +60,7 @@ void ResourceManager::Shutdown()
 ResourceManager::ResourceManager()
 {
     // Create the thread sync objects
-    resourceMapMutex = Mutex::Create();
+    resourceMapMutex = Mutex::Create("ResourceMap");
 }
 
 // *****************************************************************
@@ -285,7 +289,10 @@ Resource* ResourceManager::LoadUtility(const char *name, bool async, int asyncPr
     else
     {
         // Do the load now
+        GDK_PROFILE_SCOPE_DETAIL("Resource Load", resource->GetName().c_str());
+        ResourceLoadStats::BeginLoad(resource, GetResourceTypeName(), 0.0, false);
         (*loadFunction)( resource );
+        ResourceLoadStats::EndLoad();
     }
     
     return resource;
@@ -303,7 +310,195 @@ Resource* ResourceManager::LoadUtility(const char *name, bool async, int asyncPr
 // *****************************************************************
 void ResourceManager::QueueBackgroundTask(Resource* resource, int asyncPriority, void (*loadFunction)(Resource*))
 {
-    BGWorkQueue->Enqueue(BackgroundWorkItem(resource, loadFunction), asyncPriority);
+    BGWorkQueue->Enqueue(BackgroundWorkItem(resource, loadFunction, GetResourceTypeName()), asyncPriority);
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the name of the type of resource this manager loads
+/// @remarks
+///     The ResourceLoadStats group loads by this name.  Derived managers override this.
+// *****************************************************************
+const char* ResourceManager::GetResourceTypeName()
+{
+    return "Resource";
+}
+
+// *****************************************************************
+/// @brief
+///     Queues up a background task that takes an additional context argument
+/// @param resource
+///     A resource to be passed to the work method
+/// @param asyncPriority
+///     Priority level of the queue'd work.  Higher priority items are processed first
+/// @param taskFunction
+///     A worker method that will be called with the resource & context
+/// @param context
+///     Caller defined data that is passed through to the worker method
+// *****************************************************************
+void ResourceManager::QueueBackgroundTask(Resource* resource, int asyncPriority, void (*taskFunction)(Resource*, void*), void* context)
+{
+    BGWorkQueue->Enqueue(BackgroundWorkItem(resource, taskFunction, context), asyncPriority);
+}
+
+// *****************************************************************
+/// @brief
+///     Runs a set of independent tasks in parallel, on the calling thread & the background threads
+/// @param resource
+///     A resource to be passed to the task method
+/// @param numTasks
+///     Number of tasks to run.  The task method is called once for each index from 0 to numTasks-1
+/// @param taskFunction
+///     A worker method that will be called with the resource, context & task index
+/// @param context
+///     Caller defined data that is passed through to the task method
+/// @remarks
+///     This is meant for loaders that can split the decoding of a single large asset into pieces,
+///     (such as the bands of a chunked .gdkimage).  The calling thread works through the tasks itself, while
+///     helpers queued on the background threads take tasks alongside it.  The method returns once every task
+///     is complete.
+///   @par
+///     As the calling thread never waits on a task that has not been started, this is safe to call from a 
+///     background thread, even when every other background thread is busy.
+// *****************************************************************
+void ResourceManager::RunParallelTasks(Resource* resource, int numTasks, void (*taskFunction)(Resource*, void*, int), void* context)
+{
+    // Without background threads (or with a single task), just run the tasks here
+    int numHelpers = numTasks - 1;
+    if(numHelpers > numBGThreads)
+        numHelpers = numBGThreads;
+    if(numHelpers <= 0)
+    {
+        for(int taskIndex = 0; taskIndex < numTasks; taskIndex++)
+            (*taskFunction)(resource, context, taskIndex);
+        return;
+    }
+    
+    // Create the task group  (Referenced by this thread & each of the helpers)
+    ParallelTaskGroup* group = GdkNew ParallelTaskGroup();
+    group->Res = resource;
+    group->TaskFunction = taskFunction;
+    group->Context = context;
+    group->NumTasks = numTasks;
+    group->NextTask = 0;
+    group->TasksDone = 0;
+    group->RefCount = numHelpers + 1;
+    group->GroupMutex = Mutex::Create("ParallelTaskGroup");
+    group->DoneEvent = Event::Create();
+    
+    // Queue the helpers, ahead of any other background work
+    for(int helperIndex = 0; helperIndex < numHelpers; helperIndex++)
+        BGWorkQueue->Enqueue(BackgroundWorkItem(resource, &ResourceManager::PerformParallelTasks, group), SHRT_MAX);
+    
+    // Work through the tasks on this thread, then wait for any the helpers are still running
+    RunTasksFromGroup(group);
+    group->DoneEvent->Wait(false);
+    
+    ReleaseTaskGroup(group);
+}
+
+// *****************************************************************
+/// @brief
+///     Background worker for the helpers of RunParallelTasks()
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void ResourceManager::PerformParallelTasks(Resource* resource, void* context)
+{
+    ParallelTaskGroup* group = (ParallelTaskGroup*) context;
+    
+    RunTasksFromGroup(group);
+    ReleaseTaskGroup(group);
+}
+
+// *****************************************************************
+/// @brief
+///     Takes & runs tasks from a parallel task group, until there are none left to start
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void ResourceManager::RunTasksFromGroup(ParallelTaskGroup* group)
+{
+    while(true)
+    {
+        // Take the next task
+        group->GroupMutex->Lock();
+        int taskIndex = group->NextTask++;
+        group->GroupMutex->Unlock();
+        
+        if(taskIndex >= group->NumTasks)
+            return;
+        
+        (*(group->TaskFunction))(group->Res, group->Context, taskIndex);
+        
+        // Signal the group once the last task is done
+        group->GroupMutex->Lock();
+        bool allDone = (++group->TasksDone == group->NumTasks);
+        group->GroupMutex->Unlock();
+        
+        if(allDone)
+            group->DoneEvent->Set();
+    }
+}
+
+// *****************************************************************
+/// @brief
+///     Releases a reference to a parallel task group, & deletes it with the last reference
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void ResourceManager::ReleaseTaskGroup(ParallelTaskGroup* group)
+{
+    group->GroupMutex->Lock();
+    bool lastReference = (--group->RefCount == 0);
+    group->GroupMutex->Unlock();
+    
+    if(lastReference)
+    {
+        GdkDelete( group->DoneEvent );
+        GdkDelete( group->GroupMutex );
+        GdkDelete( group );
+    }
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the number of background threads that load resources & run the parallel tasks of loaders
+// *****************************************************************
+int ResourceManager::GetBackgroundThreadCount()
+{
+    return numBGThreads;
+}
+
+// *****************************************************************
+/// @brief
+///     Changes the number of background threads that load resources & run the parallel tasks of loaders
+/// @param numBackgroundThreads
+///     The new number of background threads.  With 0, every load is done on the calling thread.
+/// @remarks
+///     The existing threads are joined & replaced.  Any work still queued on them is dropped, so
+///     this must only be called while no resources are loading asyncronously.
+// *****************************************************************
+void ResourceManager::SetBackgroundThreadCount(int numBackgroundThreads)
+{
+    if(numBackgroundThreads == numBGThreads)
+        return;
+    
+    GdkDelete( BGWorkQueue );
+    BGWorkQueue = GdkNew BackgroundWorkQueue(numBackgroundThreads);
+    numBGThreads = numBackgroundThreads;
+}
+
+// *****************************************************************
+/// @brief
+///     Checks if the background work queue has any threads to process queued tasks
+/// @remarks
+///     When ApplicationSettings::ResourceLoaderBackgroundThreads is 0, queued tasks are
+///     never processed, so managers must do their work on the calling thread instead.
+// *****************************************************************
+bool ResourceManager::HasBackgroundThreads()
+{
+    return numBGThreads > 0;
 }
                          
                          
@@ -50,6 +50,17 @@ namespace Gdk
         size_t GetTotalMemoryUsed();
         
         /// @}
+        
+        // -----------------------------------
+        /// @name Loader Utility Methods 
+        /// @{
+        
+        static void RunParallelTasks(Resource* resource, int numTasks, void (*taskFunction)(Resource*, void*, int), void* context);
+        
+        static int GetBackgroundThreadCount();
+        static void SetBackgroundThreadCount(int numBackgroundThreads);
+        
+        /// @}
                   
     protected:
         
@@ -69,10 +80,15 @@ namespace Gdk
         
         Resource* LoadUtility(const char *name, bool async, int asyncPriority, void (*loadFunction)(Resource*));
         void QueueBackgroundTask(Resource* resource, int asyncPriority, void (*loadFunction)(Resource*));
+        void QueueBackgroundTask(Resource* resource, int asyncPriority, void (*taskFunction)(Resource*, void*), void* context);
+        bool HasBackgroundThreads();
         
         // Derived managers must implement this, and it must return a new RESOURCETYPE* 
         virtual Resource* OnCreateNewResourceInstance() = 0;
         
+        // Name of the resource type, for the ResourceLoadStats  (Must be a string literal)
+        virtual const char* GetResourceTypeName();
+        
     private:
         
         // Private Types
@@ -83,13 +99,30 @@ namespace Gdk
         {
         public:
             void (*WorkerFunction)(Resource*);
+            void (*ContextWorkerFunction)(Resource*, void*);
             Resource* Res;
+            void* Context;
+            const char* TypeName;       // Resource type, for the ResourceLoadStats of WorkerFunction loads
+            double QueueTime;           // HighResTimer time when the item was queued
             
             BackgroundWorkItem() {}
-            BackgroundWorkItem(Resource* resource, void (*workerFunction)(Resource*)) 
+            BackgroundWorkItem(Resource* resource, void (*workerFunction)(Resource*), const char* typeName) 
             { 
                 Res = resource;
                 WorkerFunction = workerFunction; 
+                ContextWorkerFunction = NULL;
+                Context = NULL;
+                TypeName = typeName;
+                QueueTime = HighResTimer::GetSeconds();
+            }
+            BackgroundWorkItem(Resource* resource, void (*contextWorkerFunction)(Resource*, void*), void* context) 
+            { 
+                Res = resource;
+                WorkerFunction = NULL;
+                ContextWorkerFunction = contextWorkerFunction; 
+                Context = context;
+                TypeName = NULL;
+                QueueTime = HighResTimer::GetSeconds();
             }
         };
         
@@ -98,15 +131,38 @@ namespace Gdk
         class BackgroundWorkQueue : public ThreadedWorkQueue<BackgroundWorkItem>
         {
         public:
-            BackgroundWorkQueue(int numThreads) : ThreadedWorkQueue<BackgroundWorkItem>(numThreads)  {}
+            BackgroundWorkQueue(int numThreads) : ThreadedWorkQueue<BackgroundWorkItem>(numThreads, "ResourceManager")  {}
             
         protected:
             virtual void OnProcessWorkItem(BackgroundWorkItem item)
             {
-                (*(item.WorkerFunction))(item.Res);
+                GDK_PROFILE_SCOPE_DETAIL("Resource Load", item.Res->GetName().c_str());
+                if(item.ContextWorkerFunction != NULL)
+                    (*(item.ContextWorkerFunction))(item.Res, item.Context);
+                else
+                {
+                    ResourceLoadStats::BeginLoad(item.Res, item.TypeName, HighResTimer::GetSeconds() - item.QueueTime, true);
+                    (*(item.WorkerFunction))(item.Res);
+                    ResourceLoadStats::EndLoad();
+                }
             }
         };
 
+        // ***********************************************************************
+        struct ParallelTaskGroup
+        {
+            Resource* Res;
+            void (*TaskFunction)(Resource*, void*, int);
+            void* Context;
+            
+            int NumTasks;
+            int NextTask;
+            int TasksDone;
+            int RefCount;
+            
+            Mutex* GroupMutex;
+            Event* DoneEvent;
+        };
         
         // Private Properties
 		// ================================
@@ -119,6 +175,7 @@ namespace Gdk
         
         // Static background work queue
         static BackgroundWorkQueue* BGWorkQueue;
+        static int numBGThreads;
         
         // Private Methods
 		// ================================
@@ -126,6 +183,11 @@ namespace Gdk
         // Removes the resource from this resource manager
         void RemoveResource(Resource* resource);
         
+        // Parallel task helpers
+        static void PerformParallelTasks(Resource* resource, void* context);
+        static void RunTasksFromGroup(ParallelTaskGroup* group);
+        static void ReleaseTaskGroup(ParallelTaskGroup* group);
+        
 		// Application Interface        
 		static void Init(int numBackgroundThreads);
 		static void Shutdown();
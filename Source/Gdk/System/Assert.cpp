@@ -30,7 +30,8 @@ void Gdk::Assert(bool condition, const char* file, int line, const char* format,
 	va_end (args);
 
 	// Log the assertion
-	Gdk::Log::Write(LogLevel::Assert, file, line, assertMessage);
+	Gdk::Log::Write(LogLevel::Assert, file, line, "%s", assertMessage);
+	Gdk::Log::Flush();
 
 #ifdef GDKPLATFORM_WINDOWS
 
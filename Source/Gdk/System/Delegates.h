@@ -466,7 +466,7 @@ namespace Gdk
         // *****************************************************************
         Delegate* AddHandlerFunction(TReturn (*function)())
         {
-			Delegate* del = Delegate::FromFunction(&function);
+			Delegate* del = Delegate::FromFunction(function);
             AddHandler(del);
 			return del;
         }
@@ -901,7 +901,7 @@ namespace Gdk
         // *****************************************************************
         Delegate* AddHandlerFunction(TReturn (*function)(TParam1))
         {
-			Delegate* del = Delegate::FromFunction(&function);
+			Delegate* del = Delegate::FromFunction(function);
             AddHandler(del);
 			return del;
         }
@@ -1351,7 +1351,7 @@ namespace Gdk
         // *****************************************************************
         Delegate* AddHandlerFunction(TReturn (*function)(TParam1, TParam2))
         {
-			Delegate* del = Delegate::FromFunction(&function);
+			Delegate* del = Delegate::FromFunction(function);
             AddHandler(del);
 			return del;
         }
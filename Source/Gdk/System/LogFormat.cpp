@@ -0,0 +1,455 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "BasePCH.h"
+#include "LogFormat.h"
+
+using namespace Gdk;
+
+// ***********************************************************************
+// A single conversion of a format string, such as "%-8.3lld"
+struct FormatSpec
+{
+    const char* Start;      // The '%'
+    const char* End;        // Just past the conversion character
+    int NumStars;           // '*' widths & precisions, which each take an int argument
+    int ArgType;            // LogArgType of the argument  (-1 = no argument, such as "%%")
+    char Conversion;
+};
+
+// *****************************************************************
+/// @brief
+///     Reads the conversion spec that starts at the given '%'
+/// @remarks
+///     Wide strings & characters, & %n, are treated as pointers.
+// *****************************************************************
+static void ReadFormatSpec(const char* start, FormatSpec& spec)
+{
+    spec.Start = start;
+    spec.NumStars = 0;
+    spec.ArgType = -1;
+    spec.Conversion = 0;
+
+    const char* c = start + 1;
+    if(*c == '%')
+    {
+        spec.Conversion = '%';
+        spec.End = c + 1;
+        return;
+    }
+
+    // Flags, width & precision
+    while(*c != 0 && strchr("-+ #0'", *c) != NULL)
+        c++;
+    while(*c == '*' || (*c >= '0' && *c <= '9') || *c == '.')
+    {
+        if(*c == '*')
+            spec.NumStars++;
+        c++;
+    }
+
+    // Length modifier
+    int length = LogArgType::Int;
+    bool isLong = false;
+    bool isLongDouble = false;
+    if(c[0] == 'h')
+    {
+        c += (c[1] == 'h') ? 2 : 1;
+    }
+    else if(c[0] == 'l' && c[1] == 'l')
+    {
+        length = LogArgType::LongLong;
+        c += 2;
+    }
+    else if(c[0] == 'l')
+    {
+        length = LogArgType::Long;
+        isLong = true;
+        c++;
+    }
+    else if(c[0] == 'q' || c[0] == 'j' || (c[0] == 'I' && c[1] == '6' && c[2] == '4'))
+    {
+        length = LogArgType::LongLong;
+        c += (c[0] == 'I') ? 3 : 1;
+    }
+    else if(c[0] == 'I' && c[1] == '3' && c[2] == '2')
+    {
+        c += 3;
+    }
+    else if(c[0] == 'z' || c[0] == 't' || c[0] == 'I')
+    {
+        length = LogArgType::Size;
+        c++;
+    }
+    else if(c[0] == 'L')
+    {
+        isLongDouble = true;
+        c++;
+    }
+
+    // Conversion
+    spec.Conversion = *c;
+    switch(*c)
+    {
+        case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+            spec.ArgType = length;
+            break;
+
+        case 'c':
+            spec.ArgType = LogArgType::Int;
+            break;
+
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            spec.ArgType = isLongDouble ? LogArgType::LongDouble : LogArgType::Double;
+            break;
+
+        case 's':
+            spec.ArgType = isLong ? LogArgType::Pointer : LogArgType::String;
+            break;
+
+        case 'C':
+            spec.ArgType = LogArgType::Int;
+            break;
+
+        case 'p': case 'n': case 'S':
+            spec.ArgType = LogArgType::Pointer;
+            break;
+
+        default:
+            // Not a conversion we know, so treat the spec as plain text
+            spec.NumStars = 0;
+            spec.Conversion = 0;
+            if(*c == 0)
+            {
+                spec.End = c;
+                return;
+            }
+            break;
+    }
+    spec.End = c + 1;
+}
+
+// *****************************************************************
+/// @brief
+///     Parses the format string for the types of its arguments
+/// @return
+///     The number of arguments
+/// @remarks
+///     Arguments past LOGFORMAT_MAX_ARGS are not logged.  It is safe for several threads to parse the
+///     same format at once.
+// *****************************************************************
+int LogFormat::Parse()
+{
+    int numArgs = 0;
+    for(const char* c = Format; *c != 0; )
+    {
+        if(*c != '%')
+        {
+            c++;
+            continue;
+        }
+
+        FormatSpec spec;
+        ReadFormatSpec(c, spec);
+        c = spec.End;
+
+        if(spec.ArgType < 0)
+            continue;
+        for(int star = 0; star < spec.NumStars && numArgs < LOGFORMAT_MAX_ARGS; star++)
+            ArgTypes[numArgs++] = LogArgType::Int;
+        if(numArgs < LOGFORMAT_MAX_ARGS)
+            ArgTypes[numArgs++] = (UInt8) spec.ArgType;
+    }
+
+    // Publish the argument count only after the types
+    GDK_MEMORY_BARRIER();
+    NumArgs = numArgs;
+
+    return numArgs;
+}
+
+// *****************************************************************
+/// @brief
+///     Copies the arguments of a message into a payload
+/// @param payload
+///     Buffer for the encoded arguments
+/// @param payloadSize
+///     Size of the payload buffer.  Arguments that don't fit are dropped.
+/// @param args
+///     The arguments, which must match the format
+/// @return
+///     Number of bytes written to the payload
+// *****************************************************************
+int LogFormat::EncodeArgs(UInt8* payload, int payloadSize, va_list args)
+{
+    UInt8* out = payload;
+    UInt8* end = payload + payloadSize;
+
+    for(int argIndex = 0; argIndex < NumArgs; argIndex++)
+    {
+        if(end - out < 8)
+            break;
+
+        switch(ArgTypes[argIndex])
+        {
+            case LogArgType::Int:
+            {
+                Int32 value = va_arg(args, int);
+                memcpy(out, &value, 4);
+                out += 4;
+                break;
+            }
+            case LogArgType::Long:
+            {
+                Int64 value = va_arg(args, long);
+                memcpy(out, &value, 8);
+                out += 8;
+                break;
+            }
+            case LogArgType::LongLong:
+            {
+                Int64 value = va_arg(args, Int64);
+                memcpy(out, &value, 8);
+                out += 8;
+                break;
+            }
+            case LogArgType::Size:
+            {
+                Int64 value = (Int64) va_arg(args, size_t);
+                memcpy(out, &value, 8);
+                out += 8;
+                break;
+            }
+            case LogArgType::Double:
+            {
+                double value = va_arg(args, double);
+                memcpy(out, &value, 8);
+                out += 8;
+                break;
+            }
+            case LogArgType::LongDouble:
+            {
+                double value = (double) va_arg(args, long double);
+                memcpy(out, &value, 8);
+                out += 8;
+                break;
+            }
+            case LogArgType::Pointer:
+            {
+                UInt64 value = (UInt64)(size_t) va_arg(args, void*);
+                memcpy(out, &value, 8);
+                out += 8;
+                break;
+            }
+            case LogArgType::String:
+            {
+                const char* value = va_arg(args, const char*);
+                if(value == NULL)
+                    value = "(null)";
+                size_t length = strlen(value);
+                if(length > LOGFORMAT_MAX_STRING)
+                    length = LOGFORMAT_MAX_STRING;
+                if((size_t)(end - out) < 2 + length)
+                    length = (end - out) - 2;
+
+                UInt16 storedLength = (UInt16) length;
+                memcpy(out, &storedLength, 2);
+                memcpy(out + 2, value, length);
+                out += 2 + length;
+                break;
+            }
+        }
+    }
+
+    return (int)(out - payload);
+}
+
+// *****************************************************************
+/// @brief
+///     Appends a single formatted argument to a text buffer
+// *****************************************************************
+template <typename T>
+static void AppendArg(char*& text, char* textEnd, const char* spec, T value)
+{
+    int room = (int)(textEnd - text);
+    if(room <= 1)
+        return;
+
+    int written = GDK_SNPRINTF(text, room, spec, value);
+    if(written < 0 || written >= room)
+        written = room - 1;
+    text += written;
+}
+
+// *****************************************************************
+/// @brief
+///     Formats a message from the format string & its encoded arguments
+/// @param text
+///     Buffer for the formatted message.  Long messages are truncated.
+/// @param textSize
+///     Size of the text buffer
+/// @param payload
+///     The arguments, as encoded by EncodeArgs()
+/// @param payloadSize
+///     Size of the encoded arguments
+/// @return
+///     Length of the formatted message  (Not including the null terminator)
+/// @remarks
+///     Each conversion is formatted on its own, so this is portable to any platform's printf.  Any
+///     conversions without an argument in the payload are copied as they are.
+// *****************************************************************
+int LogFormat::FormatArgs(char* text, int textSize, const UInt8* payload, int payloadSize) const
+{
+    char* out = text;
+    char* outEnd = text + textSize;
+    const UInt8* in = payload;
+    const UInt8* inEnd = payload + payloadSize;
+    int argIndex = 0;
+
+    for(const char* c = Format; *c != 0 && outEnd - out > 1; )
+    {
+        // Copy plain text
+        if(*c != '%')
+        {
+            *out++ = *c++;
+            continue;
+        }
+
+        FormatSpec spec;
+        ReadFormatSpec(c, spec);
+        c = spec.End;
+
+        // "%%", & specs that are not conversions
+        if(spec.ArgType < 0)
+        {
+            if(spec.Conversion == '%')
+                *out++ = '%';
+            else
+                for(const char* s = spec.Start; s < spec.End && outEnd - out > 1; s++)
+                    *out++ = *s;
+            continue;
+        }
+
+        // Build the spec on its own, with the values of any '*'s filled in
+        char specText[64];
+        int specLength = 0;
+        bool missingArg = false;
+        for(const char* s = spec.Start; s < spec.End && specLength < (int) sizeof(specText) - 12; s++)
+        {
+            if(*s != '*')
+            {
+                specText[specLength++] = *s;
+                continue;
+            }
+
+            Int32 starValue = 0;
+            if(argIndex < NumArgs && inEnd - in >= 4)
+            {
+                memcpy(&starValue, in, 4);
+                in += 4;
+                argIndex++;
+            }
+            else
+            {
+                missingArg = true;
+            }
+            specLength += GDK_SNPRINTF(specText + specLength, 12, "%d", (int) starValue);
+        }
+        specText[specLength] = 0;
+
+        // Is the argument missing from the payload?
+        int argSize = (spec.ArgType == LogArgType::Int) ? 4 : (spec.ArgType == LogArgType::String ? 2 : 8);
+        if(missingArg || argIndex >= NumArgs || inEnd - in < argSize)
+        {
+            for(const char* s = spec.Start; s < spec.End && outEnd - out > 1; s++)
+                *out++ = *s;
+            continue;
+        }
+        argIndex++;
+
+        switch(spec.ArgType)
+        {
+            case LogArgType::Int:
+            {
+                Int32 value;
+                memcpy(&value, in, 4);
+                in += 4;
+                AppendArg(out, outEnd, specText, (int) value);
+                break;
+            }
+            case LogArgType::Long:
+            {
+                Int64 value;
+                memcpy(&value, in, 8);
+                in += 8;
+                AppendArg(out, outEnd, specText, (long) value);
+                break;
+            }
+            case LogArgType::LongLong:
+            {
+                Int64 value;
+                memcpy(&value, in, 8);
+                in += 8;
+                AppendArg(out, outEnd, specText, value);
+                break;
+            }
+            case LogArgType::Size:
+            {
+                Int64 value;
+                memcpy(&value, in, 8);
+                in += 8;
+                AppendArg(out, outEnd, specText, (size_t) value);
+                break;
+            }
+            case LogArgType::Double:
+            {
+                double value;
+                memcpy(&value, in, 8);
+                in += 8;
+                AppendArg(out, outEnd, specText, value);
+                break;
+            }
+            case LogArgType::LongDouble:
+            {
+                double value;
+                memcpy(&value, in, 8);
+                in += 8;
+                AppendArg(out, outEnd, specText, (long double) value);
+                break;
+            }
+            case LogArgType::Pointer:
+            {
+                UInt64 value;
+                memcpy(&value, in, 8);
+                in += 8;
+
+                // Wide strings & %n are shown as the pointer
+                if(spec.Conversion == 'p')
+                    AppendArg(out, outEnd, specText, (void*)(size_t) value);
+                else
+                    AppendArg(out, outEnd, "%p", (void*)(size_t) value);
+                break;
+            }
+            case LogArgType::String:
+            {
+                UInt16 length;
+                memcpy(&length, in, 2);
+                in += 2;
+                if(length > inEnd - in)
+                    length = (UInt16)(inEnd - in);
+
+                char value[LOGFORMAT_MAX_STRING + 1];
+                memcpy(value, in, length);
+                value[length] = 0;
+                in += length;
+                AppendArg(out, outEnd, specText, (const char*) value);
+                break;
+            }
+        }
+    }
+
+    *out = 0;
+    return (int)(out - text);
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+
+// Most arguments a deferred log message can have
+#define LOGFORMAT_MAX_ARGS          16
+
+// Longest string argument kept by a deferred log message  (Longer strings are truncated)
+#define LOGFORMAT_MAX_STRING        255
+
+namespace Gdk
+{
+    /// @addtogroup System
+    /// @{
+
+	// =================================================================================
+    /// @brief
+    ///     Enumeration of the argument types of a deferred log message
+    /// @remarks
+    ///     The values are stored in binary logs, so they must not change.
+	// =================================================================================
+	namespace LogArgType
+	{
+		enum Enum
+		{
+            /// int, char or short  (Stored as 4 bytes)
+			Int = 0,
+
+            /// long  (Stored as 8 bytes)
+			Long = 1,
+
+            /// long long, intmax_t  (Stored as 8 bytes)
+			LongLong = 2,
+
+            /// size_t, ptrdiff_t  (Stored as 8 bytes)
+			Size = 3,
+
+            /// float or double  (Stored as an 8 byte double)
+			Double = 4,
+
+            /// long double  (Stored as an 8 byte double)
+			LongDouble = 5,
+
+            /// Any pointer  (Stored as 8 bytes)
+			Pointer = 6,
+
+            /// A char* string  (Stored as a 2 byte length & the characters, up to LOGFORMAT_MAX_STRING)
+			String = 7
+		};
+	}
+
+    // =================================================================================
+    ///	@brief
+    ///		The format string of a deferred log message, & the types of its arguments
+    ///	@remarks
+    ///		The LOG_DEFERRED macros keep a static LogFormat for each call site.  The format string is parsed
+    ///     for its argument types the first time the site logs, so later messages only copy the raw
+    ///     arguments into the log, without formatting them.
+    ///   @par
+    ///     The arguments are encoded in the same way in the log buffers & in binary log files.  Wide
+    ///     strings (%ls) are not supported, and are logged as pointers.
+    // =================================================================================
+    struct LogFormat
+    {
+        // Public Properties
+		// =====================================================
+
+        /// The printf style format string  (Must be a string literal)
+        const char* Format;
+
+        /// Number of arguments the format takes  (-1 = not parsed yet)
+        volatile int NumArgs;
+
+        /// The LogArgType of each argument
+        UInt8 ArgTypes[LOGFORMAT_MAX_ARGS];
+
+        // Public Methods
+		// =====================================================
+
+        // ---------------------------------
+        /// @name Methods
+        /// @{
+
+        int Parse();
+        int EncodeArgs(UInt8* payload, int payloadSize, va_list args);
+        int FormatArgs(char* text, int textSize, const UInt8* payload, int payloadSize) const;
+
+        /// @}
+    };
+
+    /// @}
+
+} // namespace Gdk
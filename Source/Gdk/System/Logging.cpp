@@ -1,4 +1,4 @@
-/* 
+/*
  * Copyright (c) 2011, Raincity Games LLC
  * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
  */
@@ -9,18 +9,97 @@
 #include "../IO/Path.h"
 #include "Threading/CriticalSection.h"
 
+#ifdef GDKPLATFORM_WINDOWS
+    #include <io.h>
+#else
+    #include <signal.h>
+    #include <unistd.h>
+#endif
+
 using namespace Gdk;
 
+// Size of each thread's message ring buffer  (Must be a power of 2)
+#define LOG_THREAD_BUFFER_SIZE      (64 * 1024)
+
+// Largest message that can be logged, including the time, level, file & line
+#define LOG_MAX_MESSAGE_SIZE        4096
+
+// Milliseconds the writer thread sleeps between batches
+#define LOG_WRITER_INTERVAL         15
+
 // Static properties
 bool Log::Enabled = true;
 LogLevel::Enum Log::MaxLevel = LogLevel::Verbose;
 string Log::logFilePath;
-char* Log::msgBuffer = NULL;
+FILE* Log::logFile = NULL;
+vector<Log::ThreadBuffer*> Log::threadBuffers;
+Mutex* Log::threadBuffersMutex = NULL;
+Mutex* Log::drainMutex = NULL;
+Thread* Log::writerThread = NULL;
+volatile bool Log::writerRunning = false;
+vector<Log::PendingMessage> Log::batch;
+vector<char> Log::batchText;
+bool Log::WriteBinaryLog = false;
+FILE* Log::binaryLogFile = NULL;
+map<const LogFormat*, UInt32> Log::binaryFormatIds;
+
+// Thread local slot holding each thread's ThreadBuffer
+static pthread_key_t logThreadBufferKey;
+
+// Crash handler state.  (The handlers only use these, as nothing else is safe to touch from them)
+static int crashLogFileDescriptor = -1;
+static bool crashHandlersInstalled = false;
+static volatile bool crashWritten = false;
+#ifdef GDKPLATFORM_WINDOWS
+static LPTOP_LEVEL_EXCEPTION_FILTER previousCrashFilter = NULL;
+#else
+static const int crashSignals[] = { SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT };
+#define LOG_NUM_CRASH_SIGNALS       ((int)(sizeof(crashSignals) / sizeof(int)))
+static struct sigaction previousCrashActions[LOG_NUM_CRASH_SIGNALS];
+#endif
+
+// *****************************************************************
+/// @brief
+///     Copies bytes into a ring buffer, wrapping around the end
+// *****************************************************************
+static void CopyToRing(char* ring, UInt32 position, const void* source, UInt32 size)
+{
+    UInt32 offset = position & (LOG_THREAD_BUFFER_SIZE - 1);
+    UInt32 firstPart = LOG_THREAD_BUFFER_SIZE - offset;
+    if(firstPart >= size)
+    {
+        memcpy(ring + offset, source, size);
+    }
+    else
+    {
+        memcpy(ring + offset, source, firstPart);
+        memcpy(ring, (const char*)source + firstPart, size - firstPart);
+    }
+}
+
+// *****************************************************************
+/// @brief
+///     Copies bytes out of a ring buffer, wrapping around the end
+// *****************************************************************
+static void CopyFromRing(const char* ring, UInt32 position, void* destination, UInt32 size)
+{
+    UInt32 offset = position & (LOG_THREAD_BUFFER_SIZE - 1);
+    UInt32 firstPart = LOG_THREAD_BUFFER_SIZE - offset;
+    if(firstPart >= size)
+    {
+        memcpy(destination, ring + offset, size);
+    }
+    else
+    {
+        memcpy(destination, ring + offset, firstPart);
+        memcpy((char*)destination + firstPart, ring, size - firstPart);
+    }
+}
 
 // *****************************************************************
 const char* LogLevel::ToString(LogLevel::Enum logLevel)
 {
-	static const char* logLevelNames[] = 
+	static const char* logLevelNames[] =
 	{
 		"System ",
 		"ASSERT ",
@@ -33,10 +112,10 @@ const char* LogLevel::ToString(LogLevel::Enum logLevel)
 }
 
 // *****************************************************************
-/// @brief 
+/// @brief
 ///     Writes a log message to the GDK log
-/// @remarks 
-///     For simplicity, use the LOG_ macros.  
+/// @remarks
+///     For simplicity, use the LOG_ macros.
 /// @param logLevel
 ///     The level of the log message
 /// @param file
@@ -53,101 +132,702 @@ void Log::Write(LogLevel::Enum logLevel, const char* file, int line, const char
 	// Is logging disabled?
 	if(Log::Enabled == false)
 		return;
-	
+
 	// Are we ignoring this log level
 	if((int)logLevel > (int)Log::MaxLevel)
 		return;
-	
+
+	// Format the message on this thread
+	char message[LOG_MAX_MESSAGE_SIZE];
+	va_list args;
+	va_start (args, format);
+	int length = FormatLogMessageV(message, LOG_MAX_MESSAGE_SIZE, logLevel, file, line, format, args);
+	va_end (args);
+
+	// Without the writer thread (before Init or after Shutdown), write the message right away
+	if(writerRunning == false)
+	{
+		WriteImmediate(logLevel, message);
+		return;
+	}
+
+	QueueRecord(logLevel, false, message, length + 1);
+}
+
+// *****************************************************************
+/// @brief
+///     Writes a log message to the GDK log, deferring the formatting to the log writer thread
+/// @remarks
+///     Use the LOG_DEFERRED_ macros, which keep the LogFormat of each call site.
+/// @param logLevel
+///     The level of the log message
+/// @param format
+///     The format of the message
+/// @param ...
+///     Insertion values for the format string
+// *****************************************************************
+void Log::WriteDeferred(LogLevel::Enum logLevel, LogFormat* format, ...)
+{
+	if(Log::Enabled == false || (int)logLevel > (int)Log::MaxLevel)
+		return;
+
+	// Get the argument types, parsing the format the first time through
+	if(format->NumArgs < 0)
+		format->Parse();
+	GDK_MEMORY_BARRIER();
+
+	// Copy the raw arguments, after the format pointer
+	UInt8 payload[LOG_MAX_MESSAGE_SIZE];
+	va_list args;
+	va_start (args, format);
+	int payloadLength = format->EncodeArgs(payload, sizeof(payload), args);
+	va_end (args);
+
+	// Without the writer thread, format the message right away
+	if(writerRunning == false)
+	{
+		char text[LOG_MAX_MESSAGE_SIZE];
+		char message[LOG_MAX_MESSAGE_SIZE];
+		format->FormatArgs(text, sizeof(text), payload, payloadLength);
+		FormatLogMessage(message, sizeof(message), logLevel, NULL, 0, "%s", text);
+		WriteImmediate(logLevel, message);
+		return;
+	}
+
+	QueueRecord(logLevel, true, &format, sizeof(LogFormat*), payload, payloadLength);
+}
+
+// *****************************************************************
+/// @brief
+///     Queues a message record in the calling thread's buffer
+/// @remarks
+///     If the buffer is full, Info & Verbose messages are dropped.  More important messages write out
+///     all the buffers on the calling thread, to make room.
+///     GDK Internal Use Only
+// *****************************************************************
+void Log::QueueRecord(LogLevel::Enum logLevel, bool deferred, const void* record, int length, const void* extra, int extraLength)
+{
+	ThreadBuffer* buffer = GetThreadBuffer();
+	if(PushMessage(buffer, logLevel, deferred, record, length, extra, extraLength))
+		return;
+
+	// The buffer is full.  Drop unimportant messages, rather than stall the thread
+	if(logLevel >= LogLevel::Info)
+	{
+		buffer->Dropped++;
+		return;
+	}
+
+	// Write out the buffers on this thread, to make room  (A message always fits in an empty buffer)
+	Flush();
+	PushMessage(buffer, logLevel, deferred, record, length, extra, extraLength);
+}
+
+// *****************************************************************
+/// @brief
+///     Writes out all the queued log messages, before returning
+/// @remarks
+///     Only the messages that were queued before the call are guaranteed to be written.
+// *****************************************************************
+void Log::Flush()
+{
+	if(drainMutex == NULL)
+		return;
+
+	drainMutex->Lock();
+	DrainBuffers();
+	drainMutex->Unlock();
+}
+
+// *****************************************************************
+/// @brief
+///     Formats a log message, with the time, level, file & line
+/// @return
+///     Length of the message  (Not including the null terminator)
+/// @remarks
+///     Messages too long for the buffer are truncated.
+///     GDK Internal Use Only
+// *****************************************************************
+int Log::FormatLogMessageV(char* message, int messageSize, LogLevel::Enum logLevel, const char* file, int line, const char* format, va_list args)
+{
 	// Get the current time
 	time_t currentTime;
 	time( &currentTime );
 	struct tm * timeinfo = NULL;
-	
+
 	#ifdef GDKPLATFORM_WINDOWS
 		struct tm actualTimeInfo;
 		timeinfo = &actualTimeInfo;
 		localtime_s(timeinfo, &currentTime);
 	#else
-		timeinfo = localtime(&currentTime);
+		struct tm actualTimeInfo;
+		timeinfo = localtime_r(&currentTime, &actualTimeInfo);
 	#endif
-	
-	// Thread lock
+
+	// Add the current time & log level
+	int length = GDK_SPRINTF(
+		message, messageSize,
+		"[%02d/%02d/%02d %02d:%02d:%02d][%s]:",
+		timeinfo->tm_mon + 1, timeinfo->tm_mday, timeinfo->tm_year % 100,
+		timeinfo->tm_hour, timeinfo->tm_min, timeinfo->tm_sec,
+		LogLevel::ToString(logLevel)
+		);
+
+	// Add the custom message  (Leaving room for the file & line)
+	const int suffixRoom = 512;
+	int messageLength = GDK_VSNPRINTF(message + length, messageSize - length - suffixRoom, format, args);
+	if(messageLength < 0 || messageLength >= messageSize - length - suffixRoom)
+		messageLength = messageSize - length - suffixRoom - 1;
+	length += messageLength;
+
+	// Is there a file & line number?
+	int suffixLength = 0;
+	if(file != NULL)
+		suffixLength = GDK_SPRINTF(message + length, suffixRoom, "  [File: %.400s][Line: %d]\n", file, line);
+	else // No file & line
+		suffixLength = GDK_SPRINTF(message + length, suffixRoom, "\n");
+
+	return length + suffixLength;
+}
+
+// *****************************************************************
+/// @brief
+///     Formats a log message, with the time, level, file & line, from variable arguments
+/// @note
+///     GDK Internal Use Only
+// *****************************************************************
+int Log::FormatLogMessage(char* message, int messageSize, LogLevel::Enum logLevel, const char* file, int line, const char* format, ...)
+{
+	va_list args;
+	va_start (args, format);
+	int length = FormatLogMessageV(message, messageSize, logLevel, file, line, format, args);
+	va_end (args);
+	return length;
+}
+
+// *****************************************************************
+/// @brief
+///     Writes a formatted message straight to the console & log file, on the calling thread
+/// @note
+///     GDK Internal Use Only
+// *****************************************************************
+void Log::WriteImmediate(LogLevel::Enum logLevel, const char* message)
+{
+	if(logFilePath.empty())
+		return;
+
 	GDK_BEGIN_CRITICAL_SECTION(LogWriter)
 	{
-		// Add the current time & log level to the msg buffer
-        int charsWritten = GDK_SPRINTF(
-            msgBuffer, 19500, 
-            "[%02d/%02d/%02d %02d:%02d:%02d][%s]:", 
-            timeinfo->tm_mon + 1, timeinfo->tm_mday, timeinfo->tm_year % 100, 
-            timeinfo->tm_hour, timeinfo->tm_min, timeinfo->tm_sec,
-            LogLevel::ToString(logLevel)
-            );
-        
-        if(charsWritten < 0)
-        {
-            Gdk::DebugBreak();
-        }
-        
-		char *offset = msgBuffer + charsWritten;
-        
-		// Add the custom message to the log  (using variable args)
-		va_list args;
-		va_start (args, format);
-		int charsWritten2 = GDK_VSPRINTF(offset, 2048, format, args);
-		va_end (args);
-        offset += charsWritten2;
-
-		// Is there a file & line number?
-        int charsWritten3 = 0;
-		if(file != NULL)
-			charsWritten3 = GDK_SPRINTF(offset, 2048, "  [File: %s][Line: %d]\n", file, line);
-		else // No file & line
-			charsWritten3 = GDK_SPRINTF(offset, 2048, "\n");
-        
-        offset += charsWritten3;
-
 		// For errors & warnings, put the message in the debug output
 		if( logLevel <= LogLevel::Info )
 		{
         #ifdef GDKPLATFORM_WINDOWS
-			OutputDebugStringA(msgBuffer);
+			OutputDebugStringA(message);
+        #else
+            fputs(message, stdout);
+        #endif
+		}
+
+		// Append the message to the log
+		FILE* file = NULL;
+		#ifdef GDKPLATFORM_WINDOWS
+			fopen_s(&file, logFilePath.c_str(), "a");
+		#else
+			file = fopen(logFilePath.c_str(), "a");
+		#endif
+
+		if(file != NULL)
+		{
+			fputs(message, file);
+			fclose(file);
+		}
+	}
+	GDK_END_CRITICAL_SECTION(LogWriter)
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the calling thread's message buffer, creating it on first use
+/// @note
+///     GDK Internal Use Only
+// *****************************************************************
+Log::ThreadBuffer* Log::GetThreadBuffer()
+{
+	ThreadBuffer* buffer = (ThreadBuffer*) pthread_getspecific(logThreadBufferKey);
+
+	// Is this the first time this thread is logging?
+	if(buffer == NULL)
+	{
+		buffer = GdkNew ThreadBuffer();
+		buffer->Data = (char*) GdkAlloc(LOG_THREAD_BUFFER_SIZE);
+		buffer->WritePosition = 0;
+		buffer->ReadPosition = 0;
+		buffer->Dropped = 0;
+		buffer->DroppedReported = 0;
+
+		threadBuffersMutex->Lock();
+		threadBuffers.push_back(buffer);
+		threadBuffersMutex->Unlock();
+
+		pthread_setspecific(logThreadBufferKey, buffer);
+	}
+
+	return buffer;
+}
+
+// *****************************************************************
+/// @brief
+///     Frees a thread's message buffer, when the thread exits
+/// @remarks
+///     The thread's last messages are written out first.
+/// @note
+///     GDK Internal Use Only
+// *****************************************************************
+void Log::ReleaseThreadBuffer(void* data)
+{
+	ThreadBuffer* buffer = (ThreadBuffer*) data;
+	Flush();
+
+	threadBuffersMutex->Lock();
+	vector<ThreadBuffer*>::iterator iter = find(threadBuffers.begin(), threadBuffers.end(), buffer);
+	if(iter != threadBuffers.end())
+		threadBuffers.erase(iter);
+	threadBuffersMutex->Unlock();
+
+	GdkFree(buffer->Data);
+	GdkDelete(buffer);
+}
+
+// *****************************************************************
+/// @brief
+///     Adds a message record to the end of a thread's buffer
+/// @param record
+///     The formatted text, or the LogFormat* of a deferred message
+/// @param extra
+///     Bytes that follow the record  (The encoded arguments of a deferred message)
+/// @return
+///     False if there is not enough room in the buffer
+/// @note
+///     GDK Internal Use Only
+// *****************************************************************
+bool Log::PushMessage(ThreadBuffer* buffer, LogLevel::Enum logLevel, bool deferred, const void* record, int length, const void* extra, int extraLength)
+{
+	MessageHeader header;
+	header.Time = HighResTimer::GetSeconds();
+	header.Length = (UInt16)(length + extraLength);
+	header.Level = (UInt8) logLevel;
+	header.Deferred = deferred ? 1 : 0;
+
+	// Is there room for the message?
+	UInt32 size = sizeof(MessageHeader) + header.Length;
+	UInt32 writePosition = buffer->WritePosition;
+	if(LOG_THREAD_BUFFER_SIZE - (writePosition - buffer->ReadPosition) < size)
+		return false;
+
+	CopyToRing(buffer->Data, writePosition, &header, sizeof(MessageHeader));
+	CopyToRing(buffer->Data, writePosition + sizeof(MessageHeader), record, length);
+	if(extraLength > 0)
+		CopyToRing(buffer->Data, writePosition + sizeof(MessageHeader) + length, extra, extraLength);
+
+	// Publish the message to the writer, once it is all in the buffer
+	GDK_MEMORY_BARRIER();
+	buffer->WritePosition = writePosition + size;
+	return true;
+}
+
+// *****************************************************************
+/// @brief
+///     Sort predicate that orders the pending messages by the time they were logged
+/// @note
+///     GDK Internal Use Only
+// *****************************************************************
+bool Log::ComparePendingMessages(const PendingMessage& a, const PendingMessage& b)
+{
+	return a.Time < b.Time;
+}
+
+// *****************************************************************
+/// @brief
+///     Collects the queued messages from every thread's buffer, & writes them in time order
+/// @remarks
+///     The caller must hold the drainMutex.
+///     GDK Internal Use Only
+// *****************************************************************
+void Log::DrainBuffers()
+{
+	batch.clear();
+	batchText.clear();
+
+	threadBuffersMutex->Lock();
+	for(vector<ThreadBuffer*>::iterator iter = threadBuffers.begin(); iter != threadBuffers.end(); iter++)
+	{
+		ThreadBuffer* buffer = *iter;
+
+		// Take the messages that were published before now
+		UInt32 readPosition = buffer->ReadPosition;
+		UInt32 writePosition = buffer->WritePosition;
+		GDK_MEMORY_BARRIER();
+
+		while(readPosition != writePosition)
+		{
+			MessageHeader header;
+			CopyFromRing(buffer->Data, readPosition, &header, sizeof(MessageHeader));
+
+			PendingMessage pending;
+			pending.Time = header.Time;
+			pending.Level = header.Level;
+			pending.Deferred = header.Deferred != 0;
+			pending.Offset = (int) batchText.size();
+			pending.Length = pending.Deferred ? header.Length : header.Length - 1;
+			batch.push_back(pending);
+
+			batchText.resize(batchText.size() + header.Length);
+			CopyFromRing(buffer->Data, readPosition + sizeof(MessageHeader), &batchText[pending.Offset], header.Length);
+
+			readPosition += sizeof(MessageHeader) + header.Length;
+		}
+
+		// Free the space, once the messages are copied out
+		GDK_MEMORY_BARRIER();
+		buffer->ReadPosition = readPosition;
+
+		// Report any messages the thread dropped
+		int dropped = buffer->Dropped;
+		if(dropped != buffer->DroppedReported)
+		{
+			char message[1024];
+			int length = FormatLogMessage(message, sizeof(message), LogLevel::Warning, NULL, 0, 
+				"%d log messages were dropped, as the thread's log buffer was full", dropped - buffer->DroppedReported);
+			buffer->DroppedReported = dropped;
+
+			PendingMessage pending;
+			pending.Time = HighResTimer::GetSeconds();
+			pending.Level = LogLevel::Warning;
+			pending.Deferred = false;
+			pending.Offset = (int) batchText.size();
+			pending.Length = length;
+			batch.push_back(pending);
+			batchText.insert(batchText.end(), message, message + length + 1);
+		}
+	}
+	threadBuffersMutex->Unlock();
+
+	if(batch.empty())
+		return;
+
+	// Write the messages in the order they were logged
+	stable_sort(batch.begin(), batch.end(), ComparePendingMessages);
+	char deferredText[LOG_MAX_MESSAGE_SIZE];
+	for(vector<PendingMessage>::iterator iter = batch.begin(); iter != batch.end(); iter++)
+	{
+		const char* text = &batchText[iter->Offset];
+		int length = iter->Length;
+
+		// Deferred messages are formatted here, or written to the binary log as they are
+		if(iter->Deferred)
+		{
+			const LogFormat* format;
+			memcpy(&format, text, sizeof(LogFormat*));
+			const UInt8* payload = (const UInt8*) text + sizeof(LogFormat*);
+			int payloadLength = iter->Length - (int) sizeof(LogFormat*);
+
+			if(WriteBinaryLog)
+			{
+				WriteBinaryMessage(*iter, format, payload, payloadLength);
+				continue;
+			}
+
+			char body[LOG_MAX_MESSAGE_SIZE];
+			format->FormatArgs(body, sizeof(body), payload, payloadLength);
+			length = FormatLogMessage(deferredText, sizeof(deferredText), (LogLevel::Enum) iter->Level, NULL, 0, "%s", body);
+			text = deferredText;
+		}
+
+		if(iter->Level <= LogLevel::Info)
+		{
+        #ifdef GDKPLATFORM_WINDOWS
+			OutputDebugStringA(text);
         #else
-            printf(msgBuffer);
+            fputs(text, stdout);
         #endif
 		}
 
-		// Open the log file
-		FILE* logFile = NULL;
+		if(logFile != NULL)
+			fwrite(text, 1, length, logFile);
+	}
+
+	if(logFile != NULL)
+		fflush(logFile);
+	if(binaryLogFile != NULL)
+		fflush(binaryLogFile);
+}
+
+// *****************************************************************
+/// @brief
+///     Writes a deferred message to the binary log, Gdk.blog
+/// @remarks
+///     The binary log is opened the first time it is written.  Each format is written to the log once,
+///     before its first message, & messages refer to it by id.  See "Docs/File Formats/Binary Log Format.txt".
+///     GDK Internal Use Only
+// *****************************************************************
+void Log::WriteBinaryMessage(const PendingMessage& message, const LogFormat* format, const UInt8* payload, int payloadLength)
+{
+	// Open the binary log & write its header
+	if(binaryLogFile == NULL)
+	{
+		if(logFilePath.empty())
+			return;
+		string binaryLogFilePath = Path::ChangeExtension(logFilePath.c_str(), "blog");
+
 		#ifdef GDKPLATFORM_WINDOWS
-			fopen_s(&logFile, logFilePath.c_str(), "a");
+			fopen_s(&binaryLogFile, binaryLogFilePath.c_str(), "ab");
 		#else
-			logFile = fopen(logFilePath.c_str(), "a");
+			binaryLogFile = fopen(binaryLogFilePath.c_str(), "ab");
 		#endif
+		if(binaryLogFile == NULL)
+			return;
+
+		// The session starts at the first message, so its times are never negative
+		UInt32 version = 1;
+		Int64 startTime = (Int64) time(NULL);
+		double startTimer = message.Time;
+		fwrite("GDKBLOG1", 1, 8, binaryLogFile);
+		fwrite(&version, sizeof(UInt32), 1, binaryLogFile);
+		fwrite(&startTime, sizeof(Int64), 1, binaryLogFile);
+		fwrite(&startTimer, sizeof(double), 1, binaryLogFile);
+
+		// Each session of the log has its own format ids
+		binaryFormatIds.clear();
+	}
+
+	// Write the format, the first time it is used
+	UInt32 formatId;
+	map<const LogFormat*, UInt32>::iterator formatIter = binaryFormatIds.find(format);
+	if(formatIter != binaryFormatIds.end())
+	{
+		formatId = formatIter->second;
+	}
+	else
+	{
+		formatId = (UInt32) binaryFormatIds.size();
+		binaryFormatIds[format] = formatId;
+
+		UInt8 recordType = 1;
+		UInt8 numArgs = (UInt8) format->NumArgs;
+		size_t formatLength = strlen(format->Format);
+		if(formatLength > 0xFFFF)
+			formatLength = 0xFFFF;
+		UInt16 storedLength = (UInt16) formatLength;
+
+		fwrite(&recordType, 1, 1, binaryLogFile);
+		fwrite(&formatId, sizeof(UInt32), 1, binaryLogFile);
+		fwrite(&numArgs, 1, 1, binaryLogFile);
+		fwrite(format->ArgTypes, 1, numArgs, binaryLogFile);
+		fwrite(&storedLength, sizeof(UInt16), 1, binaryLogFile);
+		fwrite(format->Format, 1, formatLength, binaryLogFile);
+	}
+
+	// Write the message
+	UInt8 recordType = 2;
+	UInt8 level = (UInt8) message.Level;
+	UInt16 storedPayloadLength = (UInt16) payloadLength;
+	fwrite(&recordType, 1, 1, binaryLogFile);
+	fwrite(&message.Time, sizeof(double), 1, binaryLogFile);
+	fwrite(&level, 1, 1, binaryLogFile);
+	fwrite(&formatId, sizeof(UInt32), 1, binaryLogFile);
+	fwrite(&storedPayloadLength, sizeof(UInt16), 1, binaryLogFile);
+	fwrite(payload, 1, payloadLength, binaryLogFile);
+}
+
+// *****************************************************************
+/// @brief
+///     Background thread that writes out the queued messages
+/// @note
+///     GDK Internal Use Only
+// *****************************************************************
+void* Log::WriterThread(void* argument)
+{
+	while(writerRunning)
+	{
+		Thread::Sleep(LOG_WRITER_INTERVAL);
+		Flush();
+	}
+	return NULL;
+}
 
-		if(logFile == NULL)
+// *****************************************************************
+/// @brief
+///     Writes bytes straight to the log file's descriptor, from a crash handler
+// *****************************************************************
+static void WriteForCrash(const void* data, int size)
+{
+	while(size > 0)
+	{
+	#ifdef GDKPLATFORM_WINDOWS
+		int written = _write(crashLogFileDescriptor, data, (unsigned int) size);
+	#else
+		int written = (int) write(crashLogFileDescriptor, data, (size_t) size);
+	#endif
+		if(written <= 0)
 			return;
-		
-		// Write the msg
-		fprintf(logFile, msgBuffer);
-		
-		// Close the log
-		fclose(logFile);
+		data = (const char*) data + written;
+		size -= written;
+	}
+}
 
+// *****************************************************************
+/// @brief
+///     Writes out the queued messages from a crash handler
+/// @remarks
+///     Nothing here takes a lock, allocates, or goes through stdio, as the crash may have happened anywhere
+///     (including inside the logger).  The messages are copied from the thread buffers & written straight to
+///     the log file's descriptor with write(), a thread at a time rather than in time order.  Deferred messages
+///     can't be formatted safely, so their format string is written as is.
+///   @par
+///     Messages that the writer thread was in the middle of writing may be written twice.
+/// @note
+///     GDK Internal Use Only
+// *****************************************************************
+void Log::Platform_FlushForCrash()
+{
+	// Only write the messages for the first crash
+	if(crashLogFileDescriptor < 0 || crashWritten)
+		return;
+	crashWritten = true;
+
+	static const char banner[] = "---- Crashed.  Messages that were still queued (By thread): ----\n";
+	WriteForCrash(banner, sizeof(banner) - 1);
+
+	char text[LOG_MAX_MESSAGE_SIZE];
+	for(size_t bufferIndex = 0; bufferIndex < threadBuffers.size(); bufferIndex++)
+	{
+		ThreadBuffer* buffer = threadBuffers[bufferIndex];
+
+		UInt32 readPosition = buffer->ReadPosition;
+		UInt32 writePosition = buffer->WritePosition;
+		GDK_MEMORY_BARRIER();
+
+		while(readPosition != writePosition && writePosition - readPosition <= LOG_THREAD_BUFFER_SIZE)
+		{
+			MessageHeader header;
+			CopyFromRing(buffer->Data, readPosition, &header, sizeof(MessageHeader));
+			UInt32 recordPosition = readPosition + sizeof(MessageHeader);
+			readPosition = recordPosition + header.Length;
+
+			if(header.Deferred == 0)
+			{
+				// Formatted text  (Written without its null terminator)
+				if(header.Length == 0 || header.Length > sizeof(text))
+					continue;
+				CopyFromRing(buffer->Data, recordPosition, text, header.Length);
+				WriteForCrash(text, header.Length - 1);
+			}
+			else
+			{
+				const LogFormat* format;
+				CopyFromRing(buffer->Data, recordPosition, &format, sizeof(LogFormat*));
+				WriteForCrash(format->Format, (int) strlen(format->Format));
+				WriteForCrash("\n", 1);
+			}
+		}
 	}
-	GDK_END_CRITICAL_SECTION(LogWriter)
+}
+
+#ifdef GDKPLATFORM_WINDOWS
+
+// *****************************************************************
+/// @brief
+///     Unhandled exception filter that writes out the log, then passes the exception to the previous filter
+// *****************************************************************
+static LONG WINAPI LogCrashFilter(EXCEPTION_POINTERS* exceptionInfo)
+{
+	Log::Platform_FlushForCrash();
+	if(previousCrashFilter != NULL)
+		return previousCrashFilter(exceptionInfo);
+	return EXCEPTION_CONTINUE_SEARCH;
+}
+
+#else
+
+// *****************************************************************
+/// @brief
+///     Signal handler that writes out the log, then passes the signal to the previous handler
+/// @remarks
+///     The previous handler is put back & the signal raised again.  It is delivered to that handler
+///     (or kills the process, by default) once this handler returns.
+// *****************************************************************
+static void LogCrashHandler(int signalNumber)
+{
+	Log::Platform_FlushForCrash();
+
+	for(int index = 0; index < LOG_NUM_CRASH_SIGNALS; index++)
+	{
+		if(crashSignals[index] == signalNumber)
+			sigaction(signalNumber, &previousCrashActions[index], NULL);
+	}
+	raise(signalNumber);
+}
+
+#endif
+
+// *****************************************************************
+/// @brief
+///     Installs handlers that write out the queued log messages if the process crashes
+/// @remarks
+///     Handles SIGSEGV, SIGBUS, SIGILL, SIGFPE & SIGABRT (or unhandled exceptions on Windows).  The handlers
+///     that were installed before are kept, & called after the log is written.  The handlers are removed
+///     when the log is shut down.
+///   @par
+///     Called by the Application when ApplicationSettings::LogCrashHandlers is set.
+// *****************************************************************
+void Log::InstallCrashHandlers()
+{
+	if(crashHandlersInstalled || crashLogFileDescriptor < 0)
+		return;
+	crashHandlersInstalled = true;
+	crashWritten = false;
+
+	#ifdef GDKPLATFORM_WINDOWS
+		previousCrashFilter = SetUnhandledExceptionFilter(&LogCrashFilter);
+	#else
+		struct sigaction action;
+		memset(&action, 0, sizeof(action));
+		action.sa_handler = &LogCrashHandler;
+		sigemptyset(&action.sa_mask);
+		for(int index = 0; index < LOG_NUM_CRASH_SIGNALS; index++)
+			sigaction(crashSignals[index], &action, &previousCrashActions[index]);
+	#endif
+}
+
+// *****************************************************************
+/// @brief
+///     Puts back the crash handlers that were installed before InstallCrashHandlers()
+/// @note
+///     GDK Internal Use Only
+// *****************************************************************
+void Log::RemoveCrashHandlers()
+{
+	if(crashHandlersInstalled == false)
+		return;
+	crashHandlersInstalled = false;
+
+	#ifdef GDKPLATFORM_WINDOWS
+		SetUnhandledExceptionFilter(previousCrashFilter);
+		previousCrashFilter = NULL;
+	#else
+		for(int index = 0; index < LOG_NUM_CRASH_SIGNALS; index++)
+			sigaction(crashSignals[index], &previousCrashActions[index], NULL);
+	#endif
 }
 
 // *****************************************************************
-/// @brief 
+/// @brief
 ///     Initializes the GDK logging system
 /// @note
 ///     GDK Internal Use Only
 // *****************************************************************
 void Log::Init()
 {
-    if(msgBuffer == NULL)
-        msgBuffer = new char[20000];
-    
 	// Get the path to the folder for the logs
 	string workingFolder = Path::GetCommonPath(CommonPaths::WorkingFolder);
 
@@ -157,16 +837,34 @@ void Log::Init()
 	// Build the full path to the log
 	logFilePath = Path::Combine(workingFolder.c_str(), "Gdk.log");
 
+	// Keep the log open for the writer  (The crash handlers write to its descriptor)
+	#ifdef GDKPLATFORM_WINDOWS
+		fopen_s(&logFile, logFilePath.c_str(), "a");
+		if(logFile != NULL)
+			crashLogFileDescriptor = _fileno(logFile);
+	#else
+		logFile = fopen(logFilePath.c_str(), "a");
+		if(logFile != NULL)
+			crashLogFileDescriptor = fileno(logFile);
+	#endif
+
+	// Start the writer thread.  (Each thread's buffer is freed when the thread exits)
+	pthread_key_create(&logThreadBufferKey, &Log::ReleaseThreadBuffer);
+	threadBuffersMutex = Mutex::Create("LogThreadBuffers");
+	drainMutex = Mutex::Create("LogDrain");
+	writerRunning = true;
+	writerThread = GdkNew Thread(Thread::Create(&Log::WriterThread));
+
 	// Enable logging
 	Log::Enabled = true;
-	
+
 	// Log the startup
 	LOG_SYSTEM("-----------------------------------------------------------------------");
 	LOG_SYSTEM("Initialized GDK Log");
 }
 
 // *****************************************************************
-/// @brief 
+/// @brief
 ///     Shuts down the GDK logging system
 /// @note
 ///     GDK Internal Use Only
@@ -176,8 +874,39 @@ void Log::Shutdown()
 	// Log the shutdown
 	LOG_SYSTEM("Shutdown GDK Log");
 	LOG_SYSTEM("-----------------------------------------------------------------------");
-    
-    delete[] msgBuffer;
-    msgBuffer = NULL;
-	
-}
\ No newline at end of file
+
+	RemoveCrashHandlers();
+
+	// Stop the writer thread, & write out whatever it had not got to
+	writerRunning = false;
+	writerThread->Join();
+	GdkDelete(writerThread);
+	writerThread = NULL;
+	Flush();
+
+	// Later messages are written immediately, so the buffers are no longer needed
+	for(vector<ThreadBuffer*>::iterator iter = threadBuffers.begin(); iter != threadBuffers.end(); iter++)
+	{
+		GdkFree((*iter)->Data);
+		GdkDelete(*iter);
+	}
+	threadBuffers.clear();
+	pthread_key_delete(logThreadBufferKey);
+
+	GdkDelete(threadBuffersMutex);
+	threadBuffersMutex = NULL;
+	GdkDelete(drainMutex);
+	drainMutex = NULL;
+
+	if(logFile != NULL)
+	{
+		crashLogFileDescriptor = -1;
+		fclose(logFile);
+		logFile = NULL;
+	}
+	if(binaryLogFile != NULL)
+	{
+		fclose(binaryLogFile);
+		binaryLogFile = NULL;
+	}
+}
@@ -31,8 +31,15 @@
 	#define GDK_LOGGING
 #endif
 
+// Comment this line to compile the deferred log messages out of the build  (They are kept in release builds)
+#define GDK_DEFERRED_LOGGING
+
 namespace Gdk
 {
+    class Mutex;
+    class Thread;
+    struct LogFormat;
+
     /// @addtogroup System
     /// @{
 
@@ -65,6 +72,15 @@ namespace Gdk
     /// @remarks
     ///     For simplified logging, use the logging macros:
     ///     LOG_SYSTEM, LOG_INFO, LOG_VERBOSE, LOG_WARN, LOG_ERROR
+    ///   @par
+    ///     Write() formats the message on the calling thread, into that thread's own ring buffer, without
+    ///     taking any locks.  A background writer thread collects the messages from all the threads every
+    ///     few milliseconds, and writes them to the console & log file in batches.  If a thread's buffer
+    ///     is full, Info & Verbose messages are dropped (& the drop is logged), while more important
+    ///     messages flush the buffers on the calling thread.
+    ///   @par
+    ///     Flush() writes out all the queued messages before returning.  It is called by asserts, so the
+    ///     last messages before a failure are not lost.  InstallCrashHandlers() does the same for crashes.
     // =================================================================================
     class Log
 	{
@@ -83,6 +99,9 @@ namespace Gdk
         /// Sets the maximum logging level that will be written to the log.
 		static LogLevel::Enum MaxLevel;
         
+        /// Write deferred messages to Gdk.blog in binary, for Tools/GdkLogDecode, instead of formatting them into the log.  (Default = false)
+        static bool WriteBinaryLog;
+        
         /// @}
         
         // Public Methods
@@ -93,21 +112,98 @@ namespace Gdk
         /// @{
 
 		static void Write(LogLevel::Enum logLevel, const char* file, int line, const char *format, ...);
+        static void WriteDeferred(LogLevel::Enum logLevel, LogFormat* format, ...);
+        static void Flush();
+        static void InstallCrashHandlers();
 
-        /// @}t        
+        /// @}
+        
+		// INTERNAL ONLY - Platform Interfaces
+		// =====================================================
+        
+        /// @cond INTERNAL
+        
+        // ---------------------------------
+        /// @name Internal Platform Methods
+        /// @{
+        
+        static void Platform_FlushForCrash();
+        
+        /// @}
+        
+        /// @endcond
+        
 	private:
         
+        // Private Types
+		// =====================================================
+        
+        // ***********************************************************************
+        struct ThreadBuffer
+        {
+            char* Data;                     // Ring buffer of messages, written only by the owning thread
+            volatile UInt32 WritePosition;  // Moved by the owning thread
+            volatile UInt32 ReadPosition;   // Moved by the thread draining the buffers
+            int Dropped;                    // Messages dropped because the buffer was full
+            int DroppedReported;
+        };
+        
+        // ***********************************************************************
+        struct MessageHeader
+        {
+            double Time;
+            UInt16 Length;                  // Length of the record that follows
+            UInt8 Level;
+            UInt8 Deferred;                 // 0 = formatted text, with its null terminator.  1 = LogFormat* & encoded arguments
+        };
+        
+        // ***********************************************************************
+        struct PendingMessage
+        {
+            double Time;
+            int Level;
+            bool Deferred;
+            int Offset;                     // Offset of the record in the batch
+            int Length;
+        };
+        
         // Private Properties
 		// =====================================================
         
         static string logFilePath;
-		static char* msgBuffer;	
+        static FILE* logFile;
+        
+        static vector<ThreadBuffer*> threadBuffers;
+        static Mutex* threadBuffersMutex;   // Guards the list of buffers  (Not the buffers themselves)
+        static Mutex* drainMutex;           // Only one thread drains the buffers at a time
+        
+        static Thread* writerThread;
+        static volatile bool writerRunning;
+        
+        static vector<PendingMessage> batch;
+        static vector<char> batchText;
+        
+        static FILE* binaryLogFile;
+        static map<const LogFormat*, UInt32> binaryFormatIds;   // Ids of the formats written to the binary log
 
 		// Private Methods
 		// =====================================================
 
         static void Init();
 		static void Shutdown();
+        
+        static int FormatLogMessage(char* message, int messageSize, LogLevel::Enum logLevel, const char* file, int line, const char* format, ...);
+        static int FormatLogMessageV(char* message, int messageSize, LogLevel::Enum logLevel, const char* file, int line, const char* format, va_list args);
+        static void WriteImmediate(LogLevel::Enum logLevel, const char* message);
+        static ThreadBuffer* GetThreadBuffer();
+        static bool PushMessage(ThreadBuffer* buffer, LogLevel::Enum logLevel, bool deferred, const void* record, int length, const void* extra = NULL, int extraLength = 0);
+        static void QueueRecord(LogLevel::Enum logLevel, bool deferred, const void* record, int length, const void* extra = NULL, int extraLength = 0);
+        static void DrainBuffers();
+        static void RemoveCrashHandlers();
+        static void ReleaseThreadBuffer(void* data);
+        static void WriteBinaryMessage(const PendingMessage& message, const LogFormat* format, const UInt8* payload, int payloadLength);
+        static bool ComparePendingMessages(const PendingMessage& a, const PendingMessage& b);
+        static void* WriterThread(void* argument);
 
         friend class Application;
 	};
@@ -137,6 +233,28 @@ namespace Gdk
 		#define LOG_ERROR(format, ...)
 	#endif
 
+	#ifdef GDK_DEFERRED_LOGGING
+		#ifdef GDKPLATFORM_WINDOWS
+			#define LOG_DEFERRED(logLevel, format, ...)		do { static Gdk::LogFormat gdkLogFormat = { "" format, -1 }; Gdk::Log::WriteDeferred(logLevel, &gdkLogFormat, __VA_ARGS__); } while(0)
+			#define LOG_DEFERRED_INFO(format, ...)			LOG_DEFERRED(Gdk::LogLevel::Info,    format, __VA_ARGS__)
+			#define LOG_DEFERRED_VERBOSE(format, ...)		LOG_DEFERRED(Gdk::LogLevel::Verbose, format, __VA_ARGS__)
+			#define LOG_DEFERRED_WARN(format, ...)			LOG_DEFERRED(Gdk::LogLevel::Warning, format, __VA_ARGS__)
+			#define LOG_DEFERRED_ERROR(format, ...)			LOG_DEFERRED(Gdk::LogLevel::Error,   format, __VA_ARGS__)
+		#else
+			#define LOG_DEFERRED(logLevel, format, args...)	do { static Gdk::LogFormat gdkLogFormat = { "" format, -1 }; Gdk::Log::WriteDeferred(logLevel, &gdkLogFormat, ##args); } while(0)
+			#define LOG_DEFERRED_INFO(format, args...)		LOG_DEFERRED(Gdk::LogLevel::Info,    format, ##args)
+			#define LOG_DEFERRED_VERBOSE(format, args...)	LOG_DEFERRED(Gdk::LogLevel::Verbose, format, ##args)
+			#define LOG_DEFERRED_WARN(format, args...)		LOG_DEFERRED(Gdk::LogLevel::Warning, format, ##args)
+			#define LOG_DEFERRED_ERROR(format, args...)		LOG_DEFERRED(Gdk::LogLevel::Error,   format, ##args)
+		#endif
+	#else
+		#define LOG_DEFERRED(logLevel, format, ...)
+		#define LOG_DEFERRED_INFO(format, ...)
+		#define LOG_DEFERRED_VERBOSE(format, ...)
+		#define LOG_DEFERRED_WARN(format, ...)
+		#define LOG_DEFERRED_ERROR(format, ...)
+	#endif
+
     // *****************************************************************
     /// @def LOG_SYSTEM(format, ...)
     /// @brief 
@@ -178,6 +296,19 @@ namespace Gdk
     /// @param ...
     ///     Insertion values for the format string
     // *****************************************************************
+    /// @def LOG_DEFERRED_INFO(format, ...)
+    /// @brief 
+    ///     Writes an Info-level log message, which is formatted later by the log writer thread  (Or by
+    ///     Tools/GdkLogDecode, with Log::WriteBinaryLog).  The LOG_DEFERRED_VERBOSE, LOG_DEFERRED_WARN &
+    ///     LOG_DEFERRED_ERROR macros are the same, at their levels.
+    /// @param format
+    ///     A printf style format string.  This must be a string literal.
+    /// @param ...
+    ///     Insertion values for the format string.  Strings are copied, up to LOGFORMAT_MAX_STRING characters.
+    /// @remarks
+    ///     Only the raw argument values are copied on the calling thread, which is several times cheaper
+    ///     than formatting the message.  These are kept in release builds, for frequent diagnostic messages.
+    // *****************************************************************
 
     /// @}
     
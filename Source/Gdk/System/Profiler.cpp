@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "BasePCH.h"
+#include "Profiler.h"
+
+using namespace Gdk;
+
+// Static Instantiations
+vector<Profiler::ThreadBuffer*> Profiler::threadBuffers;
+Mutex* Profiler::mutex = NULL;
+volatile bool Profiler::capturing = false;
+UInt32 Profiler::captureIndex = 0;
+double Profiler::captureStartTime = 0.0;
+int Profiler::eventsPerThread = 0;
+double Profiler::frameStartTime = -1.0;
+
+// Thread local slot holding each thread's ThreadBuffer
+static pthread_key_t profilerThreadBufferKey;
+
+// *****************************************************************
+/// @brief
+///     Copies a string into a buffer, escaped for use in a JSON string
+// *****************************************************************
+static void EscapeJsonString(const char* text, char* output, int outputSize)
+{
+    static const char* hexDigits = "0123456789abcdef";
+
+    char* end = output + outputSize - 7;
+    for(; *text != 0 && output < end; text++)
+    {
+        char c = *text;
+        if(c == '"' || c == '\\')
+        {
+            *output++ = '\\';
+            *output++ = c;
+        }
+        else if((unsigned char)c < 0x20)
+        {
+            *output++ = '\\';
+            *output++ = 'u';
+            *output++ = '0';
+            *output++ = '0';
+            *output++ = hexDigits[(c >> 4) & 0xF];
+            *output++ = hexDigits[c & 0xF];
+        }
+        else
+        {
+            *output++ = c;
+        }
+    }
+    *output = 0;
+}
+
+// *****************************************************************
+/// @brief
+///     Static Initializer for the Profiler
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void Profiler::Init()
+{
+    mutex = Mutex::Create();
+    pthread_key_create(&profilerThreadBufferKey, NULL);
+
+    // The GDK is initialized on the main thread
+    SetThreadName("Main Thread");
+}
+
+// *****************************************************************
+/// @brief
+///     Static Shutdown for the Profiler
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void Profiler::Shutdown()
+{
+    capturing = false;
+
+    // Free the thread buffers
+    for(vector<ThreadBuffer*>::iterator iter = threadBuffers.begin(); iter != threadBuffers.end(); iter++)
+    {
+        ThreadBuffer* buffer = *iter;
+        if(buffer->Events != NULL)
+            GdkFree(buffer->Events);
+        GdkDelete(buffer);
+    }
+    threadBuffers.clear();
+
+    pthread_key_delete(profilerThreadBufferKey);
+
+    GdkDelete(mutex);
+    mutex = NULL;
+}
+
+// *****************************************************************
+/// @brief
+///     Starts a new capture, discarding the events of the previous capture
+/// @param maxEventsPerThread
+///     The most events each thread can record.  Events past this are dropped.
+/// @remarks
+///     Each thread allocates its buffer when it records its first zone of the capture.
+// *****************************************************************
+void Profiler::BeginCapture(int maxEventsPerThread)
+{
+    ASSERT(mutex != NULL, "The Profiler is not initialized");
+    ASSERT(maxEventsPerThread > 0, "maxEventsPerThread must be greater than 0");
+
+    mutex->Lock();
+    {
+        eventsPerThread = maxEventsPerThread;
+        captureIndex++;
+        captureStartTime = HighResTimer::GetSeconds();
+        frameStartTime = -1.0;
+        capturing = true;
+    }
+    mutex->Unlock();
+}
+
+// *****************************************************************
+/// @brief
+///     Stops the current capture
+/// @remarks
+///     Zones that are still open when the capture ends are not recorded.
+// *****************************************************************
+void Profiler::EndCapture()
+{
+    mutex->Lock();
+    {
+        capturing = false;
+
+        // Log any threads that ran out of room
+        for(vector<ThreadBuffer*>::iterator iter = threadBuffers.begin(); iter != threadBuffers.end(); iter++)
+        {
+            ThreadBuffer* buffer = *iter;
+            if(buffer->CaptureIndex == captureIndex && buffer->Dropped > 0)
+                LOG_WARN("Profiler: thread %u dropped %d events", buffer->ThreadId, buffer->Dropped);
+        }
+    }
+    mutex->Unlock();
+}
+
+// *****************************************************************
+/// @brief
+///     Checks if a capture is running
+// *****************************************************************
+bool Profiler::IsCapturing()
+{
+    return capturing;
+}
+
+// *****************************************************************
+/// @brief
+///     Gets the calling thread's buffer, creating it or resetting it for the current capture as needed
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer()
+{
+    ThreadBuffer* buffer = (ThreadBuffer*) pthread_getspecific(profilerThreadBufferKey);
+
+    // Is this the first time this thread is recording?
+    if(buffer == NULL)
+    {
+        buffer = GdkNew ThreadBuffer();
+        buffer->ThreadId = Thread::GetCurrentThreadId();
+        buffer->Events = NULL;
+        buffer->Capacity = 0;
+        buffer->Count = 0;
+        buffer->Dropped = 0;
+        buffer->CaptureIndex = 0;
+
+        mutex->Lock();
+        threadBuffers.push_back(buffer);
+        mutex->Unlock();
+
+        pthread_setspecific(profilerThreadBufferKey, buffer);
+    }
+
+    // Is this the thread's first event of the current capture?
+    if(buffer->CaptureIndex != captureIndex)
+    {
+        if(buffer->Capacity != eventsPerThread)
+        {
+            if(buffer->Events != NULL)
+                GdkFree(buffer->Events);
+            buffer->Events = (Event*) GdkAlloc(sizeof(Event) * eventsPerThread);
+            buffer->Capacity = eventsPerThread;
+        }
+        buffer->Count = 0;
+        buffer->Dropped = 0;
+        buffer->CaptureIndex = captureIndex;
+    }
+
+    return buffer;
+}
+
+// *****************************************************************
+/// @brief
+///     Records a zone into the calling thread's buffer
+/// @param name
+///     Name of the zone.  Only the pointer is kept, so this must outlive the capture.
+/// @param detail
+///     Optional detail string, which is copied.  (May be NULL)
+/// @param startTime
+///     HighResTimer time when the zone started
+/// @param endTime
+///     HighResTimer time when the zone ended
+/// @remarks
+///     This is normally called by the GDK_PROFILE_SCOPE() macros.  It takes no locks, except
+///     the very first time a thread records a zone.
+// *****************************************************************
+void Profiler::RecordZone(const char* name, const char* detail, double startTime, double endTime)
+{
+    // Ignore zones that started before the capture
+    if(capturing == false || startTime < captureStartTime)
+        return;
+
+    ThreadBuffer* buffer = GetThreadBuffer();
+
+    // Is the buffer full?
+    int count = buffer->Count;
+    if(count >= buffer->Capacity)
+    {
+        buffer->Dropped++;
+        return;
+    }
+
+    Event& event = buffer->Events[count];
+    event.Name = name;
+    event.StartTime = startTime - captureStartTime;
+    event.Duration = endTime - startTime;
+    if(detail != NULL)
+    {
+        strncpy(event.Detail, detail, sizeof(event.Detail) - 1);
+        event.Detail[sizeof(event.Detail) - 1] = 0;
+    }
+    else
+    {
+        event.Detail[0] = 0;
+    }
+
+    // Publish the event
+    buffer->Count = count + 1;
+}
+
+// *****************************************************************
+/// @brief
+///     Marks the start of a new frame
+/// @remarks
+///     The time since the previous mark is recorded as a "Frame" zone, so each frame's zones
+///     nest under it in the trace.  This is called by the Application at the start of each update.
+// *****************************************************************
+void Profiler::MarkFrame()
+{
+    if(capturing == false)
+        return;
+
+    double now = HighResTimer::GetSeconds();
+    if(frameStartTime >= 0.0)
+        RecordZone("Frame", NULL, frameStartTime, now);
+    frameStartTime = now;
+}
+
+// *****************************************************************
+/// @brief
+///     Sets the name of the calling thread, as shown in the exported trace
+// *****************************************************************
+void Profiler::SetThreadName(const char* name)
+{
+    if(mutex == NULL)
+        return;
+
+    ThreadBuffer* buffer = GetThreadBuffer();
+
+    mutex->Lock();
+    buffer->Name = name;
+    mutex->Unlock();
+}
+
+// *****************************************************************
+/// @brief
+///     Writes the events of the last capture to a file, in the Chrome Trace Event format
+/// @param filePath
+///     Path of the .json file to write
+/// @remarks
+///     Call this after EndCapture().  Threads that are still recording would otherwise be racing the export.
+///     If the file can't be created, nothing is exported.  (The error is logged)
+// *****************************************************************
+void Profiler::ExportChromeTrace(const char* filePath)
+{
+    ASSERT(capturing == false, "Profiler::ExportChromeTrace() must not be called during a capture");
+
+    FileStream* file = File::Create(filePath);
+    if(file == NULL)
+        return;
+
+    char line[512];
+    char escapedName[128];
+    char escapedDetail[128];
+    int length;
+    const char* separator = "";
+
+    length = GDK_SPRINTF(line, sizeof(line), "{\"traceEvents\":[\n");
+    file->Write(line, length);
+
+    mutex->Lock();
+    for(vector<ThreadBuffer*>::iterator iter = threadBuffers.begin(); iter != threadBuffers.end(); iter++)
+    {
+        ThreadBuffer* buffer = *iter;
+        if(buffer->CaptureIndex != captureIndex)
+            continue;
+
+        // Thread name metadata
+        if(buffer->Name.empty() == false)
+        {
+            EscapeJsonString(buffer->Name.c_str(), escapedName, sizeof(escapedName));
+            length = GDK_SPRINTF(line, sizeof(line),
+                "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                separator, buffer->ThreadId, escapedName
+                );
+            file->Write(line, length);
+            separator = ",\n";
+        }
+
+        // Zones
+        for(int i = 0; i < buffer->Count; i++)
+        {
+            Event& event = buffer->Events[i];
+            EscapeJsonString(event.Name, escapedName, sizeof(escapedName));
+
+            if(event.Detail[0] != 0)
+            {
+                EscapeJsonString(event.Detail, escapedDetail, sizeof(escapedDetail));
+                length = GDK_SPRINTF(line, sizeof(line),
+                    "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"detail\":\"%s\"}}",
+                    separator, escapedName, event.StartTime * 1000000.0, event.Duration * 1000000.0, buffer->ThreadId, escapedDetail
+                    );
+            }
+            else
+            {
+                length = GDK_SPRINTF(line, sizeof(line),
+                    "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                    separator, escapedName, event.StartTime * 1000000.0, event.Duration * 1000000.0, buffer->ThreadId
+                    );
+            }
+            file->Write(line, length);
+            separator = ",\n";
+        }
+    }
+    mutex->Unlock();
+
+    length = GDK_SPRINTF(line, sizeof(line), "\n],\"displayTimeUnit\":\"ms\"}\n");
+    file->Write(line, length);
+
+    file->Close();
+    GdkDelete(file);
+}
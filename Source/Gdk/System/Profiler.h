@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+
+// Comment this line to compile the profiler zones out of the build
+#define GDK_PROFILER
+
+namespace Gdk
+{
+    class Mutex;
+
+	/// @addtogroup System
+    /// @{
+
+    // =================================================================================
+    ///	@brief
+    ///		Records timed zones of code, from any thread, & exports them as a Chrome trace.
+    ///	@remarks
+    ///		Zones are marked with GDK_PROFILE_SCOPE("Name"), which times the rest of the enclosing scope.
+    ///     Zones nest, so the trace shows where each frame's time went, level by level.  The Application
+    ///     marks the start of each frame with GDK_PROFILE_FRAME().
+    ///   @par
+    ///     Nothing is recorded until BeginCapture() is called.  Each thread records into its own buffer,
+    ///     without taking any locks.  Once EndCapture() is called, ExportChromeTrace() writes the capture in
+    ///     the Trace Event format, which can be opened with chrome://tracing or https://ui.perfetto.dev
+    ///   @par
+    ///     Zone names must be string literals (or otherwise outlive the capture), as only the pointer is recorded.
+    // =================================================================================
+	class Profiler
+	{
+	public:
+
+        // Public Methods
+		// =====================================================
+
+        // ---------------------------------
+        /// @name Capture Methods
+        /// @{
+
+        static void BeginCapture(int maxEventsPerThread = 65536);
+        static void EndCapture();
+        static bool IsCapturing();
+        static void ExportChromeTrace(const char* filePath);
+
+        /// @}
+
+        // ---------------------------------
+        /// @name Recording Methods
+        /// @{
+
+        static void RecordZone(const char* name, const char* detail, double startTime, double endTime);
+        static void MarkFrame();
+        static void SetThreadName(const char* name);
+
+        /// @}
+
+    private:
+
+        // Private Types
+		// =====================================================
+
+        // ***********************************************************************
+        struct Event
+        {
+            const char* Name;
+            double StartTime;           // Seconds since the capture began
+            double Duration;            // Seconds
+            char Detail[40];            // Copy of the zone's detail string  (Empty if none)
+        };
+
+        // ***********************************************************************
+        struct ThreadBuffer
+        {
+            UInt32 ThreadId;
+            string Name;
+            Event* Events;
+            int Capacity;
+            volatile int Count;
+            int Dropped;                // Events that did not fit in the buffer
+            UInt32 CaptureIndex;        // The capture the events belong to
+        };
+
+        // Private Methods
+		// =====================================================
+
+        friend class Application;
+
+        static void Init();
+        static void Shutdown();
+
+        static ThreadBuffer* GetThreadBuffer();
+
+        // Private Properties
+		// =====================================================
+
+        static vector<ThreadBuffer*> threadBuffers;
+        static Mutex* mutex;
+        static volatile bool capturing;
+        static UInt32 captureIndex;
+        static double captureStartTime;
+        static int eventsPerThread;
+        static double frameStartTime;
+	};
+
+    // =================================================================================
+    ///	@brief
+    ///		Times the scope it is declared in, as a Profiler zone
+    /// @remarks
+    ///     Use the GDK_PROFILE_SCOPE() macro, rather than using this class directly.
+    // =================================================================================
+    class ProfileScope
+    {
+    public:
+
+        // *****************************************************************
+        /// @brief
+        ///     Starts timing the zone, if a capture is running
+        /// @param name
+        ///     Name of the zone.  (Must be a string literal)
+        /// @param detail
+        ///     Optional string that is copied into the zone when it ends.  (Such as the name of the resource being loaded)
+        // *****************************************************************
+        ProfileScope(const char* name, const char* detail = NULL)
+            : name(name), detail(detail), startTime(Profiler::IsCapturing() ? HighResTimer::GetSeconds() : -1.0)
+        {
+        }
+
+        // *****************************************************************
+        /// @brief
+        ///     Records the zone
+        // *****************************************************************
+        ~ProfileScope()
+        {
+            if(startTime >= 0.0)
+                Profiler::RecordZone(name, detail, startTime, HighResTimer::GetSeconds());
+        }
+
+    private:
+        const char* name;
+        const char* detail;
+        double startTime;
+    };
+
+    /// @}
+
+} // namespace
+
+
+// =====================================================================
+// Profiler Macros
+
+#define GDK_PROFILE_CONCAT_INNER(a, b)      a##b
+#define GDK_PROFILE_CONCAT(a, b)            GDK_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef GDK_PROFILER
+
+    /// Times the rest of the enclosing scope as a Profiler zone
+    #define GDK_PROFILE_SCOPE(name)                     Gdk::ProfileScope GDK_PROFILE_CONCAT(gdkProfileScope, __LINE__)(name)
+
+    /// Times the rest of the enclosing scope as a Profiler zone, with a detail string  (Such as a resource name)
+    #define GDK_PROFILE_SCOPE_DETAIL(name, detail)      Gdk::ProfileScope GDK_PROFILE_CONCAT(gdkProfileScope, __LINE__)(name, detail)
+
+    /// Marks the start of a new frame
+    #define GDK_PROFILE_FRAME()                         Gdk::Profiler::MarkFrame()
+
+#else
+
+    #define GDK_PROFILE_SCOPE(name)
+    #define GDK_PROFILE_SCOPE_DETAIL(name, detail)
+    #define GDK_PROFILE_FRAME()
+
+#endif
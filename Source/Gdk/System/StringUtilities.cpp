@@ -5,7 +5,7 @@
 
 #include "BasePCH.h"
 #include "StringUtilities.h"
-#include "UTF8/unchecked.h"
+#include "utf8/unchecked.h"
 
 using namespace Gdk;
 
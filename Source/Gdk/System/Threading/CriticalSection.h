@@ -27,11 +27,12 @@ namespace Gdk
     /// @brief
     ///     Starts a critical section
     /// @param SECTION_NAME
-    ///     A unique identifier for the section name
+    ///     A unique identifier for the section name.  This is also the name LockStats records the section under.
     // *****************************************************************
 	#define GDK_BEGIN_CRITICAL_SECTION( SECTION_NAME ) \
 		static pthread_mutex_t SECTION_NAME = PTHREAD_MUTEX_INITIALIZER; \
-		pthread_mutex_lock( &SECTION_NAME );
+		static Gdk::LockProbe SECTION_NAME##Probe = { #SECTION_NAME, NULL, 0.0, 0 }; \
+		Gdk::LockStats::AcquireLock( &SECTION_NAME, &SECTION_NAME##Probe );
 
     // *****************************************************************
     /// @brief
@@ -40,7 +41,7 @@ namespace Gdk
     ///     A unique identifier for the section name
     // *****************************************************************
 	#define GDK_END_CRITICAL_SECTION( SECTION_NAME ) \
-		pthread_mutex_unlock( &SECTION_NAME ) \
+		Gdk::LockStats::ReleaseLock( &SECTION_NAME, &SECTION_NAME##Probe ) \
         ;
 
     /// @}
@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "BasePCH.h"
+#include "LockStats.h"
+
+using namespace Gdk;
+
+// Static Instantiations
+bool LockStats::Enabled = false;
+LockStatsRecord LockStats::records[LOCKSTATS_MAX_LOCKS];
+pthread_mutex_t LockStats::recordMutexes[LOCKSTATS_MAX_LOCKS];
+int LockStats::numRecords = 0;
+pthread_mutex_t LockStats::recordsMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// *****************************************************************
+/// @brief
+///     Gets the record for the locks with the given name, adding one if needed
+/// @return
+///     The record, or NULL if all LOCKSTATS_MAX_LOCKS records are used
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+LockStatsRecord* LockStats::GetRecord(const char* name)
+{
+    LockStatsRecord* record = NULL;
+
+    pthread_mutex_lock(&recordsMutex);
+    for(int index = 0; index < numRecords; index++)
+    {
+        if(strcmp(records[index].Name, name) == 0)
+        {
+            record = &records[index];
+            break;
+        }
+    }
+
+    if(record == NULL && numRecords < LOCKSTATS_MAX_LOCKS)
+    {
+        pthread_mutex_init(&recordMutexes[numRecords], NULL);
+        record = &records[numRecords];
+        memset(record, 0, sizeof(LockStatsRecord));
+        record->Name = name;
+        numRecords++;
+    }
+    pthread_mutex_unlock(&recordsMutex);
+
+    return record;
+}
+
+// *****************************************************************
+/// @brief
+///     Locks a mutex, recording the wait if the lock is named & LockStats is enabled
+/// @param mutex
+///     The mutex to lock
+/// @param probe
+///     The LockStats state of the lock
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void LockStats::AcquireLock(pthread_mutex_t* mutex, LockProbe* probe)
+{
+    // Unrecorded locks go straight to the mutex
+    if(Enabled == false || probe->Name == NULL)
+    {
+        pthread_mutex_lock(mutex);
+        probe->AcquireTime = 0.0;
+        return;
+    }
+
+    if(probe->Record == NULL)
+        probe->Record = GetRecord(probe->Name);
+
+    // Is the lock free?
+    if(pthread_mutex_trylock(mutex) == 0)
+    {
+        probe->AcquireTime = HighResTimer::GetSeconds();
+        probe->OwnerThreadId = Thread::GetCurrentThreadId();
+        return;
+    }
+
+    // Another thread holds the lock, so time the wait for it
+    UInt32 blockingThreadId = probe->OwnerThreadId;
+    double waitStartTime = HighResTimer::GetSeconds();
+    pthread_mutex_lock(mutex);
+    double acquireTime = HighResTimer::GetSeconds();
+
+    probe->AcquireTime = acquireTime;
+    probe->OwnerThreadId = Thread::GetCurrentThreadId();
+
+    if(probe->Record != NULL)
+        AddWait(probe->Record, probe->OwnerThreadId, blockingThreadId, acquireTime - waitStartTime);
+    if(Profiler::IsCapturing())
+        Profiler::RecordZone("Lock Wait", probe->Name, waitStartTime, acquireTime);
+}
+
+// *****************************************************************
+/// @brief
+///     Tries to lock a mutex without waiting, recording the hold if the lock is taken
+/// @return
+///     True if the lock was taken
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+bool LockStats::TryAcquireLock(pthread_mutex_t* mutex, LockProbe* probe)
+{
+    if(pthread_mutex_trylock(mutex) != 0)
+        return false;
+
+    probe->AcquireTime = 0.0;
+    if(Enabled == true && probe->Name != NULL)
+    {
+        if(probe->Record == NULL)
+            probe->Record = GetRecord(probe->Name);
+        probe->AcquireTime = HighResTimer::GetSeconds();
+        probe->OwnerThreadId = Thread::GetCurrentThreadId();
+    }
+    return true;
+}
+
+// *****************************************************************
+/// @brief
+///     Unlocks a mutex, recording how long it was held
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void LockStats::ReleaseLock(pthread_mutex_t* mutex, LockProbe* probe)
+{
+    // Was this hold recorded?
+    double acquireTime = probe->AcquireTime;
+    LockStatsRecord* record = probe->Record;
+    if(acquireTime == 0.0 || record == NULL)
+    {
+        pthread_mutex_unlock(mutex);
+        return;
+    }
+
+    double holdTime = HighResTimer::GetSeconds() - acquireTime;
+    probe->AcquireTime = 0.0;
+    pthread_mutex_unlock(mutex);
+
+    // Add the hold to the record, now that the lock is released
+    pthread_mutex_t* recordMutex = &recordMutexes[record - records];
+    pthread_mutex_lock(recordMutex);
+    record->Acquisitions++;
+    record->TotalHoldTime += holdTime;
+    if(holdTime > record->MaxHoldTime)
+        record->MaxHoldTime = holdTime;
+    pthread_mutex_unlock(recordMutex);
+}
+
+// *****************************************************************
+/// @brief
+///     Adds a contended wait to the record of a lock
+/// @remarks
+///     GDK Internal Use Only
+// *****************************************************************
+void LockStats::AddWait(LockStatsRecord* record, UInt32 threadId, UInt32 blockingThreadId, double waitTime)
+{
+    pthread_mutex_t* recordMutex = &recordMutexes[record - records];
+    pthread_mutex_lock(recordMutex);
+
+    record->Contentions++;
+    record->TotalWaitTime += waitTime;
+    if(waitTime > record->MaxWaitTime)
+        record->MaxWaitTime = waitTime;
+    record->LastBlockingThreadId = blockingThreadId;
+
+    // Add the wait to this thread's contender entry
+    for(int index = 0; index < record->NumContenders; index++)
+    {
+        if(record->Contenders[index].ThreadId == threadId)
+        {
+            record->Contenders[index].Contentions++;
+            record->Contenders[index].WaitTime += waitTime;
+            pthread_mutex_unlock(recordMutex);
+            return;
+        }
+    }
+    if(record->NumContenders < LOCKSTATS_MAX_CONTENDERS)
+    {
+        LockContender& contender = record->Contenders[record->NumContenders++];
+        contender.ThreadId = threadId;
+        contender.Contentions = 1;
+        contender.WaitTime = waitTime;
+    }
+
+    pthread_mutex_unlock(recordMutex);
+}
+
+// *****************************************************************
+/// @brief
+///     Gets a copy of the record of every named lock that has been taken while LockStats was enabled
+// *****************************************************************
+void LockStats::GetStats(vector<LockStatsRecord>& stats)
+{
+    pthread_mutex_lock(&recordsMutex);
+    int count = numRecords;
+    pthread_mutex_unlock(&recordsMutex);
+
+    stats.resize(count);
+    for(int index = 0; index < count; index++)
+    {
+        pthread_mutex_lock(&recordMutexes[index]);
+        stats[index] = records[index];
+        pthread_mutex_unlock(&recordMutexes[index]);
+    }
+}
+
+// *****************************************************************
+/// @brief
+///     Clears the statistics of every lock
+// *****************************************************************
+void LockStats::Reset()
+{
+    pthread_mutex_lock(&recordsMutex);
+    int count = numRecords;
+    pthread_mutex_unlock(&recordsMutex);
+
+    for(int index = 0; index < count; index++)
+    {
+        pthread_mutex_lock(&recordMutexes[index]);
+        const char* name = records[index].Name;
+        memset(&records[index], 0, sizeof(LockStatsRecord));
+        records[index].Name = name;
+        pthread_mutex_unlock(&recordMutexes[index]);
+    }
+}
+
+// *****************************************************************
+/// @brief
+///     Sort predicate that puts the locks with the most wait time first
+// *****************************************************************
+static bool CompareWaitTime(const LockStatsRecord& a, const LockStatsRecord& b)
+{
+    return a.TotalWaitTime > b.TotalWaitTime;
+}
+
+// *****************************************************************
+/// @brief
+///     Writes the statistics of every lock to the log, with the most waited on locks first
+/// @remarks
+///     The times are logged in milliseconds.
+// *****************************************************************
+void LockStats::LogStats()
+{
+    vector<LockStatsRecord> stats;
+    GetStats(stats);
+    sort(stats.begin(), stats.end(), CompareWaitTime);
+
+    LOG_INFO("Lock statistics (ms):");
+    for(vector<LockStatsRecord>::iterator iter = stats.begin(); iter != stats.end(); iter++)
+    {
+        const LockStatsRecord& record = *iter;
+        LOG_INFO("  %-20s acquired %lld  contended %lld  wait %.3f (max %.3f)  hold %.3f (max %.3f)",
+            record.Name, (long long) record.Acquisitions, (long long) record.Contentions,
+            record.TotalWaitTime * 1000.0, record.MaxWaitTime * 1000.0,
+            record.TotalHoldTime * 1000.0, record.MaxHoldTime * 1000.0
+            );
+
+        for(int index = 0; index < record.NumContenders; index++)
+        {
+            const LockContender& contender = record.Contenders[index];
+            LOG_INFO("      thread %u waited %lld times, %.3f", contender.ThreadId, (long long) contender.Contentions, contender.WaitTime * 1000.0);
+        }
+    }
+}
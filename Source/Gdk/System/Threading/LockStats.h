@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+
+// Maximum number of lock names that can be recorded
+#define LOCKSTATS_MAX_LOCKS         64
+
+// Maximum number of waiting threads recorded per lock
+#define LOCKSTATS_MAX_CONTENDERS    8
+
+namespace Gdk
+{
+	/// @addtogroup System
+    /// @{
+    /// @addtogroup Threading
+    /// @{
+
+    // =================================================================================
+    ///	@brief
+    ///		A thread that had to wait for a lock, & how long it waited
+    // =================================================================================
+    struct LockContender
+    {
+        UInt32 ThreadId;
+        Int64 Contentions;
+        double WaitTime;
+    };
+
+    // =================================================================================
+    ///	@brief
+    ///		Statistics of all the locks with a given name
+    ///	@remarks
+    ///		All times are in seconds.  A contention is an acquisition that had to wait for another thread
+    ///     to release the lock.
+    // =================================================================================
+    struct LockStatsRecord
+    {
+        const char* Name;
+
+        Int64 Acquisitions;
+        Int64 Contentions;
+        double TotalWaitTime;
+        double MaxWaitTime;
+        double TotalHoldTime;
+        double MaxHoldTime;
+
+        /// The thread that held the lock, the last time another thread had to wait for it
+        UInt32 LastBlockingThreadId;
+
+        /// The threads that waited for the lock  (The first LOCKSTATS_MAX_CONTENDERS of them)
+        LockContender Contenders[LOCKSTATS_MAX_CONTENDERS];
+        int NumContenders;
+    };
+
+    // =================================================================================
+    ///	@brief
+    ///		Per lock instance state used by LockStats  (GDK Internal Use Only)
+    // =================================================================================
+    struct LockProbe
+    {
+        const char* Name;
+        LockStatsRecord* Record;    // Looked up by name, the first time the lock is taken with LockStats enabled
+        double AcquireTime;         // When the current owner got the lock  (0 = not being recorded)
+        UInt32 OwnerThreadId;
+    };
+
+    // =================================================================================
+    ///	@brief
+    ///		Records how long threads wait for, & hold, named locks
+    ///	@remarks
+    ///		Mutexes created with a name, and GDK critical sections, are recorded by name while Enabled
+    ///     is true.  Locks that share a name share a record, so (for example) the mutexes of every
+    ///     instance of a class can be measured together.
+    ///   @par
+    ///     While the Profiler is capturing, each contended wait is also recorded as a "Lock Wait" zone,
+    ///     with the lock name as the detail.  LogStats() writes the records to the log.
+    // =================================================================================
+	class LockStats
+	{
+	public:
+
+        // Public Properties
+		// =====================================================
+
+        /// Should lock waits & holds be recorded?  (Default = false)
+        static bool Enabled;
+
+        // Public Methods
+		// =====================================================
+
+        // ---------------------------------
+        /// @name Statistics Methods
+        /// @{
+
+        static void GetStats(vector<LockStatsRecord>& stats);
+        static void LogStats();
+        static void Reset();
+
+        /// @}
+
+		// INTERNAL ONLY - Lock Interfaces
+		// =====================================================
+
+        /// @cond INTERNAL
+
+        // ---------------------------------
+        /// @name Internal Lock Methods
+        /// @{
+
+        static void AcquireLock(pthread_mutex_t* mutex, LockProbe* probe);
+        static bool TryAcquireLock(pthread_mutex_t* mutex, LockProbe* probe);
+        static void ReleaseLock(pthread_mutex_t* mutex, LockProbe* probe);
+
+        /// @}
+
+        /// @endcond
+
+    private:
+
+        // Private Methods
+		// =====================================================
+
+        static LockStatsRecord* GetRecord(const char* name);
+        static void AddWait(LockStatsRecord* record, UInt32 threadId, UInt32 blockingThreadId, double waitTime);
+
+        // Private Properties
+		// =====================================================
+
+        static LockStatsRecord records[LOCKSTATS_MAX_LOCKS];    // Never freed, as static locks keep pointers to their records
+        static pthread_mutex_t recordMutexes[LOCKSTATS_MAX_LOCKS];  // Guard the updates of each record
+        static int numRecords;
+        static pthread_mutex_t recordsMutex;
+	};
+
+    /// @}
+    /// @}
+
+} // namespace Gdk
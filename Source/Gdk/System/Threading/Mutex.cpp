@@ -28,8 +28,11 @@ Mutex::~Mutex()
 // *****************************************************************
 /// @brief
 ///     Creates a new mutex
+/// @param name
+///     Name the mutex is recorded under by LockStats.  (Must be a string literal)  Unnamed mutexes 
+///     are not recorded.
 // *****************************************************************
-Mutex* Mutex::Create()
+Mutex* Mutex::Create(const char* name)
 {
 	// Create the mutex
 	Mutex* mutex = GdkNew Mutex();
@@ -37,6 +40,10 @@ Mutex* Mutex::Create()
 	// Create the pthread mutex
 	pthread_mutex_init(&mutex->internalMutex, NULL);
 
+	// Setup the LockStats probe
+	memset(&mutex->probe, 0, sizeof(LockProbe));
+	mutex->probe.Name = name;
+
 	return mutex;
 }
 
@@ -47,7 +54,7 @@ Mutex* Mutex::Create()
 void Mutex::Lock()
 {
 	// Lock the mutex
-	pthread_mutex_lock(&this->internalMutex);
+	LockStats::AcquireLock(&this->internalMutex, &this->probe);
 }
 
 // *****************************************************************
@@ -59,10 +66,7 @@ void Mutex::Lock()
 bool Mutex::TryLock()
 {
 	// Lock the mutex
-	int result = pthread_mutex_trylock(&this->internalMutex);
-	if(result == EBUSY)
-		return false;
-	return true;
+	return LockStats::TryAcquireLock(&this->internalMutex, &this->probe);
 }
 
 // *****************************************************************
@@ -71,6 +75,6 @@ bool Mutex::TryLock()
 // *****************************************************************
 void Mutex::Unlock()
 {
-	// Lock the mutex
-	pthread_mutex_unlock(&this->internalMutex);
+	// Unlock the mutex
+	LockStats::ReleaseLock(&this->internalMutex, &this->probe);
 }
\ No newline at end of file
@@ -17,6 +17,8 @@ namespace Gdk
 	// =================================================================================
     ///	@brief
     ///		A synchronization mechanism for guarding non-thread safe resources
+    ///	@remarks
+    ///		Mutexes created with a name have their contention recorded by LockStats.
     // =================================================================================
     class Mutex
 	{
@@ -36,7 +38,7 @@ namespace Gdk
         void Lock();
         bool TryLock();
         void Unlock();
-		static Mutex* Create();
+		static Mutex* Create(const char* name = NULL);
 
         /// @}
         
@@ -49,6 +51,7 @@ namespace Gdk
 
 		// Properties
 		pthread_mutex_t internalMutex;
+		LockProbe probe;
 	};
 
 	// TODO(P2):  Timeout based locking : pthread_mutex_timedlock()
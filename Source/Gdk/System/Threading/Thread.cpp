@@ -6,6 +6,11 @@
 #include "BasePCH.h"
 #include "../Logging.h"
 #include "Thread.h"
+#include "Event.h"
+
+#ifdef GDKPLATFORM_LINUX
+    #include <sys/syscall.h>
+#endif
 
 
 using namespace Gdk;
@@ -18,6 +23,7 @@ using namespace Gdk;
 Thread::Thread()
 {
     memset(&this->internalThreadId, 0, sizeof(pthread_t));
+    this->threadId = 0;
 }
 
 // *****************************************************************
@@ -27,6 +33,7 @@ Thread::Thread()
 Thread::Thread(const Thread& original)
 {
 	this->internalThreadId = original.internalThreadId;
+	this->threadId = original.threadId;
 }
 
 // *****************************************************************
@@ -36,6 +43,7 @@ Thread::Thread(const Thread& original)
 Thread& Thread::operator= (const Thread& input)
 {
 	this->internalThreadId = input.internalThreadId;
+	this->threadId = input.threadId;
 	return *this;
 }
 
@@ -43,7 +51,12 @@ Thread& Thread::operator= (const Thread& input)
 struct ThreadLaunchData
 {
 	Thread::Delegate* ThreadDelegate;
+	void* (*ThreadFunction)(void*);
 	void* ThreadArgument;
+
+	// Set by the new thread once it has started, before it runs the delegate / function
+	UInt32 ThreadId;
+	Event* Started;
 };
 
 // ===================================================================================
@@ -52,20 +65,58 @@ void *Gdk_Thread_ThreadFunction(void* arg)
 	// Get the launch data
 	ThreadLaunchData* launchData = (ThreadLaunchData*) arg;
 	Thread::Delegate* threadDelegate = launchData->ThreadDelegate;
+	void* (*threadFunction)(void*) = launchData->ThreadFunction;
 	void* threadArgument = launchData->ThreadArgument;
 
-	// Destroy the launch data struct
-	GdkDelete(launchData);
+	// Pass our id back to the creating thread.  (Which owns the launch data, & destroys it once it is signalled)
+	launchData->ThreadId = Thread::GetCurrentThreadId();
+	launchData->Started->Set();
 
-	// Call the delegate
-	return threadDelegate->Invoke(threadArgument);
+	// Call the delegate / function
+	if(threadDelegate != NULL)
+		return threadDelegate->Invoke(threadArgument);
+	return threadFunction(threadArgument);
+}
+
+// ===================================================================================
+Thread Thread::Launch(Thread::Delegate* threadDelegate, void* threadFunction(void*), void* argument, bool createDetached)
+{
+	// Setup the thread attributes
+	pthread_attr_t attributes;
+	pthread_attr_init(&attributes);
+	pthread_attr_setdetachstate(&attributes, createDetached ? PTHREAD_CREATE_DETACHED : PTHREAD_CREATE_JOINABLE);
+	
+	// Setup the launch data
+	ThreadLaunchData launchData;
+	launchData.ThreadDelegate = threadDelegate;
+	launchData.ThreadFunction = threadFunction;
+	launchData.ThreadArgument = argument;
+	launchData.ThreadId = 0;
+	launchData.Started = Event::Create();
+
+	// Create the thread, & wait for it to start & report its id
+	Thread thread;
+	if(pthread_create(&thread.internalThreadId, &attributes, Gdk_Thread_ThreadFunction, (void*)&launchData) == 0)
+	{
+		launchData.Started->Wait();
+		thread.threadId = launchData.ThreadId;
+	}
+	else
+		LOG_ERROR("Unable to create a thread");
+	
+	// Cleanup
+	GdkDelete(launchData.Started);
+	pthread_attr_destroy(&attributes);
+
+	return thread;
 }
 
 // *****************************************************************
 /// @brief
 ///     Creates a new thread.
 /// @remarks
-///     The caller is responsible for cleaning the delegate* when the thread finishes
+///     The caller is responsible for cleaning the delegate* when the thread finishes.
+///     Returns once the thread has started, so that GetId() is valid.
 /// @param threadDelegate
 ///     A delegate that will be run in the thread
 /// @param argument
@@ -75,31 +126,15 @@ void *Gdk_Thread_ThreadFunction(void* arg)
 // *****************************************************************
 Thread Thread::Create(Thread::Delegate* threadDelegate, void* argument, bool createDetached)
 {
-	
-	// Setup the thread attributes
-	pthread_attr_t attributes;
-	pthread_attr_init(&attributes);
-	pthread_attr_setdetachstate(&attributes, createDetached ? PTHREAD_CREATE_DETACHED : PTHREAD_CREATE_JOINABLE);
-	
-	// Create a ThreadLaunchData
-	ThreadLaunchData* launchData = GdkNew ThreadLaunchData;
-	launchData->ThreadDelegate = threadDelegate;
-	launchData->ThreadArgument = argument;
-
-	// Create the thread
-	Thread thread;
-	pthread_create(&thread.internalThreadId, &attributes, Gdk_Thread_ThreadFunction, (void*)launchData);
-	
-	// Release the thread attributes
-	pthread_attr_destroy(&attributes);
-
-	return thread;
+	return Launch(threadDelegate, NULL, argument, createDetached);
 }
 
 
 // *****************************************************************
 /// @brief
 ///     Creates a new thread.
+/// @remarks
+///     Returns once the thread has started, so that GetId() is valid.
 /// @param threadFunction
 ///     A function or static class method that will be executed in the thread.
 /// @param argument
@@ -109,19 +144,7 @@ Thread Thread::Create(Thread::Delegate* threadDelegate, void* argument, bool cre
 // *****************************************************************
 Thread Thread::Create(void* threadFunction(void*), void* argument, bool createDetached)
 {
-	// Setup the thread attributes
-	pthread_attr_t attributes;
-	pthread_attr_init(&attributes);
-	pthread_attr_setdetachstate(&attributes, createDetached ? PTHREAD_CREATE_DETACHED : PTHREAD_CREATE_JOINABLE);
-	
-	// Create the thread
-	Thread thread;
-	pthread_create(&thread.internalThreadId, &attributes, threadFunction, argument);
-	
-	// Release the thread attributes
-	pthread_attr_destroy(&attributes);
-
-	return thread;
+	return Launch(NULL, threadFunction, argument, createDetached);
 }
 
 // *****************************************************************
@@ -155,32 +178,34 @@ void Thread::Detach()
 /// @brief
 ///     Gets a unique identifier for the thread
 /// @remarks
-///     The calling thread will block and wait for the given thread to finish
+///     This is the id the thread got from GetCurrentThreadId() when it started, so the two can be compared
 // *****************************************************************
 UInt32 Thread::GetId()
 {
-	// Get the thread ID as a UInt32
-#ifdef GDKPLATFORM_WINDOWS
-    return (UInt32) internalThreadId.p;
-#else
-    return (UInt32) internalThreadId->__sig;
-#endif
+	return this->threadId;
 }
 
 // *****************************************************************
 /// @brief
 ///     Gets the unique ID of the current executing thread
+/// @remarks
+///     On Linux this is the kernel's thread id, as shown by top & gdb.  (A pthread_t is a pointer there, and
+///     truncating it to 32 bits wouldn't be unique)
 // *****************************************************************
 UInt32 Thread::GetCurrentThreadId()
 {
+#ifdef GDKPLATFORM_LINUX
+    return (UInt32) syscall(SYS_gettid);
+#else
 	// Get the current thread
 	pthread_t currentThreadId = pthread_self();
 	
 	// Return the thread ID as a UInt32
-#ifdef GDKPLATFORM_WINDOWS
+    #ifdef GDKPLATFORM_WINDOWS
     return (UInt32) currentThreadId.p;
-#else
+    #else
     return (UInt32) currentThreadId->__sig;
+    #endif
 #endif
 }
 
@@ -66,9 +66,11 @@ namespace Gdk
         
         Thread();
 
+        static Thread Launch(Thread::Delegate* threadDelegate, void* threadFunction(void*), void* argument, bool createDetached);
 
 		// Properties
 		pthread_t internalThreadId;
+		UInt32 threadId;
 	};
     
     /// @}
@@ -37,13 +37,19 @@ namespace Gdk
         ///     Constructs a new threaded work queue
         /// @param numThreads
         ///     Number of threads to create for handling work items. (Typically 2-4)
+        /// @param name
+        ///     Name of the queue  (Must be a string literal)  The queue's lock is recorded under this name
+        ///     by LockStats, and the worker threads are named after it in the Profiler.
         // *****************************************************************
-        ThreadedWorkQueue(int numThreads)
+        ThreadedWorkQueue(int numThreads, const char* name)
         {
+            this->name = name;
+            
             // Create the thread sync objects
-            queueMutex = Mutex::Create();
+            queueMutex = Mutex::Create(name);
             signalEvent = Event::Create();
             shutdownRequest = false;
+            nextWorkerIndex = 0;
             
             // Create the worker threads
             for(int threadIndex=0; threadIndex < numThreads; threadIndex++)
@@ -169,6 +175,15 @@ namespace Gdk
             // Get the ThreadedWorkQueue (passed in through the void*)
             ThreadedWorkQueue<TWorkItem>* workQueue = (ThreadedWorkQueue<TWorkItem>*)data;
             
+            // Name the thread by its index in the queue, so the workers can be told apart in a trace
+            workQueue->queueMutex->Lock();
+            int workerIndex = workQueue->nextWorkerIndex++;
+            workQueue->queueMutex->Unlock();
+            
+            char threadName[64];
+            GDK_SNPRINTF(threadName, sizeof(threadName), "%s Worker %d", workQueue->name, workerIndex);
+            Profiler::SetThreadName(threadName);
+            
             // Loop forever
             while(1)
             {
@@ -212,7 +227,10 @@ namespace Gdk
                     workQueue->queueMutex->Unlock();
                     
                     // Do the work for this item
-                    workQueue->OnProcessWorkItem(queueEntry.Data);
+                    {
+                        GDK_PROFILE_SCOPE("ThreadedWorkQueue::ProcessWorkItem");
+                        workQueue->OnProcessWorkItem(queueEntry.Data);
+                    }
                     
                 } // while(1) - working loop
                 
@@ -253,11 +271,15 @@ namespace Gdk
         // The work item queue
         WorkItemPriorityQueue workItemQueue;
         
+        // Name of the queue
+        const char* name;
+        
         // Thread controls
         vector<Thread> threads;
         Mutex* queueMutex;
         Event* signalEvent;
         bool shutdownRequest;
+        int nextWorkerIndex;                // Index given to the next worker thread to start
         
         
 	};
@@ -63,11 +63,10 @@ double HighResTimer::GetSeconds()
 
 double HighResTimer::GetSeconds()
 {
-	// TODO(Android)
-
-	// use these methods...
-	int clock_getres(clockid_t clock_id, struct timespec *res);
-	int clock_gettime(clockid_t clock_id, struct timespec *tp);
+	// Get the current time, from the monotonic clock  (Unaffected by changes to the system time)
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+
+// Includes
+#include "BasePCH.h"
+
+#include <limits.h>
+#include <sys/utsname.h>
+
+using namespace std;
+using namespace Gdk;
+
+// Globals
+GLuint g_frameBufferId = 0;
+GLuint g_colorRenderBufferId = 0;
+GLuint g_depthRenderBufferId = 0;
+
+// Prototypes
+void ResizeOffscreenBuffers(int width, int height);
+string ReadFirstLine(const char* filePath);
+
+/// ===========================================================
+///
+/// IO
+///
+/// ===========================================================
+
+string _Gdk_Platform_IO_GetCommonPath(CommonPaths::Enum commonPath)
+{
+	// Get the full path of the executable
+	char exeFilePath[PATH_MAX + 1];
+	ssize_t length = readlink("/proc/self/exe", exeFilePath, PATH_MAX);
+	exeFilePath[length > 0 ? length : 0] = 0;
+
+	// Get the directory of the executable
+	string exeFolder = Path::GetDirectory(exeFilePath);
+
+	// Which path is the user asking for?
+	switch(commonPath)
+	{
+        case CommonPaths::ApplicationFolder:
+			return exeFolder;
+
+		case CommonPaths::AssetFolder:
+			return Path::Combine(exeFolder.c_str(), "Assets");
+
+		case CommonPaths::WorkingFolder:
+			return Path::Combine(exeFolder.c_str(), "Data");
+	}
+
+	return string();
+}
+
+
+/// ===========================================================
+///
+/// Window / Application Methods
+///
+/// ===========================================================
+
+void _Gdk_Platform_SetTitle(const char* title)
+{
+	// No window to put the title on
+	GDK_NOT_USED(title);
+}
+
+// ---------------------------------------------------
+void _Gdk_Platform_Resize(int width, int height)
+{
+	// Resize the off-screen frame buffer, which stands in for the window
+	ResizeOffscreenBuffers(width, height);
+	Application::Platform_OnResize(width, height);
+}
+
+/// ===========================================================
+///
+/// Mouse Methods
+///
+/// ===========================================================
+
+// ---------------------------------------------------
+void _Gdk_Platform_Mouse_SetPosition(int x, int y)
+{
+	// There is no cursor, so just tell the GDK the mouse moved
+	Mouse::Platform_ProcessMouseMove(x, y);
+}
+
+// ---------------------------------------------------
+void _Gdk_Platform_Mouse_ShowCursor(bool show)
+{
+	// No cursor
+	GDK_NOT_USED(show);
+}
+
+/// ===========================================================
+///
+/// Device
+///
+/// ===========================================================
+
+// ---------------------------------------------------
+Gdk::DeviceType::Enum _Gdk_Platform_Device_GetDeviceType()
+{
+	return DeviceType::PC;
+}
+
+// ---------------------------------------------------
+Gdk::PlatformType::Enum _Gdk_Platform_Device_GetPlatformType()
+{
+	return PlatformType::Linux;
+}
+
+// ---------------------------------------------------
+Gdk::PlatformVersion _Gdk_Platform_Device_GetPlatformVersion()
+{
+	// Get the kernel version  (The release is "major.minor.revision-...")
+	struct utsname systemName;
+	unsigned int majorVersion = 0, minorVersion = 0, revision = 0;
+	if(uname(&systemName) == 0)
+		GDK_SSCANF(systemName.release, "%u.%u.%u", &majorVersion, &minorVersion, &revision);
+
+	return PlatformVersion(majorVersion, minorVersion, revision);
+}
+
+// ---------------------------------------------------
+string _Gdk_Platform_Device_GetDeviceDisplayName()
+{
+	char hostName[256];
+	if(gethostname(hostName, sizeof(hostName)) == 0)
+	{
+		hostName[sizeof(hostName) - 1] = 0;
+		return string(hostName);
+	}
+
+	return StringUtilities::Unknown;
+}
+
+// ---------------------------------------------------
+string _Gdk_Platform_Device_GetDeviceUniqueId()
+{
+	// The machine id is unique to the installation, and stays the same across reboots
+	string machineId = ReadFirstLine("/etc/machine-id");
+	if(machineId.empty())
+		machineId = ReadFirstLine("/var/lib/dbus/machine-id");
+
+	return machineId;
+}
+
+// ---------------------------------------------------
+Gdk::DeviceBatteryState::Enum _Gdk_Platform_Device_GetBatteryState()
+{
+	// No battery?  Then we're on mains power
+	string status = ReadFirstLine("/sys/class/power_supply/BAT0/status");
+	if(status.empty())
+		return Gdk::DeviceBatteryState::Charging;
+
+	if(status == "Discharging")
+		return Gdk::DeviceBatteryState::Unplugged;
+	return Gdk::DeviceBatteryState::Charging;
+}
+
+// ---------------------------------------------------
+float _Gdk_Platform_Device_GetBatteryLevel()
+{
+	// Convert the 0-100 capacity to a 0.0 - 1.0 float value
+	string capacity = ReadFirstLine("/sys/class/power_supply/BAT0/capacity");
+	if(capacity.empty())
+		return 1.0f;
+
+	return atoi(capacity.c_str()) / 100.0f;
+}
+
+// ---------------------------------------------------
+void _Gdk_Platform_Device_Vibrate()
+{
+	// No vibration on servers :)
+}
+
+
+/// ===========================================================
+///
+/// Off-screen Frame Buffer  (Stands in for the window, which headless Linux doesn't have)
+///
+/// ===========================================================
+
+// ---------------------------------------------------
+bool CreateOffscreenBuffers(int width, int height)
+{
+	glGenFramebuffers(1, &g_frameBufferId);
+	glGenRenderbuffers(1, &g_colorRenderBufferId);
+	glGenRenderbuffers(1, &g_depthRenderBufferId);
+	ResizeOffscreenBuffers(width, height);
+
+	// Attach the render buffers
+	glBindFramebuffer(GL_FRAMEBUFFER, g_frameBufferId);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, g_colorRenderBufferId);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, g_depthRenderBufferId);
+
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	if(status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		LOG_ERROR("The off-screen frame buffer is incomplete: 0x%04x", status);
+		return false;
+	}
+
+	return true;
+}
+
+// ---------------------------------------------------
+void ResizeOffscreenBuffers(int width, int height)
+{
+	// 8 bit color, if the driver has it
+	const char* extensions = (const char*) glGetString(GL_EXTENSIONS);
+	GLenum colorFormat = (extensions != NULL && strstr(extensions, "GL_OES_rgb8_rgba8") != NULL) ? GL_RGBA8_OES : GL_RGBA4;
+
+	glBindRenderbuffer(GL_RENDERBUFFER, g_colorRenderBufferId);
+	glRenderbufferStorage(GL_RENDERBUFFER, colorFormat, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, g_depthRenderBufferId);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT16, width, height);
+}
+
+// ---------------------------------------------------
+void DestroyOffscreenBuffers()
+{
+	if(g_frameBufferId == 0)
+		return;
+
+	glDeleteFramebuffers(1, &g_frameBufferId);
+	glDeleteRenderbuffers(1, &g_colorRenderBufferId);
+	glDeleteRenderbuffers(1, &g_depthRenderBufferId);
+	g_frameBufferId = g_colorRenderBufferId = g_depthRenderBufferId = 0;
+}
+
+
+
+
+
+
+// =====================================================================================
+string ReadFirstLine(const char* filePath)
+{
+	FILE* file = fopen(filePath, "r");
+	if(file == NULL)
+		return StringUtilities::Empty;
+
+	char line[256];
+	string result;
+	if(fgets(line, sizeof(line), file) != NULL)
+	{
+		// Trim the line ending
+		size_t length = strlen(line);
+		while(length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r'))
+			line[--length] = 0;
+		result = line;
+	}
+
+	fclose(file);
+	return result;
+}
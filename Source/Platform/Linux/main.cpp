@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+//
+// Headless Linux host.  There is no window & no input devices:  The game renders into an off-screen
+// frame buffer, through an EGL context that needs no display server.  (Mesa's surfaceless platform, when
+// it's available)  For dedicated servers, build machine perf runs, and batch content validation.
+//
+// Built with GDK_NULL_GRAPHICS, there is no EGL or GL driver at all:  The GL commands go to the null graphics
+// device, which counts & captures them.  (See GLCommandRecorder)
+//
+// Usage:
+//
+//      GAMENAME [-frames count] [-record file] [-playback file]
+//
+//          -frames count       Exit after this many frames  (Default = run until Application::Exit() or SIGINT / SIGTERM)
+//          -record file        Record the input & frame times to a file  (Overrides ApplicationSettings::InputRecordFile)
+//          -playback file      Play back an input recording, then exit  (Overrides ApplicationSettings::InputPlaybackFile)
+//
+
+// Includes
+#include "BasePCH.h"
+
+#include <signal.h>
+#ifndef GDK_NULL_GRAPHICS
+	#include <EGL/egl.h>
+	#include <EGL/eglext.h>
+#endif
+
+using namespace std;
+
+// Function Declarations
+bool InitEGL();
+void ShutdownEGL();
+bool CreateOffscreenBuffers(int width, int height);
+void DestroyOffscreenBuffers();
+void OnQuitSignal(int signalNumber);
+
+// Globals
+#ifndef GDK_NULL_GRAPHICS
+EGLDisplay g_eglDisplay = EGL_NO_DISPLAY;
+EGLContext g_eglContext = EGL_NO_CONTEXT;
+EGLSurface g_eglSurface = EGL_NO_SURFACE;
+#endif
+volatile sig_atomic_t g_quitSignal = 0;
+
+// Off-screen frame buffer  (In PlatformImpl.cpp)
+extern GLuint g_frameBufferId;
+extern GLuint g_colorRenderBufferId;
+extern GLuint g_depthRenderBufferId;
+
+// ******************************************************************************
+int main(int argc, char** argv)
+{
+	bool quit = false;
+	int maxFrames = 0;
+	const char* recordFile = NULL;
+	const char* playbackFile = NULL;
+
+	// Parse the command line
+	for(int argIndex = 1; argIndex < argc; argIndex++)
+	{
+		if(strcmp(argv[argIndex], "-frames") == 0 && argIndex + 1 < argc)
+			maxFrames = atoi(argv[++argIndex]);
+		else if(strcmp(argv[argIndex], "-record") == 0 && argIndex + 1 < argc)
+			recordFile = argv[++argIndex];
+		else if(strcmp(argv[argIndex], "-playback") == 0 && argIndex + 1 < argc)
+			playbackFile = argv[++argIndex];
+		else
+		{
+			printf("Usage: %s [-frames count] [-record file] [-playback file]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	// Start up the GDK
+	if(Gdk::Application::Platform_InitGdk() == false)
+		return 1;
+
+	// Get the GDK application settings
+	Gdk::ApplicationSettings* appSettings = Gdk::Application::Platform_GetInitialAppSettings();
+	if(recordFile != NULL)
+		appSettings->InputRecordFile = recordFile;
+	if(playbackFile != NULL)
+		appSettings->InputPlaybackFile = playbackFile;
+
+	// Exit cleanly on Ctrl-C, or when the service is stopped
+	signal(SIGINT, OnQuitSignal);
+	signal(SIGTERM, OnQuitSignal);
+
+	// Enable OpenGL ES
+	// -----------------------------------------------------
+
+	if(InitEGL() == false || CreateOffscreenBuffers(Gdk::Application::GetWidth(), Gdk::Application::GetHeight()) == false)
+	{
+		ShutdownEGL();
+		Gdk::Application::Platform_ShutdownGdk();
+		return 1;
+	}
+
+	// Tell the GDK about the off-screen frame & render buffers
+	Gdk::Graphics::Platform_SetOSFrameBuffers(g_frameBufferId, g_colorRenderBufferId, g_depthRenderBufferId, 0);
+
+	// -------------------------------------
+
+	// Exception handle
+	try
+	{
+		// Init the application
+		// ----------------------------------------
+
+		if(Gdk::Application::Platform_InitGame() == true)
+		{
+			// Set the application as active
+			Gdk::Application::Platform_OnActive();
+
+			// Main loop
+			// ----------------------------------------
+
+			int frameCount = 0;
+			while ( !quit )
+			{
+				// Update the gdk host
+				Gdk::Application::Platform_MainLoop();
+
+				// Is there an exit request in the gdk host, or from a signal?
+				if(Gdk::Application::IsExitRequest() == true || g_quitSignal != 0)
+				{
+					// Set the quit flag
+					quit = true;
+				}
+				else
+				{
+					// There is nothing to swap, so wait for the frame's rendering to finish instead
+					Gdk::FrameStats::Platform_BeginPresent();
+					glFinish();
+					Gdk::FrameStats::Platform_EndPresent();
+
+					// Have we run the requested number of frames?
+					frameCount++;
+					if(maxFrames > 0 && frameCount >= maxFrames)
+						quit = true;
+				}
+
+			} // Main Loop
+
+		} // if(init)
+
+		// Shutdown the application
+		Gdk::Application::Platform_ShutdownGame();
+	}
+	// Catch any standard C++ exceptions
+	catch (exception& ex)
+	{
+		// Log the exception
+		LOG_ERROR("C++ Exception caught!!");
+		LOG_ERROR("C++ Exception: %s", ex.what());
+
+		#if !defined(DEBUG)
+			GDK_NOT_USED(ex);
+		#endif
+	}
+	catch(...)
+	{
+		// Log the exception
+		LOG_ERROR("Unknown Exception caught!!");
+	}
+
+	// Shutdown GDK
+	Gdk::Application::Platform_ShutdownGdk();
+
+	// Shutdown OpenGL ES
+	DestroyOffscreenBuffers();
+	ShutdownEGL();
+
+	return 0;
+}
+
+#ifdef GDK_NULL_GRAPHICS
+
+// **************************************************************************************
+bool InitEGL()
+{
+	// The null graphics device needs no context
+	LOG_INFO("Null graphics device:  GL commands are recorded, not rendered");
+	return true;
+}
+
+// **************************************************************************************
+void ShutdownEGL()
+{
+}
+
+#else
+
+// **************************************************************************************
+bool InitEGL()
+{
+	// Use the surfaceless platform if we can, as it doesn't need a display server
+	const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+	if(clientExtensions != NULL && strstr(clientExtensions, "EGL_MESA_platform_surfaceless") != NULL)
+	{
+		PFNEGLGETPLATFORMDISPLAYEXTPROC eglGetPlatformDisplayEXT = (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+		if(eglGetPlatformDisplayEXT != NULL)
+			g_eglDisplay = eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+	}
+	if(g_eglDisplay == EGL_NO_DISPLAY)
+		g_eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+	EGLint majorVersion, minorVersion;
+	if(g_eglDisplay == EGL_NO_DISPLAY || eglInitialize(g_eglDisplay, &majorVersion, &minorVersion) == EGL_FALSE)
+	{
+		LOG_ERROR("Failed to initialize EGL: 0x%04x", eglGetError());
+		return false;
+	}
+	eglBindAPI(EGL_OPENGL_ES_API);
+
+	// Without surfaceless contexts, the context is made current on a 1x1 pbuffer
+	const char* displayExtensions = eglQueryString(g_eglDisplay, EGL_EXTENSIONS);
+	bool surfaceless = displayExtensions != NULL && strstr(displayExtensions, "EGL_KHR_surfaceless_context") != NULL;
+
+	// Choose a config
+	EGLint configAttributes[] =
+	{
+		EGL_RENDERABLE_TYPE,	EGL_OPENGL_ES2_BIT,
+		EGL_SURFACE_TYPE,		surfaceless ? 0 : EGL_PBUFFER_BIT,
+		EGL_NONE
+	};
+	EGLConfig config;
+	EGLint numConfigs = 0;
+	if(eglChooseConfig(g_eglDisplay, configAttributes, &config, 1, &numConfigs) == EGL_FALSE || numConfigs == 0)
+	{
+		LOG_ERROR("No EGL config supports OpenGL ES 2.0: 0x%04x", eglGetError());
+		return false;
+	}
+
+	// Create the OpenGL ES 2.0 context
+	EGLint contextAttributes[] = { EGL_CONTEXT_CLIENT_VERSION, 2, EGL_NONE };
+	g_eglContext = eglCreateContext(g_eglDisplay, config, EGL_NO_CONTEXT, contextAttributes);
+	if(g_eglContext == EGL_NO_CONTEXT)
+	{
+		LOG_ERROR("Failed to create the OpenGL ES context: 0x%04x", eglGetError());
+		return false;
+	}
+
+	if(surfaceless == false)
+	{
+		EGLint pbufferAttributes[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+		g_eglSurface = eglCreatePbufferSurface(g_eglDisplay, config, pbufferAttributes);
+		if(g_eglSurface == EGL_NO_SURFACE)
+		{
+			LOG_ERROR("Failed to create the EGL pbuffer: 0x%04x", eglGetError());
+			return false;
+		}
+	}
+
+	// Make the context current
+	if(eglMakeCurrent(g_eglDisplay, g_eglSurface, g_eglSurface, g_eglContext) == EGL_FALSE)
+	{
+		LOG_ERROR("Failed to make the OpenGL ES context current: 0x%04x", eglGetError());
+		return false;
+	}
+
+	LOG_INFO("EGL %d.%d, %s  (%s)", majorVersion, minorVersion, (const char*) glGetString(GL_RENDERER), surfaceless ? "Surfaceless" : "Pbuffer");
+	return true;
+}
+
+// **************************************************************************************
+void ShutdownEGL()
+{
+	if(g_eglDisplay == EGL_NO_DISPLAY)
+		return;
+
+	eglMakeCurrent(g_eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	if(g_eglSurface != EGL_NO_SURFACE)
+		eglDestroySurface(g_eglDisplay, g_eglSurface);
+	if(g_eglContext != EGL_NO_CONTEXT)
+		eglDestroyContext(g_eglDisplay, g_eglContext);
+	eglTerminate(g_eglDisplay);
+
+	g_eglSurface = EGL_NO_SURFACE;
+	g_eglContext = EGL_NO_CONTEXT;
+	g_eglDisplay = EGL_NO_DISPLAY;
+}
+
+#endif // GDK_NULL_GRAPHICS
+
+// **************************************************************************************
+void OnQuitSignal(int signalNumber)
+{
+	GDK_NOT_USED(signalNumber);
+	g_quitSignal = 1;
+}
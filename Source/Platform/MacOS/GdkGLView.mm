@@ -42,7 +42,9 @@ extern NSWindow*    _Gdk_Mac_MainWindow;
     Gdk::Application::Platform_MainLoop();
     
     // Present the GL Rendering
+    Gdk::FrameStats::Platform_BeginPresent();
 	CGLFlushDrawable(cglContext);
+    Gdk::FrameStats::Platform_EndPresent();
     
     // Unlock the mutex
 	CGLUnlockContext(cglContext);
@@ -260,7 +260,9 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance,
 					else
 					{
 						// Swap the front/back buffers
+						Gdk::FrameStats::Platform_BeginPresent();
 						SwapBuffers( hDC );
+						Gdk::FrameStats::Platform_EndPresent();
 					}
 				}
 
@@ -170,7 +170,9 @@
     Gdk::Application::Platform_MainLoop();
     
     // Present the frame buffer
+    Gdk::FrameStats::Platform_BeginPresent();
     [(GdkGLView *)self.view presentFramebuffer];
+    Gdk::FrameStats::Platform_EndPresent();
     
     // Queue up the next update loop
     [self queueNextUpdateLoop];
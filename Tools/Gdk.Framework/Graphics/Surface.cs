@@ -69,6 +69,9 @@ namespace Gdk.Framework
         private int width;
         private int height;
 
+        // Target size of the uncompressed bands of rows in a chunked .gdkimage
+        private const int GdkImageChunkSize = 256 * 1024;
+
         /// <summary>
         /// Gets or Sets the width of the surface image
         /// </summary>
@@ -668,6 +671,18 @@ namespace Gdk.Framework
 			// Bit 3 & 4 = filter mode
 			flags |= (UInt16)((int)filterMode << 3);
 
+			// Get the image data in the given pixel format
+			byte[] imageData = GetImageData(pixelFormat);
+			int rowSize = imageData.Length / Height;
+
+			// Images larger than a single chunk are compressed in bands of rows, that can be decompressed in parallel
+			int rowsPerChunk = Math.Max(1, Math.Min(UInt16.MaxValue, GdkImageChunkSize / Math.Max(1, rowSize)));
+			bool chunked = Height > rowsPerChunk;
+
+			// Bit 5 = chunked image data
+			if(chunked)
+				flags |= 0x0020;
+
 			// Write the image header
 			outFileStream.Write(BitConverter.GetBytes((UInt16)Width), 0, 2);
             outFileStream.Write(BitConverter.GetBytes((UInt16)Height), 0, 2);
@@ -675,11 +690,42 @@ namespace Gdk.Framework
             outFileStream.Write(BitConverter.GetBytes((UInt16)flags), 0, 2);
 			outFileStream.Flush();
 
+			if(chunked)
+			{
+				// Compress each band of rows on its own
+				int numChunks = (Height + rowsPerChunk - 1) / rowsPerChunk;
+				List<byte[]> chunks = new List<byte[]>();
+				for(int chunkIndex = 0; chunkIndex < numChunks; chunkIndex++)
+				{
+					int firstRow = chunkIndex * rowsPerChunk;
+					int numRows = Math.Min(rowsPerChunk, Height - firstRow);
+
+					MemoryStream chunkStream = new MemoryStream();
+					DeflaterOutputStream chunkZStream = new DeflaterOutputStream(chunkStream);
+					chunkZStream.Write(imageData, firstRow * rowSize, numRows * rowSize);
+					chunkZStream.Finish();
+					chunks.Add(chunkStream.ToArray());
+					chunkZStream.Close();
+				}
+
+				// Write the chunk table
+				outFileStream.Write(BitConverter.GetBytes((UInt16)rowsPerChunk), 0, 2);
+				outFileStream.Write(BitConverter.GetBytes((UInt16)numChunks), 0, 2);
+				foreach(byte[] chunk in chunks)
+					outFileStream.Write(BitConverter.GetBytes((UInt32)chunk.Length), 0, 4);
+
+				// Write the chunks
+				foreach(byte[] chunk in chunks)
+					outFileStream.Write(chunk, 0, chunk.Length);
+
+				outFileStream.Close();
+				return;
+			}
+
 			// Open the compressed stream
 			DeflaterOutputStream outZStream = new DeflaterOutputStream(outFileStream);
 
-			// Get the image data in the given pixel format
-			byte[] imageData = GetImageData(pixelFormat);
+			// Write the image data
 			outZStream.Write(imageData, 0, imageData.Length);
 
 			// Flush and close the stream
@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+// Stands in for the GDK's BasePCH.h, when the GDK's LogFormat.cpp is built into GdkLogDecode.
+// Only the platform header & the LogFormat are needed, not the rest of the GDK.
+
+#include "GdkLIB.h"
+#include "System/LogFormat.h"
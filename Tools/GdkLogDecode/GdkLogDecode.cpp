@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+//
+// GdkLogDecode:  Converts a binary log (Gdk.blog) into text, in the same format as Gdk.log
+//
+// Usage:
+//
+//      GdkLogDecode [-t] <Gdk.blog> [output.log]
+//
+//          -t              Show the time of each message in seconds since the first message of
+//                          its session, instead of the wall clock time
+//
+//      The text is written to stdout if no output file is given.
+//
+// Building:
+//
+//      make                                    (See the Makefile)
+//      cl /O2 /EHsc /DWIN32 /I. /I..\..\Source\Gdk /I..\..\Source\Platform\Windows\External\include
+//         GdkLogDecode.cpp ..\..\Source\Gdk\System\LogFormat.cpp
+//
+//      The messages are formatted by the GDK's own LogFormat.cpp, which is built into the tool.  The
+//      BasePCH.h in this folder stands in for the GDK's, so that LogFormat.cpp builds without the rest
+//      of the GDK.  (This folder must come before the GDK source folder in the include path)
+//
+// The binary log is written by the GDK when Log::WriteBinaryLog is set, and holds the messages of
+// the LOG_DEFERRED_ macros.  The format is described in "Docs/File Formats/Binary Log Format.txt".
+//
+
+#include "BasePCH.h"
+
+using namespace std;
+using namespace Gdk;
+
+// Binary log record types
+#define BLOG_RECORD_FORMAT      1
+#define BLOG_RECORD_MESSAGE     2
+
+// Longest formatted message  (LOG_MAX_MESSAGE_SIZE)
+#define MAX_MESSAGE_SIZE        4096
+
+// ***********************************************************************
+struct BlogFormat
+{
+    string Format;
+    vector<UInt8> ArgTypes;
+};
+
+// *****************************************************************
+/// @brief
+///     Formats a message from its format & encoded arguments, with LogFormat::FormatArgs()
+// *****************************************************************
+static string FormatMessage(const BlogFormat& blogFormat, const UInt8* payload, int payloadSize)
+{
+    LogFormat format;
+    format.Format = blogFormat.Format.c_str();
+    format.NumArgs = (int) blogFormat.ArgTypes.size();
+    if(format.NumArgs > LOGFORMAT_MAX_ARGS)
+        format.NumArgs = LOGFORMAT_MAX_ARGS;
+    if(format.NumArgs > 0)
+        memcpy(format.ArgTypes, &blogFormat.ArgTypes[0], format.NumArgs);
+
+    char text[MAX_MESSAGE_SIZE];
+    format.FormatArgs(text, sizeof(text), payload, payloadSize);
+    return text;
+}
+
+// *****************************************************************
+/// @brief
+///     Reads a value from the log
+/// @return
+///     False at the end of the log
+// *****************************************************************
+template <typename T>
+static bool Read(FILE* file, T& value)
+{
+    return fread(&value, sizeof(T), 1, file) == 1;
+}
+
+// *****************************************************************
+static const char* levelNames[] =
+{
+    "System ",
+    "ASSERT ",
+    "ERROR  ",
+    "Warning",
+    "Info   ",
+    "Verbose"
+};
+
+// *****************************************************************
+int main(int argc, char** argv)
+{
+    // Parse the command line
+    bool relativeTimes = false;
+    vector<string> args;
+    for(int argIndex = 1; argIndex < argc; argIndex++)
+    {
+        if(strcmp(argv[argIndex], "-t") == 0)
+            relativeTimes = true;
+        else
+            args.push_back(argv[argIndex]);
+    }
+
+    if(args.size() < 1 || args.size() > 2)
+    {
+        printf("Usage: GdkLogDecode [-t] <Gdk.blog> [output.log]\n");
+        return 1;
+    }
+
+    FILE* input = fopen(args[0].c_str(), "rb");
+    if(input == NULL)
+    {
+        printf("ERROR: Unable to open the log: %s\n", args[0].c_str());
+        return 1;
+    }
+
+    FILE* output = stdout;
+    if(args.size() == 2)
+    {
+        output = fopen(args[1].c_str(), "w");
+        if(output == NULL)
+        {
+            printf("ERROR: Unable to create the output file: %s\n", args[1].c_str());
+            fclose(input);
+            return 1;
+        }
+    }
+
+    // The log can hold several sessions, each starting with a header
+    map<UInt32, BlogFormat> formats;
+    Int64 startTime = 0;
+    double startTimer = 0.0;
+    int numMessages = 0;
+    bool corrupt = false;
+
+    UInt8 recordType;
+    while(corrupt == false && Read(input, recordType))
+    {
+        switch(recordType)
+        {
+            case 'G':
+            {
+                // Session header
+                char tag[7];
+                UInt32 version;
+                if(fread(tag, 1, 7, input) != 7 || memcmp(tag, "DKBLOG1", 7) != 0 ||
+                    Read(input, version) == false || version != 1 ||
+                    Read(input, startTime) == false || Read(input, startTimer) == false)
+                {
+                    corrupt = true;
+                    break;
+                }
+                formats.clear();
+                break;
+            }
+
+            case BLOG_RECORD_FORMAT:
+            {
+                UInt32 formatId;
+                UInt8 numArgs;
+                UInt16 length;
+                BlogFormat format;
+                if(Read(input, formatId) == false || Read(input, numArgs) == false)
+                {
+                    corrupt = true;
+                    break;
+                }
+                format.ArgTypes.resize(numArgs);
+                if(numArgs > 0 && fread(&format.ArgTypes[0], 1, numArgs, input) != numArgs)
+                {
+                    corrupt = true;
+                    break;
+                }
+                if(Read(input, length) == false)
+                {
+                    corrupt = true;
+                    break;
+                }
+                format.Format.resize(length);
+                if(length > 0 && fread(&format.Format[0], 1, length, input) != length)
+                {
+                    corrupt = true;
+                    break;
+                }
+                formats[formatId] = format;
+                break;
+            }
+
+            case BLOG_RECORD_MESSAGE:
+            {
+                double messageTime;
+                UInt8 level;
+                UInt32 formatId;
+                UInt16 payloadSize;
+                if(Read(input, messageTime) == false || Read(input, level) == false ||
+                    Read(input, formatId) == false || Read(input, payloadSize) == false)
+                {
+                    corrupt = true;
+                    break;
+                }
+                vector<UInt8> payload(payloadSize + 1);
+                if(payloadSize > 0 && fread(&payload[0], 1, payloadSize, input) != payloadSize)
+                {
+                    corrupt = true;
+                    break;
+                }
+
+                // Time & level, as Gdk.log writes them
+                char prefix[64];
+                const char* levelName = level < 6 ? levelNames[level] : "Unknown";
+                if(relativeTimes)
+                {
+                    GDK_SNPRINTF(prefix, sizeof(prefix), "[%12.6f][%s]:", messageTime - startTimer, levelName);
+                }
+                else
+                {
+                    time_t wallTime = (time_t)(startTime + (Int64)(messageTime - startTimer));
+                    struct tm* timeinfo = localtime(&wallTime);
+                    GDK_SNPRINTF(prefix, sizeof(prefix), "[%02d/%02d/%02d %02d:%02d:%02d][%s]:",
+                        timeinfo->tm_mon + 1, timeinfo->tm_mday, timeinfo->tm_year % 100,
+                        timeinfo->tm_hour, timeinfo->tm_min, timeinfo->tm_sec,
+                        levelName);
+                }
+
+                map<UInt32, BlogFormat>::iterator formatIter = formats.find(formatId);
+                if(formatIter == formats.end())
+                    fprintf(output, "%s<unknown format %u>\n", prefix, formatId);
+                else
+                    fprintf(output, "%s%s\n", prefix, FormatMessage(formatIter->second, &payload[0], payloadSize).c_str());
+                numMessages++;
+                break;
+            }
+
+            default:
+                corrupt = true;
+                break;
+        }
+    }
+
+    if(corrupt)
+        fprintf(stderr, "WARNING: The log is corrupt or truncated after %d messages\n", numMessages);
+
+    fclose(input);
+    if(output != stdout)
+        fclose(output);
+    return corrupt ? 1 : 0;
+}
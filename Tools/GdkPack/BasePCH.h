@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+// Stands in for the GDK's BasePCH.h, when the GDK's PackWriter.cpp & StringUtilities.cpp are built into GdkPack.
+// Only the platform header & those two classes are needed, not the rest of the GDK.
+
+#include "GdkLIB.h"
+#include "System/StringUtilities.h"
+#include "Resource/PackWriter.h"
+
+// The PackWriter reports its errors through LOG_ERROR, which goes to the console in the tool
+#ifdef GDKPLATFORM_WINDOWS
+    #define LOG_ERROR(format, ...)          printf("ERROR: " format "\n", __VA_ARGS__)
+#else
+    #define LOG_ERROR(format, args...)      printf("ERROR: " format "\n", ##args)
+#endif
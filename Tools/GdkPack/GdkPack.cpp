@@ -0,0 +1,157 @@
+/* 
+ * Copyright (c) 2011, Raincity Games LLC
+ * Licensed under the MIT license: http://www.opensource.org/licenses/mit-license.php
+ */
+
+//
+// GdkPack:  Builds a .gdkpack asset pack from a folder of assets
+//
+// Usage:
+//
+//      GdkPack [-z | -c codec] [-a alignment] <asset folder> <output.gdkpack>
+//
+//          -z              Compress assets with zlib, when it makes them at least 10% smaller
+//          -c codec        Compress assets with the given codec: zlib, lz4 or zstd.  (Same rule as -z)
+//          -a alignment    Alignment of each asset within the pack, in bytes.  (Default = 16)
+//
+// Building:
+//
+//      make                                    (See the Makefile.  make LZ4=1 ZSTD=1 builds in the lz4 & zstd codecs)
+//      cl /O2 /EHsc /DWIN32 /I. /I..\..\Source\Gdk /I..\..\Source\Platform\Windows\External\include
+//         GdkPack.cpp ..\..\Source\Gdk\Resource\PackWriter.cpp ..\..\Source\Gdk\System\StringUtilities.cpp zlib.lib
+//
+//      The pack is written by the GDK's own PackWriter, which is built into the tool along with the
+//      StringUtilities it hashes the asset paths with.  The BasePCH.h in this folder stands in for the
+//      GDK's, so that they build without the rest of the GDK.  (This folder must come before the GDK
+//      source folder in the include path)
+//
+//      The lz4 & zstd codecs are built in with -DGDK_LZ4 (link lz4) and -DGDK_ZSTD (link zstd).
+//      Packs that use them can only be read by builds of GDK with the same defines.
+//
+// The pack format is described in "Docs/File Formats/Pack File Format.txt".  Asset paths are
+// stored relative to the asset folder, with '/' separators, so they match the paths used
+// with AssetManager::GetAssetStream().
+//
+
+#include "BasePCH.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <dirent.h>
+    #include <sys/stat.h>
+#endif
+
+using namespace std;
+using namespace Gdk;
+
+// *****************************************************************
+/// @brief
+///     Recursively collects the relative paths of all the files in a folder
+// *****************************************************************
+void FindFiles(const string& rootFolder, const string& relativeFolder, vector<string>& files)
+{
+    string folder = relativeFolder.empty() ? rootFolder : rootFolder + "/" + relativeFolder;
+
+#ifdef _WIN32
+    WIN32_FIND_DATAA findData;
+    HANDLE findHandle = FindFirstFileA((folder + "/*").c_str(), &findData);
+    if(findHandle == INVALID_HANDLE_VALUE)
+        return;
+    do
+    {
+        string name = findData.cFileName;
+        if(name == "." || name == "..")
+            continue;
+        string relativePath = relativeFolder.empty() ? name : relativeFolder + "/" + name;
+        if(findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+            FindFiles(rootFolder, relativePath, files);
+        else
+            files.push_back(relativePath);
+    } while(FindNextFileA(findHandle, &findData));
+    FindClose(findHandle);
+#else
+    DIR* dir = opendir(folder.c_str());
+    if(dir == NULL)
+        return;
+    struct dirent* dirEntry;
+    while((dirEntry = readdir(dir)) != NULL)
+    {
+        string name = dirEntry->d_name;
+        if(name == "." || name == "..")
+            continue;
+        string relativePath = relativeFolder.empty() ? name : relativeFolder + "/" + name;
+        struct stat fileStat;
+        if(stat((rootFolder + "/" + relativePath).c_str(), &fileStat) != 0)
+            continue;
+        if(S_ISDIR(fileStat.st_mode))
+            FindFiles(rootFolder, relativePath, files);
+        else if(S_ISREG(fileStat.st_mode))
+            files.push_back(relativePath);
+    }
+    closedir(dir);
+#endif
+}
+
+// *****************************************************************
+int main(int argc, char** argv)
+{
+    // Parse the command line
+    UInt16 compression = GDKPACK_COMPRESSION_NONE;
+    UInt64 alignment = GDKPACK_DEFAULT_ALIGNMENT;
+    vector<string> args;
+    for(int argIndex = 1; argIndex < argc; argIndex++)
+    {
+        if(strcmp(argv[argIndex], "-z") == 0)
+            compression = GDKPACK_COMPRESSION_ZLIB;
+        else if(strcmp(argv[argIndex], "-c") == 0 && argIndex + 1 < argc)
+        {
+            const char* codec = argv[++argIndex];
+            if(strcmp(codec, "zlib") == 0)
+                compression = GDKPACK_COMPRESSION_ZLIB;
+            else if(strcmp(codec, "lz4") == 0)
+                compression = GDKPACK_COMPRESSION_LZ4;
+            else if(strcmp(codec, "zstd") == 0)
+                compression = GDKPACK_COMPRESSION_ZSTD;
+            else
+                compression = 0xFFFF;
+
+            if(PackWriter::IsCompressionSupported(compression) == false)
+            {
+                printf("ERROR: Unsupported codec: %s\n", codec);
+                return 1;
+            }
+        }
+        else if(strcmp(argv[argIndex], "-a") == 0 && argIndex + 1 < argc)
+            alignment = (UInt64) atoi(argv[++argIndex]);
+        else
+            args.push_back(argv[argIndex]);
+    }
+
+    if(args.size() != 2 || alignment == 0)
+    {
+        printf("Usage: GdkPack [-z | -c codec] [-a alignment] <asset folder> <output.gdkpack>\n");
+        return 1;
+    }
+
+    const string& assetFolder = args[0];
+    const string& outputPath = args[1];
+
+    // Find the assets
+    vector<string> files;
+    FindFiles(assetFolder, "", files);
+    sort(files.begin(), files.end());
+
+    // Add the assets, in path order
+    PackWriter writer;
+    writer.SetAlignment(alignment);
+    for(size_t fileIndex = 0; fileIndex < files.size(); fileIndex++)
+        writer.AddFile(files[fileIndex].c_str(), (assetFolder + "/" + files[fileIndex]).c_str(), compression);
+
+    // Write the pack  (The writer reports any errors)
+    if(writer.Write(outputPath.c_str()) == false)
+        return 1;
+
+    printf("Packed %d assets into %s (%llu bytes)\n", (int) writer.GetAssetCount(), outputPath.c_str(), (unsigned long long) writer.GetPackSize());
+    return 0;
+}